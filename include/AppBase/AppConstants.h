@@ -133,6 +133,7 @@ struct Constant {
 		// Function timeout
 		struct Timeout {
 			static constexpr int WaitMessage			= 30000;							// 30 seconds
+			static constexpr int ScheduleTimer			= 900000;							// 15 minutes
 		};
 	};
 
@@ -285,12 +286,19 @@ struct Constant {
 			static constexpr const wchar_t* TraceError			= L"TraceError";
 			static constexpr const wchar_t* TraceDebug			= L"TraceDebug";
 			static constexpr const wchar_t* DebugInfo			= L"DebugInfo";
+			static constexpr const wchar_t* AppDataSnapshot		= L"AppData";
+			static constexpr const wchar_t* LogSpill			= L"LogSpill_%02d_%02d";
+			static constexpr const wchar_t* LogJournal			= L"LogJournal_%02d";
 		};
 		struct Extension {
 			static constexpr const wchar_t* Exe					= L".exe";						// EXE file
 			static constexpr const wchar_t* Ini					= L".ini";						// INI file
 			static constexpr const wchar_t* Reg					= L".reg";						// Registry file
 			static constexpr const wchar_t* Log					= L".log";						// Log file
+			static constexpr const wchar_t* LogStore			= L".plb";						// Binary log store file
+			static constexpr const wchar_t* DataSnapshot		= L".pds";						// Binary app data snapshot file
+			static constexpr const wchar_t* LogSpill			= L".pls";						// Log spill file (session only)
+			static constexpr const wchar_t* LogJournal			= L".plj";						// Log journal file
 			static constexpr const wchar_t* Backup				= L".bak";						// Backup file extension
 			static constexpr const wchar_t* Backup_Log			= L"_%02d.log.bak";				// Backup log file extension
 			static constexpr const wchar_t* Help				= L".hlps";						// Help file
@@ -234,6 +234,7 @@
 #define SM_APP_DEBUGCMD_EXEC						(SM_APP_MESSAGE + 11)
 #define SM_APP_DEBUG_OUTPUT							(SM_APP_MESSAGE + 12)
 #define SM_APP_DEBUGCMD_NOREPLY						(SM_APP_MESSAGE + 13)
+#define SM_APP_DEBUGLOG_BUFFERED					(SM_APP_MESSAGE + 14)
 
 
 // Define window custom messages
@@ -281,6 +282,8 @@
 #define TIMERID_STD_POWERREMINDER					(TIMERID_DEFAULT + 2)			// Timer ID for Power Reminder feature
 #define TIMERID_STD_EVENTSKIPCOUNTER				(TIMERID_DEFAULT + 3)			// Timer ID for Event skip counter
 #define TIMERID_RMDMSG_AUTOCLOSE					(TIMERID_DEFAULT + 4)			// Timer ID for Reminder message auto close feature
+#define TIMERID_LOGVIEWER_FILTER					(TIMERID_DEFAULT + 5)			// Timer ID for LogViewer filter refresh (while indexing)
+#define TIMERID_STD_DEBUGLOGFLUSH					(TIMERID_DEFAULT + 6)			// Timer ID for trace/debug log file buffer flushing
 
 
 // Define special numbers and numeric values
@@ -321,6 +324,19 @@
 
 #define TRACE_FORMAT									DebugLogging::GetDebugLogger().TraceErrorFormat
 #define TRACE_ERROR(logString)							DebugLogging::GetDebugLogger().TraceError(logString)
+
+// Leveled trace log functions (std::format syntax, e.g: TRACE_INFO(L"Item count: {}", nCount))
+// Calls below compile-time level are discarded, calls below runtime level only cost one comparison,
+// arguments are captured by value and formatted when trace records are written
+#define TRACE_LOG(level, ...)							do { if constexpr ((level) >= TraceLog::compiledLevel) { \
+															if (TraceLog::IsEnabled(level)) TraceLog::Write((level), std::source_location::current(), __VA_ARGS__); } \
+														} while (0)
+#define TRACE_VERBOSE(...)								TRACE_LOG(TraceLog::Verbose, __VA_ARGS__)
+#define TRACE_DEBUGINFO(...)							TRACE_LOG(TraceLog::Debug, __VA_ARGS__)
+#define TRACE_INFO(...)									TRACE_LOG(TraceLog::Info, __VA_ARGS__)
+#define TRACE_WARNING(...)								TRACE_LOG(TraceLog::Warning, __VA_ARGS__)
+
+// Trace debug info (written to file right away, not filtered by trace level)
 #define TRACE_DEBUG(func, file, line)					DebugLogging::GetDebugLogger().TraceDebugInfo(func, file, line)
 
 
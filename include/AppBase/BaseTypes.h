@@ -67,6 +67,12 @@ using TokenList = typename std::vector<std::wstring>;
 #endif
 
 
+// Using std::to_chars for number conversion
+#if !defined(_CHARCONV_)
+	#include <charconv>
+#endif
+
+
 // Basic string
 // Wrapper of STL wstring
 class String
@@ -108,13 +114,9 @@ public:
 	template <typename _Type>
 	static String FromNumber(_Type number) {
 		static_assert(std::is_arithmetic<_Type>::value, "FromNumber requires a numeric type.");
-		static thread_local wchar_t _tempBuff[100];
-		if constexpr (std::is_integral<_Type>::value)
-			swprintf(_tempBuff, 100, L"%lld", static_cast<long long>(number));
-		else if constexpr (std::is_floating_point<_Type>::value)
-			swprintf(_tempBuff, 100, L"%f", static_cast<double>(number));
-		else wprintf(_tempBuff, 100, L"(Unsupported)");
-		return String(_tempBuff);
+		String _result;
+		_result.AppendNumber(number);
+		return _result;
 	};
 
 public:
@@ -127,23 +129,36 @@ public:
 	};
 
 	// Concatenation operator
-	String operator+(const String& other) const noexcept {
+	// A temporary left operand is appended in place (no new string for each part of a chain)
+	String operator+(const String& other) const& noexcept {
 		return String(_buffer + other._buffer);
 	};
+	String operator+(const String& other) && noexcept {
+		_buffer += other._buffer;
+		return std::move(*this);
+	};
 	String& operator+=(const String& other) {
 		if (this != &other) _buffer += other._buffer;
 		return *this;
 	};
-	String operator+(const std::wstring& other) const noexcept {
+	String operator+(const std::wstring& other) const& noexcept {
 		return String(_buffer + other);
 	};
+	String operator+(const std::wstring& other) && noexcept {
+		_buffer += other;
+		return std::move(*this);
+	};
 	String& operator+=(const std::wstring& other) {
 		if (_buffer != other) _buffer += other;
 		return *this;
 	};
-	String operator+(const wchar_t* other) const noexcept {
+	String operator+(const wchar_t* other) const& noexcept {
 		return String(_buffer + other);
 	};
+	String operator+(const wchar_t* other) && noexcept {
+		_buffer += other;
+		return std::move(*this);
+	};
 	String& operator+=(const wchar_t* other) {
 		_buffer += other;
 		return *this;
@@ -263,6 +278,14 @@ public:
 	constexpr size_t GetLength(void) const noexcept {
 		return _buffer.length();
 	};
+	constexpr size_t GetCapacity(void) const noexcept {
+		return _buffer.capacity();
+	};
+
+	// Pre-allocate buffer capacity (content is kept)
+	void Reserve(size_t capacity) {
+		_buffer.reserve(capacity);
+	};
 
 public:
 	// Get/set functions
@@ -340,6 +363,25 @@ public:
 		return *this;
 	};
 
+	// Append a number (same output as "%lld" or "%f" format, without formatting overhead)
+	template <typename _Type>
+	String& AppendNumber(_Type number) {
+		static_assert(std::is_arithmetic<_Type>::value, "AppendNumber requires a numeric type.");
+		char _tempBuff[384];
+		std::to_chars_result _result{};
+		if constexpr (std::is_same<_Type, bool>::value)
+			_result = std::to_chars(_tempBuff, _tempBuff + sizeof(_tempBuff), static_cast<int>(number));
+		else if constexpr (std::is_integral<_Type>::value && std::is_unsigned<_Type>::value)
+			_result = std::to_chars(_tempBuff, _tempBuff + sizeof(_tempBuff), static_cast<unsigned long long>(number));
+		else if constexpr (std::is_integral<_Type>::value)
+			_result = std::to_chars(_tempBuff, _tempBuff + sizeof(_tempBuff), static_cast<long long>(number));
+		else
+			_result = std::to_chars(_tempBuff, _tempBuff + sizeof(_tempBuff), static_cast<double>(number), std::chars_format::fixed, 6);
+		if (_result.ec == std::errc())
+			_buffer.append(_tempBuff, _result.ptr);
+		return *this;
+	};
+
 	// Remove all occurences of a character
 	String& Remove(const wchar_t& ch) {
 		_buffer.erase(std::remove(_buffer.begin(), _buffer.end(), ch), _buffer.end());
@@ -488,6 +530,14 @@ public:
 	};
 	String& FormatV(const wchar_t* formatStr, va_list vargs);
 
+	// Append formatted string (formatted directly into the existing buffer capacity)
+	String& AppendFormat(const wchar_t* formatStr, ...) {
+		va_list args; va_start(args, formatStr);
+		AppendFormatV(formatStr, args); va_end(args);
+		return *this;
+	};
+	String& AppendFormatV(const wchar_t* formatStr, va_list vargs);
+
 	// Upper first character of each word
 	String& UpperEachWord(void);
 
@@ -496,6 +546,70 @@ public:
 };
 
 
+// String builder
+// Build strings in one growing buffer; resetting the builder keeps allocated capacity,
+// so the same builder can be reused to build many strings without allocating again
+class StringBuilder
+{
+private:
+	String _buffer;
+
+public:
+	// Construction
+	explicit StringBuilder(size_t initCapacity = 256) {
+		_buffer.Reserve(initCapacity);
+	};
+
+	// No copyable
+	StringBuilder(const StringBuilder&) = delete;
+	StringBuilder& operator=(const StringBuilder&) = delete;
+
+public:
+	// Append data
+	StringBuilder& Append(const String& str) {
+		_buffer.Append(str);
+		return *this;
+	};
+	StringBuilder& Append(const wchar_t* str) {
+		if (str != NULL) _buffer.Append(str);
+		return *this;
+	};
+	StringBuilder& AppendChar(wchar_t ch) {
+		_buffer.AppendChar(ch);
+		return *this;
+	};
+	template <typename _Type>
+	StringBuilder& AppendNumber(_Type number) {
+		_buffer.AppendNumber(number);
+		return *this;
+	};
+	StringBuilder& AppendFormat(const wchar_t* formatStr, ...) {
+		va_list args; va_start(args, formatStr);
+		_buffer.AppendFormatV(formatStr, args); va_end(args);
+		return *this;
+	};
+
+	// Clear content (keep buffer capacity for reuse)
+	void Reset(void) noexcept {
+		_buffer.Empty();
+	};
+
+	// Access result
+	constexpr size_t GetLength(void) const noexcept {
+		return _buffer.GetLength();
+	};
+	constexpr const wchar_t* GetString(void) const noexcept {
+		return _buffer.GetString();
+	};
+	String& GetBuffer(void) noexcept {
+		return _buffer;
+	};
+	String ToString(void) const {
+		return _buffer;
+	};
+};
+
+
 // Use STL chrono for time
 #ifndef _CHRONO_
 	#include <chrono>
@@ -1046,6 +1160,18 @@ class DateTime : public __TimeBase
 public:
 	enum __DayOfWeek { Sunday, Monday, Tuesday, Wednesday, Thursday, Friday, Saturday };
 
+	// Broken-down calendar fields
+	struct Fields {
+		int			year;
+		unsigned	month;
+		unsigned	day;
+		int			hour;
+		int			minute;
+		int			second;
+		int			millisecond;
+		int			dayOfWeek;
+	};
+
 public:
 	// Construction
 	explicit DateTime() = default;
@@ -1089,7 +1215,26 @@ public:
 
 	// Get clock-time data
 	ClockTime GetClockTime(void) const noexcept {
-		return ClockTime(Hour(), Minute(), Second(), Millisecond());
+		const Fields _fields = Decompose();
+		return ClockTime(_fields.hour, _fields.minute, _fields.second, _fields.millisecond);
+	};
+
+	// Get all calendar fields with a single date/time decomposition
+	// (use this instead of calling several field getters in a row)
+	constexpr Fields Decompose(void) const noexcept {
+		const auto _days = std::chrono::floor<__Days>(_timePoint);
+		const __Date _dateVal{ _days };
+		const std::chrono::hh_mm_ss<__Milliseconds> _timeVal{ std::chrono::floor<__Milliseconds>(_timePoint - _days) };
+		return Fields{
+			static_cast<int>(_dateVal.year()),
+			static_cast<unsigned>(_dateVal.month()),
+			static_cast<unsigned>(_dateVal.day()),
+			static_cast<int>(_timeVal.hours().count()),
+			static_cast<int>(_timeVal.minutes().count()),
+			static_cast<int>(_timeVal.seconds().count()),
+			static_cast<int>(_timeVal.subseconds().count()),
+			static_cast<int>(__Weekday{ _days }.c_encoding())
+		};
 	};
 
 public:
@@ -227,6 +227,7 @@
 #define IDC_LOGVIEWER_REMOVEALL_BTN          			(CONTROLID_LOGVIEWER_DLG+2)
 #define IDC_LOGVIEWER_DETAILS_BTN          				(CONTROLID_LOGVIEWER_DLG+3)
 #define IDC_LOGVIEWER_CLOSE_BTN        					(CONTROLID_LOGVIEWER_DLG+4)
+#define IDC_LOGVIEWER_FILTER_EDIT        				(CONTROLID_LOGVIEWER_DLG+5)
 
 //****************************************************************************************
 
@@ -110,6 +110,9 @@
 	#include <Wbemidl.h>
 	#pragma comment(lib, "wbemuuid.lib")
 
+	#include <ktmw32.h>
+	#pragma comment(lib, "ktmw32.lib")
+
 	#include <dwmapi.h>
 	#ifndef DWMWA_USE_IMMERSIVE_DARK_MODE
 		#define DWMWA_USE_IMMERSIVE_DARK_MODE 20
@@ -14,6 +14,10 @@
 #include "Components/GridCtrl/GridCellCheck.h"
 #include "Language.h"
 
+#include <array>
+#include <atomic>
+#include <functional>
+
 
 // Grid table column style
 typedef enum eGRIDCOLSTYLE {
@@ -161,6 +165,9 @@ public:
 		restartAsAdmin,												// Restart as admin flag
 		pwrBroadcastSkipCount,										// Power Broadcase event skip counter
 		wtsSessionNotifyRegistered,									// WTS Session Change State Notification registered
+
+	// Number of flags (must be the last)
+		flagCount,
 	};
 	enum ManagerID {
 		dialogFlagManager,											// Dialog-owned flag manager
@@ -173,13 +180,35 @@ public:
 		globallyManaged,											// For flags managed centrally by a global/shared manager
 	};
 
+public:
+	// Flag value change callback
+	using FlagChangedCallback = typename std::function<void(AppFlagID eFlagID, int nValue)>;
+
 private:
+	// Flag change subscriber
+	struct SUBSCRIBER {
+		size_t				nSubscriptionID;						// Subscription ID
+		AppFlagID			eFlagID;								// Subscribed flag ID
+		FlagChangedCallback	funcCallback;							// Callback function
+	};
+
 	// Define private typenames/aliases
-	using UniqueFlagMap = typename std::unordered_map<AppFlagID, int>;
+	using FlagArray = typename std::array<std::atomic<int>, flagCount>;
+	using SubscriberList = typename std::vector<SUBSCRIBER>;
+
+	// One bit per flag for flag presence and change masks
+	static_assert(flagCount <= 64, "Flag masks only support up to 64 flags");
 
 private:
 	// Attributes
-	UniqueFlagMap m_mapUniqueFlags;
+	// Flag values are lock-free atomics indexed by flag ID, so they can be read from any thread
+	FlagArray				m_arrFlags{};							// Flag values
+	std::atomic<uint64_t>	m_ullPresentMask{0};					// Flags which have been set
+	std::atomic<uint64_t>	m_ullChangedMask{0};					// Flags changed since last notification
+
+	// Change subscribers (only accessed from the UI thread)
+	SubscriberList			m_arrSubscribers;
+	size_t					m_nNextSubscriptionID = 1;
 
 public:
 	// Constructor
@@ -194,24 +223,39 @@ private:
 	FlagManager(const FlagManager&&) = delete;
 	FlagManager& operator=(const FlagManager&&) = delete;
 
+	// Flag mask bit and validity
+	static constexpr bool IsValidFlagID(AppFlagID eFlagID) noexcept {
+		return ((eFlagID >= 0) && (eFlagID < flagCount));
+	};
+	static constexpr uint64_t GetFlagBit(AppFlagID eFlagID) noexcept {
+		return (1ULL << eFlagID);
+	};
+
 public:
 	// Check if a flag value exists
-	bool IsFlagPresent(AppFlagID eFlagID) const {
-		auto it = m_mapUniqueFlags.find(eFlagID);
-		return (it != m_mapUniqueFlags.end());
+	bool IsFlagPresent(AppFlagID eFlagID) const noexcept {
+		if (!IsValidFlagID(eFlagID)) return false;
+		return ((m_ullPresentMask.load(std::memory_order_acquire) & GetFlagBit(eFlagID)) != 0);
 	};
 
 	// Get application flag value by ID
-	int GetFlagValue(AppFlagID eFlagID) const {
-		auto it = m_mapUniqueFlags.find(eFlagID);
-		if (it != m_mapUniqueFlags.end()) return it->second;
-		else return FLAG_OFF;
+	int GetFlagValue(AppFlagID eFlagID) const noexcept {
+		if (!IsValidFlagID(eFlagID)) return FLAG_OFF;
+		return m_arrFlags[eFlagID].load(std::memory_order_acquire);
 	};
 
 	// Set application flag value by ID
-	void SetFlagValue(AppFlagID eFlagID, int nValue) {
-		m_mapUniqueFlags[eFlagID] = nValue;
+	void SetFlagValue(AppFlagID eFlagID, int nValue) noexcept {
+		if (!IsValidFlagID(eFlagID)) return;
+		int nOldValue = m_arrFlags[eFlagID].exchange(nValue, std::memory_order_acq_rel);
+		m_ullPresentMask.fetch_or(GetFlagBit(eFlagID), std::memory_order_release);
+		if (nOldValue != nValue) m_ullChangedMask.fetch_or(GetFlagBit(eFlagID), std::memory_order_release);
 	};
+
+	// Flag change notification (batched, dispatched from the UI thread)
+	size_t Subscribe(AppFlagID eFlagID, FlagChangedCallback&& funcCallback);
+	void Unsubscribe(size_t nSubscriptionID);
+	size_t DispatchNotifications(void);
 };
 
 // Define new global typenames for the enum attributes of Application flag data
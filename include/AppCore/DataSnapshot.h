@@ -0,0 +1,47 @@
+﻿/**
+ * @file		DataSnapshot.h
+ * @brief		Versioned binary snapshot file of app data for fast loading at startup
+ * @author		AnthonyLeeStark
+ * @date		2026.10.17
+ *
+ * @copyright 	Copyright (c) 2015-2025 AnthonyLeeStark
+ */
+
+#pragma once
+
+#include "AppCore/AppCore.h"
+#include "AppCore/SettingsStore.h"
+
+
+// App data snapshot file layout
+//	[Header][Serialized settings snapshot (config, schedule, HotkeySet and Power Reminder sections)]
+// The file holds the same sections/keys as registry, so it can be loaded with one read instead of
+// one registry query per value. Registry stays the primary storage: the file is only used
+// if its serial number matches the one committed to registry together with the data,
+// otherwise data is loaded from registry keys and the file is written again.
+namespace DataSnapshot
+{
+	// Define constant values
+	static constexpr DWORD	fileMagic = 0x53445050;					// File signature ("PPDS")
+	static constexpr WORD	formatVersion = 1;						// Snapshot format version
+	static constexpr DWORD	maxFileSize = 0x1000000;				// Max file size (in bytes)
+
+	// File header
+	struct FILEHEADER {
+		DWORD	dwMagic;											// File signature
+		WORD	wVersion;											// Snapshot format version
+		WORD	wHeaderSize;										// Header size (in bytes)
+		DWORD	dwSerial;											// Snapshot serial number (same as registry)
+		DWORD	dwDataSize;											// Snapshot data size (in bytes)
+		DWORD	dwChecksum;											// Snapshot data checksum (CRC-32)
+	};
+
+	// Get snapshot file path
+	String GetFilePath(void);
+
+	// Write snapshot file (atomically replace the old file)
+	bool Write(const SettingsStore::Snapshot& snapshot, DWORD dwSerial);
+
+	// Read and validate snapshot file
+	bool Read(DWORD dwSerial, SettingsStore::Snapshot& snapshot);
+};
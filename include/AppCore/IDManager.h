@@ -11,6 +11,8 @@
 
 #include "AppCore.h"
 
+#include <unordered_map>
+
 
 // Get application-managed resource ID map data pointer
 #define GET_RESOURCEID_MAP()	\
@@ -58,10 +60,9 @@
 			Menu, resourceID, nameID \
 		},
 
-// Add resource ID to map
+// Add resource ID to map (existing resource IDs are skipped)
 #define ADD_RESOURCE_ID(typeID, resourceID, nameID) \
-		if (GET_RESOURCEID_MAP()->FindResourceID(resourceID) == -1) \
-			GET_RESOURCEID_MAP()->Add(typeID, resourceID, nameID);
+		GET_RESOURCEID_MAP()->Add(typeID, resourceID, nameID);
 
 // Modify resource name ID
 #define MODIFY_RESOURCE_ID(resourceID, newNameID) \
@@ -121,6 +122,7 @@ struct RESOURCE_ID_MAP_ENTRY
 
 // Define new typename for Resource ID Map data
 using RESOURCE_ID_MAP = RESOURCE_ID_MAP_ENTRY*;
+using RESOURCE_ID_MAP_DATA = typename std::vector<RESOURCE_ID_MAP_ENTRY>;
 
 
 // For resource ID mapping function
@@ -129,9 +131,12 @@ class SResourceIDMap : public CObject
 	DECLARE_DYNAMIC(SResourceIDMap)
 
 private:
-	// Data container
-	RESOURCE_ID_MAP m_pIDMapData;
-	size_t			m_nSize;
+	// Data container (contiguous, in order of addition)
+	RESOURCE_ID_MAP_DATA m_arrIDMapData;
+
+	// Lookup indexes (ID --> index of first entry with that ID)
+	std::unordered_map<DWORD, size_t>		m_mapResourceIDIndex;
+	std::unordered_map<std::string, size_t>	m_mapNameIDIndex;
 
 	// Single instance and thread safety guard
 	static SResourceIDMap*	m_thisInstance;
@@ -174,4 +179,9 @@ public:
 	// Attributes get/set functions
 	const RESOURCE_ID_MAP_ENTRY& GetAt(size_t nIndex) const;
 	size_t GetMapCount(void) const;
+
+private:
+	void Reserve(size_t nCount);
+	void AddEntry(const RESOURCE_ID_MAP_ENTRY& mapEntry);
+	void RebuildIndex(void);
 };
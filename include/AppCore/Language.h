@@ -227,6 +227,7 @@ namespace Language
 		{ IDC_LOGVIEWER_REMOVEALL_BTN,							_T("Remove All Records") },
 		{ IDC_LOGVIEWER_DETAILS_BTN,							_T("Details") },
 		{ IDC_LOGVIEWER_CLOSE_BTN,								_T("Close") },
+		{ IDC_LOGVIEWER_FILTER_EDIT,							_T("Filter (words, id:, name:, pid:, from:, to:)") },
 
 		{ GRIDCOLUMN_LOGVIEWER_DATETIME,						_T("Date/Time") },
 		{ GRIDCOLUMN_LOGVIEWER_CATEGORY,						_T("Category") },
@@ -755,6 +756,7 @@ namespace Language
 		{ IDC_LOGVIEWER_REMOVEALL_BTN,							_T("Xoá hết Bản ghi") },
 		{ IDC_LOGVIEWER_DETAILS_BTN,							_T("Chi tiết") },
 		{ IDC_LOGVIEWER_CLOSE_BTN,								_T("Đóng") },
+		{ IDC_LOGVIEWER_FILTER_EDIT,							_T("Lọc (từ khoá, id:, name:, pid:, from:, to:)") },
 
 		{ GRIDCOLUMN_LOGVIEWER_DATETIME,						_T("Ngày/Giờ") },
 		{ GRIDCOLUMN_LOGVIEWER_CATEGORY,						_T("Sự kiện") },
@@ -1284,6 +1286,7 @@ namespace Language
 		{ IDC_LOGVIEWER_REMOVEALL_BTN,							_T("删除所有记录") },
 		{ IDC_LOGVIEWER_DETAILS_BTN,							_T("细节") },
 		{ IDC_LOGVIEWER_CLOSE_BTN,								_T("关闭") },
+		{ IDC_LOGVIEWER_FILTER_EDIT,							_T("筛选 (关键字, id:, name:, pid:, from:, to:)") },
 
 		{ GRIDCOLUMN_LOGVIEWER_DATETIME,						_T("时间") },
 		{ GRIDCOLUMN_LOGVIEWER_CATEGORY,						_T("事件") },
@@ -1617,8 +1620,13 @@ namespace Language
 	};
 
 
+	// Language string lookup index (ID -> string)
+	using LANGINDEX = std::unordered_map<unsigned, const wchar_t*>;
+
 	// Language table package processing functions
 	const wchar_t* GetLanguageName(unsigned nCurLanguage, bool bGetDescription = false);
 	LANGTABLE_PTR LoadLanguageTable(unsigned nCurLanguage);
+	const LANGINDEX* GetLanguageIndex(LANGTABLE_PTR ptLanguage);
 	const wchar_t* GetLanguageString(LANGTABLE_PTR ptLanguage, unsigned nID);
+	const wchar_t* FindLanguageString(LANGTABLE_PTR ptLanguage, unsigned nID);
 };
@@ -0,0 +1,120 @@
+﻿/**
+ * @file		LogArena.h
+ * @brief		Monotonic memory arena for log item detail data
+ * @author		AnthonyLeeStark
+ * @date		2026.10.17
+ *
+ * @copyright 	Copyright (c) 2015-2025 AnthonyLeeStark
+ */
+
+#pragma once
+
+#include "AppCore.h"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+
+
+// Monotonic memory arena shared by a batch of log items
+// Memory is only allocated (never freed one by one) and is released all at once
+// when the last item referencing the arena is gone. Log items created in a row
+// take their detail records and strings from the same batch arena.
+class LogArena
+{
+public:
+	// Define constant values
+	static constexpr size_t blockSize = 0x4000;						// Arena block size (in bytes)
+	static constexpr size_t batchSize = 0x10000;					// Start a new batch arena after this many bytes
+
+private:
+	// Arena blocks
+	std::vector<std::unique_ptr<BYTE[]>> m_arrBlocks;				// Allocated blocks
+	BYTE*					m_pCurrent;								// Free space in current block
+	size_t					m_nRemaining;							// Free space size in current block
+	size_t					m_nUsedSize;							// Allocated size (in bytes)
+	size_t					m_nReservedSize;						// Total block size (in bytes)
+	mutable std::mutex		m_mtxArena;								// Arena lock (items may be copied on other threads)
+
+	// Statistics of all arenas
+	static std::atomic<size_t> totalUsedSize;						// Allocated size of all alive arenas (in bytes)
+
+public:
+	// Construction
+	LogArena();
+	~LogArena();
+
+	// No copyable
+	LogArena(const LogArena&) = delete;
+	LogArena& operator=(const LogArena&) = delete;
+
+public:
+	// Allocate memory
+	void* Allocate(size_t nSize, size_t nAlignment);
+
+	// Copy a string into arena (return empty string for NULL or empty source)
+	const wchar_t* CopyString(const wchar_t* srcString);
+
+	// Get arena statistics
+	size_t GetUsedSize(void) const noexcept;
+	size_t GetReservedSize(void) const noexcept;
+	static size_t GetTotalUsedSize(void) noexcept {
+		return totalUsedSize.load(std::memory_order_relaxed);
+	};
+
+	// Get the arena of current log item batch
+	static std::shared_ptr<LogArena> GetCurrentBatch(void);
+};
+
+
+// STL allocator taking memory from a log arena
+// The allocator shares ownership of its arena and propagates with the container,
+// so copied/moved containers always keep the arena holding their data alive
+template <typename _Type>
+class LogArenaAllocator
+{
+	template <typename _Other>
+	friend class LogArenaAllocator;
+
+public:
+	using value_type = _Type;
+	using propagate_on_container_copy_assignment = std::true_type;
+	using propagate_on_container_move_assignment = std::true_type;
+	using propagate_on_container_swap = std::true_type;
+
+private:
+	std::shared_ptr<LogArena> m_pArena;								// Arena
+
+public:
+	// Construction
+	explicit LogArenaAllocator(const std::shared_ptr<LogArena>& pArena) noexcept : m_pArena(pArena) {};
+	template <typename _Other>
+	LogArenaAllocator(const LogArenaAllocator<_Other>& other) noexcept : m_pArena(other.m_pArena) {};
+
+	// Moving keeps the source allocator unchanged (no implicit move constructor)
+	LogArenaAllocator(const LogArenaAllocator&) noexcept = default;
+	LogArenaAllocator& operator=(const LogArenaAllocator&) noexcept = default;
+
+public:
+	// Allocator functions
+	_Type* allocate(size_t nCount) {
+		return static_cast<_Type*>(m_pArena->Allocate(nCount * sizeof(_Type), alignof(_Type)));
+	};
+	void deallocate(_Type* /*pData*/, size_t /*nCount*/) noexcept {
+		// Memory is released together with the arena
+	};
+	LogArenaAllocator select_on_container_copy_construction(void) const noexcept {
+		return *this;
+	};
+
+	// Get arena
+	const std::shared_ptr<LogArena>& GetArena(void) const noexcept {
+		return m_pArena;
+	};
+
+	// Equality operator
+	template <typename _Other>
+	bool operator==(const LogArenaAllocator<_Other>& other) const noexcept {
+		return (m_pArena == other.m_pArena);
+	};
+};
@@ -0,0 +1,139 @@
+﻿/**
+ * @file		LogIndex.h
+ * @brief		In-memory inverted index over log items for filtering and searching
+ * @author		AnthonyLeeStark
+ * @date		2026.10.17
+ *
+ * @copyright 	Copyright (c) 2015-2025 AnthonyLeeStark
+ */
+
+#pragma once
+
+#include "Logging.h"
+
+#include <map>
+#include <mutex>
+#include <shared_mutex>
+#include <atomic>
+#include <functional>
+#include <thread>
+#include <unordered_map>
+
+
+// Index log items on a background thread and answer filter queries
+// Items are numbered in order of addition (same as their index in the log data source).
+// Filter syntax (all terms must match, words are matched by prefix, case-insensitive):
+//	word		- Description words, category name or name ID
+//	id:123		- Resource ID detail
+//	name:abc	- Name ID detail
+//	pid:456		- Process ID
+//	from:2025/01/31, to:2025/12/31 - Date range (inclusive)
+class LogIndex
+{
+public:
+	// Define index typenames
+	using ItemList = typename std::vector<UINT>;
+
+	// Index entry (key fields copied from a log item)
+	struct Entry {
+		INT64			nTime;										// Log time (milliseconds since epoch)
+		DWORD			dwProcessID;								// Process ID
+		USHORT			usCategory;									// Log category
+		int				nResourceID;								// Resource ID detail (INT_INVALID if none)
+		std::wstring	nameID;										// Name ID detail
+		std::wstring	description;								// Description string
+	};
+
+	// Item source: fill the entry of an item (return false if the item can not be read)
+	using SourceFunc = typename std::function<bool(size_t, Entry&)>;
+
+private:
+	// Parsed filter
+	struct Filter {
+		std::vector<std::wstring> arrWords;							// Words (lower-case)
+		std::vector<std::wstring> arrNameIDs;						// Name ID prefixes (lower-case)
+		std::vector<int>	arrResourceIDs;							// Resource IDs
+		std::vector<DWORD>	arrProcessIDs;							// Process IDs
+		INT64				nTimeFrom;								// Date range begin
+		INT64				nTimeTo;								// Date range end
+	};
+
+private:
+	// Index data (guarded by index lock)
+	mutable std::shared_mutex	m_mtxIndex;							// Index lock
+	std::vector<INT64>			m_arrTime;							// Log time column
+	std::vector<DWORD>			m_arrProcessID;						// Process ID column
+	std::vector<USHORT>			m_arrCategory;						// Log category column
+	std::map<std::wstring, ItemList>		m_mapTokens;			// Description word postings (sorted, for prefix search)
+	std::map<std::wstring, ItemList>		m_mapNameIDs;			// Name ID postings (sorted, for prefix search)
+	std::unordered_map<USHORT, ItemList>	m_mapCategories;		// Category postings
+	std::unordered_map<int, ItemList>		m_mapResourceIDs;		// Resource ID postings
+
+	// Pending entries (guarded by pending lock)
+	std::mutex			m_mtxPending;								// Pending lock
+	std::vector<Entry>	m_arrPending;								// Entries waiting for indexing
+	size_t				m_nGeneration;								// Incremented when the index is cleared
+	std::atomic<size_t>	m_nAddedCount;								// Number of added entries
+
+	// Item source (guarded by pending lock, read on the indexing thread)
+	SourceFunc			m_fnSource;									// Source item reader
+	size_t				m_nSourceCount;								// Number of source items
+	size_t				m_nSourcePos;								// Next source item to read
+
+	// Indexing thread
+	std::thread			m_thrIndexer;								// Indexing thread
+	HANDLE				m_hWakeEvent;								// Wake-up event
+	std::atomic<bool>	m_bStopRequest;								// Stop request flag
+
+public:
+	// Construction
+	LogIndex();
+	~LogIndex();
+
+	// No copyable
+	LogIndex(const LogIndex&) = delete;
+	LogIndex& operator=(const LogIndex&) = delete;
+
+public:
+	// Indexing thread control
+	bool Start(void);
+	void Stop(void);
+	bool IsRunning(void) const noexcept {
+		return m_thrIndexer.joinable();
+	};
+
+	// Add items (indexed later on the indexing thread)
+	void AddItem(const LOGITEM& logItem);
+	void AddEntry(Entry&& indexEntry);
+	void Clear(void);
+
+	// Set a source of items to be read on the indexing thread, chunk by chunk,
+	// so that the caller does not have to read all items beforehand.
+	// Source items are numbered from 0 (the index must be empty) and are indexed
+	// before entries added later. Queries only see the items indexed so far.
+	void SetSource(SourceFunc fnSource, size_t nItemCount);
+
+	// Get indexing progress
+	size_t GetAddedCount(void) const noexcept {
+		return m_nAddedCount.load();
+	};
+	size_t GetIndexedCount(void) const;
+	bool IsUpToDate(void) const {
+		return (GetIndexedCount() >= GetAddedCount());
+	};
+
+	// Get items (in order) which match a filter string
+	size_t Query(const wchar_t* filterString, LANGTABLE_PTR ptrLanguage, ItemList& arrResult) const;
+
+public:
+	// Make an index entry from a log item
+	static void MakeEntry(const LOGITEM& logItem, Entry& indexEntry);
+
+private:
+	void Run(void);
+	void IndexEntry(const Entry& indexEntry);
+	static void ParseFilter(const wchar_t* filterString, Filter& filter);
+	static void Tokenize(const std::wstring& text, std::vector<std::wstring>& arrTokens);
+	static void Intersect(ItemList& arrItems, const ItemList& arrOther);
+	static void CollectPrefix(const std::map<std::wstring, ItemList>& mapPostings, const std::wstring& prefix, ItemList& arrItems);
+};
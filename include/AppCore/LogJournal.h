@@ -0,0 +1,110 @@
+﻿/**
+ * @file		LogJournal.h
+ * @brief		Append-only checksummed journal of log items which are not written yet
+ * @author		AnthonyLeeStark
+ * @date		2026.10.17
+ *
+ * @copyright 	Copyright (c) 2015-2025 AnthonyLeeStark
+ */
+
+#pragma once
+
+#include "Logging.h"
+
+#include <atomic>
+#include <mutex>
+
+
+// Log journal file layout
+//	[Record][Record]...		Record: [Header][Data]
+// Each queued log item is appended as one item record before it is handed to the writer thread,
+// and a checkpoint record marks that all items with a lower sequence number are written into log files.
+// If a batch is only written into some of the output files, a written record marks its items,
+// so that they are not written into those files again when the journal is replayed.
+// Records are appended with one sequential write and are not flushed to disk one by one,
+// so they survive an app crash or a system shutdown, but not a power loss.
+// A torn or corrupted record (checksum mismatch) ends the journal.
+class LogJournal
+{
+public:
+	// Define constant values
+	static constexpr DWORD	recordMagic = 0x4A4C5050;				// Record signature ("PPLJ")
+	static constexpr DWORD	maxRecordSize = 0x100000;				// Max record data size (in bytes)
+	static constexpr DWORD	maxFileSize = 0x4000000;				// Max journal size to be replayed (in bytes)
+	static constexpr ULONGLONG truncateSize = 0x40000;				// Empty the journal when all items are written and it exceeds this size
+
+	// Record types
+	enum RecordType : WORD {
+		Item = 1,													// Log item
+		Checkpoint,													// Items before this sequence number are written
+		Written,													// Items from this sequence number are written into some output files
+	};
+
+	// Output files of log items
+	enum OutputFile : WORD {
+		LogFile = 0x0001,											// YAML log file
+		StoreFile = 0x0002,											// Log store file
+		AllFiles = (LogFile | StoreFile),
+	};
+
+	// Record header
+	struct RECORDHEADER {
+		DWORD		dwMagic;										// Record signature
+		DWORD		dwChecksum;										// Checksum of the rest of header and data (CRC-32)
+		WORD		wType;											// Record type
+		WORD		wHeaderSize;									// Header size (in bytes)
+		DWORD		dwDataSize;										// Record data size (in bytes)
+		ULONGLONG	ullSequence;									// Item sequence number
+	};
+
+private:
+	// Journal file
+	String					m_strFilePath;							// Journal file path
+	HANDLE					m_hFile;								// Journal file handle
+	ULONGLONG				m_ullFileSize;							// Journal file size
+	std::vector<BYTE>		m_arrRecordBuff;						// Record buffer (reused)
+	std::mutex				m_mtxJournal;							// Journal lock
+
+public:
+	// Construction
+	LogJournal();
+	~LogJournal();
+
+	// No copyable
+	LogJournal(const LogJournal&) = delete;
+	LogJournal& operator=(const LogJournal&) = delete;
+
+public:
+	// Create an empty journal file (the previous one is overwritten)
+	bool Create(const wchar_t* filePath);
+	bool IsOpen(void) const noexcept {
+		return (m_hFile != INVALID_HANDLE_VALUE);
+	};
+
+	// Close and remove the journal file (all items are written)
+	void Remove(void);
+
+	// Append a log item record
+	bool AppendItem(size_t nSequence, const LOGITEM& logItem);
+
+	// Mark items before a sequence number as written
+	// If no other item is queued (queued count equals written count) and the journal is large enough, empty it instead
+	bool AppendCheckpoint(size_t nWrittenCount, const std::atomic<size_t>& nQueuedCount);
+
+	// Mark a range of items as written into some output files (OutputFile flags)
+	bool AppendWritten(size_t nSequence, size_t nCount, WORD wOutputFiles);
+
+public:
+	// Get journal file path of a log type
+	static String GetFilePath(byte byLogType, const wchar_t* folderPath);
+
+	// Read items of a journal file which are not written into log files yet (in sequence order)
+	// and optionally the output files which already have each item (OutputFile flags)
+	static bool ReadItems(const wchar_t* filePath, LOGDATA& arrLogData, std::vector<WORD>* pArrWrittenFiles = NULL);
+
+private:
+	bool AppendRecord(WORD wType, size_t nSequence);
+	bool Truncate(void);
+	static void SerializeItem(const LOGITEM& logItem, std::vector<BYTE>& buffer);
+	static bool DeserializeItem(const BYTE* pData, size_t nSize, LOGITEM& logItem);
+};
@@ -0,0 +1,97 @@
+﻿/**
+ * @file		LogSpill.h
+ * @brief		Spill older log items of a bounded in-memory log into a session file
+ * @author		AnthonyLeeStark
+ * @date		2026.10.17
+ *
+ * @copyright 	Copyright (c) 2015-2025 AnthonyLeeStark
+ */
+
+#pragma once
+
+#include "Logging.h"
+#include "LogStore.h"
+
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <thread>
+
+
+// Keep log items which are moved out of an in-memory ring buffer
+// Each spilled segment is appended as one log store block to a spill file by a background thread.
+// Segments stay readable in memory until they are written, then items are read back
+// through a mapped view of the file. The spill file only lives as long as the log data.
+class LogSpill
+{
+public:
+	// Spilled segment (consecutive log items, oldest first)
+	using SEGMENT = std::vector<LOGITEM>;
+	using PSEGMENT = std::shared_ptr<SEGMENT>;
+
+private:
+	// Properties
+	byte		m_byLogType;										// Log type
+	String		m_strFilePath;										// Spill file path
+	std::atomic<DWORD> m_dwLastError;								// Last write error code
+
+	// Spilled data
+	std::deque<PSEGMENT>	m_arrPending;							// Segments which are not written yet
+	size_t					m_nSpilledCount;						// Number of spilled items
+	std::atomic<size_t>		m_nWrittenCount;						// Number of items written into spill file
+	mutable std::mutex		m_mtxSpill;								// Spilled data lock
+
+	// Spill thread
+	std::thread			m_thrSpill;									// Spill thread
+	HANDLE				m_hWakeEvent;								// Wake-up event
+	std::atomic<bool>	m_bStopRequest;								// Stop request flag
+
+	// Spill file
+	CFile				m_fSpillFile;								// Opening spill file (spill thread only)
+	LogStoreBlock		m_storeBlock;								// Log store block of current segment (spill thread only)
+	mutable LogStoreReader m_spillReader;							// Spill file reader
+	mutable std::mutex	m_mtxReader;								// Spill file reader lock
+
+public:
+	// Construction
+	explicit LogSpill(byte byLogType);
+	~LogSpill();
+
+	// No copyable
+	LogSpill(const LogSpill&) = delete;
+	LogSpill& operator=(const LogSpill&) = delete;
+
+public:
+	// Spill thread control
+	bool Start(void);
+	void Stop(void);
+	bool IsRunning(void) const noexcept {
+		return m_thrSpill.joinable();
+	};
+
+	// Remove all spilled data and the spill file
+	void Reset(void);
+
+	// Hand a segment over to the spill thread (segment data is moved)
+	void AddSegment(SEGMENT&& segment);
+
+	// Read a spilled item (index is counted from the first spilled item)
+	bool ReadItem(size_t nIndex, LOGITEM& logItem) const;
+
+	// Get spilled data info
+	size_t GetSpilledCount(void) const;
+	size_t GetWrittenCount(void) const noexcept {
+		return m_nWrittenCount.load();
+	};
+
+	// Get and reset last write error code (errors are reported by the caller thread)
+	DWORD TakeLastError(void) noexcept {
+		return m_dwLastError.exchange(APP_ERROR_SUCCESS);
+	};
+
+private:
+	// Spill thread functions
+	void Run(void);
+	void WritePendingSegments(void);
+	bool WriteSegment(const SEGMENT& segment);
+};
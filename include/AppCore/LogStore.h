@@ -0,0 +1,184 @@
+﻿/**
+ * @file		LogStore.h
+ * @brief		Binary columnar log store and its memory-mapped reader
+ * @author		AnthonyLeeStark
+ * @date		2026.10.17
+ *
+ * @copyright 	Copyright (c) 2015-2025 AnthonyLeeStark
+ */
+
+#pragma once
+
+#include "Logging.h"
+
+#include <unordered_map>
+
+
+// Binary log store file layout
+// A store file is a sequence of blocks, each block holds a batch of log items in fixed-width columns:
+//	[Header][Time][PID][Category][Description][DetailEnd][DetailCategory][DetailFlag][DetailValue][DetailString][String pool]
+// Blocks are only appended, so the writer never rewrites previous data,
+// and every column starts at an 8-byte boundary so that it can be read in place from a mapped view
+namespace LogStore
+{
+	// Define constant values
+	static constexpr DWORD	blockMagic = 0x424C5050;				// Block signature ("PPLB")
+	static constexpr WORD	formatVersion = 1;						// Store format version
+	static constexpr DWORD	nullString = 0xFFFFFFFF;				// No string (string pool offset)
+	static constexpr size_t	columnAlignment = 8;					// Column alignment (in bytes)
+	static constexpr size_t	maxBlockItemCount = 4096;				// Max number of items per block (converter)
+
+	// Block header
+	struct BLOCKHEADER {
+		DWORD	dwMagic;											// Block signature
+		WORD	wVersion;											// Store format version
+		WORD	wHeaderSize;										// Header size (in bytes)
+		DWORD	dwBlockSize;										// Total block size, including header (in bytes)
+		DWORD	dwItemCount;										// Number of log items
+		DWORD	dwDetailCount;										// Number of detail items (all log items)
+		DWORD	dwStringPoolSize;									// String pool size (in characters)
+	};
+
+	// Column offsets inside a block (in bytes, from block start)
+	struct COLUMNLAYOUT {
+		size_t	nTime;												// Log time (INT64, milliseconds since epoch)
+		size_t	nProcessID;											// Process ID (DWORD)
+		size_t	nCategory;											// Log category (USHORT)
+		size_t	nDescription;										// Description (DWORD, string pool offset)
+		size_t	nDetailEnd;											// End of detail range of each item (DWORD)
+		size_t	nDetailCategory;									// Detail category (USHORT)
+		size_t	nDetailFlag;										// Detail flag (USHORT)
+		size_t	nDetailValue;										// Detail value (INT)
+		size_t	nDetailString;										// Detail string (DWORD, string pool offset)
+		size_t	nStringPool;										// String pool (wchar_t)
+		size_t	nBlockSize;											// Total block size
+	};
+
+	// Calculate column layout of a block
+	void GetColumnLayout(size_t nItemCount, size_t nDetailCount, size_t nStringPoolSize, COLUMNLAYOUT& layout) noexcept;
+};
+
+
+// Build a log store block from log items
+class LogStoreBlock
+{
+private:
+	// Columns
+	std::vector<INT64>		m_arrTime;								// Log time
+	std::vector<DWORD>		m_arrProcessID;							// Process ID
+	std::vector<USHORT>		m_arrCategory;							// Log category
+	std::vector<DWORD>		m_arrDescription;						// Description string
+	std::vector<DWORD>		m_arrDetailEnd;							// End of detail range
+	std::vector<USHORT>		m_arrDetailCategory;					// Detail category
+	std::vector<USHORT>		m_arrDetailFlag;						// Detail flag
+	std::vector<INT>		m_arrDetailValue;						// Detail value
+	std::vector<DWORD>		m_arrDetailString;						// Detail string
+
+	// String pool (each string is stored once per block)
+	std::vector<wchar_t>	m_arrStringPool;						// String pool
+	std::unordered_map<std::wstring, DWORD> m_mapStringOffset;		// String pool offsets
+
+	// Output buffer
+	std::vector<BYTE>		m_arrOutputBuff;						// Serialized block data
+
+public:
+	// Member functions
+	void Clear(void) noexcept;
+	bool IsEmpty(void) const noexcept {
+		return m_arrTime.empty();
+	};
+	size_t GetItemCount(void) const noexcept {
+		return m_arrTime.size();
+	};
+
+	// Add a log item (read-only details are not stored, same as YAML log files)
+	void AddItem(const LOGITEM& logItem);
+
+	// Write the block at the end of a file
+	bool Write(CFile& storeFile);
+
+private:
+	DWORD AddString(const wchar_t* stringValue);
+};
+
+
+// Read log store files through memory-mapped views, without parsing or copying data
+class LogStoreReader
+{
+private:
+	// Mapped file
+	struct MAPPEDFILE {
+		HANDLE		hFile;											// File handle
+		HANDLE		hMapping;										// File mapping handle
+		const BYTE*	pView;											// Mapped view
+	};
+
+	// Block view (column pointers inside mapped view)
+	struct BLOCKVIEW {
+		size_t			nFirstItem;									// Index of the first item (in whole store)
+		size_t			nItemCount;									// Number of items
+		size_t			nDetailCount;								// Number of detail items
+		size_t			nStringPoolSize;							// String pool size
+		const INT64*	pTime;										// Log time column
+		const DWORD*	pProcessID;									// Process ID column
+		const USHORT*	pCategory;									// Log category column
+		const DWORD*	pDescription;								// Description column
+		const DWORD*	pDetailEnd;									// End of detail range column
+		const USHORT*	pDetailCategory;							// Detail category column
+		const USHORT*	pDetailFlag;								// Detail flag column
+		const INT*		pDetailValue;								// Detail value column
+		const DWORD*	pDetailString;								// Detail string column
+		const wchar_t*	pStringPool;								// String pool
+	};
+
+private:
+	std::vector<MAPPEDFILE>	m_arrFiles;								// Mapped files
+	std::vector<BLOCKVIEW>	m_arrBlocks;							// Block views (in file order)
+	size_t					m_nItemCount;							// Total number of items
+
+public:
+	// Construction
+	LogStoreReader();
+	~LogStoreReader();
+
+	// No copyable
+	LogStoreReader(const LogStoreReader&) = delete;
+	LogStoreReader& operator=(const LogStoreReader&) = delete;
+
+public:
+	// Open a store file and append its items (files should be opened in chronological order)
+	bool Open(const wchar_t* filePath);
+	void Close(void) noexcept;
+	bool IsOpen(void) const noexcept {
+		return !m_arrFiles.empty();
+	};
+
+	// Get item data
+	size_t GetItemCount(void) const noexcept {
+		return m_nItemCount;
+	};
+	DateTime GetTime(size_t nIndex) const;
+	DWORD GetProcessID(size_t nIndex) const;
+	USHORT GetCategory(size_t nIndex) const;
+	const wchar_t* GetDescription(size_t nIndex) const;
+	size_t GetDetailCount(size_t nIndex) const;
+
+	// Read whole log item data
+	bool ReadLogItem(size_t nIndex, LOGITEM& logItem) const;
+
+private:
+	const BLOCKVIEW* FindBlock(size_t nIndex, size_t& nLocalIndex) const;
+	static const wchar_t* GetPoolString(const BLOCKVIEW& blockView, DWORD dwOffset);
+};
+
+
+// Log store utility functions
+class LogStoreUtils
+{
+public:
+	// Get store file path of a YAML log file (same name, store file extension)
+	static String GetStoreFilePath(const wchar_t* logFilePath);
+
+	// Convert a YAML log file into a store file
+	static bool ConvertYAMLFile(const wchar_t* yamlFilePath, const wchar_t* storeFilePath, byte byLogType, size_t* pnItemCount = NULL);
+};
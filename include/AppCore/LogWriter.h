@@ -0,0 +1,138 @@
+﻿/**
+ * @file		LogWriter.h
+ * @brief		Background log writer with a bounded lock-free queue
+ * @author		AnthonyLeeStark
+ * @date		2026.10.17
+ *
+ * @copyright 	Copyright (c) 2015-2025 AnthonyLeeStark
+ */
+
+#pragma once
+
+#include "Logging.h"
+#include "LogStore.h"
+#include "LogJournal.h"
+
+#include <atomic>
+#include <thread>
+
+
+// Write log items into log files on a background thread
+// Producers (any thread) push items into a bounded lock-free MPSC queue and never touch the disk,
+// the writer thread formats items in batches and keeps the log file open between batches.
+// Each batch is also appended to a binary log store file next to the YAML log file.
+// Queued items are recorded in a journal file until they are written, and items left in the journal
+// by a previous session (crash or forced shutdown) are written first when the writer is started.
+// Items which fail to be written are kept and retried on the next pass before any newer item,
+// so that items are always written in queue order
+class LogWriter
+{
+public:
+	// Queue slot
+	struct Slot {
+		std::atomic<size_t>	nSequence;								// Slot sequence number
+		LOGITEM				logItem;								// Log item data
+	};
+
+public:
+	// Define constant values
+	static constexpr size_t defaultCapacity = 1024;					// Queue capacity (must be power of 2)
+	static constexpr size_t defaultBatchSize = 64;					// Wake the writer up when this many items are pending
+	static constexpr DWORD	defaultFlushInterval = 2000;			// Write pending items at least every 2 seconds
+
+private:
+	// Properties
+	byte		m_byLogType;										// Log type
+	String		m_strFolderPath;									// Log folder path
+	std::atomic<DWORD> m_dwLastError;								// Last write error code
+
+	// Bounded MPSC queue
+	std::unique_ptr<Slot[]>	m_arrSlots;								// Queue slots
+	size_t					m_nCapacity;							// Queue capacity
+	std::atomic<size_t>		m_nEnqueuePos;							// Producer position
+	std::atomic<size_t>		m_nDequeuePos;							// Consumer position (written by writer thread only)
+
+	// Writer thread
+	std::thread			m_thrWriter;								// Writer thread
+	HANDLE				m_hWakeEvent;								// Wake-up event
+	HANDLE				m_hFlushedEvent;							// Flush completed event
+	std::atomic<bool>	m_bStopRequest;								// Stop request flag
+	std::atomic<size_t>	m_nFlushRequest;							// Flush request counter
+	size_t				m_nFlushDone;								// Flush completed counter (writer thread only)
+
+	// Output file (writer thread only)
+	CFile				m_fLogFile;									// Opening log file
+	String				m_strCurFilePath;							// Opening log file path
+	CFile				m_fStoreFile;								// Opening log store file
+	String				m_strCurStorePath;							// Opening log store file path
+	LogStoreBlock		m_storeBlock;								// Log store block of current batch
+
+	// Items taken out of the queue but not written yet (writer thread only)
+	LOGDATA				m_arrPendingItems;							// Pending items (in queue order)
+	std::vector<WORD>	m_arrPendingWritten;						// Output files which already have each pending item
+	size_t				m_nPendingPos;								// Queue position of the first pending item
+
+	// Journal
+	LogJournal			m_journal;									// Journal of queued items
+	size_t				m_nCheckpointPos;							// Queue position of last checkpoint (writer thread only)
+	std::atomic<bool>	m_bWriteFailed;								// Last pass failed to write some items (they are retried)
+
+public:
+	// Construction
+	explicit LogWriter(byte byLogType, size_t nCapacity = defaultCapacity);
+	~LogWriter();
+
+	// No copyable
+	LogWriter(const LogWriter&) = delete;
+	LogWriter& operator=(const LogWriter&) = delete;
+
+public:
+	// Writer thread control
+	bool Start(void);
+	void Stop(void);
+	bool IsRunning(void) const noexcept {
+		return m_thrWriter.joinable();
+	};
+
+	// Push a log item into the queue (lock-free, return false if queue is full)
+	bool Enqueue(const LOGITEM& logItem);
+	bool Enqueue(LOGITEM&& logItem);
+
+	// Wait until all items queued so far are written (return false if some items failed to be written)
+	bool Flush(DWORD dwTimeout = INFINITE);
+
+	// Get number of pending items
+	size_t GetPendingCount(void) const noexcept {
+		return (m_nEnqueuePos.load(std::memory_order_relaxed) - m_nDequeuePos.load(std::memory_order_relaxed));
+	};
+
+	// Get and reset last write error code (errors are reported by the caller thread)
+	DWORD TakeLastError(void) noexcept {
+		return m_dwLastError.exchange(APP_ERROR_SUCCESS);
+	};
+
+public:
+	// Get output log file path of a log item
+	static bool GetLogFilePath(byte byLogType, const DateTime& logTime, const wchar_t* folderPath, String& filePath);
+
+private:
+	// Queue functions
+	Slot* ClaimSlot(size_t& nPos);
+	void PublishSlot(Slot* pSlot, size_t nPos);
+	void ResetQueue(size_t nStartPos);
+
+	// Journal functions
+	bool ReplayJournal(const String& journalFilePath);
+	void RecordPendingItems(void);
+
+	// Writer thread functions
+	void Run(void);
+	bool Dequeue(LOGITEM& logItem);
+	bool WriteBatch(void);
+	bool WritePendingItems(void);
+	WORD WriteBatchFiles(const String& filePath, String& logString, WORD wWrittenFiles);
+	bool WriteToFile(const String& filePath, const String& logString);
+	bool WriteToStore(const String& filePath);
+	void CloseLogFile(void);
+	void CloseOutputFile(CFile& outputFile, String& filePath);
+};
@@ -12,41 +12,50 @@
 #include "AppCore.h"
 #include "MapTable.h"
 #include "Logging_defs.h"
+#include "LogArena.h"
+#include "TraceLog.h"
 
 
 // Store log detail info item
+// Detail string and pointer data are not owned by the item: they are stored
+// in the arena of the log detail info which the item belongs to.
+// Lifetime: an item is only valid as long as that detail info (or a copy of it, which shares its arena) is alive.
+// Items can't be copied on their own, refer to them inside their detail info, or add them
+// into another detail info with LogDetailInfo::AddDetail (data is copied into its arena)
 class LogDetail
 {
+	friend class LogDetailInfo;
+
 private:
 	// Attributes
 	USHORT	m_usCategory;									// Detail category
+	byte	m_byPointerType;								// Detail info pointer data type
 	int		m_nFlag;										// Detail flag
 
 	// Data
 	int		m_nDetailValue;									// Detail value (integer)
-	String	m_strDetailInfo;								// Detail info (string)
-	PVOID	m_ptrDetailData;								// Detail data (pointer)
-	byte	m_byPointerType;								// Detail info pointer data type
-	size_t	m_szPointerSize;								// Detail info pointer data size
+	DWORD	m_dwPointerSize;								// Detail info pointer data size
+	const wchar_t* m_pszDetailInfo;							// Detail info (string)
+	const void* m_ptrDetailData;							// Detail data (pointer)
 
 public:
 	// Construction
 	LogDetail();
-	LogDetail(const LogDetail& other) {
-		this->Copy(other);
-	};
+	LogDetail(LogDetail&&) noexcept = default;
+	LogDetail& operator=(LogDetail&&) noexcept = default;
 
-	// Copy assignment operator
-	LogDetail& operator=(const LogDetail& other) {
-		this->Copy(other);
-		return *this;
-	};
+	// No copyable (a copy would refer to data of another detail info)
+	LogDetail(const LogDetail&) = delete;
+	LogDetail& operator=(const LogDetail&) = delete;
+
+private:
+	// Copy data references (only for items of detail info sharing the same arena)
+	void Copy(const LogDetail& other) noexcept;
+	void PointerCopy(const LogDetail& other) noexcept;
 
 public:
 	// Member functions
 	void Init(void) noexcept;
-	void Copy(const LogDetail& other) noexcept;
-	void PointerCopy(const LogDetail& other);
 	bool Compare(const LogDetail& other) const;
 	bool PointerCompare(const LogDetail& other) const;
 	bool IsEmpty(void) const noexcept;
@@ -71,16 +80,16 @@ public:
 	void SetDetailValue(int nDetailValue) noexcept {
 		m_nDetailValue = nDetailValue;
 	};
-	String GetDetailString(void) const noexcept {
-		return m_strDetailInfo;
+	const wchar_t* GetDetailString(void) const noexcept {
+		return m_pszDetailInfo;
 	};
 	void SetDetailString(const wchar_t* detailInfo) noexcept {
-		m_strDetailInfo = detailInfo;
+		m_pszDetailInfo = (detailInfo != NULL) ? detailInfo : Constant::String::Empty;
 	};
-	PVOID GetPointerData(void) const noexcept {
+	const void* GetPointerData(void) const noexcept {
 		return m_ptrDetailData;
 	};
-	bool SetPointerData(PVOID pDataBuff, byte byDataType = -1, size_t szDataSize = 0);
+	bool SetPointerData(LogArena& arena, const void* pDataBuff, byte byDataType = -1, size_t szDataSize = 0);
 	constexpr byte GetPointerType(void) const noexcept {
 		return m_byPointerType;
 	};
@@ -88,30 +97,31 @@ public:
 		m_byPointerType = byPointerType;
 	};
 	constexpr size_t GetPointerSize(void) const noexcept {
-		return m_szPointerSize;
+		return m_dwPointerSize;
 	};
 	void SetPointerSize(size_t szPointerSize) noexcept {
-		m_szPointerSize = szPointerSize;
+		m_dwPointerSize = static_cast<DWORD>(szPointerSize);
 	};
 };
 
 // Define new typenames for LogData
 using LOGDETAIL = LogDetail;
 using PLOGDETAIL = LogDetail*;
-using LOGDETAILARRAY = typename std::vector<LogDetail>;
+using LOGDETAILARRAY = typename std::vector<LogDetail, LogArenaAllocator<LogDetail>>;
 
 
 // Store application log detail info
+// Detail items and their strings are allocated from the current batch arena;
+// copies share the arena (detail data is never changed once added), moves take it over
 class LogDetailInfo : public LOGDETAILARRAY
 {
 public:
 	// Construction
-	LogDetailInfo() : LOGDETAILARRAY() {
-		this->clear();
-	};
-	LogDetailInfo(const LogDetailInfo& other) {
+	LogDetailInfo() : LOGDETAILARRAY(LogArenaAllocator<LogDetail>(LogArena::GetCurrentBatch())) {};
+	LogDetailInfo(const LogDetailInfo& other) : LOGDETAILARRAY(other.get_allocator()) {
 		this->CopyData(other);
 	};
+	LogDetailInfo(LogDetailInfo&& other) noexcept : LOGDETAILARRAY(std::move(other)) {};
 
 	// Copy assignment operator
 	LogDetailInfo& operator=(const LogDetailInfo& other) {
@@ -119,21 +129,27 @@ public:
 		return *this;
 	};
 
+	// Move assignment operator
+	LogDetailInfo& operator=(LogDetailInfo&& other) noexcept {
+		LOGDETAILARRAY::operator=(std::move(other));
+		return *this;
+	};
+
 public:
 	// Member functions
 	void Init(void) noexcept {
 		this->clear();
 	};
-	void CopyData(const LogDetailInfo& other) {
-		this->Init();
-		this->assign(other.begin(), other.end());
+	void CopyData(const LogDetailInfo& other);
+
+	// Get arena
+	LogArena& GetArena(void) const noexcept {
+		return *(this->get_allocator().GetArena());
 	};
 
 public:
 	// Update data functions
-	void AddDetail(const LOGDETAIL& logDetail) {
-		this->push_back(logDetail);
-	};
+	void AddDetail(const LOGDETAIL& logDetail);
 
 	// Add detail item
 	void AddDetail(USHORT usCategory, int nDetailInfo, int nFlag = 0);								// Add detail item (integer data only)
@@ -163,6 +179,7 @@ public:
 	LogItem(const LogItem& other) {
 		this->Copy(other);
 	};
+	LogItem(LogItem&& other) noexcept;
 
 	// Copy assignment operator
 	LogItem& operator=(const LogItem& other) {
@@ -170,6 +187,9 @@ public:
 		return *this;
 	};
 
+	// Move assignment operator
+	LogItem& operator=(LogItem&& other) noexcept;
+
 public:
 	// Member functions
 	void Copy(const LogItem& other) noexcept;
@@ -198,6 +218,9 @@ public:
 	void SetProcessID(void) noexcept {
 		m_dwProcessID = GetCurrentProcessId();
 	};
+	void SetProcessID(DWORD dwProcessID) noexcept {
+		m_dwProcessID = dwProcessID;
+	};
 	constexpr USHORT GetCategory(void) const noexcept {
 		return m_usCategory;
 	};
@@ -212,6 +235,12 @@ public:
 	};
 
 	// Detail info functions
+	const LOGDETAILINFO& GetDetailInfo(void) const noexcept {
+		return m_arrDetailInfo;
+	};
+	void SetDetailInfo(LOGDETAILINFO&& logDetailInfo) noexcept {
+		m_arrDetailInfo = std::move(logDetailInfo);
+	};
 	void AddDetail(const LOGDETAIL& logDetail) {
 		m_arrDetailInfo.AddDetail(logDetail);
 	};
@@ -227,7 +256,10 @@ public:
 
 	// Format data functions
 	String FormatDateTime(void) const;
+	static String FormatDateTime(const DateTime& stTime);
 	String FormatOutput(void) const;
+	void   FormatOutput(String& outputBuffer) const;
+	String FormatOutputJSON(void) const;
 };
 
 // Define new typenames for LogItem
@@ -346,6 +378,16 @@ using JSONDATA = JSON;
 using PJSONDATA = JSONDATA*;
 
 
+// Background log writer
+class LogWriter;
+
+// Log data index
+class LogIndex;
+
+// Log spill file (LogSpill.h)
+class LogSpill;
+
+
 // Using for saving application log data
 class SLogging
 {
@@ -360,6 +402,23 @@ private:
 	String   m_strFilePath;					// Log output file path
 	PLOGITEM m_pItemDefTemplate;			// Log default template
 
+	// Background writer
+	LogWriter* m_pLogWriter;				// Background log writer
+	size_t	   m_nWrittenCount;				// Number of log data items already handed to writer
+
+	// Search index
+	LogIndex*  m_pLogIndex;					// Log data index (built in background)
+
+	// Ring buffer mode (older items are spilled to disk)
+	size_t	   m_nRingCapacity;				// Ring buffer capacity (0: ring buffer mode is disabled)
+	size_t	   m_nSegmentSize;				// Number of items spilled at once
+	size_t	   m_nRingHead;					// Ring buffer position of the oldest in-memory item
+	size_t	   m_nMemoryCount;				// Number of in-memory items
+	size_t	   m_nSpilledCount;				// Number of spilled items (index of the oldest in-memory item)
+	LogSpill*  m_pLogSpill;					// Spill file of older items
+	mutable LOGITEM m_spillCacheItem;		// Last item read back from spill file
+	mutable size_t	m_nSpillCacheIndex;		// Index of last item read back from spill file
+
 public:
 	// Construction
 	SLogging(byte byLogType);
@@ -367,20 +426,18 @@ public:
 
 public:
 	// Initialization
-	virtual void Init(void) noexcept {
-		m_arrLogData.clear();
-	};
-	virtual void DeleteAll(void) noexcept {
-		m_arrLogData.clear();
-	};
+	virtual void Init(void) noexcept;
+	virtual void DeleteAll(void) noexcept;
 
 	// Get/set data
 	virtual constexpr bool IsEmpty(void) const noexcept {
-		return m_arrLogData.empty();
+		return (GetLogCount() == 0);
 	};
 	virtual constexpr size_t GetLogCount(void) const noexcept {
-		return m_arrLogData.size();
+		return (m_nSpilledCount + m_nMemoryCount);
 	};
+	// Items spilled to disk are read back into one cache item, so they can only be read (const version),
+	// and the returned reference is only valid until the next GetLogItem call
 	virtual LOGITEM& GetLogItem(int nIndex);
 	virtual const LOGITEM& GetLogItem(int nIndex) const;
 
@@ -390,7 +447,7 @@ public:
 	};
 	virtual bool SetMaxSize(size_t nMaxSize) noexcept {
 		// Max size can only be larger than current log data size
-		if (nMaxSize > (this->m_arrLogData.size())) {
+		if (nMaxSize > GetLogCount()) {
 			m_nMaxSize = nMaxSize;
 			return true;
 		}
@@ -413,14 +470,47 @@ public:
 	};
 	virtual void SetDefaultTemplate(const LOGITEM& logItemTemplate) noexcept;
 
+	// Ring buffer mode functions
+	// Keep only the latest items in memory, older items are spilled to disk in segments
+	// and read back by GetLogItem (data of items read back can not be changed)
+	bool EnableRingBuffer(size_t nCapacity, size_t nSegmentSize);
+	bool IsRingBufferEnabled(void) const noexcept {
+		return (m_nRingCapacity > 0);
+	};
+	size_t GetMemoryCount(void) const noexcept {
+		return m_nMemoryCount;
+	};
+
 	// Output log functions
 	void OutputItem(const LOGITEM& logItem);
+	void OutputItem(LOGITEM&& logItem);
 	void OutputString(const wchar_t* logString, bool bUseLastTemplate = true);
 
 	// Write log functions
 	bool Write(void);
 	bool Write(const LOGITEM& logItem, const wchar_t* filePath = NULL);
 	bool Write(const wchar_t* logString, const wchar_t* filePath = NULL);
+
+	// Background writer functions
+	bool StartWriter(void);
+	void StopWriter(void);
+	bool IsWriterRunning(void) const noexcept;
+
+	// Search index functions
+	bool StartIndexing(void);
+	void StopIndexing(void);
+	const LogIndex* GetLogIndex(void) const noexcept {
+		return m_pLogIndex;
+	};
+
+private:
+	void HandOffPendingItems(void);
+	bool EnqueueInstantItem(LOGITEM& logItem);
+	void SpillOldestSegment(void);
+	LOGITEM& ReadSpilledItem(size_t nIndex) const;
+	size_t GetRingPosition(size_t nIndex) const noexcept {
+		return ((m_nRingHead + nIndex) % m_arrLogData.size());
+	};
 };
 
 
@@ -438,6 +528,32 @@ private:
 	CFileException* m_pExcLogTraceDebug;
 	CFileException* m_pExcLogDebugInfo;
 
+	// Log file write buffer
+	struct LOGFILEBUFFER {
+		String		strBuffer;								// Log strings which are not written yet
+		ULONGLONG	ullFileSize = 0;						// File size (including buffered strings)
+		ULONGLONG	ullLastFlushTime = 0;					// Last time the buffer was written (tick count)
+	};
+
+	// Log file write buffers
+	LOGFILEBUFFER m_bufLogTraceError;
+	LOGFILEBUFFER m_bufLogTraceDebug;
+	LOGFILEBUFFER m_bufLogDebugInfo;
+
+	// Cached format templates
+	String m_strDateTimeFormat;
+	String m_strLogStringFormat;
+
+	// Trace records waiting for writing (formatted when written)
+	std::vector<std::unique_ptr<TraceLog::Record>> m_arrTraceRecords;
+
+	// Window to notify when log strings are buffered (to arm its flush timer)
+	HWND m_hFlushNotifyWnd;
+	bool m_bFlushRequested;
+
+	// Log file access lock
+	std::recursive_mutex m_mtxLogFile;
+
 private:
 	// Singleton
 	DebugLogging();
@@ -473,6 +589,10 @@ public:
 	void ReleaseTraceDebugLogFile(void);
 	void ReleaseDebugInfoLogFile(void);
 
+	// Write all buffered log strings to files
+	void FlushLogFiles(void);
+	void SetFlushNotifyWnd(HWND hWnd);
+
 	// Access pointer
 	CFile* GetTraceErrorLogFile(void) {
 		return m_pFileLogTraceError;
@@ -501,6 +621,10 @@ public:
 	void TraceErrorFormat(const wchar_t* traceLogFormatW, ...);
 	void TraceDebugInfo(const char* funcName, const char* fileName, int lineIndex);
 
+	// Leveled trace functions
+	void AddTraceRecord(std::unique_ptr<TraceLog::Record>&& pRecord);
+	void WriteTraceRecords(void);
+
 	// Debug logging functions
 	static void OutputDebugLog(const wchar_t* debugLog, int forceStyle = -1);
 	static void OutputDebugLogFormat(const wchar_t* debugLogFormat, va_list args);
@@ -508,10 +632,17 @@ public:
 
 	// Trace/debug file logging functions
 	bool BackupOldLogFile(const String& filePath, const wchar_t* logFileName);
-	void WriteTraceErrorLogFile(const wchar_t* logStringW);
-	void WriteTraceDebugLogFile(const wchar_t* logStringW);
-	void WriteDebugInfoLogFile(const wchar_t* logStringW);
+	void WriteTraceErrorLogFile(const wchar_t* logStringW, const DateTime* pLogTime = NULL);
+	void WriteTraceDebugLogFile(const wchar_t* logStringW, const DateTime* pLogTime = NULL);
+	void WriteDebugInfoLogFile(const wchar_t* logStringW, const DateTime* pLogTime = NULL);
 	void WriteTraceNDebugLogFileBase(const wchar_t* fileName, const wchar_t* logStringW);
+
+private:
+	void FormatLogString(const wchar_t* logStringW, String& outputString, const DateTime* pLogTime = NULL);
+	bool WriteLogFileBuffer(CFile* pLogFile, LOGFILEBUFFER& fileBuffer, const String& logString);
+	void FlushLogFileBuffer(CFile* pLogFile, LOGFILEBUFFER& fileBuffer);
+	bool HasBufferedData(void) const;
+	void RequestFlush(void);
 };
 
 // Define wrapper for static debug logging functions for global usage
@@ -22,32 +22,140 @@ namespace MapTable
 		unsigned second;								// Second pair ID
 	};
 
+	// ID map table reference (sorted index columns)
+	struct IDMAPTABLE_REF
+	{
+		const IDPAIR*	pByFirst;						// Entries sorted by first ID
+		const IDPAIR*	pBySecond;						// Entries sorted by second ID
+		size_t			nSize;							// Number of entries
+	};
+
 	// ID map table
-	using IDMAPTABLE = const IDPAIR[];
-	using IDMAPTABLE_REF = const IDPAIR*;
+	// Entries are kept in declaration order, with index columns sorted at compile time
+	template <size_t nSize>
+	struct IDMAPTABLE
+	{
+		std::array<IDPAIR, nSize> arrEntries;			// Entries (declaration order)
+		std::array<IDPAIR, nSize> arrByFirst;			// Entries sorted by first ID
+		std::array<IDPAIR, nSize> arrBySecond;			// Entries sorted by second ID
+
+		constexpr size_t Size(void) const noexcept {
+			return nSize;
+		};
+		constexpr const IDPAIR& operator[](size_t nIndex) const {
+			return arrEntries[nIndex];
+		};
+		constexpr operator IDMAPTABLE_REF(void) const noexcept {
+			return { arrByFirst.data(), arrBySecond.data(), nSize };
+		};
+	};
 
 	// Initialize ID map table
 	#define INITIALIZE_IDMAPTABLE(tableName) \
-		static IDMAPTABLE tableName = {
+		static constexpr auto tableName = MapTable::MakeIDMapTable([]() { \
+			constexpr MapTable::IDPAIR arrEntries[] = {
 	#define END_IDMAPTABLE() \
-		,INFINITE,INFINITE};
+			}; return std::to_array(arrEntries); }());
+
+	// String key entry (case-folded key hash)
+	struct STRINGKEY
+	{
+		unsigned		nKeyHash;						// Case-folded string hash
+		size_t			nIndex;							// Entry index (declaration order)
+	};
+
+	// String map table reference (sorted index columns)
+	struct STRINGTABLE_REF
+	{
+		const LANGTEXT*		pEntries;					// Entries (declaration order)
+		const LANGTEXT*		pByID;						// Entries sorted by ID
+		const STRINGKEY*	pByKey;						// Case-folded keys sorted by hash
+		size_t				nSize;						// Number of entries
+	};
 
 	// String map table
-	using STRINGTABLE = const LANGTEXT[];
-	using STRINGTABLE_REF = const LANGTEXT*;
+	// Entries are kept in declaration order, with index columns sorted at compile time
+	template <size_t nSize>
+	struct STRINGTABLE
+	{
+		std::array<LANGTEXT, nSize>	 arrEntries;		// Entries (declaration order)
+		std::array<LANGTEXT, nSize>	 arrByID;			// Entries sorted by ID
+		std::array<STRINGKEY, nSize> arrByKey;			// Case-folded keys sorted by hash
+
+		constexpr size_t Size(void) const noexcept {
+			return nSize;
+		};
+		constexpr const LANGTEXT& operator[](size_t nIndex) const {
+			return arrEntries[nIndex];
+		};
+		constexpr operator STRINGTABLE_REF(void) const noexcept {
+			return { arrEntries.data(), arrByID.data(), arrByKey.data(), nSize };
+		};
+	};
 
 	// Initialize string map table
 	#define INITIALIZE_STRINGMAPTABLE(tableName) \
-		static STRINGTABLE tableName = {
+		static constexpr auto tableName = MapTable::MakeStringTable([]() { \
+			constexpr LANGTEXT arrEntries[] = {
 	#define END_STRINGMAPTABLE() \
-		,INFINITE, _T("")};
-
-	// Maximum table size
-	#define MAX_TABLESIZE	1000
+			}; return std::to_array(arrEntries); }());
 
 	// Get map table size
+	template <typename T, size_t nSize>
+	constexpr int GetTableSize(const T (&)[nSize]) noexcept {
+		return static_cast<int>(nSize - 1);				// Exclude the terminating entry
+	};
+	template <typename TABLE>
+	constexpr int GetTableSize(const TABLE& table) noexcept {
+		return static_cast<int>(table.Size());
+	};
 	#define TABLE_SIZE(tableName) \
-		(static_cast<int>(sizeof(tableName) / sizeof(tableName[0]) - 1))
+		(MapTable::GetTableSize(tableName))
+
+	// Case-folding (ASCII) and hashing for string keys
+	constexpr wchar_t FoldCase(wchar_t chValue) noexcept {
+		return ((chValue >= L'A') && (chValue <= L'Z')) ? static_cast<wchar_t>(chValue + (L'a' - L'A')) : chValue;
+	};
+	constexpr unsigned HashFoldedString(const wchar_t* lpszString) noexcept {
+		unsigned nHash = 2166136261u;					// FNV-1a offset basis
+		for (; (lpszString != NULL) && (*lpszString != L'\0'); lpszString++) {
+			nHash ^= static_cast<unsigned>(FoldCase(*lpszString));
+			nHash *= 16777619u;							// FNV-1a prime
+		}
+		return nHash;
+	};
+
+	// Stable insertion sort (usable in constant expressions)
+	template <typename T, size_t nSize, typename LESS>
+	constexpr void StableSort(std::array<T, nSize>& arrData, LESS isLess) {
+		for (size_t nIndex = 1; nIndex < nSize; nIndex++) {
+			T tempItem = arrData[nIndex];
+			size_t nPos = nIndex;
+			for (; (nPos > 0) && isLess(tempItem, arrData[nPos - 1]); nPos--) {
+				arrData[nPos] = arrData[nPos - 1];
+			}
+			arrData[nPos] = tempItem;
+		}
+	};
+
+	// Build sorted index columns for map tables
+	template <size_t nSize>
+	constexpr IDMAPTABLE<nSize> MakeIDMapTable(const std::array<IDPAIR, nSize>& arrEntries) {
+		IDMAPTABLE<nSize> idMapTable{ arrEntries, arrEntries, arrEntries };
+		StableSort(idMapTable.arrByFirst, [](const IDPAIR& left, const IDPAIR& right) { return (left.first < right.first); });
+		StableSort(idMapTable.arrBySecond, [](const IDPAIR& left, const IDPAIR& right) { return (left.second < right.second); });
+		return idMapTable;
+	};
+	template <size_t nSize>
+	constexpr STRINGTABLE<nSize> MakeStringTable(const std::array<LANGTEXT, nSize>& arrEntries) {
+		STRINGTABLE<nSize> stringTable{ arrEntries, arrEntries, {} };
+		for (size_t nIndex = 0; nIndex < nSize; nIndex++) {
+			stringTable.arrByKey[nIndex] = { HashFoldedString(arrEntries[nIndex].langString), nIndex };
+		}
+		StableSort(stringTable.arrByID, [](const LANGTEXT& left, const LANGTEXT& right) { return (left.id < right.id); });
+		StableSort(stringTable.arrByKey, [](const STRINGKEY& left, const STRINGKEY& right) { return (left.nKeyHash < right.nKeyHash); });
+		return stringTable;
+	};
 
 	// Initialize template table
 	#define INITIALIZE_TABLE(elementType, tableName) \
@@ -0,0 +1,135 @@
+﻿/**
+ * @file		ScheduleEngine.h
+ * @brief		Event-driven schedule engine which computes the next fire time of schedule items
+ * @author		AnthonyLeeStark
+ * @date		2026.10.17
+ *
+ * @copyright 	Copyright (c) 2015-2025 AnthonyLeeStark
+ */
+
+#pragma once
+
+// This engine is platform-neutral on purpose (standard library only),
+// so that it can be unit-tested and benchmarked with a fake clock
+#include <chrono>
+#include <vector>
+#include <functional>
+#include <algorithm>
+
+
+// Compute schedule item fire times and keep them in a min-heap,
+// so that the caller only needs to wake up at the earliest deadline
+class ScheduleEngine
+{
+public:
+	// Define engine typenames
+	using TimePoint = std::chrono::system_clock::time_point;
+	using Duration = std::chrono::system_clock::duration;
+	using ClockFunc = std::function<TimePoint(void)>;
+
+	enum EventType {
+		notifyEvent = 0,											// Notify before schedule time
+		actionEvent,												// Execute schedule action
+		snoozeEvent,												// Snoozed schedule action
+	};
+
+	// Schedule entry descriptor (decoupled from ScheduleItem)
+	struct Entry {
+		unsigned		nItemID;									// Schedule item ID
+		bool			bEnabled;									// Enable/disable state
+		bool			bRepeat;									// Repeat daily
+		unsigned char	byActiveDays;								// Days of week (bitmask, Sunday = bit 0)
+		int				nTimeOfDay;									// Schedule time (seconds since midnight)
+	};
+
+	// Schedule fire event
+	struct Event {
+		TimePoint		tpFireTime;									// Event fire time
+		TimePoint		tpOccurrence;								// Schedule occurrence that the event belongs to
+		unsigned		nItemID;									// Schedule item ID
+		EventType		eType;										// Event type
+	};
+
+	// Define new typenames for entry and event data
+	using EntryList = typename std::vector<Entry>;
+	using EventList = typename std::vector<Event>;
+
+public:
+	// Define constant values
+	static constexpr int defaultNotifyOffset = 30;					// Notify 30 seconds before schedule time
+	static constexpr int defaultLateTolerance = 10;					// Drop action events which are late more than 10 seconds
+
+private:
+	// Attributes
+	ClockFunc	m_fnClock;											// Clock source
+	EntryList	m_arrEntries;										// Schedule entries
+	EventList	m_arrEventHeap;										// Pending events (min-heap by fire time)
+	EventList	m_arrHandled;										// Handled occurrences (to avoid duplicated firing)
+	int			m_nNotifyOffset;									// Notify offset (in seconds)
+	int			m_nLateTolerance;									// Late tolerance (in seconds)
+
+public:
+	// Constructor
+	explicit ScheduleEngine(ClockFunc fnClock = &std::chrono::system_clock::now);
+
+public:
+	// Clock source
+	TimePoint Now(void) const {
+		return m_fnClock();
+	};
+	void SetClock(ClockFunc fnClock) {
+		m_fnClock = std::move(fnClock);
+	};
+
+	// Engine settings
+	void SetNotifyOffset(int nSeconds) noexcept {
+		m_nNotifyOffset = nSeconds;
+	};
+	constexpr int GetNotifyOffset(void) const noexcept {
+		return m_nNotifyOffset;
+	};
+	void SetLateTolerance(int nSeconds) noexcept {
+		m_nLateTolerance = nSeconds;
+	};
+
+	// Rebuild all events from schedule entries
+	void Rebuild(const EntryList& arrEntries);
+	void Clear(void) noexcept;
+
+	// Snooze an item (fire a snoozed action after the interval)
+	void Snooze(unsigned nItemID, int nInterval);
+	void CancelSnooze(unsigned nItemID);
+
+	// Get next deadline
+	constexpr bool IsEmpty(void) const noexcept {
+		return m_arrEventHeap.empty();
+	};
+	constexpr size_t GetPendingCount(void) const noexcept {
+		return m_arrEventHeap.size();
+	};
+	TimePoint GetNextDeadline(void) const noexcept {
+		return (IsEmpty()) ? TimePoint::max() : m_arrEventHeap.front().tpFireTime;
+	};
+	std::chrono::milliseconds GetTimeToNextDeadline(void) const;
+
+	// Pop all events which are due at current time, and re-schedule next occurrences
+	size_t CollectDueEvents(EventList& arrDueEvents);
+
+public:
+	// Calculate next fire time of an entry at or after given time point
+	static bool CalcNextFireTime(const Entry& schEntry, TimePoint tpFrom, TimePoint& tpNextFire);
+
+private:
+	// Heap processing
+	void PushEvent(const Event& schEvent);
+	Event PopEvent(void);
+	void ScheduleOccurrence(const Entry& schEntry, TimePoint tpFrom);
+	const Entry* FindEntry(unsigned nItemID) const noexcept;
+	bool IsHandled(const Event& schEvent) const noexcept;
+	void MarkHandled(const Event& schEvent);
+
+	// Heap order comparator (earliest fire time on top)
+	static bool CompareEvent(const Event& left, const Event& right) noexcept {
+		return (left.tpFireTime > right.tpFireTime);
+	};
+};
@@ -11,6 +11,9 @@
 
 #include "AppCore/AppCore.h"
 #include "AppCore/Serialization_defs.h"
+#include "AppCore/SettingsStore.h"
+
+#include <unordered_map>
 
 
 // Functions using for reading/writing registry values
@@ -29,6 +32,10 @@ namespace AppRegistry
 	// Delete registry section or subsection by name
 	bool DeleteRegistrySection(const wchar_t* sectionName, const wchar_t* subSectionName = NULL);
 
+	// Serve reads of the sections contained in a snapshot from that snapshot instead of registry
+	// (used when loading app data from snapshot file, set NULL to read from registry again)
+	void SetReadSnapshot(const SettingsStore::Snapshot* pSnapshot);
+
 
 	/*--------------- Functions for reading/writing application profile info ---------------*/
 
@@ -111,6 +118,70 @@ namespace AppRegistry
 	bool WriteGlobalData(const wchar_t* subSectionName, const wchar_t* keyName, int nValue);
 	bool GetGlobalData(const wchar_t* subSectionName, const wchar_t* keyName, String& strRef);
 	bool WriteGlobalData(const wchar_t* subSectionName, const wchar_t* keyName, const wchar_t* value);
+
+	// Read app data snapshot serial number
+	bool GetDataSnapshotSerial(const wchar_t* keyName, int& nRef);
+
+
+	/*------------- Functions for setting data values into a settings snapshot -------------*/
+
+
+	// Set config values
+	void SetConfig(SettingsStore::Snapshot& snapshot, const wchar_t* keyName, int nValue);
+
+	// Set default schedule, schedule extra item number and item values
+	void SetDefaultSchedule(SettingsStore::Snapshot& snapshot, const wchar_t* keyName, int nValue);
+	void SetScheduleExtraItemNum(SettingsStore::Snapshot& snapshot, const wchar_t* keyName, int nValue);
+	void SetScheduleExtra(SettingsStore::Snapshot& snapshot, int nItemIndex, const wchar_t* keyName, int nValue);
+
+	// Set hotkeyset item number and item values
+	void SetHotkeyItemNum(SettingsStore::Snapshot& snapshot, const wchar_t* keyName, int nValue);
+	void SetHotkeySet(SettingsStore::Snapshot& snapshot, int nItemIndex, const wchar_t* keyName, int nValue);
+
+	// Set Power Reminder common style, item number and item values
+	void SetPwrReminderCommonStyle(SettingsStore::Snapshot& snapshot, const wchar_t* keyName, int nValue);
+	void SetPwrReminderCommonStyle(SettingsStore::Snapshot& snapshot, const wchar_t* keyName, const wchar_t* value);
+	void SetPwrReminderItemNum(SettingsStore::Snapshot& snapshot, const wchar_t* keyName, int nValue);
+	void SetPwrReminder(SettingsStore::Snapshot& snapshot, int nItemIndex, const wchar_t* keyName, int nValue);
+	void SetPwrReminder(SettingsStore::Snapshot& snapshot, int nItemIndex, const wchar_t* keyName, const wchar_t* value);
+
+	// Set app data snapshot serial number
+	void SetDataSnapshotSerial(SettingsStore::Snapshot& snapshot, const wchar_t* keyName, int nValue);
+};
+
+
+// Registry settings backend (application registry key under HKEY_CURRENT_USER)
+// Changes are applied in a kernel transaction (KTM) when available, so a crash or power loss
+// in the middle of saving never leaves settings half-written. Section key handles are opened
+// once per transaction and cached until it is committed or rolled back.
+class RegistrySettingsBackend final : public SettingsStore::Backend
+{
+private:
+	HANDLE									m_hTransaction;			// Kernel transaction handle
+	bool									m_bInTransaction;		// Transaction state
+	std::unordered_map<std::wstring, HKEY>	m_mapKeyHandles;		// Cached section key handles
+
+public:
+	RegistrySettingsBackend();
+	~RegistrySettingsBackend();
+
+public:
+	bool ReadSection(const std::wstring& rootSection, SettingsStore::Snapshot& snapshot) override;
+	bool BeginTransaction(void) override;
+	bool CommitTransaction(void) override;
+	void RollbackTransaction(void) override;
+	bool WriteValue(const std::wstring& sectionPath, const std::wstring& keyName, const SettingsStore::Value& value) override;
+	bool DeleteValue(const std::wstring& sectionPath, const std::wstring& keyName) override;
+	bool DeleteSection(const std::wstring& sectionPath) override;
+
+private:
+	// Open (or create) section key inside the current transaction
+	HKEY OpenSectionKey(const std::wstring& sectionPath, bool bCreate);
+	void CloseSectionKeys(void);
+	void EndTransaction(void);
+
+	// Read values and subkeys of a key recursively
+	static bool ReadKey(HKEY hKey, const std::wstring& sectionPath, SettingsStore::Snapshot& snapshot);
 };
 
 
@@ -103,6 +103,7 @@ struct Section {
 	};
 
 	static constexpr const wchar_t* SystemEventTracking							= _T("SystemEventTracking");
+	static constexpr const wchar_t* AppDataSnapshot								= _T("AppDataSnapshot");
 };
 
 // Data keys
@@ -219,4 +220,8 @@ struct Key
 		static constexpr const wchar_t* LastSysWakeup							= _T("LastSysWakeup");
 		static constexpr const wchar_t* LastSessionEnd							= _T("LastSessionEnd");
 	};
+
+	struct AppDataSnapshot {
+		static constexpr const wchar_t* Serial									= _T("Serial");
+	};
 };
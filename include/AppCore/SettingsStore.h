@@ -0,0 +1,147 @@
+﻿/**
+ * @file		SettingsStore.h
+ * @brief		Transactional, diff-based settings persistence with pluggable storage backends
+ * @author		AnthonyLeeStark
+ * @date		2026.10.17
+ *
+ * @copyright 	Copyright (c) 2015-2025 AnthonyLeeStark
+ */
+
+#pragma once
+
+// This module only depends on the C++ standard library,
+// so the store and the memory/file backend can also be built and tested on other platforms
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <variant>
+#include <vector>
+
+
+// Persist settings data by diffing against the last persisted snapshot
+// Data is saved per root section (ConfigData, ScheduleData, ...): only changed keys are written,
+// keys and subsections which no longer exist are deleted, and all changes of one commit
+// are applied in a single backend transaction.
+class SettingsStore
+{
+public:
+	// Define settings typenames
+	using Value = std::variant<int, std::wstring>;					// Setting value (integer/string)
+	using KeyMap = std::map<std::wstring, Value>;					// Key name -> value
+	using Snapshot = std::map<std::wstring, KeyMap>;				// Section path (e.g: "ScheduleData\\ScheduleItem_00") -> keys
+
+	// Storage backend interface
+	// Section paths are relative to the application root key and use backslash as separator
+	class Backend
+	{
+	public:
+		virtual ~Backend() = default;
+
+	public:
+		// Read a root section (including all subsections) into snapshot
+		virtual bool ReadSection(const std::wstring& rootSection, Snapshot& snapshot) = 0;
+
+		// Transaction control
+		virtual bool BeginTransaction(void) = 0;
+		virtual bool CommitTransaction(void) = 0;
+		virtual void RollbackTransaction(void) = 0;
+
+		// Write/delete data (only called inside a transaction)
+		virtual bool WriteValue(const std::wstring& sectionPath, const std::wstring& keyName, const Value& value) = 0;
+		virtual bool DeleteValue(const std::wstring& sectionPath, const std::wstring& keyName) = 0;
+		virtual bool DeleteSection(const std::wstring& sectionPath) = 0;
+	};
+
+private:
+	// Store data
+	std::unique_ptr<Backend>		m_pBackend;						// Storage backend
+	std::map<std::wstring, Snapshot> m_mapPersisted;				// Last persisted snapshot of each root section
+	std::mutex						m_mtxStore;						// Store lock
+
+	// Statistics of last commit
+	size_t							m_nLastWriteCount;				// Number of written values
+	size_t							m_nLastDeleteCount;				// Number of deleted values/sections
+
+public:
+	explicit SettingsStore(std::unique_ptr<Backend>&& pBackend);
+	~SettingsStore() = default;
+
+	// No copyable
+	SettingsStore(const SettingsStore&) = delete;
+	SettingsStore& operator=(const SettingsStore&) = delete;
+
+public:
+	// Build snapshot data
+	static std::wstring MakeSectionPath(const wchar_t* sectionName, const wchar_t* subSectionName = nullptr);
+	static void SetValue(Snapshot& snapshot, const wchar_t* sectionName, const wchar_t* subSectionName, const wchar_t* keyName, int nValue);
+	static void SetValue(Snapshot& snapshot, const wchar_t* sectionName, const wchar_t* subSectionName, const wchar_t* keyName, const wchar_t* value);
+
+	// Persist the given root sections of snapshot (all-or-nothing)
+	bool Commit(const Snapshot& snapshot, const std::vector<std::wstring>& rootSections);
+
+	// Forget last persisted snapshot (it will be read again from backend on next commit)
+	void Invalidate(const wchar_t* rootSection = nullptr);
+
+	// Set/get last persisted snapshot of root sections
+	void SetPersistedData(const Snapshot& snapshot, const std::vector<std::wstring>& rootSections);
+	bool GetPersistedData(const std::vector<std::wstring>& rootSections, Snapshot& snapshot);
+
+	// Binary serialization of snapshot data
+	static void Serialize(const Snapshot& snapshot, std::vector<uint8_t>& buffer);
+	static bool Deserialize(const uint8_t* pData, size_t nSize, Snapshot& snapshot);
+	static uint32_t Checksum(const uint8_t* pData, size_t nSize) noexcept;
+
+	// Get statistics of last commit
+	size_t GetLastWriteCount(void) const noexcept {
+		return m_nLastWriteCount;
+	};
+	size_t GetLastDeleteCount(void) const noexcept {
+		return m_nLastDeleteCount;
+	};
+
+private:
+	// Diff and write a root section inside the current transaction
+	bool CommitSection(const Snapshot& persisted, const Snapshot& snapshot);
+
+	// Get all sections belonging to a root section
+	static void ExtractSection(const Snapshot& snapshot, const std::wstring& rootSection, Snapshot& result);
+};
+
+
+// In-memory settings backend, optionally backed by a file
+// The whole data set is kept in memory; a transaction works on a staged copy,
+// and committing replaces the file atomically (write temporary file, then rename)
+class MemorySettingsBackend final : public SettingsStore::Backend
+{
+private:
+	SettingsStore::Snapshot		m_mapData;							// Committed data
+	SettingsStore::Snapshot		m_mapStaged;						// Staged data (inside transaction)
+	bool						m_bInTransaction;					// Transaction state
+	std::filesystem::path		m_filePath;							// Backing file path (empty: memory only)
+
+public:
+	MemorySettingsBackend();
+	explicit MemorySettingsBackend(const std::filesystem::path& filePath);
+
+public:
+	bool ReadSection(const std::wstring& rootSection, SettingsStore::Snapshot& snapshot) override;
+	bool BeginTransaction(void) override;
+	bool CommitTransaction(void) override;
+	void RollbackTransaction(void) override;
+	bool WriteValue(const std::wstring& sectionPath, const std::wstring& keyName, const SettingsStore::Value& value) override;
+	bool DeleteValue(const std::wstring& sectionPath, const std::wstring& keyName) override;
+	bool DeleteSection(const std::wstring& sectionPath) override;
+
+	// Get committed data
+	const SettingsStore::Snapshot& GetData(void) const noexcept {
+		return m_mapData;
+	};
+
+private:
+	// Load/save backing file
+	bool LoadFile(void);
+	bool SaveFile(const SettingsStore::Snapshot& data) const;
+};
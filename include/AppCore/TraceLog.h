@@ -0,0 +1,154 @@
+﻿/**
+ * @file		TraceLog.h
+ * @brief		Leveled trace logging with compile-time/runtime filtering and deferred formatting
+ * @author		AnthonyLeeStark
+ * @date		2026.10.17
+ *
+ * @copyright 	Copyright (c) 2015-2025 AnthonyLeeStark
+ */
+
+#pragma once
+
+#include "AppCore.h"
+
+#include <atomic>
+#include <format>
+#include <memory>
+#include <source_location>
+#include <tuple>
+
+
+// Compile-time trace level threshold (trace calls below this level are removed from the build)
+#ifndef TRACE_LEVEL_COMPILED
+	#ifdef _DEBUG
+		#define TRACE_LEVEL_COMPILED		0						// Verbose
+	#else
+		#define TRACE_LEVEL_COMPILED		1						// Debug
+	#endif
+#endif
+
+
+// Leveled trace logging
+// Call sites only check the level, arguments are copied into a typed record
+// and formatted (std::format syntax) when trace records are written to files
+namespace TraceLog
+{
+	// Trace levels
+	enum Level : int {
+		Verbose = 0,												// Detailed execution trace
+		Debug,														// Debug trace info
+		Info,														// General information
+		Warning,													// Unexpected but handled situation
+		Error,														// Error
+		Off,														// Disable tracing (runtime threshold only)
+	};
+
+	// Compile-time level threshold
+	inline constexpr int compiledLevel = TRACE_LEVEL_COMPILED;
+
+	// Runtime level threshold
+	extern std::atomic<int> runtimeLevel;
+
+	// Get/set runtime level threshold
+	inline bool IsEnabled(int nLevel) noexcept {
+		return (nLevel >= runtimeLevel.load(std::memory_order_relaxed));
+	};
+	inline int GetLevel(void) noexcept {
+		return runtimeLevel.load(std::memory_order_relaxed);
+	};
+	inline void SetLevel(int nLevel) noexcept {
+		runtimeLevel.store(nLevel, std::memory_order_relaxed);
+	};
+
+	// Get level name
+	const wchar_t* GetLevelName(int nLevel) noexcept;
+
+	// Trace record (captured at call site, formatted when written)
+	class Record
+	{
+	private:
+		int						m_nLevel;							// Trace level
+		std::source_location	m_location;							// Source location
+		DateTime				m_logTime;							// Capture time
+
+	public:
+		Record(int nLevel, const std::source_location& location)
+			: m_nLevel(nLevel), m_location(location), m_logTime(DateTimeUtils::GetCurrentDateTime()) {};
+		virtual ~Record() = default;
+
+	public:
+		int GetLevel(void) const noexcept {
+			return m_nLevel;
+		};
+		const std::source_location& GetLocation(void) const noexcept {
+			return m_location;
+		};
+		const DateTime& GetTime(void) const noexcept {
+			return m_logTime;
+		};
+
+		// Format trace message
+		virtual void FormatText(std::wstring& outputString) const = 0;
+	};
+
+	// Argument capture: strings are copied (call site buffers may not live until formatting),
+	// other arguments are stored by value
+	inline std::wstring Capture(const wchar_t* stringValue) {
+		return (stringValue != NULL) ? std::wstring(stringValue) : std::wstring(Constant::String::Null);
+	};
+	inline std::wstring Capture(const char* stringValue) {
+		return (stringValue != NULL) ? std::wstring(MAKEUNICODE(stringValue)) : std::wstring(Constant::String::Null);
+	};
+	inline std::wstring Capture(const String& stringValue) {
+		return std::wstring(stringValue.GetString());
+	};
+	inline std::wstring Capture(const std::wstring& stringValue) {
+		return stringValue;
+	};
+	inline const void* Capture(const void* pointerValue) noexcept {
+		return pointerValue;
+	};
+	template <typename T> requires std::is_arithmetic_v<T>
+	inline T Capture(T numberValue) noexcept {
+		return numberValue;
+	};
+	template <typename T> requires std::is_enum_v<T>
+	inline std::underlying_type_t<T> Capture(T enumValue) noexcept {
+		return static_cast<std::underlying_type_t<T>>(enumValue);
+	};
+
+	// Stored type of a captured argument
+	template <typename T>
+	using Stored_t = decltype(Capture(std::declval<T>()));
+
+	// Trace record with typed argument pack
+	template <typename... Stored>
+	class TypedRecord final : public Record
+	{
+	private:
+		std::wstring_view		m_formatString;						// Format string (string literal)
+		std::tuple<Stored...>	m_arguments;						// Captured arguments
+
+	public:
+		template <typename... Args>
+		TypedRecord(int nLevel, const std::source_location& location, std::wstring_view formatString, Args&&... args)
+			: Record(nLevel, location), m_formatString(formatString), m_arguments(Capture(std::forward<Args>(args))...) {};
+
+	public:
+		void FormatText(std::wstring& outputString) const override {
+			std::apply([&](const Stored&... args) {
+				std::vformat_to(std::back_inserter(outputString), m_formatString, std::make_wformat_args(args...));
+			}, m_arguments);
+		};
+	};
+
+	// Hand a trace record over to the debug logger
+	void Submit(std::unique_ptr<Record>&& pRecord);
+
+	// Capture a trace call (format string is checked at compile time against captured argument types)
+	template <typename... Args>
+	void Write(int nLevel, const std::source_location& location, std::wformat_string<Stored_t<Args>...> formatString, Args&&... args)
+	{
+		Submit(std::make_unique<TypedRecord<Stored_t<Args>...>>(nLevel, location, formatString.get(), std::forward<Args>(args)...));
+	}
+};
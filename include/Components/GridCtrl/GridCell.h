@@ -21,6 +21,7 @@ class CGridCtrl;
 class CGridCell : public CGridCellBase
 {
     friend class CGridCtrl;
+    friend class CGridCellStore;
     DECLARE_DYNCREATE(CGridCell)
 
 // Construction/Destruction
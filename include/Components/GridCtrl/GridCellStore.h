@@ -0,0 +1,135 @@
+﻿/**
+ * @file		GridCellStore.h
+ * @brief		CGridCellStore class header file
+ * @author		AnthonyLeeStark
+ * @date		2026.10.17
+ *
+ * @copyright 	Copyright (c) 2015-2025 AnthonyLeeStark
+ */
+
+#if !defined(AFX_GRIDCELLSTORE_H__INCLUDED_)
+#define AFX_GRIDCELLSTORE_H__INCLUDED_
+
+#if _MSC_VER >= 1000
+#pragma once
+#endif // _MSC_VER >= 1000
+
+#include "GridCell.h"
+#include <memory>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+//////////////////////////////////////////////////////////////////////
+// Compact cell storage for CGridCtrl (see CGridCtrl::SetCompactMode)
+//
+// Instead of one heap-allocated CGridCell per cell, cell data is kept
+// column by column: each cell only holds a text ID in the column's
+// string pool and an ID of a style shared by all cells with the same
+// attributes (colours, format, state, font...). Concrete cell objects
+// are created by the grid only for cells which are being accessed.
+//////////////////////////////////////////////////////////////////////
+
+// Cell attributes which are shared between cells
+struct GRID_CELL_STYLE
+{
+    DWORD       nFormat;        // (DWORD)-1: default format
+    DWORD       nState;
+    COLORREF    crFgClr, crBkClr;
+    COLORREF    crHFgClr, crHBkClr;
+    int         nImage;
+    UINT        nMargin;        // (UINT)-1: default margin
+    int         nFont;          // Index in the font table, -1: default font
+
+    bool operator==(const GRID_CELL_STYLE& style) const
+        { return (memcmp(this, &style, sizeof(GRID_CELL_STYLE)) == 0); }
+};
+
+// Interned strings (a string never moves once it is added)
+class CGridStringPool
+{
+public:
+    CGridStringPool();
+
+    UINT    Add(LPCTSTR lpszText);              // Returns string ID (0 is the empty string)
+    LPCTSTR GetAt(UINT nID) const;
+    UINT    GetCount() const                    { return (UINT)m_arStrings.size(); }
+    void    RemoveAll();
+    size_t  GetMemoryUsage() const;
+
+protected:
+    enum { BLOCK_SIZE = 16384 };                // Characters per block
+
+    std::vector<std::unique_ptr<TCHAR[]>>   m_arBlocks;
+    TCHAR*                                  m_pszBlockFree; // First free character in last block
+    size_t                                  m_nBlockFree;   // Free characters in last block
+    size_t                                  m_nCharCount;   // Allocated characters
+    std::vector<LPCTSTR>                    m_arStrings;
+    std::unordered_map<std::basic_string_view<TCHAR>, UINT> m_mapStrings;
+};
+
+class CGridCellStore
+{
+public:
+    CGridCellStore();
+
+    // Dimensions (new cells are empty and use style 0, see GetDefaultStyle)
+    int  GetRowCount() const                    { return m_nRows; }
+    int  GetColumnCount() const                 { return (int)m_arColumns.size(); }
+    void SetRowCount(int nRows);
+    void SetColumnCount(int nCols);
+    void InsertRows(int nRow, int nCount = 1);
+    void RemoveRows(int nRow, int nCount = 1);
+    void InsertColumns(int nCol, int nCount = 1);
+    void RemoveColumns(int nCol, int nCount = 1);
+    void RemoveAll();
+
+    // Move rows [nFirstRow, nFirstRow + arOrder.size()): arOrder[i] is the row placed at nFirstRow + i
+    void PermuteRows(int nFirstRow, const std::vector<int>& arOrder);
+
+    // Cell data
+    LPCTSTR GetText(int nRow, int nCol) const;
+    void    SetText(int nRow, int nCol, LPCTSTR lpszText);
+    LPARAM  GetData(int nRow, int nCol) const;
+    void    SetData(int nRow, int nCol, LPARAM lParam);
+    UINT    GetStyleID(int nRow, int nCol) const;
+    void    SetStyleID(int nRow, int nCol, UINT nStyleID);
+    void    FillStyleID(int nCol, int nFirstRow, int nLastRow, UINT nStyleID);  // Rows [nFirstRow, nLastRow)
+
+    // Shared styles
+    static GRID_CELL_STYLE GetDefaultStyle();   // Attributes of a reset CGridCell
+    const GRID_CELL_STYLE& GetStyle(UINT nStyleID) const;
+    UINT AddStyle(const GRID_CELL_STYLE& style);
+    UINT AddCellStyle(const CGridCell* pCell);
+
+    // Copy cell data into/from a cell object
+    void LoadCell(int nRow, int nCol, CGridCell* pCell) const;
+    void StoreCell(int nRow, int nCol, const CGridCell* pCell);
+
+    size_t GetMemoryUsage() const;
+
+protected:
+    struct GRID_COLUMN
+    {
+        CGridStringPool     strings;        // Column text pool
+        std::vector<UINT>   arText;         // Text ID of each row
+        std::vector<UINT>   arStyle;        // Style ID of each row
+        std::vector<LPARAM> arData;         // Item data of each row (empty until a value is set)
+    };
+
+    struct STYLE_HASH
+    {
+        size_t operator()(const GRID_CELL_STYLE& style) const;
+    };
+
+    void CompactStrings(GRID_COLUMN& column);
+
+protected:
+    int                                 m_nRows;
+    std::vector<GRID_COLUMN>            m_arColumns;
+    std::vector<GRID_CELL_STYLE>        m_arStyles;
+    std::unordered_map<GRID_CELL_STYLE, UINT, STYLE_HASH> m_mapStyles;
+    std::vector<LOGFONT>                m_arFonts;
+};
+
+#endif // !defined(AFX_GRIDCELLSTORE_H__INCLUDED_)
@@ -13,7 +13,12 @@
 
 #include "CellRange.h"
 #include "GridCell.h"
+#include "GridSizeArray.h"
+#include "GridCellStore.h"
+#include "GridTextCache.h"
 #include <afxtempl.h>
+#include <list>
+#include <unordered_map>
 #include <vector>
 
 
@@ -94,6 +99,15 @@ typedef struct tagGV_CACHEHINT {
     CCellRange range;
 } GV_CACHEHINT;
 
+// Repaint timing (see CGridCtrl::GetPaintStats)
+typedef struct tagGV_PAINTSTATS {
+    UINT    nPaintCount;        // Number of paints
+    UINT    nScrollCount;       // Number of scrolls done by moving the rendered cells
+    double  dTotalTime;         // Total paint time (ms)
+    double  dMaxTime;           // Longest paint (ms)
+    double  dLastTime;          // Last paint (ms)
+} GV_PAINTSTATS;
+
 // storage typedef for each row in the grid
 typedef CTypedPtrArray<CObArray, CGridCellBase*> GRID_ROW;
 
@@ -116,6 +130,15 @@ typedef BOOL (CALLBACK* GRIDCALLBACK)(GV_DISPINFO *, LPARAM);
 #define GVS_DATA                2       // Size using column non-fixed cells data only
 #define GVS_BOTH                3       // Size using column fixed and non-fixed
 
+// Autosizing: timer used by AutoSizeDeferred (runs once the message queue is idle)
+#define GRID_AUTOSIZE_TIMERID   0x0A55
+
+// Compact mode: number of CGridCell objects kept for recently accessed cells
+#define GRID_COMPACT_CACHE_SIZE 1024
+
+// Sorting: number of rows from which built-in comparisons sort in parallel
+#define GRID_PARALLEL_SORT_ROWS 20000
+
 // Cell Searching options
 #define GVNI_FOCUSED            0x0001
 #define GVNI_SELECTED           0x0002
@@ -332,6 +355,9 @@ public:
 
     void SetVirtualMode(BOOL bVirtual);
     BOOL GetVirtualMode() const                   { return m_bVirtualMode;            }
+    void SetCompactMode(BOOL bCompact);                                     // GetCell pointers are only valid for a while (see SetCompactMode)
+    BOOL GetCompactMode() const                   { return m_bCompactMode && !m_bVirtualMode; }
+    const CGridCellStore& GetCellStore() const    { return m_CellStore;               }
     void SetCallbackFunc(GRIDCALLBACK pCallback, 
                          LPARAM lParam)           { m_pfnCallback = pCallback; m_lParam = lParam; }
     GRIDCALLBACK GetCallbackFunc()                { return m_pfnCallback;             }
@@ -366,8 +392,12 @@ public:
     BOOL GetHeaderSort() const                    { return m_bSortOnClick;            }
     void SetHandleTabKey(BOOL bHandleTab = TRUE)  { m_bHandleTabKey = bHandleTab;     }
     BOOL GetHandleTabKey() const                  { return m_bHandleTabKey;           }
-    void SetDoubleBuffering(BOOL bBuffer = TRUE)  { m_bDoubleBuffer = bBuffer;        }
+    void SetDoubleBuffering(BOOL bBuffer = TRUE)  { m_bDoubleBuffer = bBuffer; m_bBackBufferValid = FALSE; }
     BOOL GetDoubleBuffering() const               { return m_bDoubleBuffer;           }
+    void SetScrollBlit(BOOL bBlit = TRUE)         { m_bScrollBlit = bBlit;            }
+    BOOL GetScrollBlit() const                    { return m_bScrollBlit;             }
+    const GV_PAINTSTATS& GetPaintStats() const    { return m_PaintStats;              }
+    void ResetPaintStats()                        { memset(&m_PaintStats, 0, sizeof(m_PaintStats)); }
     void EnableTitleTips(BOOL bEnable = TRUE)     { m_bTitleTips = bEnable;           }
     BOOL GetTitleTips()                           { return m_bTitleTips;              }
     void SetSortColumn(int nCol);
@@ -380,6 +410,9 @@ public:
     BOOL GetFrameFocusCell()                      { return m_bFrameFocus;             }
     void SetAutoSizeStyle(int nStyle = GVS_BOTH)  { m_nAutoSizeColumnStyle = nStyle;  }
     int  GetAutoSizeStyle()                       { return m_nAutoSizeColumnStyle; }
+    void SetAutoSizeSampleRows(int nRows = 0)     { m_nAutoSizeSampleRows = nRows;    }   // 0: measure all rows
+    int  GetAutoSizeSampleRows() const            { return m_nAutoSizeSampleRows;     }
+    CGridTextExtentCache& GetTextExtentCache()    { return m_TextExtentCache;         }
 
     void EnableHiddenColUnhide(BOOL bEnable = TRUE){ m_bHiddenColUnhide = bEnable;    }
     BOOL GetHiddenColUnhide()                     { return m_bHiddenColUnhide;        }
@@ -472,6 +505,8 @@ public:
     void AutoSizeRows();
     void AutoSizeColumns(UINT nAutoSizeStyle = GVS_DEFAULT);
     void AutoSize(UINT nAutoSizeStyle = GVS_DEFAULT);
+    void AutoSizeDeferred(UINT nAutoSizeStyle = GVS_DEFAULT);
+    BOOL IsAutoSizePending() const                { return m_bAutoSizePending; }
     void ExpandColumnsToFit(BOOL bExpandFixed = TRUE);
     void ExpandLastColumn();
     void ExpandRowsToFit(BOOL bExpandFixed = TRUE);
@@ -555,6 +590,8 @@ public:
 	// in-built sort functions
 	static int CALLBACK pfnCellTextCompare(LPARAM lParam1, LPARAM lParam2, LPARAM lParamSort);
 	static int CALLBACK pfnCellNumericCompare(LPARAM lParam1, LPARAM lParam2, LPARAM lParamSort);
+	static int CALLBACK pfnCellDateCompare(LPARAM lParam1, LPARAM lParam2, LPARAM lParamSort);
+	static DATE ParseCellDate(LPCTSTR lpszText);
 
 ///////////////////////////////////////////////////////////////////////////////////
 // Printing
@@ -617,6 +654,16 @@ protected:
     BOOL MouseOverRowResizeArea(const CPoint& point);
     BOOL MouseOverColumnResizeArea(const CPoint& point);
 
+    // Row/column positions (offsets from the first row/column, in display order)
+    long GetRowOffset(int nRow) const;
+    long GetColumnOffset(int nCol) const;
+    int  GetRowFromOffset(long lOffset) const;
+    int  GetColumnFromOffset(long lOffset) const;
+    int  FindLastVisibleRow(int nFirstRow, int nTop, int nBottom, int& nRowBottom) const;
+    int  FindLastVisibleColumn(int nFirstCol, int nLeft, int nRight, int& nColRight) const;
+    BOOL IsDefaultColumnOrder() const;
+    void UpdateColumnOrderState();
+
     CCellRange GetUnobstructedNonFixedCellRange(BOOL bForceRecalculation = FALSE);
     CCellRange GetVisibleNonFixedCellRange(LPRECT pRect = NULL, BOOL bForceRecalculation = FALSE);
     CCellRange GetVisibleFixedCellRange(LPRECT pRect = NULL, BOOL bForceRecalculation = FALSE);
@@ -631,6 +678,8 @@ protected:
     BOOL SortTextItems(int nCol, BOOL bAscending, int low, int high);
     BOOL SortItems(PFNLVCOMPARE pfnCompare, int nCol, BOOL bAscending, LPARAM data,
                    int low, int high);
+    LPCTSTR GetSortKeyText(int nRow, int nCol) const;
+    void ApplyRowOrder(int nFirstRow, const std::vector<int>& arOrder);
 
     CPoint GetPointClicked(int nRow, int nCol, const CPoint& point);
 
@@ -671,11 +720,32 @@ protected:
 
     // Drawing
     virtual void  OnDraw(CDC* pDC);
+    BOOL PrepareBackBuffer(CDC* pDC, const CSize& size);
+    void ReleaseBackBuffer();
+    void ScrollCells(const CCellID& idOldTopLeft, const CRect& rectScroll);
+
+    // Autosizing
+    int  GetAutoSizeRowStep(int nStartRow, int nEndRow) const;
+    int  MeasureColumnWidth(CDC* pDC, int nCol, int nStartRow, int nEndRow);
+    int  MeasureRowHeight(CDC* pDC, int nRow);
+    void OnDeferredAutoSize();
 
     // CGridCellBase Creation and Cleanup
     virtual CGridCellBase* CreateCell(int nRow, int nCol);
     virtual void DestroyCell(int nRow, int nCol);
 
+    // Compact mode cell objects (created on access, see SetCompactMode)
+    static ULONGLONG GetCompactCellKey(int nRow, int nCol) { return ((ULONGLONG)(UINT)nRow << 32) | (UINT)nCol; }
+    CGridCellBase* GetCompactCell(int nRow, int nCol) const;
+    void ReleaseCompactCells();
+    void DeleteCompactCells();
+    void ShiftCompactCells(int nFirstRow, int nRowShift, int nFirstCol, int nColShift);
+    void FillCompactCellStyles(int nFirstRow, int nLastRow, int nFirstCol, int nLastCol);
+    void InsertCompactRows(int nRow, int nCount);
+    void RemoveCompactRows(int nRow, int nCount);
+    void InsertCompactColumns(int nCol, int nCount);
+    void RemoveCompactColumns(int nCol, int nCount);
+
 // Attributes
 protected:
     // General attributes
@@ -686,6 +756,7 @@ protected:
     COLORREF    m_crTTipBackClr, m_crTTipTextClr;                 // Titletip colours - FNA
     
     BOOL        m_bVirtualMode;
+    BOOL        m_bCompactMode;
     LPARAM      m_lParam;                                           // lParam for callback
     GRIDCALLBACK m_pfnCallback;                                     // The callback function
 
@@ -702,6 +773,7 @@ protected:
     BOOL        m_bSortOnClick;
     BOOL        m_bHandleTabKey;
     BOOL        m_bDoubleBuffer;
+    BOOL        m_bScrollBlit;
     BOOL        m_bTitleTips;
     int         m_nBarState;
     BOOL        m_bWysiwygPrinting;
@@ -711,6 +783,9 @@ protected:
     BOOL        m_bTrackFocusCell;
     BOOL        m_bFrameFocus;
     UINT        m_nAutoSizeColumnStyle;
+    int         m_nAutoSizeSampleRows;
+    BOOL        m_bAutoSizePending;                                 // AutoSizeDeferred timer is running
+    UINT        m_nDeferredAutoSizeStyle;
 	BOOL        m_bForceVScroll, m_bForceHScroll;
 	COLORREF    m_crFreezeLineColour;
 
@@ -723,9 +798,21 @@ protected:
 	BOOL m_bExcludeFreezedColsFromSelection;
 	BOOL m_bShowHorzNonGridArea;
 
-    CUIntArray  m_arRowHeights, m_arColWidths;
+    CGridSizeArray m_arRowHeights, m_arColWidths;   // Indexed by prefix sums (see GetRowOffset/GetColumnOffset)
     int         m_nVScrollMax, m_nHScrollMax;
 
+    // Back buffer kept between paints (double buffering): only the update region of the
+    // window is drawn into it, and scrolling moves the cells already drawn
+    CDC         m_dcBackBuffer;
+    CBitmap     m_bmpBackBuffer;
+    CBitmap*    m_pOldBackBitmap;
+    CSize       m_sizeBackBuffer;
+    BOOL        m_bBackBufferValid;     // FALSE: the buffer does not match the window
+    GV_PAINTSTATS m_PaintStats;
+
+    // Measured text extents, shared by all cells (see CGridCellBase::GetTextExtent)
+    CGridTextExtentCache m_TextExtentCache;
+
     // Fonts and images
     CRuntimeClass*   m_pRtcDefault; // determines kind of Grid Cell created by default
     CGridDefaultCell m_cellDefault;  // "default" cell. Contains default colours, font etc.
@@ -736,6 +823,17 @@ protected:
     // Cell data
     CTypedPtrArray<CObArray, GRID_ROW*> m_RowData;
 
+    // Cell data in compact mode: plain CGridCell objects of recently accessed cells are
+    // cached (and written back to the store when reused), other cell types are kept
+    mutable CGridCellStore m_CellStore;
+    struct COMPACT_CELL
+    {
+        CGridCellBase*                  pCell;
+        std::list<ULONGLONG>::iterator  posCache;   // Position in m_lstCompactCache (end() if the cell is kept)
+    };
+    mutable std::unordered_map<ULONGLONG, COMPACT_CELL> m_mapCompactCells;    // By GetCompactCellKey(row, physical column)
+    mutable std::list<ULONGLONG> m_lstCompactCache;                            // Keys of cached CGridCell objects, least recently used first
+
     // Mouse operations such as cell selection
     int         m_MouseMode;
     BOOL        m_bMouseClickDisable;
@@ -881,6 +979,7 @@ private:
 	bool m_AllowReorderColumn;
 	bool m_QuitFocusOnTab;
 	bool m_AllowSelectRowInFixedCol;
+	BOOL m_bDefaultColOrder; // column order is identity, so column widths can be summed up by index
 
 };
 
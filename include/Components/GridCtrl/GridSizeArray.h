@@ -0,0 +1,92 @@
+﻿/**
+ * @file		GridSizeArray.h
+ * @brief		CGridSizeArray class header file
+ * @author		AnthonyLeeStark
+ * @date		2026.10.17
+ *
+ * @copyright 	Copyright (c) 2015-2025 AnthonyLeeStark
+ */
+
+#if !defined(AFX_GRIDSIZEARRAY_H__INCLUDED_)
+#define AFX_GRIDSIZEARRAY_H__INCLUDED_
+
+#if _MSC_VER >= 1000
+#pragma once
+#endif // _MSC_VER >= 1000
+
+#include "AppBase/AppBase.h"
+#include <vector>
+
+//////////////////////////////////////////////////////////////////////
+// CGridSizeArray - row heights / column widths with a prefix sum index
+//
+// Drop-in replacement for the CUIntArray used to store grid row heights
+// and column widths. Sizes are indexed by a Fenwick (binary indexed) tree,
+// so the offset of a row/column and the row/column found at an offset
+// are both O(log n) instead of a walk over all previous rows/columns.
+//
+// Changing a single size updates the tree in O(log n). Inserting or
+// removing sizes shifts the array, so the tree is rebuilt (O(n)) lazily
+// on the next query instead.
+//////////////////////////////////////////////////////////////////////
+
+class CGridSizeArray
+{
+public:
+    // Reference to one size, so that the tree is updated on every assignment
+    class CSizeRef
+    {
+    public:
+        CSizeRef(CGridSizeArray& array, INT_PTR nIndex) : m_array(array), m_nIndex(nIndex) {}
+
+        operator UINT() const                       { return m_array.GetAt(m_nIndex); }
+        CSizeRef& operator=(UINT nSize)             { m_array.SetAt(m_nIndex, nSize); return *this; }
+        CSizeRef& operator=(const CSizeRef& ref)    { return operator=((UINT)ref); }
+        CSizeRef& operator+=(int nDelta)            { return operator=(m_array.GetAt(m_nIndex) + nDelta); }
+        CSizeRef& operator-=(int nDelta)            { return operator=(m_array.GetAt(m_nIndex) - nDelta); }
+
+    private:
+        CGridSizeArray& m_array;
+        INT_PTR         m_nIndex;
+    };
+
+public:
+    CGridSizeArray();
+
+    // Attributes
+    INT_PTR GetSize() const                 { return (INT_PTR)m_arSizes.size(); }
+    INT_PTR GetCount() const                { return GetSize(); }
+    BOOL IsEmpty() const                    { return m_arSizes.empty(); }
+    const UINT* GetData() const             { return m_arSizes.data(); }
+
+    // Element access
+    UINT GetAt(INT_PTR nIndex) const;
+    void SetAt(INT_PTR nIndex, UINT nSize);
+    void SetData(const UINT* pSizes, INT_PTR nCount);
+    UINT operator[](INT_PTR nIndex) const   { return GetAt(nIndex); }
+    CSizeRef operator[](INT_PTR nIndex)     { return CSizeRef(*this, nIndex); }
+
+    // Operations (new elements are zero sized)
+    void SetSize(INT_PTR nNewSize);
+    INT_PTR Add(UINT nSize);
+    void InsertAt(INT_PTR nIndex, UINT nSize, INT_PTR nCount = 1);
+    void RemoveAt(INT_PTR nIndex, INT_PTR nCount = 1);
+    void RemoveAll();
+
+    // Prefix sum queries
+    LONGLONG GetTotal() const               { return GetSum(GetSize()); }
+    LONGLONG GetSum(INT_PTR nCount) const;                 // Sum of the first nCount sizes
+    LONGLONG GetSum(INT_PTR nFirst, INT_PTR nLast) const;  // Sum of sizes [nFirst, nLast)
+    INT_PTR  FindIndex(LONGLONG lOffset) const;            // Index of the element which covers the offset (GetSize() if beyond the end)
+
+protected:
+    void Rebuild() const;
+    void Update(INT_PTR nIndex, LONGLONG lDelta);
+
+protected:
+    std::vector<UINT>             m_arSizes;        // Element sizes
+    mutable std::vector<LONGLONG> m_arTree;         // Fenwick tree (1-based)
+    mutable BOOL                  m_bTreeValid;     // FALSE: rebuild before next query
+};
+
+#endif // !defined(AFX_GRIDSIZEARRAY_H__INCLUDED_)
@@ -0,0 +1,97 @@
+﻿/**
+ * @file		GridTextCache.h
+ * @brief		CGridTextExtentCache class header file
+ * @author		AnthonyLeeStark
+ * @date		2026.10.17
+ *
+ * @copyright 	Copyright (c) 2015-2025 AnthonyLeeStark
+ */
+
+#if !defined(AFX_GRIDTEXTCACHE_H__INCLUDED_)
+#define AFX_GRIDTEXTCACHE_H__INCLUDED_
+
+#if _MSC_VER >= 1000
+#pragma once
+#endif // _MSC_VER >= 1000
+
+#include "AppBase/AppBase.h"
+#include <list>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// Default number of measured strings kept by the cache
+#define GRID_TEXTEXTENT_CACHE_SIZE  4096
+
+//////////////////////////////////////////////////////////////////////
+// CGridTextExtentCache - text extents measured by the grid
+//
+// Autosizing and drawing measure the same strings with the same few
+// fonts over and over. Extents are kept per (font, string) and the
+// least recently used ones are dropped when the cache is full, so a
+// repeated measure is a hash lookup instead of a GDI call.
+//
+// Extents depend on the device the text is measured for: printer DCs
+// are never cached, and the cache must be cleared (RemoveAll) when the
+// screen resolution or the system font settings change.
+//////////////////////////////////////////////////////////////////////
+
+class CGridTextExtentCache
+{
+public:
+    CGridTextExtentCache(size_t nCapacity = GRID_TEXTEXTENT_CACHE_SIZE);
+
+    // Extent of the text drawn with the given font, which must be selected into pDC
+    CSize GetTextExtent(CDC* pDC, const LOGFONT* pLF, LPCTSTR lpszText, int nLength = -1);
+
+    void   SetCapacity(size_t nCapacity);
+    size_t GetCapacity() const                  { return m_nCapacity; }
+    size_t GetCount() const                     { return m_lstEntries.size(); }
+    void   RemoveAll();
+
+    // Statistics
+    UINT GetHitCount() const                    { return m_nHits; }
+    UINT GetMissCount() const                   { return m_nMisses; }
+    void ResetStats()                           { m_nHits = m_nMisses = 0; }
+
+protected:
+    enum { MAX_TEXT_LENGTH = 256 };             // Longer strings are measured every time
+    enum { MAX_FONT_COUNT = 64 };               // Cache is cleared when more fonts are used
+
+    struct EXTENT_KEY
+    {
+        int                             nFont;  // Index in the font table
+        std::basic_string_view<TCHAR>   strText;
+
+        bool operator==(const EXTENT_KEY& key) const
+            { return (nFont == key.nFont && strText == key.strText); }
+    };
+
+    struct EXTENT_KEY_HASH
+    {
+        size_t operator()(const EXTENT_KEY& key) const;
+    };
+
+    struct EXTENT_ENTRY
+    {
+        int                         nFont;
+        std::basic_string<TCHAR>    strText;    // Viewed by the map key (list nodes never move)
+        CSize                       size;
+    };
+
+    typedef std::list<EXTENT_ENTRY> EXTENT_LIST;
+
+    int  GetFontID(const LOGFONT* pLF);
+    void RemoveOldest();
+
+protected:
+    size_t                      m_nCapacity;
+    EXTENT_LIST                 m_lstEntries;   // Most recently used first
+    std::unordered_map<EXTENT_KEY, EXTENT_LIST::iterator, EXTENT_KEY_HASH> m_mapEntries;
+    std::vector<LOGFONT>        m_arFonts;
+    int                         m_nLastFont;    // Font of the last lookup
+    UINT                        m_nHits, m_nMisses;
+};
+
+#endif // !defined(AFX_GRIDTEXTCACHE_H__INCLUDED_)
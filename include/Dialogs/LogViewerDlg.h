@@ -12,6 +12,8 @@
 #include "AppCore/AppCore.h"
 #include "AppCore/MapTable.h"
 #include "AppCore/Logging.h"
+#include "AppCore/LogStore.h"
+#include "AppCore/LogIndex.h"
 #include "AppCore/IDManager.h"
 #include "AppCore/Serialization.h"
 #include "Framework/SDialog.h"
@@ -46,6 +48,16 @@ private:
 	Data m_ptrAppEventLog;
 	size_t m_nLogCount;
 
+	// Saved log history (binary log store)
+	LogStoreReader m_logStoreReader;
+	LogIndex m_logStoreIndex;					// Reads the store on its thread (must be destroyed before the reader)
+	bool m_bUseLogStore;
+
+	// Filter (displayed rows are mapped to log item indexes)
+	String m_strFilter;
+	LogIndex::ItemList m_arrFilteredItems;
+	bool m_bFiltered;
+
 	// Table format and properties
 	int	m_nColNum;
 	GRIDCTRLCOLFORMAT* m_apGrdColFormat;
@@ -66,6 +78,9 @@ public:
 	afx_msg void OnDetailBtn();
 	afx_msg void OnCloseBtn();
 	afx_msg void OnSelectLogItem(NMHDR* pNMHDR, LRESULT* pResult);
+	afx_msg void OnGetLogItemDispInfo(NMHDR* pNMHDR, LRESULT* pResult);
+	afx_msg void OnFilterChange();
+	afx_msg void OnTimer(UINT_PTR nIDEvent);
 	virtual void DoDataExchange(CDataExchange* pDX);    // DDX/DDV support
 
 	DECLARE_MESSAGE_MAP()
@@ -77,7 +92,10 @@ public:
 	void SetupLogViewerList(LANGTABLE_PTR ptrLanguage);
 	void DrawLogViewerTable(void);
 	BOOL LoadAppEventLogData(void);
+	BOOL LoadLogStoreData(void);
 	void UpdateLogViewer(void);
+	void ApplyFilter(void);
+	int GetItemIndex(int nRow) const;
 	void DisplayLogDetails(int nIndex);
 
 	// Layout functions
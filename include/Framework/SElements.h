@@ -12,6 +12,8 @@
 #include "AppCore/AppCore.h"
 #include "AppCore/IDManager.h"
 
+#include <variant>
+
 
 // Define dialog/window control types
 enum ControlType {
@@ -85,11 +87,31 @@ class SCtrlInfoWrap : public CObject
 {
 	DECLARE_DYNAMIC(SCtrlInfoWrap)
 
+public:
+	// Control data value (one of the supported data types)
+	using DataValue = std::variant<std::monostate, bool, LONG_PTR, DOUBLE, String, ULongArray, StringArray, SYSTEMTIME>;
+
+	// Control data value keys
+	enum class DataKey : BYTE {
+		None = 0,
+		Check,												// Checked state
+		Integer, ReserveInteger, MinInteger, MaxInteger,	// Integer data
+		Float, ReserveFloat, MinFloat, MaxFloat,			// Float data
+		Text, ReserveText,									// String data
+		IntArray, ReserveIntArray,							// Integer array data
+		StrArray, ReserveStrArray,							// String array data
+		Time,												// Time data
+	};
+
 public:
 	// Construction
 	SCtrlInfoWrap();								// default constructor
+	SCtrlInfoWrap(SCtrlInfoWrap&& other) noexcept;	// move constructor
 	virtual ~SCtrlInfoWrap();						// destructor
 
+	// Move assignment operator
+	SCtrlInfoWrap& operator=(SCtrlInfoWrap&& other) noexcept;
+
 protected:
 	// Base control window pointer
 	CWnd*			m_pBaseControl;
@@ -112,39 +134,18 @@ protected:
 protected:
 	// --- Control data values --- //
 
-	// Boolean data
-	bool*			m_pbCheck;
-
-	// Integer data
-	PLONG_PTR		m_plValue;
-	PLONG_PTR		m_plReserveValue;
-	PLONG_PTR		m_plMinValue;
-	PLONG_PTR		m_plMaxValue;
-
-	// Float data
-	double*			m_pdbValue;
-	double*			m_pdbReserveValue;
-	double*			m_pdbMinValue;
-	double*			m_pdbMaxValue;
-
-	// String data
-	String*			m_pstrValue;
-	String*			m_pstrReserveValue;
-
-	// Integer array data
-	ULongArray*		m_paulValueList;
-	ULongArray*		m_paulReserveValueList;
-
-	// String array data
-	StringArray*	m_pastrValueList;
-	StringArray*	m_pastrReserveValueList;
-
-	// Time data
-	LPSYSTEMTIME	m_pstTimeValue;
+	// Most controls only hold one data value, which is stored inline;
+	// the other values of the same control (reserve, min/max, item lists, ...)
+	// are stored in the extra value list
+	DataKey			m_eValueKey;
+	DataValue		m_value;
+	std::vector<std::pair<DataKey, DataValue>> m_arrExtraValues;
 
 	// Custom data
-	LPVOID			m_ptrCustomData;		// Data pointer
-	PSIZE_T			m_pszDataSize;			// Total size in bytes
+	std::vector<BYTE> m_arrCustomData;
+
+	// Data needs to be updated from the control window
+	bool			m_bDirty;
 
 public:
 	// Initialization
@@ -237,6 +238,14 @@ public:
 		m_bFocused = bFocused;
 	};
 
+	// Data update state
+	virtual bool IsDirty(void) const {
+		return m_bDirty;
+	};
+	virtual void SetDirty(_In_ bool bDirty) {
+		m_bDirty = bDirty;
+	};
+
 	// Get boolean data values
 	virtual bool	 GetCheck(void) const;
 
@@ -306,10 +315,17 @@ public:
 	// Custom data size retrieving and validating
 	virtual bool	IsDataEmpty(void) const;
 	virtual SIZE_T	GetDataSize(void) const;
+
+private:
+	// Data value slot accessing
+	const DataValue* FindValue(DataKey eKey) const;
+	DataValue&		 AcquireValue(DataKey eKey);
+	template<typename VALUE_TYPE>
+	const VALUE_TYPE* GetValuePtr(DataKey eKey) const;
 };
 
 // Define new typename
-using SCtrlInfoList = typename std::vector<SCtrlInfoWrap*>;
+using SCtrlInfoList = typename std::vector<SCtrlInfoWrap>;
 
 
 // Custom base class for user menu
@@ -339,8 +355,9 @@ public:
 	virtual ~SControlManager();						// destructor
 
 private:
-	// List of control info wrappers
-	SCtrlInfoList* m_pCtrlInfoArray;
+	// List of control info wrappers (contiguous) and control ID to list index map
+	SCtrlInfoList m_arrCtrlInfo;
+	std::unordered_map<unsigned, size_t> m_mapCtrlIndex;
 
 	// Parent window
 	CWnd* m_pParentWnd;
@@ -352,12 +369,10 @@ public:
 
 	// Attributes
 	size_t GetCount(void) const {
-		if (m_pCtrlInfoArray == NULL) return 0;
-		return m_pCtrlInfoArray->size();
+		return m_arrCtrlInfo.size();
 	};
 	bool IsEmpty(void) const {
-		if (m_pCtrlInfoArray == NULL) return TRUE;
-		return m_pCtrlInfoArray->empty();
+		return m_arrCtrlInfo.empty();
 	};
 
 	// Parent window functions
@@ -372,13 +387,23 @@ public:
 	};
 
 	// Add/remove control
-	long long AddControl(SCtrlInfoWrap* pControl);
+	long long AddControl(SCtrlInfoWrap&& control);
 	long long AddControl(unsigned nCtrlID, unsigned nTypeID);
 	long long RemoveControl(unsigned nCtrlID);
 
 	// Accessing elements
+	// Note: Returned pointer is only valid until controls are added/removed
 	SCtrlInfoWrap* GetControl(unsigned nCtrlID);
 	bool SetBuddy(unsigned nBaseCtrlID, unsigned nBuddyCtrlID);
+
+	// Update data (all controls, or the specified control)
+	// Controls changed by their notifications are marked dirty, only them are updated when idle
+	void SetDirty(unsigned nCtrlID = NULL);
 	void UpdateData(unsigned nCtrlID = NULL);
+	void UpdateDirtyData(void);
+
+private:
+	// Update data for a control from its window
+	void UpdateControlData(SCtrlInfoWrap& control);
 };
 
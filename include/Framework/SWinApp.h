@@ -145,6 +145,7 @@ public:
 	virtual const FlagManager& GetAppFlagManager(void) const {
 		return m_flagManager;
 	};
+	virtual void DispatchFlagNotifications(void);
 
 	// Directly access flag values
 	virtual bool GetChangeFlagValue(void) const {
@@ -12,6 +12,7 @@
 #include "AppCore/AppCore.h"
 #include "AppCore/MapTable.h"
 #include "AppCore/Serialization.h"
+#include "AppCore/DataSnapshot.h"
 
 #include "AppCore/Logging.h"
 #include "AppCore/IDManager.h"
@@ -35,6 +36,10 @@ private:
 	HotkeySetData*		m_phksHotkeySetData;
 	PwrReminderData*	m_ppwrReminderData;
 
+	// App data settings store
+	SettingsStore*		m_pSettingsStore;
+	DWORD				m_dwAppDataSerial;
+
 	// Logging pointers
 	SLogging* m_pAppHistoryLog;
 
@@ -62,6 +67,8 @@ public:
 	bool LoadRegistryAppData();
 	bool SaveRegistryAppData(DWORD dwDataType = APPDATA_ALL);
 	bool BackupRegistryAppData();
+	bool LoadAppDataSnapshot(SettingsStore::Snapshot& snapshotData);
+	bool SaveAppDataSnapshot(void);
 	bool UpdateAppLaunchTimeProfileInfo(void);
 	bool LoadGlobalData(void);
 	bool SaveGlobalData(BYTE byCateID = 0xFF);
@@ -83,6 +90,7 @@ public:
 	void InitAppHistoryLog();
 	SLogging* GetAppHistoryLog();
 	void OutputAppHistoryLog(LOGITEM logItem);
+	void UpdateAppLogWriters();
 
 	// Data validity checking functions
 	void TraceSerializeData(WORD wErrCode);
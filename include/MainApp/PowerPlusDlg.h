@@ -15,6 +15,7 @@
 
 #include "AppCore/Logging.h"
 #include "AppCore/IDManager.h"
+#include "AppCore/ScheduleEngine.h"
 
 #include "Framework/SDialog.h"
 
@@ -99,6 +100,9 @@ private:
 	// Power++ runtime queue data
 	PwrRuntimeQueue m_arrRuntimeQueue;
 
+	// Action Schedule engine (next-fire time queue)
+	ScheduleEngine m_schScheduleEngine;
+
 	// Child dialogs
 	CAboutDlg*			m_pAboutDlg;
 	CHelpDlg*			m_pHelpDlg;
@@ -146,6 +150,7 @@ protected:
 	afx_msg LRESULT OnProcessDebugCommand(WPARAM wParam, LPARAM lParam);
 	afx_msg LRESULT OnShowDialog(WPARAM wParam, LPARAM lParam);
 	afx_msg LRESULT OnShowErrorMessage(WPARAM wParam, LPARAM lParam);
+	afx_msg LRESULT OnDebugLogBuffered(WPARAM wParam, LPARAM lParam);
 	afx_msg LRESULT OnPowerBroadcastEvent(WPARAM wParam, LPARAM lParam);
 	afx_msg LRESULT OnQuerryEndSession(WPARAM wParam, LPARAM lParam);
 	afx_msg LRESULT OnWTSSessionChange(WPARAM wParam, LPARAM lParam);
@@ -205,6 +210,9 @@ private:
 
 	// Action Schedule feature functions
 	bool ProcessActionSchedule(void);
+	void UpdateScheduleEngine(void);
+	void ArmActionScheduleTimer(void);
+	PScheduleItem FindScheduleItem(unsigned nItemID);
 	void ReupdateActionScheduleData(void);
 	void SetActionScheduleSkip(const ScheduleItem& schItem, int nSkipFlag);
 	void SetActionScheduleSnooze(const ScheduleItem& schItem, int nSnoozeFlag);
@@ -13,29 +13,39 @@
 // Format string
 String& String::FormatV(const wchar_t* formatStr, va_list vargs)
 {
-	if (!formatStr) _buffer.clear();
-	else {
-		wchar_t _tempBuff[1024];
+	_buffer.clear();
+	return AppendFormatV(formatStr, vargs);
+}
+
+// Append formatted string
+String& String::AppendFormatV(const wchar_t* formatStr, va_list vargs)
+{
+	if (!formatStr) return *this;
+
+	// Format into the free space at the end of the buffer,
+	// grow and retry if the result does not fit
+	constexpr size_t _maxLength = 0x100000;
+	const size_t _oldLength = _buffer.length();
+	size_t _available = _buffer.capacity() - _oldLength;
+	_available = (std::max)(_available, wcslen(formatStr) * 2 + 64);
+
+	while (true) {
+		_buffer.resize(_oldLength + _available);
 
 		va_list _args;
 		va_copy(_args, vargs);
-		int len = std::vswprintf(_tempBuff, sizeof(_tempBuff) / sizeof(wchar_t), formatStr, _args);
+		int len = std::vswprintf(_buffer.data() + _oldLength, _available + 1, formatStr, _args);
 		va_end(_args);
 
-		if (len >= 0 && static_cast<size_t>(len) < sizeof(_tempBuff) / sizeof(wchar_t))
-			_buffer = _tempBuff;
-		else {
-			size_t size = (len > 0) ? len + 1 : 4096;
-			std::vector<wchar_t> dynamic(size);
-
-			va_copy(_args, vargs);
-			len = std::vswprintf(dynamic.data(), size, formatStr, _args);
-			va_end(_args);
-
-			if (len < 0) _buffer.clear();
-			else
-				_buffer.assign(dynamic.data(), static_cast<size_t>(len));
+		if (len >= 0) {
+			_buffer.resize(_oldLength + static_cast<size_t>(len));
+			break;
+		}
+		else if (_available >= _maxLength) {
+			_buffer.resize(_oldLength);
+			break;
 		}
+		_available *= 2;
 	}
 
 	return *this;
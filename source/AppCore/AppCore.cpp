@@ -221,6 +221,72 @@ constexpr bool ConfigData::Compare(const ConfigData& other) const noexcept
 }
 
 
+/**
+ * @brief	Subscribe to value changes of a flag
+ * @param	eFlagID		 - Flag ID
+ * @param	funcCallback - Callback function (called with the latest flag value)
+ * @return	size_t - Subscription ID (0 if failed)
+ */
+size_t FlagManager::Subscribe(AppFlagID eFlagID, FlagChangedCallback&& funcCallback)
+{
+	if ((!IsValidFlagID(eFlagID)) || (!funcCallback))
+		return 0;
+
+	size_t nSubscriptionID = m_nNextSubscriptionID++;
+	m_arrSubscribers.push_back({ nSubscriptionID, eFlagID, std::move(funcCallback) });
+	return nSubscriptionID;
+}
+
+/**
+ * @brief	Remove a flag change subscription
+ * @param	nSubscriptionID - Subscription ID
+ * @return	None
+ */
+void FlagManager::Unsubscribe(size_t nSubscriptionID)
+{
+	auto itSubscriber = std::find_if(m_arrSubscribers.begin(), m_arrSubscribers.end(),
+		[nSubscriptionID](const SUBSCRIBER& subscriber) { return (subscriber.nSubscriptionID == nSubscriptionID); });
+	if (itSubscriber != m_arrSubscribers.end()) {
+		m_arrSubscribers.erase(itSubscriber);
+	}
+}
+
+/**
+ * @brief	Notify subscribers of all flags changed since last dispatch
+ *			Changes are collected by SetFlagValue (from any thread) and dispatched once per
+ *			message loop iteration; a flag changed multiple times is only notified once
+ * @param	None
+ * @return	size_t - Number of notified flags
+ */
+size_t FlagManager::DispatchNotifications(void)
+{
+	// Take and reset changed flags
+	uint64_t ullChangedMask = m_ullChangedMask.exchange(0, std::memory_order_acq_rel);
+	if ((ullChangedMask == 0) || (m_arrSubscribers.empty()))
+		return 0;
+
+	// Callbacks may subscribe/unsubscribe, so notify a copy of subscriber list
+	const SubscriberList arrSubscribers = m_arrSubscribers;
+
+	size_t nNotifiedCount = 0;
+	for (int nFlag = 0; nFlag < flagCount; nFlag++) {
+		AppFlagID eFlagID = static_cast<AppFlagID>(nFlag);
+		if ((ullChangedMask & GetFlagBit(eFlagID)) == 0)
+			continue;
+
+		int nValue = GetFlagValue(eFlagID);
+		for (const SUBSCRIBER& subscriber : arrSubscribers) {
+			if (subscriber.eFlagID == eFlagID) {
+				subscriber.funcCallback(eFlagID, nValue);
+			}
+		}
+		nNotifiedCount++;
+	}
+
+	return nNotifiedCount;
+}
+
+
 /**
  * @brief	Constructor
  */
@@ -2490,15 +2556,17 @@ DateTime DateTimeUtils::FromSystemTime(SYSTEMTIME sysTime)
  */
 SYSTEMTIME DateTimeUtils::ToSystemTime(const DateTime& dateTime)
 {
+	const DateTime::Fields fields = dateTime.Decompose();
+
 	SYSTEMTIME _sysTime{};
-	_sysTime.wYear = static_cast<unsigned short>(dateTime.Year());
-	_sysTime.wMonth = static_cast<unsigned short>(dateTime.Month());
-	_sysTime.wDay = static_cast<unsigned short>(dateTime.Day());
-	_sysTime.wDayOfWeek = static_cast<unsigned short>(dateTime.DayOfWeek());
-	_sysTime.wHour = static_cast<unsigned short>(dateTime.Hour());
-	_sysTime.wMinute = static_cast<unsigned short>(dateTime.Minute());
-	_sysTime.wSecond = static_cast<unsigned short>(dateTime.Second());
-	_sysTime.wMilliseconds = static_cast<unsigned short>(dateTime.Millisecond());
+	_sysTime.wYear = static_cast<unsigned short>(fields.year);
+	_sysTime.wMonth = static_cast<unsigned short>(fields.month);
+	_sysTime.wDay = static_cast<unsigned short>(fields.day);
+	_sysTime.wDayOfWeek = static_cast<unsigned short>(fields.dayOfWeek);
+	_sysTime.wHour = static_cast<unsigned short>(fields.hour);
+	_sysTime.wMinute = static_cast<unsigned short>(fields.minute);
+	_sysTime.wSecond = static_cast<unsigned short>(fields.second);
+	_sysTime.wMilliseconds = static_cast<unsigned short>(fields.millisecond);
 
 	return _sysTime;
 }
@@ -2529,10 +2597,11 @@ String DateTimeUtils::Format(LANGTABLE_PTR pLang, unsigned nFormatID, const Date
 String DateTimeUtils::Format(LANGTABLE_PTR pLang, const wchar_t* formatString, const DateTime& dateTime)
 {
 	// Format time string
-	unsigned nTimePeriod = (dateTime.Hour() < 12) ? FORMAT_TIMEPERIOD_ANTE_MERIDIEM : FORMAT_TIMEPERIOD_POST_MERIDIEM;
+	const ClockTime clockTime = dateTime.GetClockTime();
+	unsigned nTimePeriod = (clockTime.Hour() < 12) ? FORMAT_TIMEPERIOD_ANTE_MERIDIEM : FORMAT_TIMEPERIOD_POST_MERIDIEM;
 	const wchar_t* timePeriodFormat = Language::GetLanguageString(pLang, nTimePeriod);
-	int hourVal = (dateTime.Hour() > 12) ? (dateTime.Hour() - 12) : dateTime.Hour();
-	int minuteVal = dateTime.Minute();
+	int hourVal = (clockTime.Hour() > 12) ? (clockTime.Hour() - 12) : clockTime.Hour();
+	int minuteVal = clockTime.Minute();
 
 	return StringUtils::StringFormat(formatString, hourVal, minuteVal, timePeriodFormat);
 }
@@ -2671,11 +2740,52 @@ LANGTABLE_PTR Language::LoadLanguageTable(unsigned nCurLanguage)
 }
 
 
+/**
+ * @brief	Build ID-to-string lookup index for a language table
+ * @param	langTable - Language table
+ * @return	LANGINDEX - Language string index
+ */
+static Language::LANGINDEX BuildLanguageIndex(LANGTABLE& langTable)
+{
+	Language::LANGINDEX langIndex;
+	langIndex.reserve(langTable.size());
+
+	// If an ID is duplicated, keep the first one (same as sequential search)
+	for (const LANGTEXT& langText : langTable) {
+		langIndex.emplace(langText.id, langText.langString);
+	}
+
+	return langIndex;
+}
+
+
+/**
+ * @brief	Get lookup index of specified language table
+ * @param	ptLanguage - Language package pointer
+ * @return	const LANGINDEX* - Language string index (NULL if table is unknown)
+ */
+const Language::LANGINDEX* Language::GetLanguageIndex(LANGTABLE_PTR ptLanguage)
+{
+	// Indexes are built only once, on first use
+	static const LANGINDEX langIndex_en_US = BuildLanguageIndex(langtable_en_US);
+	static const LANGINDEX langIndex_vi_VN = BuildLanguageIndex(langtable_vi_VN);
+	static const LANGINDEX langIndex_zh_CH = BuildLanguageIndex(langtable_zh_CH);
+
+	if (ptLanguage == &langtable_en_US)
+		return &langIndex_en_US;
+	else if (ptLanguage == &langtable_vi_VN)
+		return &langIndex_vi_VN;
+	else if (ptLanguage == &langtable_zh_CH)
+		return &langIndex_zh_CH;
+
+	return NULL;
+}
+
+
 /**
  * @brief	Find and return language string by ID
  * @param	ptLanguage - Language package pointer
  * @param	nID		   - Language string ID
- * @param	pszResult  - Result string (reference-type)
  * @return	const wchar_t*	- Language string
  */
 const wchar_t* Language::GetLanguageString(LANGTABLE_PTR ptLanguage, unsigned nID)
@@ -2684,10 +2794,32 @@ const wchar_t* Language::GetLanguageString(LANGTABLE_PTR ptLanguage, unsigned nI
 	if ((ptLanguage == NULL) || (ptLanguage->empty()))
 		return Constant::String::Null;
 
-	// Find and return corresponding language string paired with specified ID
-	for (int nIndex = 0; nIndex < ptLanguage->size(); nIndex++) {
-		LANGTEXT langText = ptLanguage->at(nIndex);
+	// Look up in table index
+	const LANGINDEX* pLangIndex = GetLanguageIndex(ptLanguage);
+	if (pLangIndex != NULL) {
+		auto itFound = pLangIndex->find(nID);
+		return (itFound != pLangIndex->end()) ? itFound->second : Constant::String::Null;
+	}
+
+	// Unindexed table: sequential search
+	return FindLanguageString(ptLanguage, nID);
+}
+
+
+/**
+ * @brief	Find language string by ID using sequential search (no index)
+ * @param	ptLanguage - Language package pointer
+ * @param	nID		   - Language string ID
+ * @return	const wchar_t*	- Language string
+ */
+const wchar_t* Language::FindLanguageString(LANGTABLE_PTR ptLanguage, unsigned nID)
+{
+	// Return NULL string if language table is empty
+	if ((ptLanguage == NULL) || (ptLanguage->empty()))
+		return Constant::String::Null;
 
+	// Find and return corresponding language string paired with specified ID
+	for (const LANGTEXT& langText : *ptLanguage) {
 		if (langText.id == nID)
 			return langText.langString;
 	}
@@ -2874,10 +3006,11 @@ bool AppCore::ExecutePowerActionDummy(unsigned nActionType, unsigned nMessage, D
 
 	// Time format
 	String timeFormatStr;
-	const wchar_t* timePeriod = (currentDateTime.Hour() < 12) ? Constant::Symbol::AnteMeridiem : Constant::Symbol::PostMeridiem;
+	const DateTime::Fields timeFields = currentDateTime.Decompose();
+	const wchar_t* timePeriod = (timeFields.hour < 12) ? Constant::Symbol::AnteMeridiem : Constant::Symbol::PostMeridiem;
 	String templateFormatStr = StringUtils::LoadResourceString(IDS_FORMAT_FULLDATETIME);
-	timeFormatStr.Format(templateFormatStr, currentDateTime.Year(), currentDateTime.Month(), currentDateTime.Day(),
-						currentDateTime.Hour(), currentDateTime.Minute(), currentDateTime.Second(), currentDateTime.Millisecond(), timePeriod);
+	timeFormatStr.Format(templateFormatStr, timeFields.year, timeFields.month, timeFields.day,
+						timeFields.hour, timeFields.minute, timeFields.second, timeFields.millisecond, timePeriod);
 
 	// Message format
 	String messageFormatStr;
@@ -0,0 +1,127 @@
+﻿/**
+ * @file		DataSnapshot.cpp
+ * @brief		Implement binary snapshot file of app data
+ * @author		AnthonyLeeStark
+ * @date		2026.10.17
+ *
+ * @copyright 	Copyright (c) 2015-2025 AnthonyLeeStark
+ */
+
+#include "AppCore/DataSnapshot.h"
+#include "AppCore/Logging.h"
+
+#ifdef _DEBUG
+#define new DEBUG_NEW
+#endif
+
+
+/**
+ * @brief	Get snapshot file path
+ * @param	None
+ * @return	String
+ */
+String DataSnapshot::GetFilePath(void)
+{
+	String appPath = StringUtils::GetApplicationPath(false);
+	return StringUtils::MakeFilePath(appPath, Constant::File::Name::AppDataSnapshot, Constant::File::Extension::DataSnapshot);
+}
+
+/**
+ * @brief	Write snapshot file (write a temporary file, then replace the old file)
+ * @param	snapshot - Settings snapshot
+ * @param	dwSerial - Snapshot serial number
+ * @return	true/false
+ */
+bool DataSnapshot::Write(const SettingsStore::Snapshot& snapshot, DWORD dwSerial)
+{
+	// Serialize data after header
+	std::vector<uint8_t> fileBuffer(sizeof(FILEHEADER));
+	SettingsStore::Serialize(snapshot, fileBuffer);
+
+	const uint8_t* pData = fileBuffer.data() + sizeof(FILEHEADER);
+	size_t nDataSize = fileBuffer.size() - sizeof(FILEHEADER);
+	if (fileBuffer.size() > maxFileSize) return false;
+
+	FILEHEADER header{};
+	header.dwMagic = fileMagic;
+	header.wVersion = formatVersion;
+	header.wHeaderSize = static_cast<WORD>(sizeof(FILEHEADER));
+	header.dwSerial = dwSerial;
+	header.dwDataSize = static_cast<DWORD>(nDataSize);
+	header.dwChecksum = SettingsStore::Checksum(pData, nDataSize);
+	memcpy(fileBuffer.data(), &header, sizeof(FILEHEADER));
+
+	// Write temporary file
+	String filePath = GetFilePath();
+	String tempFilePath = filePath + _T(".tmp");
+	HANDLE hFile = CreateFile(tempFilePath, GENERIC_WRITE, 0, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (hFile == INVALID_HANDLE_VALUE) {
+		TRACE_FORMAT("Error: Create app data snapshot file failed!!! (Code: 0x%08X)", GetLastError());
+		return false;
+	}
+
+	DWORD dwWritten = 0;
+	bool bRet = (WriteFile(hFile, fileBuffer.data(), static_cast<DWORD>(fileBuffer.size()), &dwWritten, NULL) != FALSE);
+	bRet &= (dwWritten == fileBuffer.size());
+	bRet &= (FlushFileBuffers(hFile) != FALSE);
+	CloseHandle(hFile);
+
+	// Replace old file
+	if (bRet == true) {
+		bRet = (MoveFileEx(tempFilePath, filePath, MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != FALSE);
+	}
+	if (bRet == false) {
+		TRACE_FORMAT("Error: Write app data snapshot file failed!!! (Code: 0x%08X)", GetLastError());
+		DeleteFile(tempFilePath);
+	}
+
+	return bRet;
+}
+
+/**
+ * @brief	Read snapshot file with one read and validate it
+ * @param	dwSerial - Expected snapshot serial number (saved in registry)
+ * @param	snapshot - Result snapshot (out)
+ * @return	true/false - Snapshot is valid and up-to-date or not
+ */
+bool DataSnapshot::Read(DWORD dwSerial, SettingsStore::Snapshot& snapshot)
+{
+	HANDLE hFile = CreateFile(GetFilePath(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+	if (hFile == INVALID_HANDLE_VALUE) return false;
+
+	// Read whole file
+	std::vector<uint8_t> fileBuffer;
+	LARGE_INTEGER liFileSize{};
+	bool bRet = (GetFileSizeEx(hFile, &liFileSize) != FALSE);
+	bRet &= ((liFileSize.QuadPart >= static_cast<LONGLONG>(sizeof(FILEHEADER))) && (liFileSize.QuadPart <= maxFileSize));
+	if (bRet == true) {
+		DWORD dwRead = 0;
+		fileBuffer.resize(static_cast<size_t>(liFileSize.QuadPart));
+		bRet = (ReadFile(hFile, fileBuffer.data(), static_cast<DWORD>(fileBuffer.size()), &dwRead, NULL) != FALSE);
+		bRet &= (dwRead == fileBuffer.size());
+	}
+	CloseHandle(hFile);
+	if (bRet == false) return false;
+
+	// Validate header
+	FILEHEADER header{};
+	memcpy(&header, fileBuffer.data(), sizeof(FILEHEADER));
+	if ((header.dwMagic != fileMagic) || (header.wVersion != formatVersion)) return false;
+	if ((header.wHeaderSize < sizeof(FILEHEADER)) || (header.wHeaderSize > fileBuffer.size())) return false;
+	if (header.dwDataSize != (fileBuffer.size() - header.wHeaderSize)) return false;
+
+	// Outdated snapshot (registry data was saved after the file)
+	if (header.dwSerial != dwSerial) {
+		TRACE_INFO(L"App data snapshot is outdated (serial: {}, registry: {})", header.dwSerial, dwSerial);
+		return false;
+	}
+
+	// Validate data
+	const uint8_t* pData = fileBuffer.data() + header.wHeaderSize;
+	if (SettingsStore::Checksum(pData, header.dwDataSize) != header.dwChecksum) {
+		TRACE_WARNING(L"App data snapshot checksum mismatch");
+		return false;
+	}
+
+	return SettingsStore::Deserialize(pData, header.dwDataSize, snapshot);
+}
@@ -29,8 +29,9 @@ std::mutex		SResourceIDMap::m_mutexLockGuard;
 SResourceIDMap::SResourceIDMap() : CObject()
 {
 	// Initialization
-	m_pIDMapData = NULL;
-	m_nSize = 0;
+	m_arrIDMapData.clear();
+	m_mapResourceIDIndex.clear();
+	m_mapNameIDIndex.clear();
 }
 
 /**
@@ -103,25 +104,13 @@ void SResourceIDMap::Copy(const RESOURCE_ID_MAP_ENTRY* pSrc, size_t nSize)
 	if ((pSrc == NULL) || (nSize <= 0))
 		return;
 
-	// If the destination data is not empty
-	if (m_pIDMapData != NULL) {
-
-		// Do not copy itself
-		if (m_pIDMapData == pSrc)
-			return;
-
-		// Clean it up to prepare for copying
-		delete[] m_pIDMapData;
-		m_pIDMapData = NULL;
-	}
-
-	// Allocated and initialize destination data
-	m_pIDMapData = new RESOURCE_ID_MAP_ENTRY[nSize];
-	ASSERT(m_pIDMapData != NULL);
+	// Do not copy itself
+	if ((!m_arrIDMapData.empty()) && (m_arrIDMapData.data() == pSrc))
+		return;
 
-	// Copy data
-	CopyElements(m_pIDMapData, pSrc, nSize);
-	m_nSize = nSize;
+	// Clean up current data and copy
+	RemoveAll();
+	Append(pSrc, nSize);
 }
 
 /**
@@ -129,6 +118,7 @@ void SResourceIDMap::Copy(const RESOURCE_ID_MAP_ENTRY* pSrc, size_t nSize)
  * @param	pSrc - Source data pointer
  * @param	nSize - Source data size
  * @return	None
+ * @note	Items which resource IDs already exist in current map data are skipped
  */
 void SResourceIDMap::Append(const RESOURCE_ID_MAP_ENTRY* pSrc, size_t nSize)
 {
@@ -137,45 +127,13 @@ void SResourceIDMap::Append(const RESOURCE_ID_MAP_ENTRY* pSrc, size_t nSize)
 	if ((pSrc == NULL) || (nSize <= 0))
 		return;
 
-	// If the destination data is not allocated, copy data
-	if (m_pIDMapData == NULL) {
-		Copy(pSrc, nSize);
-		return;
-	}
+	// Reserve for all source items at once
+	Reserve(m_arrIDMapData.size() + nSize);
 
-	// Filter items in source map which doesn't exist in destination map
-	size_t nFilterCount = 0;
-	RESOURCE_ID_MAP pFilterSrc = new RESOURCE_ID_MAP_ENTRY[nSize];
-	ASSERT(pFilterSrc != NULL);
+	// Append items which don't exist in current map
 	for (size_t nIndex = 0; nIndex < nSize; nIndex++) {
-		if (FindResourceID(pSrc[nIndex].dwResourceID) == INT_INVALID) {
-			// Copy item into filter map
-			pFilterSrc[nFilterCount] = pSrc[nIndex];
-			// Increase filter map count
-			nFilterCount++;
-		}
+		AddEntry(pSrc[nIndex]);
 	}
-
-	// If filter map is empty (which means all items already existed), do not append
-	if ((pFilterSrc == NULL) || (nFilterCount <= 0))
-		return;
-
-	// Create new map data
-	size_t nNewSize = m_nSize + nFilterCount;
-	RESOURCE_ID_MAP pNewMapData = new RESOURCE_ID_MAP_ENTRY[nNewSize];
-	ASSERT(pNewMapData != NULL);
-
-	// Copy current map data to new map data
-	CopyElements(pNewMapData, m_pIDMapData, m_nSize);
-
-	// Append filtered source map data to new map data
-	CopyElements(pNewMapData + m_nSize, pFilterSrc, nFilterCount);
-	delete[] pFilterSrc;
-
-	// Copy data back
-	delete[] m_pIDMapData;
-	m_pIDMapData = pNewMapData;
-	m_nSize = nNewSize;
 }
 
 /**
@@ -184,29 +142,19 @@ void SResourceIDMap::Append(const RESOURCE_ID_MAP_ENTRY* pSrc, size_t nSize)
  * @param	dwResID	   - Resource ID
  * @param	lpszNameID - Resource name string ID
  * @return	None
+ * @note	If the resource ID already exists, do nothing
  */
 void SResourceIDMap::Add(byte byTypeID, DWORD dwResID, const char* lpszNameID)
 {
-	// Check data validity
-	ASSERT(m_pIDMapData != NULL);
-	if (m_pIDMapData == NULL)
-		return;
-
-	// Create a new clone map data
-	int nNewSize = m_nSize + 1;
-	RESOURCE_ID_MAP pNewMapData = new RESOURCE_ID_MAP_ENTRY[nNewSize];
-	ASSERT(pNewMapData != NULL);
-	CopyElements(pNewMapData, m_pIDMapData, m_nSize);
-
-	// Add new control ID map entry
-	pNewMapData[m_nSize].byTypeID = byTypeID;
-	pNewMapData[m_nSize].dwResourceID = dwResID;
-	pNewMapData[m_nSize].strNameID = lpszNameID;
-
-	// Copy data back
-	delete[] m_pIDMapData;
-	m_pIDMapData = pNewMapData;
-	m_nSize = nNewSize;
+	// Make new map entry
+	RESOURCE_ID_MAP_ENTRY mapEntry;
+	mapEntry.byTypeID = byTypeID;
+	mapEntry.dwResourceID = dwResID;
+	mapEntry.strNameID = lpszNameID;
+
+	// Add entry
+	Reserve(m_arrIDMapData.size() + 1);
+	AddEntry(mapEntry);
 }
 
 /**
@@ -217,18 +165,16 @@ void SResourceIDMap::Add(byte byTypeID, DWORD dwResID, const char* lpszNameID)
  */
 void SResourceIDMap::Modify(DWORD dwResID, const char* lpszNewNameID)
 {
-	// Check data validity
-	ASSERT(m_pIDMapData != NULL);
-	if (m_pIDMapData == NULL)
-		return;
-
 	// Find item index
-	int nIndex = FindResourceID(dwResID);
+	long long nIndex = FindResourceID(dwResID);
 	if (nIndex == INT_INVALID)
 		return;
 	
 	// Modify item at index
-	m_pIDMapData[nIndex].strNameID = lpszNewNameID;
+	m_arrIDMapData[static_cast<size_t>(nIndex)].strNameID = lpszNewNameID;
+
+	// Name ID index changed
+	RebuildIndex();
 }
 
 /**
@@ -239,34 +185,16 @@ void SResourceIDMap::Modify(DWORD dwResID, const char* lpszNewNameID)
  */
 void SResourceIDMap::Remove(DWORD dwResID)
 {
-	// Check data validity
-	ASSERT(m_pIDMapData != NULL);
-	if (m_pIDMapData == NULL)
-		return;
-
 	// Find item index
-	int nItemIndex = FindResourceID(dwResID);
+	long long nItemIndex = FindResourceID(dwResID);
 	if (nItemIndex == INT_INVALID)
 		return;
 
-	// Create a new clone map data
-	size_t nNewSize = (m_nSize - 1);
-	RESOURCE_ID_MAP pNewMapData = new RESOURCE_ID_MAP_ENTRY[m_nSize];
-	ASSERT(pNewMapData != NULL);
-
-	// Copy old data to new data
-	// except for the item at the index we need to remove
-	size_t nDestIdx = 0;
-	for (size_t nSrcIdx = 0; nSrcIdx < m_nSize; nSrcIdx++) {
-		if (nSrcIdx == nItemIndex) continue;
-		pNewMapData[nDestIdx] = m_pIDMapData[nSrcIdx];
-		nDestIdx++;
-	}
+	// Remove item (following items are shifted)
+	m_arrIDMapData.erase(m_arrIDMapData.begin() + static_cast<ptrdiff_t>(nItemIndex));
 
-	// Copy data back
-	delete[] m_pIDMapData;
-	m_pIDMapData = pNewMapData;
-	m_nSize = nNewSize;
+	// Item indexes changed
+	RebuildIndex();
 }
 
 /**
@@ -276,13 +204,10 @@ void SResourceIDMap::Remove(DWORD dwResID)
  */
 void SResourceIDMap::RemoveAll(void)
 {
-	// Check data validity
-	if (m_pIDMapData == NULL)
-		return;
-
 	// Clean-up data
-	delete[] m_pIDMapData;
-	m_pIDMapData = NULL;
+	m_arrIDMapData.clear();
+	m_mapResourceIDIndex.clear();
+	m_mapNameIDIndex.clear();
 }
 
 /**
@@ -292,18 +217,13 @@ void SResourceIDMap::RemoveAll(void)
  */
 unsigned SResourceIDMap::GetResourceID(const char* lpszNameID) const
 {
-	// Check data validity
-	ASSERT(m_pIDMapData != NULL);
-	if (m_pIDMapData == NULL)
-		return INT_NULL;
-
 	// Find index
-	int nIndex = FindNameID(lpszNameID);
+	long long nIndex = FindNameID(lpszNameID);
 	if (nIndex == INT_INVALID)
 		return INT_NULL;
 
 	// Return control resource ID
-	return m_pIDMapData[nIndex].dwResourceID;
+	return m_arrIDMapData[static_cast<size_t>(nIndex)].dwResourceID;
 }
 
 /**
@@ -313,18 +233,13 @@ unsigned SResourceIDMap::GetResourceID(const char* lpszNameID) const
  */
 const char* SResourceIDMap::GetNameID(DWORD dwResID) const
 {
-	// Check data validity
-	ASSERT(m_pIDMapData != NULL);
-	if (m_pIDMapData == NULL)
-		return "#NULL";
-
 	// Find index
-	int nIndex = FindResourceID(dwResID);
+	long long nIndex = FindResourceID(dwResID);
 	if (nIndex == INT_INVALID)
 		return "#NULL";
 
 	// Return string ID
-	return m_pIDMapData[nIndex].strNameID;
+	return m_arrIDMapData[static_cast<size_t>(nIndex)].strNameID;
 }
 
 /**
@@ -335,20 +250,11 @@ const char* SResourceIDMap::GetNameID(DWORD dwResID) const
  */
 long long SResourceIDMap::FindResourceID(DWORD dwResID) const
 {
-	// Check data validity
-	ASSERT(m_pIDMapData != NULL);
-	if (m_pIDMapData == NULL)
+	auto iter = m_mapResourceIDIndex.find(dwResID);
+	if (iter == m_mapResourceIDIndex.end())
 		return INT_INVALID;
 
-	// Find ID
-	long long resIndex = INT_INVALID;
-	for (size_t index = 0; index < m_nSize; index++) {
-		if (m_pIDMapData[index].dwResourceID == dwResID) {
-			resIndex = index;	// Index found
-			break;
-		}
-	}
-	return resIndex;
+	return static_cast<long long>(iter->second);
 }
 
 /**
@@ -359,20 +265,14 @@ long long SResourceIDMap::FindResourceID(DWORD dwResID) const
  */
 long long SResourceIDMap::FindNameID(const char* lpszNameID) const
 {
-	// Check data validity
-	ASSERT(m_pIDMapData != NULL);
-	if (m_pIDMapData == NULL)
+	if (lpszNameID == NULL)
 		return INT_INVALID;
 
-	// Find ID
-	long long resIndex = INT_INVALID;
-	for (size_t index = 0; index < m_nSize; index++) {
-		if (strcmp(m_pIDMapData[index].strNameID, lpszNameID) == 0) {
-			resIndex = index;	// Index found
-			break;
-		}
-	}
-	return resIndex;
+	auto iter = m_mapNameIDIndex.find(lpszNameID);
+	if (iter == m_mapNameIDIndex.end())
+		return INT_INVALID;
+
+	return static_cast<long long>(iter->second);
 }
 
 /**
@@ -382,9 +282,9 @@ long long SResourceIDMap::FindNameID(const char* lpszNameID) const
  */
 const RESOURCE_ID_MAP_ENTRY& SResourceIDMap::GetAt(size_t nIndex) const
 {
-	ASSERT((nIndex >= 0) && (nIndex < m_nSize));
-	if ((nIndex >= 0) && (nIndex < m_nSize)) {
-		return m_pIDMapData[nIndex];
+	ASSERT(nIndex < m_arrIDMapData.size());
+	if (nIndex < m_arrIDMapData.size()) {
+		return m_arrIDMapData[nIndex];
 	}
 
 	// Invalid argument
@@ -398,5 +298,55 @@ const RESOURCE_ID_MAP_ENTRY& SResourceIDMap::GetAt(size_t nIndex) const
  */
 size_t SResourceIDMap::GetMapCount(void) const
 {
-	return m_nSize;
+	return m_arrIDMapData.size();
+}
+
+/**
+ * @brief	Reserve map data and indexes for a number of entries
+ * @param	nCount - Total number of entries
+ * @return	None
+ * @note	Capacity grows at least twice, so that adding items one by one is not quadratic
+ */
+void SResourceIDMap::Reserve(size_t nCount)
+{
+	if (nCount <= m_arrIDMapData.capacity())
+		return;
+
+	nCount = (std::max)(nCount, m_arrIDMapData.capacity() * 2);
+	m_arrIDMapData.reserve(nCount);
+	m_mapResourceIDIndex.reserve(nCount);
+	m_mapNameIDIndex.reserve(nCount);
+}
+
+/**
+ * @brief	Add a map entry and index it (if its resource ID doesn't exist yet)
+ * @param	mapEntry - Resource ID map entry
+ * @return	None
+ */
+void SResourceIDMap::AddEntry(const RESOURCE_ID_MAP_ENTRY& mapEntry)
+{
+	// Resource ID already exists
+	size_t nNewIndex = m_arrIDMapData.size();
+	if (!m_mapResourceIDIndex.try_emplace(mapEntry.dwResourceID, nNewIndex).second)
+		return;
+
+	// Add entry (only the first entry of a name ID is indexed)
+	m_arrIDMapData.push_back(mapEntry);
+	m_mapNameIDIndex.try_emplace(std::string(mapEntry.strNameID.GetString()), nNewIndex);
+}
+
+/**
+ * @brief	Rebuild lookup indexes from map data
+ * @param	None
+ * @return	None
+ */
+void SResourceIDMap::RebuildIndex(void)
+{
+	m_mapResourceIDIndex.clear();
+	m_mapNameIDIndex.clear();
+	for (size_t nIndex = 0; nIndex < m_arrIDMapData.size(); nIndex++) {
+		const RESOURCE_ID_MAP_ENTRY& mapEntry = m_arrIDMapData[nIndex];
+		m_mapResourceIDIndex.try_emplace(mapEntry.dwResourceID, nIndex);
+		m_mapNameIDIndex.try_emplace(std::string(mapEntry.strNameID.GetString()), nIndex);
+	}
 }
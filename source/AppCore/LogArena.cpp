@@ -0,0 +1,129 @@
+﻿/**
+ * @file		LogArena.cpp
+ * @brief		Implement monotonic memory arena for log item detail data
+ * @author		AnthonyLeeStark
+ * @date		2026.10.17
+ *
+ * @copyright 	Copyright (c) 2015-2025 AnthonyLeeStark
+ */
+
+#include "AppCore/LogArena.h"
+
+#ifdef _DEBUG
+#define new DEBUG_NEW
+#endif
+
+
+// Allocated size of all alive arenas
+std::atomic<size_t> LogArena::totalUsedSize = 0;
+
+
+/**
+ * @brief	Constructor
+ */
+LogArena::LogArena()
+{
+	m_pCurrent = NULL;
+	m_nRemaining = 0;
+	m_nUsedSize = 0;
+	m_nReservedSize = 0;
+}
+
+/**
+ * @brief	Destructor
+ */
+LogArena::~LogArena()
+{
+	totalUsedSize.fetch_sub(m_nUsedSize, std::memory_order_relaxed);
+}
+
+/**
+ * @brief	Allocate memory from arena
+ * @param	nSize	   - Size (in bytes)
+ * @param	nAlignment - Alignment (in bytes)
+ * @return	void*
+ */
+void* LogArena::Allocate(size_t nSize, size_t nAlignment)
+{
+	std::lock_guard<std::mutex> lock(m_mtxArena);
+
+	// Align inside current block
+	void* pData = m_pCurrent;
+	size_t nSpace = m_nRemaining;
+	if ((pData == NULL) || (std::align(nAlignment, nSize, pData, nSpace) == NULL)) {
+
+		// Not enough space: add a new block (large requests get their own block)
+		size_t nNewBlockSize = (std::max)(blockSize, nSize + nAlignment);
+		m_arrBlocks.push_back(std::make_unique<BYTE[]>(nNewBlockSize));
+		m_nReservedSize += nNewBlockSize;
+
+		pData = m_arrBlocks.back().get();
+		nSpace = nNewBlockSize;
+		std::align(nAlignment, nSize, pData, nSpace);
+	}
+
+	// Take the allocated part out of free space
+	m_pCurrent = static_cast<BYTE*>(pData) + nSize;
+	m_nRemaining = nSpace - nSize;
+	m_nUsedSize += nSize;
+	totalUsedSize.fetch_add(nSize, std::memory_order_relaxed);
+
+	return pData;
+}
+
+/**
+ * @brief	Copy a string into arena
+ * @param	srcString - Source string
+ * @return	const wchar_t* - String in arena
+ */
+const wchar_t* LogArena::CopyString(const wchar_t* srcString)
+{
+	if (IS_NULL_STRING(srcString))
+		return Constant::String::Empty;
+
+	size_t nLength = wcslen(srcString);
+	wchar_t* pString = static_cast<wchar_t*>(Allocate((nLength + 1) * sizeof(wchar_t), alignof(wchar_t)));
+	wmemcpy(pString, srcString, nLength + 1);
+	return pString;
+}
+
+/**
+ * @brief	Get allocated size of arena
+ * @param	None
+ * @return	size_t
+ */
+size_t LogArena::GetUsedSize(void) const noexcept
+{
+	std::lock_guard<std::mutex> lock(m_mtxArena);
+	return m_nUsedSize;
+}
+
+/**
+ * @brief	Get total block size of arena
+ * @param	None
+ * @return	size_t
+ */
+size_t LogArena::GetReservedSize(void) const noexcept
+{
+	std::lock_guard<std::mutex> lock(m_mtxArena);
+	return m_nReservedSize;
+}
+
+/**
+ * @brief	Get the arena of current log item batch
+ * @param	None
+ * @return	std::shared_ptr<LogArena>
+ * @note	A new batch arena is started once the current one is full,
+ *			the previous one is released together with its last log item
+ */
+std::shared_ptr<LogArena> LogArena::GetCurrentBatch(void)
+{
+	static std::mutex mtxBatch;
+	static std::shared_ptr<LogArena> pCurrentBatch;
+
+	std::lock_guard<std::mutex> lock(mtxBatch);
+	if ((pCurrentBatch == NULL) || (pCurrentBatch->GetUsedSize() >= batchSize)) {
+		pCurrentBatch = std::make_shared<LogArena>();
+	}
+	return pCurrentBatch;
+}
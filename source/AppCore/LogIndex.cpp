@@ -0,0 +1,538 @@
+﻿/**
+ * @file		LogIndex.cpp
+ * @brief		Implement in-memory inverted index over log items
+ * @author		AnthonyLeeStark
+ * @date		2026.10.17
+ *
+ * @copyright 	Copyright (c) 2015-2025 AnthonyLeeStark
+ */
+
+#include "AppCore/LogIndex.h"
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+#ifdef _DEBUG
+#define new DEBUG_NEW
+#endif
+
+using namespace Language;
+
+
+// Number of entries indexed per index lock, so that queries are never blocked for long
+constexpr const size_t indexChunkSize = 1024;
+
+
+/**
+ * @brief	Convert a date/time into milliseconds since epoch
+ * @param	dateTime - Date/time
+ * @return	INT64
+ */
+static INT64 ToMillisecs(const DateTime& dateTime)
+{
+	using namespace std::chrono;
+	return duration_cast<milliseconds>(dateTime.GetTimePoint().time_since_epoch()).count();
+}
+
+/**
+ * @brief	Convert a string to lower-case
+ * @param	text - String (in/out)
+ * @return	None
+ */
+static void MakeLower(std::wstring& text)
+{
+	for (wchar_t& ch : text) ch = towlower(ch);
+}
+
+
+/**
+ * @brief	Constructor
+ */
+LogIndex::LogIndex()
+{
+	// Pending entries
+	m_nGeneration = 0;
+	m_nAddedCount.store(0);
+
+	// Item source
+	m_nSourceCount = 0;
+	m_nSourcePos = 0;
+
+	// Indexing thread
+	m_hWakeEvent = NULL;
+	m_bStopRequest.store(false);
+}
+
+/**
+ * @brief	Destructor
+ */
+LogIndex::~LogIndex()
+{
+	Stop();
+}
+
+/**
+ * @brief	Start the indexing thread
+ * @param	None
+ * @return	true/false
+ */
+bool LogIndex::Start(void)
+{
+	// Already running
+	if (IsRunning())
+		return true;
+
+	// Create wake-up event
+	m_hWakeEvent = CreateEvent(NULL, FALSE, FALSE, NULL);
+	if (m_hWakeEvent == NULL) {
+		TRACE_FORMAT("Error: Log index event creation failed!!! (Code: 0x%08X)", GetLastError());
+		TRACE_DEBUG(__FUNCTION__, __FILENAME__, __LINE__);
+		return false;
+	}
+
+	// Start indexing thread (entries added before starting are indexed first)
+	m_bStopRequest.store(false);
+	m_thrIndexer = std::thread(&LogIndex::Run, this);
+	SetEvent(m_hWakeEvent);
+
+	return true;
+}
+
+/**
+ * @brief	Stop the indexing thread
+ * @param	None
+ * @return	None
+ */
+void LogIndex::Stop(void)
+{
+	if (!IsRunning())
+		return;
+
+	m_bStopRequest.store(true);
+	SetEvent(m_hWakeEvent);
+	m_thrIndexer.join();
+
+	CloseHandle(m_hWakeEvent);
+	m_hWakeEvent = NULL;
+}
+
+/**
+ * @brief	Add a log item to be indexed
+ * @param	logItem - Log item
+ * @return	None
+ */
+void LogIndex::AddItem(const LOGITEM& logItem)
+{
+	Entry indexEntry;
+	MakeEntry(logItem, indexEntry);
+	AddEntry(std::move(indexEntry));
+}
+
+/**
+ * @brief	Add an index entry to be indexed
+ * @param	indexEntry - Index entry
+ * @return	None
+ */
+void LogIndex::AddEntry(Entry&& indexEntry)
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mtxPending);
+		m_arrPending.push_back(std::move(indexEntry));
+		m_nAddedCount++;
+	}
+
+	if (m_hWakeEvent != NULL) {
+		SetEvent(m_hWakeEvent);
+	}
+}
+
+/**
+ * @brief	Set a source of items to be read on the indexing thread
+ * @param	fnSource   - Source item reader
+ * @param	nItemCount - Number of source items
+ * @return	None
+ */
+void LogIndex::SetSource(SourceFunc fnSource, size_t nItemCount)
+{
+	{
+		std::lock_guard<std::mutex> lock(m_mtxPending);
+
+		// Source items take the first item numbers
+		ASSERT(m_nAddedCount.load() == 0);
+		m_fnSource = std::move(fnSource);
+		m_nSourceCount = (m_fnSource) ? nItemCount : 0;
+		m_nSourcePos = 0;
+		m_nAddedCount += m_nSourceCount;
+	}
+
+	if (m_hWakeEvent != NULL) {
+		SetEvent(m_hWakeEvent);
+	}
+}
+
+/**
+ * @brief	Remove all indexed and pending entries
+ * @param	None
+ * @return	None
+ */
+void LogIndex::Clear(void)
+{
+	// Lock order: index, then pending
+	std::unique_lock<std::shared_mutex> indexLock(m_mtxIndex);
+	std::lock_guard<std::mutex> pendingLock(m_mtxPending);
+
+	// Entries which are being indexed will be dropped
+	m_nGeneration++;
+	m_arrPending.clear();
+	m_nAddedCount.store(0);
+	m_fnSource = nullptr;
+	m_nSourceCount = 0;
+	m_nSourcePos = 0;
+
+	m_arrTime.clear();
+	m_arrProcessID.clear();
+	m_arrCategory.clear();
+	m_mapTokens.clear();
+	m_mapNameIDs.clear();
+	m_mapCategories.clear();
+	m_mapResourceIDs.clear();
+}
+
+/**
+ * @brief	Get number of indexed entries
+ * @param	None
+ * @return	size_t
+ */
+size_t LogIndex::GetIndexedCount(void) const
+{
+	std::shared_lock<std::shared_mutex> lock(m_mtxIndex);
+	return m_arrTime.size();
+}
+
+/**
+ * @brief	Get items which match a filter string
+ * @param	filterString - Filter string
+ * @param	ptrLanguage	 - Language package (to match category names)
+ * @param	arrResult	 - Matched item numbers, in ascending order (output)
+ * @return	size_t - Number of matched items
+ */
+size_t LogIndex::Query(const wchar_t* filterString, LANGTABLE_PTR ptrLanguage, ItemList& arrResult) const
+{
+	arrResult.clear();
+
+	// Parse filter string
+	Filter filter;
+	ParseFilter(filterString, filter);
+
+	std::shared_lock<std::shared_mutex> lock(m_mtxIndex);
+	size_t nItemCount = m_arrTime.size();
+
+	// Intersect posting lists of all terms
+	ItemList arrCandidates;
+	ItemList arrTermItems;
+	bool bHasCandidates = false;
+	auto ApplyTerm = [&](ItemList& arrItems) {
+		std::sort(arrItems.begin(), arrItems.end());
+		arrItems.erase(std::unique(arrItems.begin(), arrItems.end()), arrItems.end());
+		if (bHasCandidates == false) {
+			arrCandidates.swap(arrItems);
+			bHasCandidates = true;
+		}
+		else {
+			Intersect(arrCandidates, arrItems);
+		}
+	};
+
+	// Words: description, name ID or category name
+	std::wstring categoryName;
+	for (const std::wstring& word : filter.arrWords) {
+		arrTermItems.clear();
+		CollectPrefix(m_mapTokens, word, arrTermItems);
+		CollectPrefix(m_mapNameIDs, word, arrTermItems);
+		if (ptrLanguage != NULL) {
+			for (const auto& [usCategory, arrItems] : m_mapCategories) {
+				categoryName = GetLanguageString(ptrLanguage, usCategory);
+				MakeLower(categoryName);
+				if (categoryName.find(word) != std::wstring::npos)
+					arrTermItems.insert(arrTermItems.end(), arrItems.begin(), arrItems.end());
+			}
+		}
+		ApplyTerm(arrTermItems);
+	}
+
+	// Name IDs
+	for (const std::wstring& nameID : filter.arrNameIDs) {
+		arrTermItems.clear();
+		CollectPrefix(m_mapNameIDs, nameID, arrTermItems);
+		ApplyTerm(arrTermItems);
+	}
+
+	// Resource IDs (any of them)
+	if (!filter.arrResourceIDs.empty()) {
+		arrTermItems.clear();
+		for (int nResourceID : filter.arrResourceIDs) {
+			auto iter = m_mapResourceIDs.find(nResourceID);
+			if (iter != m_mapResourceIDs.end())
+				arrTermItems.insert(arrTermItems.end(), iter->second.begin(), iter->second.end());
+		}
+		ApplyTerm(arrTermItems);
+	}
+
+	// No indexed term: all items are candidates
+	if (bHasCandidates == false) {
+		arrCandidates.resize(nItemCount);
+		std::iota(arrCandidates.begin(), arrCandidates.end(), 0);
+	}
+
+	// Column filters: process ID and date range
+	arrResult.reserve(arrCandidates.size());
+	for (UINT nItem : arrCandidates) {
+		if ((m_arrTime[nItem] < filter.nTimeFrom) || (m_arrTime[nItem] > filter.nTimeTo))
+			continue;
+		if ((!filter.arrProcessIDs.empty()) &&
+			(std::find(filter.arrProcessIDs.begin(), filter.arrProcessIDs.end(), m_arrProcessID[nItem]) == filter.arrProcessIDs.end()))
+			continue;
+		arrResult.push_back(nItem);
+	}
+
+	return arrResult.size();
+}
+
+/**
+ * @brief	Make an index entry from a log item
+ * @param	logItem	   - Log item
+ * @param	indexEntry - Index entry (output)
+ * @return	None
+ */
+void LogIndex::MakeEntry(const LOGITEM& logItem, Entry& indexEntry)
+{
+	indexEntry.nTime = ToMillisecs(logItem.GetTime());
+	indexEntry.dwProcessID = logItem.GetProcessID();
+	indexEntry.usCategory = logItem.GetCategory();
+	indexEntry.nResourceID = INT_INVALID;
+	indexEntry.nameID.clear();
+	indexEntry.description = logItem.GetLogString().GetString();
+
+	// Detail info
+	for (const LOGDETAIL& logDetail : logItem.GetDetailInfo()) {
+		if (logDetail.GetCategory() == EventDetail::ResourceID)
+			indexEntry.nResourceID = logDetail.GetDetailValue();
+		else if (logDetail.GetCategory() == EventDetail::NameID)
+			indexEntry.nameID = logDetail.GetDetailString();
+	}
+}
+
+/**
+ * @brief	Indexing thread procedure
+ * @param	None
+ * @return	None
+ */
+void LogIndex::Run(void)
+{
+	std::vector<Entry> arrBatch;
+	while (m_bStopRequest.load() != true) {
+
+		// Take the next chunk of source items, then pending entries
+		size_t nGeneration = 0;
+		SourceFunc fnSource;
+		size_t nSourceFirst = 0;
+		{
+			std::lock_guard<std::mutex> lock(m_mtxPending);
+			nGeneration = m_nGeneration;
+			if (m_nSourcePos < m_nSourceCount) {
+				fnSource = m_fnSource;
+				nSourceFirst = m_nSourcePos;
+				m_nSourcePos = (std::min)(m_nSourcePos + indexChunkSize, m_nSourceCount);
+				arrBatch.resize(m_nSourcePos - nSourceFirst);
+			}
+			else {
+				arrBatch.swap(m_arrPending);
+			}
+		}
+
+		// Read source items without holding any lock
+		// Unreadable items are indexed empty, so that item numbers stay in order
+		if (fnSource) {
+			for (size_t nIndex = 0; nIndex < arrBatch.size(); nIndex++) {
+				if (!fnSource(nSourceFirst + nIndex, arrBatch[nIndex])) {
+					arrBatch[nIndex] = Entry{};
+					arrBatch[nIndex].nResourceID = INT_INVALID;
+				}
+			}
+		}
+
+		// Nothing to do: sleep until new entries are added
+		if (arrBatch.empty()) {
+			WaitForSingleObject(m_hWakeEvent, INFINITE);
+			continue;
+		}
+
+		// Index entries chunk by chunk
+		for (size_t nIndex = 0; (nIndex < arrBatch.size()) && (m_bStopRequest.load() != true); ) {
+			std::unique_lock<std::shared_mutex> indexLock(m_mtxIndex);
+			{
+				// Index has been cleared: drop the batch
+				std::lock_guard<std::mutex> pendingLock(m_mtxPending);
+				if (nGeneration != m_nGeneration)
+					break;
+			}
+			size_t nChunkEnd = (std::min)(nIndex + indexChunkSize, arrBatch.size());
+			for (; nIndex < nChunkEnd; nIndex++) {
+				IndexEntry(arrBatch[nIndex]);
+			}
+		}
+		arrBatch.clear();
+	}
+}
+
+/**
+ * @brief	Add an entry into the index (index lock must be held)
+ * @param	indexEntry - Index entry
+ * @return	None
+ */
+void LogIndex::IndexEntry(const Entry& indexEntry)
+{
+	UINT nItem = static_cast<UINT>(m_arrTime.size());
+
+	// Columns
+	m_arrTime.push_back(indexEntry.nTime);
+	m_arrProcessID.push_back(indexEntry.dwProcessID);
+	m_arrCategory.push_back(indexEntry.usCategory);
+
+	// Postings
+	m_mapCategories[indexEntry.usCategory].push_back(nItem);
+	if (indexEntry.nResourceID != INT_INVALID) {
+		m_mapResourceIDs[indexEntry.nResourceID].push_back(nItem);
+	}
+	if (!indexEntry.nameID.empty()) {
+		std::wstring nameID = indexEntry.nameID;
+		MakeLower(nameID);
+		m_mapNameIDs[nameID].push_back(nItem);
+	}
+
+	// Description words (each word is posted once per item)
+	std::vector<std::wstring> arrTokens;
+	Tokenize(indexEntry.description, arrTokens);
+	std::sort(arrTokens.begin(), arrTokens.end());
+	arrTokens.erase(std::unique(arrTokens.begin(), arrTokens.end()), arrTokens.end());
+	for (const std::wstring& token : arrTokens) {
+		m_mapTokens[token].push_back(nItem);
+	}
+}
+
+/**
+ * @brief	Parse a filter string
+ * @param	filterString - Filter string
+ * @param	filter		 - Parsed filter (output)
+ * @return	None
+ */
+void LogIndex::ParseFilter(const wchar_t* filterString, Filter& filter)
+{
+	filter.nTimeFrom = (std::numeric_limits<INT64>::min)();
+	filter.nTimeTo = (std::numeric_limits<INT64>::max)();
+	if (filterString == NULL)
+		return;
+
+	// Split by spaces
+	std::wstring filterText = filterString;
+	size_t nPos = 0;
+	while (nPos < filterText.size()) {
+		size_t nStart = filterText.find_first_not_of(L" \t", nPos);
+		if (nStart == std::wstring::npos) break;
+		size_t nEnd = filterText.find_first_of(L" \t", nStart);
+		if (nEnd == std::wstring::npos) nEnd = filterText.size();
+		std::wstring term = filterText.substr(nStart, nEnd - nStart);
+		MakeLower(term);
+		nPos = nEnd;
+
+		// Prefixed terms
+		size_t nSeparator = term.find(L':');
+		std::wstring termName = (nSeparator != std::wstring::npos) ? term.substr(0, nSeparator) : std::wstring();
+		std::wstring termValue = (nSeparator != std::wstring::npos) ? term.substr(nSeparator + 1) : term;
+		if ((!termName.empty()) && termValue.empty())
+			continue;
+
+		if (termName == L"id") {
+			filter.arrResourceIDs.push_back(_wtoi(termValue.c_str()));
+		}
+		else if (termName == L"name") {
+			filter.arrNameIDs.push_back(termValue);
+		}
+		else if (termName == L"pid") {
+			filter.arrProcessIDs.push_back(static_cast<DWORD>(wcstoul(termValue.c_str(), NULL, 10)));
+		}
+		else if ((termName == L"from") || (termName == L"to")) {
+			int nYear = 0, nMonth = 0, nDay = 0;
+			if (swscanf_s(termValue.c_str(), L"%d%*[/-]%d%*[/-]%d", &nYear, &nMonth, &nDay) != 3)
+				continue;
+			if (termName == L"from")
+				filter.nTimeFrom = ToMillisecs(DateTime(nYear, nMonth, nDay, 0, 0, 0, 0));
+			else
+				filter.nTimeTo = ToMillisecs(DateTime(nYear, nMonth, nDay, 23, 59, 59, 999));
+		}
+		else {
+			// Plain words (split the same way as descriptions)
+			Tokenize(term, filter.arrWords);
+		}
+	}
+}
+
+/**
+ * @brief	Split a text into lower-case words
+ * @param	text	  - Text
+ * @param	arrTokens - Words (appended)
+ * @return	None
+ */
+void LogIndex::Tokenize(const std::wstring& text, std::vector<std::wstring>& arrTokens)
+{
+	std::wstring token;
+	for (wchar_t ch : text) {
+		if (iswalnum(ch)) {
+			token.push_back(towlower(ch));
+		}
+		else if (!token.empty()) {
+			arrTokens.push_back(token);
+			token.clear();
+		}
+	}
+	if (!token.empty()) {
+		arrTokens.push_back(token);
+	}
+}
+
+/**
+ * @brief	Keep only items which also exist in another sorted list
+ * @param	arrItems - Sorted item list (in/out)
+ * @param	arrOther - Sorted item list
+ * @return	None
+ */
+void LogIndex::Intersect(ItemList& arrItems, const ItemList& arrOther)
+{
+	// Compact in place (std::set_intersection must not write into one of its inputs)
+	size_t nOutPos = 0;
+	auto iterOther = arrOther.begin();
+	for (size_t nPos = 0; (nPos < arrItems.size()) && (iterOther != arrOther.end()); nPos++) {
+		while ((iterOther != arrOther.end()) && (*iterOther < arrItems[nPos]))
+			iterOther++;
+		if ((iterOther != arrOther.end()) && (*iterOther == arrItems[nPos]))
+			arrItems[nOutPos++] = arrItems[nPos];
+	}
+	arrItems.resize(nOutPos);
+}
+
+/**
+ * @brief	Collect postings of all keys which start with a prefix
+ * @param	mapPostings - Sorted postings
+ * @param	prefix		- Key prefix
+ * @param	arrItems	- Item list (appended, unsorted)
+ * @return	None
+ */
+void LogIndex::CollectPrefix(const std::map<std::wstring, ItemList>& mapPostings, const std::wstring& prefix, ItemList& arrItems)
+{
+	for (auto iter = mapPostings.lower_bound(prefix); iter != mapPostings.end(); iter++) {
+		if (iter->first.compare(0, prefix.size(), prefix) != 0)
+			break;
+		arrItems.insert(arrItems.end(), iter->second.begin(), iter->second.end());
+	}
+}
@@ -0,0 +1,418 @@
+﻿/**
+ * @file		LogJournal.cpp
+ * @brief		Implement log journal file
+ * @author		AnthonyLeeStark
+ * @date		2026.10.17
+ *
+ * @copyright 	Copyright (c) 2015-2025 AnthonyLeeStark
+ */
+
+#include "AppCore/LogJournal.h"
+#include "AppCore/SettingsStore.h"
+
+#include <algorithm>
+#include <tuple>
+
+#ifdef _DEBUG
+#define new DEBUG_NEW
+#endif
+
+
+// Checksum range starts right after checksum field
+constexpr const size_t checksumOffset = offsetof(LogJournal::RECORDHEADER, wType);
+
+
+/**
+ * @brief	Append/read binary data to/from record data buffer
+ * @param	buffer	- Data buffer
+ * @param	value	- Value
+ * @param	text	- String value
+ * @param	nOffset	- Read offset (in/out)
+ * @return	true/false
+ */
+template <typename T>
+static void AppendValue(std::vector<BYTE>& buffer, T value)
+{
+	const BYTE* pData = reinterpret_cast<const BYTE*>(&value);
+	buffer.insert(buffer.end(), pData, pData + sizeof(T));
+}
+
+static void AppendText(std::vector<BYTE>& buffer, const wchar_t* text)
+{
+	size_t nLength = IS_NULL_STRING(text) ? 0 : wcslen(text);
+	AppendValue(buffer, static_cast<DWORD>(nLength));
+	const BYTE* pData = reinterpret_cast<const BYTE*>(text);
+	if (nLength > 0) buffer.insert(buffer.end(), pData, pData + nLength * sizeof(wchar_t));
+}
+
+template <typename T>
+static bool ReadValue(const BYTE* pData, size_t nSize, size_t& nOffset, T& value)
+{
+	if ((nOffset + sizeof(T)) > nSize) return false;
+	memcpy(&value, pData + nOffset, sizeof(T));
+	nOffset += sizeof(T);
+	return true;
+}
+
+static bool ReadText(const BYTE* pData, size_t nSize, size_t& nOffset, std::wstring& text)
+{
+	DWORD dwLength = 0;
+	if (!ReadValue(pData, nSize, nOffset, dwLength)) return false;
+	if ((nOffset + static_cast<size_t>(dwLength) * sizeof(wchar_t)) > nSize) return false;
+	text.assign(reinterpret_cast<const wchar_t*>(pData + nOffset), dwLength);
+	nOffset += static_cast<size_t>(dwLength) * sizeof(wchar_t);
+	return true;
+}
+
+
+/**
+ * @brief	Constructor
+ */
+LogJournal::LogJournal()
+{
+	// Journal file
+	m_strFilePath = Constant::String::Empty;
+	m_hFile = INVALID_HANDLE_VALUE;
+	m_ullFileSize = 0;
+}
+
+/**
+ * @brief	Destructor
+ */
+LogJournal::~LogJournal()
+{
+	// Keep the file for next startup (items might not be written)
+	if (m_hFile != INVALID_HANDLE_VALUE) {
+		CloseHandle(m_hFile);
+		m_hFile = INVALID_HANDLE_VALUE;
+	}
+}
+
+/**
+ * @brief	Create an empty journal file
+ * @param	filePath - Journal file path
+ * @return	true/false
+ */
+bool LogJournal::Create(const wchar_t* filePath)
+{
+	std::lock_guard<std::mutex> lock(m_mtxJournal);
+
+	if (m_hFile != INVALID_HANDLE_VALUE) {
+		CloseHandle(m_hFile);
+	}
+
+	// Open once and append sequentially for the whole session
+	m_strFilePath = filePath;
+	m_hFile = CreateFile(filePath, GENERIC_WRITE, FILE_SHARE_READ, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+	m_ullFileSize = 0;
+	if (m_hFile == INVALID_HANDLE_VALUE) {
+		TRACE_FORMAT("Error: Create log journal file failed!!! (Code: 0x%08X)", GetLastError());
+		return false;
+	}
+
+	m_arrRecordBuff.reserve(sizeof(RECORDHEADER) + 256);
+	return true;
+}
+
+/**
+ * @brief	Close and remove the journal file
+ * @param	None
+ * @return	None
+ */
+void LogJournal::Remove(void)
+{
+	std::lock_guard<std::mutex> lock(m_mtxJournal);
+
+	if (m_hFile == INVALID_HANDLE_VALUE)
+		return;
+
+	CloseHandle(m_hFile);
+	m_hFile = INVALID_HANDLE_VALUE;
+	m_ullFileSize = 0;
+	DeleteFile(m_strFilePath);
+}
+
+/**
+ * @brief	Append a log item record
+ * @param	nSequence - Item sequence number
+ * @param	logItem	  - Log item
+ * @return	true/false
+ */
+bool LogJournal::AppendItem(size_t nSequence, const LOGITEM& logItem)
+{
+	std::lock_guard<std::mutex> lock(m_mtxJournal);
+
+	if (m_hFile == INVALID_HANDLE_VALUE)
+		return false;
+
+	// Serialize item data after header
+	m_arrRecordBuff.resize(sizeof(RECORDHEADER));
+	SerializeItem(logItem, m_arrRecordBuff);
+
+	return AppendRecord(Item, nSequence);
+}
+
+/**
+ * @brief	Mark items before a sequence number as written, or empty the journal
+ *			if no other item is queued and the journal is large enough
+ * @param	nWrittenCount - Number of written items (sequence number of the first unwritten item)
+ * @param	nQueuedCount  - Number of items queued so far (current value is checked under journal lock)
+ * @return	true/false
+ */
+bool LogJournal::AppendCheckpoint(size_t nWrittenCount, const std::atomic<size_t>& nQueuedCount)
+{
+	std::lock_guard<std::mutex> lock(m_mtxJournal);
+
+	if (m_hFile == INVALID_HANDLE_VALUE)
+		return false;
+
+	// An item is queued before it is appended (under this lock),
+	// so if the queued count matches here, there is no record which is not written yet
+	if ((m_ullFileSize >= truncateSize) && (nQueuedCount.load() == nWrittenCount))
+		return Truncate();
+
+	m_arrRecordBuff.resize(sizeof(RECORDHEADER));
+	return AppendRecord(Checkpoint, nWrittenCount);
+}
+
+/**
+ * @brief	Mark a range of items as written into some output files
+ * @param	nSequence	 - Sequence number of the first item
+ * @param	nCount		 - Number of items
+ * @param	wOutputFiles - Output files which have the items (OutputFile flags)
+ * @return	true/false
+ */
+bool LogJournal::AppendWritten(size_t nSequence, size_t nCount, WORD wOutputFiles)
+{
+	std::lock_guard<std::mutex> lock(m_mtxJournal);
+
+	if (m_hFile == INVALID_HANDLE_VALUE)
+		return false;
+
+	m_arrRecordBuff.resize(sizeof(RECORDHEADER));
+	AppendValue(m_arrRecordBuff, static_cast<ULONGLONG>(nCount));
+	AppendValue(m_arrRecordBuff, wOutputFiles);
+	return AppendRecord(Written, nSequence);
+}
+
+/**
+ * @brief	Get journal file path of a log type
+ * @param	byLogType  - Log type
+ * @param	folderPath - Log folder path
+ * @return	String
+ */
+String LogJournal::GetFilePath(byte byLogType, const wchar_t* folderPath)
+{
+	String fileName;
+	fileName.Format(Constant::File::Name::LogJournal, byLogType);
+	return StringUtils::MakeFilePath(folderPath, fileName, Constant::File::Extension::LogJournal);
+}
+
+/**
+ * @brief	Read items of a journal file which are not written into log files yet
+ * @param	filePath		 - Journal file path
+ * @param	arrLogData		 - Log items (output, in sequence order)
+ * @param	pArrWrittenFiles - Output files which already have each item (output, OutputFile flags, optional)
+ * @return	true/false - false if the journal file can not be read
+ */
+bool LogJournal::ReadItems(const wchar_t* filePath, LOGDATA& arrLogData, std::vector<WORD>* pArrWrittenFiles /* = NULL */)
+{
+	HANDLE hFile = CreateFile(filePath, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+	if (hFile == INVALID_HANDLE_VALUE) return false;
+
+	// Read whole file
+	std::vector<BYTE> fileBuffer;
+	LARGE_INTEGER liFileSize{};
+	bool bRet = (GetFileSizeEx(hFile, &liFileSize) != FALSE);
+	bRet &= (liFileSize.QuadPart <= maxFileSize);
+	if (bRet == true) {
+		DWORD dwRead = 0;
+		fileBuffer.resize(static_cast<size_t>(liFileSize.QuadPart));
+		bRet = (ReadFile(hFile, fileBuffer.data(), static_cast<DWORD>(fileBuffer.size()), &dwRead, NULL) != FALSE);
+		bRet &= (dwRead == fileBuffer.size());
+	}
+	CloseHandle(hFile);
+	if (bRet == false) return false;
+
+	// Walk through records until the end or the first torn/corrupted record
+	std::vector<std::pair<ULONGLONG, LOGITEM>> arrItemRecords;
+	std::vector<std::tuple<ULONGLONG, ULONGLONG, WORD>> arrWrittenRanges;
+	ULONGLONG ullWrittenCount = 0;
+	size_t nOffset = 0;
+	while ((nOffset + sizeof(RECORDHEADER)) <= fileBuffer.size()) {
+		RECORDHEADER header{};
+		memcpy(&header, fileBuffer.data() + nOffset, sizeof(RECORDHEADER));
+		if ((header.dwMagic != recordMagic) || (header.wHeaderSize != sizeof(RECORDHEADER)) || (header.dwDataSize > maxRecordSize))
+			break;
+		if ((nOffset + header.wHeaderSize + header.dwDataSize) > fileBuffer.size())
+			break;
+
+		const BYTE* pRecord = fileBuffer.data() + nOffset;
+		if (SettingsStore::Checksum(pRecord + checksumOffset, header.wHeaderSize + header.dwDataSize - checksumOffset) != header.dwChecksum)
+			break;
+
+		if (header.wType == Item) {
+			LOGITEM logItem;
+			if (DeserializeItem(pRecord + header.wHeaderSize, header.dwDataSize, logItem)) {
+				arrItemRecords.emplace_back(header.ullSequence, std::move(logItem));
+			}
+		}
+		else if (header.wType == Checkpoint) {
+			ullWrittenCount = (std::max)(ullWrittenCount, header.ullSequence);
+		}
+		else if (header.wType == Written) {
+			size_t nDataOffset = 0;
+			ULONGLONG ullCount = 0;
+			WORD wOutputFiles = 0;
+			if (ReadValue(pRecord + header.wHeaderSize, header.dwDataSize, nDataOffset, ullCount) &&
+				ReadValue(pRecord + header.wHeaderSize, header.dwDataSize, nDataOffset, wOutputFiles)) {
+				arrWrittenRanges.emplace_back(header.ullSequence, header.ullSequence + ullCount, wOutputFiles);
+			}
+		}
+		nOffset += header.wHeaderSize + header.dwDataSize;
+	}
+
+	// Take items which are not written yet
+	std::stable_sort(arrItemRecords.begin(), arrItemRecords.end(), [](const auto& first, const auto& second) {
+		return (first.first < second.first);
+	});
+	for (auto& itemRecord : arrItemRecords) {
+		if (itemRecord.first < ullWrittenCount)
+			continue;
+
+		// Output files which already have the item
+		WORD wWrittenFiles = 0;
+		for (const auto& [ullFirst, ullEnd, wOutputFiles] : arrWrittenRanges) {
+			if ((itemRecord.first >= ullFirst) && (itemRecord.first < ullEnd))
+				wWrittenFiles |= wOutputFiles;
+		}
+		if ((wWrittenFiles & AllFiles) == AllFiles)
+			continue;
+
+		arrLogData.push_back(std::move(itemRecord.second));
+		if (pArrWrittenFiles != NULL) pArrWrittenFiles->push_back(wWrittenFiles);
+	}
+
+	return true;
+}
+
+/**
+ * @brief	Complete the record in record buffer and append it with one write (journal lock must be held)
+ * @param	wType	  - Record type
+ * @param	nSequence - Sequence number
+ * @return	true/false
+ */
+bool LogJournal::AppendRecord(WORD wType, size_t nSequence)
+{
+	RECORDHEADER header{};
+	header.dwMagic = recordMagic;
+	header.wType = wType;
+	header.wHeaderSize = static_cast<WORD>(sizeof(RECORDHEADER));
+	header.dwDataSize = static_cast<DWORD>(m_arrRecordBuff.size() - sizeof(RECORDHEADER));
+	header.ullSequence = nSequence;
+	memcpy(m_arrRecordBuff.data(), &header, sizeof(RECORDHEADER));
+
+	// Checksum covers the rest of header and data
+	header.dwChecksum = SettingsStore::Checksum(m_arrRecordBuff.data() + checksumOffset, m_arrRecordBuff.size() - checksumOffset);
+	memcpy(m_arrRecordBuff.data() + offsetof(RECORDHEADER, dwChecksum), &header.dwChecksum, sizeof(DWORD));
+
+	DWORD dwWritten = 0;
+	if (!WriteFile(m_hFile, m_arrRecordBuff.data(), static_cast<DWORD>(m_arrRecordBuff.size()), &dwWritten, NULL) ||
+		(dwWritten != m_arrRecordBuff.size())) {
+		return false;
+	}
+
+	m_ullFileSize += dwWritten;
+	return true;
+}
+
+/**
+ * @brief	Empty the journal file (journal lock must be held)
+ * @param	None
+ * @return	true/false
+ */
+bool LogJournal::Truncate(void)
+{
+	LARGE_INTEGER liOffset{};
+	if (!SetFilePointerEx(m_hFile, liOffset, NULL, FILE_BEGIN) || !SetEndOfFile(m_hFile))
+		return false;
+
+	m_ullFileSize = 0;
+	return true;
+}
+
+/**
+ * @brief	Serialize log item data (read-only details are not stored, same as log files)
+ * @param	logItem - Log item
+ * @param	buffer	- Data buffer (data is appended)
+ * @return	None
+ */
+void LogJournal::SerializeItem(const LOGITEM& logItem, std::vector<BYTE>& buffer)
+{
+	// Log item base info
+	using namespace std::chrono;
+	AppendValue(buffer, static_cast<INT64>(duration_cast<milliseconds>(logItem.GetTime().GetTimePoint().time_since_epoch()).count()));
+	AppendValue(buffer, logItem.GetProcessID());
+	AppendValue(buffer, logItem.GetCategory());
+	AppendText(buffer, logItem.GetLogString());
+
+	// Log item detail info
+	const LOGDETAILINFO& logDetailInfo = logItem.GetDetailInfo();
+	DWORD dwDetailCount = 0;
+	for (const LOGDETAIL& logDetail : logDetailInfo) {
+		if (!(logDetail.GetFlag() & LogDetailFlag::ReadOnly_Data)) dwDetailCount++;
+	}
+	AppendValue(buffer, dwDetailCount);
+
+	for (const LOGDETAIL& logDetail : logDetailInfo) {
+
+		// Skip if detail item is read-only
+		if (logDetail.GetFlag() & LogDetailFlag::ReadOnly_Data)
+			continue;
+
+		AppendValue(buffer, logDetail.GetCategory());
+		AppendValue(buffer, static_cast<USHORT>(logDetail.GetFlag()));
+		AppendValue(buffer, static_cast<INT>(logDetail.GetDetailValue()));
+		AppendText(buffer, logDetail.GetDetailString());
+	}
+}
+
+/**
+ * @brief	Deserialize log item data
+ * @param	pData	- Record data
+ * @param	nSize	- Record data size
+ * @param	logItem - Log item (output)
+ * @return	true/false
+ */
+bool LogJournal::DeserializeItem(const BYTE* pData, size_t nSize, LOGITEM& logItem)
+{
+	size_t nOffset = 0;
+	INT64 llTime = 0;
+	DWORD dwProcessID = 0, dwDetailCount = 0;
+	USHORT usCategory = 0;
+	std::wstring text;
+
+	// Log item base info
+	if (!ReadValue(pData, nSize, nOffset, llTime) || !ReadValue(pData, nSize, nOffset, dwProcessID) ||
+		!ReadValue(pData, nSize, nOffset, usCategory) || !ReadText(pData, nSize, nOffset, text))
+		return false;
+
+	logItem.SetTime(DateTime(std::chrono::system_clock::time_point(std::chrono::milliseconds(llTime))));
+	logItem.SetProcessID(dwProcessID);
+	logItem.SetCategory(usCategory);
+	logItem.SetLogString(text.c_str());
+
+	// Log item detail info
+	if (!ReadValue(pData, nSize, nOffset, dwDetailCount)) return false;
+	for (DWORD dwIndex = 0; dwIndex < dwDetailCount; dwIndex++) {
+		USHORT usDetailCategory = 0, usFlag = 0;
+		INT nValue = 0;
+		if (!ReadValue(pData, nSize, nOffset, usDetailCategory) || !ReadValue(pData, nSize, nOffset, usFlag) ||
+			!ReadValue(pData, nSize, nOffset, nValue) || !ReadText(pData, nSize, nOffset, text))
+			return false;
+
+		logItem.AddDetail(usDetailCategory, nValue, text.c_str(), usFlag);
+	}
+
+	return true;
+}
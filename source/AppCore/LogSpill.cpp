@@ -0,0 +1,300 @@
+﻿/**
+ * @file		LogSpill.cpp
+ * @brief		Implement log spill file
+ * @author		AnthonyLeeStark
+ * @date		2026.10.17
+ *
+ * @copyright 	Copyright (c) 2015-2025 AnthonyLeeStark
+ */
+
+#include "AppCore/LogSpill.h"
+
+#ifdef _DEBUG
+#define new DEBUG_NEW
+#endif
+
+
+/**
+ * @brief	Constructor
+ * @param	byLogType - Log type
+ */
+LogSpill::LogSpill(byte byLogType)
+{
+	// Each log data instance gets its own spill file
+	static std::atomic<int> nInstanceCount = 0;
+
+	// Properties
+	m_byLogType = byLogType;
+	m_dwLastError.store(APP_ERROR_SUCCESS);
+
+	// Spill file path (in log folder)
+	String fileName;
+	fileName.Format(Constant::File::Name::LogSpill, byLogType, nInstanceCount.fetch_add(1));
+	String folderPath = StringUtils::GetSubFolderPath(Constant::Folder::Log);
+	m_strFilePath = StringUtils::MakeFilePath(folderPath, fileName, Constant::File::Extension::LogSpill);
+
+	// Spilled data
+	m_nSpilledCount = 0;
+	m_nWrittenCount.store(0);
+
+	// Spill thread
+	m_hWakeEvent = NULL;
+	m_bStopRequest.store(false);
+}
+
+/**
+ * @brief	Destructor
+ */
+LogSpill::~LogSpill()
+{
+	// Spill file is not kept after the log data is destroyed
+	Reset();
+}
+
+/**
+ * @brief	Start the spill thread
+ * @param	None
+ * @return	true/false
+ */
+bool LogSpill::Start(void)
+{
+	// Already running
+	if (IsRunning())
+		return true;
+
+	// Create wake-up event
+	m_hWakeEvent = CreateEvent(NULL, FALSE, FALSE, NULL);
+	if (m_hWakeEvent == NULL) {
+		TRACE_FORMAT("Error: Log spill event creation failed!!! (Code: 0x%08X)", GetLastError());
+		TRACE_DEBUG(__FUNCTION__, __FILENAME__, __LINE__);
+		return false;
+	}
+
+	// Start spill thread
+	m_bStopRequest.store(false);
+	m_thrSpill = std::thread(&LogSpill::Run, this);
+
+	return true;
+}
+
+/**
+ * @brief	Write all pending segments and stop the spill thread
+ * @param	None
+ * @return	None
+ */
+void LogSpill::Stop(void)
+{
+	if (!IsRunning())
+		return;
+
+	// Request stop and wait for the spill thread to exit
+	m_bStopRequest.store(true);
+	SetEvent(m_hWakeEvent);
+	m_thrSpill.join();
+
+	CloseHandle(m_hWakeEvent);
+	m_hWakeEvent = NULL;
+}
+
+/**
+ * @brief	Remove all spilled data and the spill file
+ * @param	None
+ * @return	None
+ */
+void LogSpill::Reset(void)
+{
+	// Drop pending segments first, so that the spill thread does not write them
+	{
+		std::lock_guard<std::mutex> lock(m_mtxSpill);
+		m_arrPending.clear();
+	}
+	Stop();
+
+	// Close reader and remove spill file
+	{
+		std::lock_guard<std::mutex> lock(m_mtxReader);
+		m_spillReader.Close();
+	}
+	DeleteFile(m_strFilePath);
+
+	std::lock_guard<std::mutex> lock(m_mtxSpill);
+	m_nSpilledCount = 0;
+	m_nWrittenCount.store(0);
+}
+
+/**
+ * @brief	Hand a segment over to the spill thread
+ * @param	segment - Spilled segment (data is moved)
+ * @return	None
+ */
+void LogSpill::AddSegment(SEGMENT&& segment)
+{
+	if (segment.empty())
+		return;
+
+	// Segment stays readable in memory until it is written
+	{
+		std::lock_guard<std::mutex> lock(m_mtxSpill);
+		m_nSpilledCount += segment.size();
+		m_arrPending.push_back(std::make_shared<SEGMENT>(std::move(segment)));
+	}
+
+	// Start spill thread on first use
+	// If it can not be started, spilled items are kept in memory
+	if (!IsRunning() && !Start())
+		return;
+
+	SetEvent(m_hWakeEvent);
+}
+
+/**
+ * @brief	Read a spilled item
+ * @param	nIndex	- Item index (counted from the first spilled item)
+ * @param	logItem - Log item (output)
+ * @return	true/false
+ */
+bool LogSpill::ReadItem(size_t nIndex, LOGITEM& logItem) const
+{
+	// Item is not written yet: copy it from pending segments
+	{
+		std::lock_guard<std::mutex> lock(m_mtxSpill);
+		size_t nWrittenCount = m_nWrittenCount.load();
+		if (nIndex >= nWrittenCount) {
+			size_t nOffset = nIndex - nWrittenCount;
+			for (const PSEGMENT& pSegment : m_arrPending) {
+				if (nOffset < pSegment->size()) {
+					logItem.Copy(pSegment->at(nOffset));
+					return true;
+				}
+				nOffset -= pSegment->size();
+			}
+			return false;
+		}
+	}
+
+	// Map the spill file again if it has grown since last time
+	std::lock_guard<std::mutex> lock(m_mtxReader);
+	if (nIndex >= m_spillReader.GetItemCount()) {
+		m_spillReader.Close();
+		if (!m_spillReader.Open(m_strFilePath))
+			return false;
+	}
+
+	return m_spillReader.ReadLogItem(nIndex, logItem);
+}
+
+/**
+ * @brief	Get number of spilled items
+ * @param	None
+ * @return	size_t
+ */
+size_t LogSpill::GetSpilledCount(void) const
+{
+	std::lock_guard<std::mutex> lock(m_mtxSpill);
+	return m_nSpilledCount;
+}
+
+/**
+ * @brief	Spill thread procedure
+ * @param	None
+ * @return	None
+ */
+void LogSpill::Run(void)
+{
+	for (;;) {
+		// Sleep until a segment is handed over or a stop is requested
+		WaitForSingleObject(m_hWakeEvent, INFINITE);
+		bool bStopRequest = m_bStopRequest.load();
+
+		// Write all pending segments
+		WritePendingSegments();
+
+		if (bStopRequest == true)
+			break;
+	}
+
+	if (m_fSpillFile.m_hFile != CFile::hFileNull) {
+		m_fSpillFile.Close();
+	}
+}
+
+/**
+ * @brief	Write pending segments in order (spill thread only)
+ * @param	None
+ * @return	None
+ */
+void LogSpill::WritePendingSegments(void)
+{
+	for (;;) {
+		// Take the oldest segment (it stays in the pending list while being written)
+		PSEGMENT pSegment;
+		{
+			std::lock_guard<std::mutex> lock(m_mtxSpill);
+			if (m_arrPending.empty())
+				break;
+			pSegment = m_arrPending.front();
+		}
+
+		// Keep failed segment in memory, it will be written again next time
+		if (!WriteSegment(*pSegment))
+			break;
+
+		// Release segment memory (unless it was dropped by Reset)
+		std::lock_guard<std::mutex> lock(m_mtxSpill);
+		if (!m_arrPending.empty() && (m_arrPending.front() == pSegment)) {
+			m_nWrittenCount.fetch_add(pSegment->size());
+			m_arrPending.pop_front();
+		}
+	}
+}
+
+/**
+ * @brief	Append a segment to the spill file as one log store block (spill thread only)
+ * @param	segment - Spilled segment
+ * @return	true/false
+ */
+bool LogSpill::WriteSegment(const SEGMENT& segment)
+{
+	// Check if file is opening, if not, create it
+	if (m_fSpillFile.m_hFile == CFile::hFileNull) {
+		if (!m_fSpillFile.Open(m_strFilePath, CFile::modeCreate | CFile::modeWrite | CFile::shareDenyWrite)) {
+			// Open file failed --> Keep error code for the caller thread to report
+			m_dwLastError.store(GetLastError());
+			return false;
+		}
+	}
+
+	// Build block data (read-only details are not stored, same as log files)
+	m_storeBlock.Clear();
+	for (const LOGITEM& logItem : segment) {
+		m_storeBlock.AddItem(logItem);
+	}
+
+	// Go to end of file
+	ULONGLONG ullFileLength = 0;
+	TRY {
+		ullFileLength = m_fSpillFile.SeekToEnd();
+	}
+	CATCH(CFileException, pException) {
+		m_dwLastError.store(pException->m_lOsError);
+		return false;
+	}
+	END_CATCH
+
+	// Write the whole block at once
+	if (!m_storeBlock.Write(m_fSpillFile)) {
+		m_dwLastError.store(APP_ERROR_FAILED);
+
+		// Cut off partially written data, so that the next blocks can still be read
+		TRY {
+			m_fSpillFile.SetLength(ullFileLength);
+		}
+		CATCH(CFileException, pException) {
+			m_dwLastError.store(pException->m_lOsError);
+		}
+		END_CATCH
+		return false;
+	}
+
+	return true;
+}
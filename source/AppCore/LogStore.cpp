@@ -0,0 +1,675 @@
+﻿/**
+ * @file		LogStore.cpp
+ * @brief		Implement binary columnar log store and its memory-mapped reader
+ * @author		AnthonyLeeStark
+ * @date		2026.10.17
+ *
+ * @copyright 	Copyright (c) 2015-2025 AnthonyLeeStark
+ */
+
+#include "AppCore/LogStore.h"
+
+#ifdef _DEBUG
+#define new DEBUG_NEW
+#endif
+
+using namespace Language;
+using namespace MapTable;
+
+
+/**
+ * @brief	Round up a size to column alignment
+ * @param	nSize - Size (in bytes)
+ * @return	size_t - Aligned size
+ */
+static constexpr size_t AlignColumn(size_t nSize) noexcept
+{
+	return ((nSize + (LogStore::columnAlignment - 1)) & ~(LogStore::columnAlignment - 1));
+}
+
+/**
+ * @brief	Calculate column layout of a block
+ * @param	nItemCount		- Number of log items
+ * @param	nDetailCount	- Number of detail items
+ * @param	nStringPoolSize	- String pool size (in characters)
+ * @param	layout			- Column layout (output)
+ * @return	None
+ */
+void LogStore::GetColumnLayout(size_t nItemCount, size_t nDetailCount, size_t nStringPoolSize, COLUMNLAYOUT& layout) noexcept
+{
+	size_t nOffset = AlignColumn(sizeof(BLOCKHEADER));
+
+	// Log item columns
+	layout.nTime = nOffset;				nOffset += AlignColumn(nItemCount * sizeof(INT64));
+	layout.nProcessID = nOffset;		nOffset += AlignColumn(nItemCount * sizeof(DWORD));
+	layout.nCategory = nOffset;			nOffset += AlignColumn(nItemCount * sizeof(USHORT));
+	layout.nDescription = nOffset;		nOffset += AlignColumn(nItemCount * sizeof(DWORD));
+	layout.nDetailEnd = nOffset;		nOffset += AlignColumn(nItemCount * sizeof(DWORD));
+
+	// Detail item columns
+	layout.nDetailCategory = nOffset;	nOffset += AlignColumn(nDetailCount * sizeof(USHORT));
+	layout.nDetailFlag = nOffset;		nOffset += AlignColumn(nDetailCount * sizeof(USHORT));
+	layout.nDetailValue = nOffset;		nOffset += AlignColumn(nDetailCount * sizeof(INT));
+	layout.nDetailString = nOffset;		nOffset += AlignColumn(nDetailCount * sizeof(DWORD));
+
+	// String pool
+	layout.nStringPool = nOffset;		nOffset += AlignColumn(nStringPoolSize * sizeof(wchar_t));
+	layout.nBlockSize = nOffset;
+}
+
+
+/**
+ * @brief	Remove all items (keep allocated memory for next blocks)
+ * @param	None
+ * @return	None
+ */
+void LogStoreBlock::Clear(void) noexcept
+{
+	m_arrTime.clear();
+	m_arrProcessID.clear();
+	m_arrCategory.clear();
+	m_arrDescription.clear();
+	m_arrDetailEnd.clear();
+	m_arrDetailCategory.clear();
+	m_arrDetailFlag.clear();
+	m_arrDetailValue.clear();
+	m_arrDetailString.clear();
+	m_arrStringPool.clear();
+	m_mapStringOffset.clear();
+}
+
+/**
+ * @brief	Add a log item into the block
+ * @param	logItem - Log item
+ * @return	None
+ */
+void LogStoreBlock::AddItem(const LOGITEM& logItem)
+{
+	// Log item base info
+	using namespace std::chrono;
+	m_arrTime.push_back(duration_cast<milliseconds>(logItem.GetTime().GetTimePoint().time_since_epoch()).count());
+	m_arrProcessID.push_back(logItem.GetProcessID());
+	m_arrCategory.push_back(logItem.GetCategory());
+	m_arrDescription.push_back(AddString(logItem.GetLogString()));
+
+	// Log item detail info
+	for (const LOGDETAIL& logDetail : logItem.GetDetailInfo()) {
+
+		// Skip if detail item is read-only
+		if (logDetail.GetFlag() & LogDetailFlag::ReadOnly_Data)
+			continue;
+
+		m_arrDetailCategory.push_back(logDetail.GetCategory());
+		m_arrDetailFlag.push_back(static_cast<USHORT>(logDetail.GetFlag()));
+		m_arrDetailValue.push_back(logDetail.GetDetailValue());
+		m_arrDetailString.push_back(IS_NULL_STRING(logDetail.GetDetailString()) ? LogStore::nullString : AddString(logDetail.GetDetailString()));
+	}
+	m_arrDetailEnd.push_back(static_cast<DWORD>(m_arrDetailCategory.size()));
+}
+
+/**
+ * @brief	Write the block at the end of a file
+ * @param	storeFile - Opening store file
+ * @return	true/false
+ */
+bool LogStoreBlock::Write(CFile& storeFile)
+{
+	if (IsEmpty())
+		return true;
+
+	// Calculate block layout
+	LogStore::COLUMNLAYOUT layout;
+	LogStore::GetColumnLayout(m_arrTime.size(), m_arrDetailCategory.size(), m_arrStringPool.size(), layout);
+
+	// Prepare block header
+	LogStore::BLOCKHEADER blockHeader{};
+	blockHeader.dwMagic = LogStore::blockMagic;
+	blockHeader.wVersion = LogStore::formatVersion;
+	blockHeader.wHeaderSize = static_cast<WORD>(sizeof(LogStore::BLOCKHEADER));
+	blockHeader.dwBlockSize = static_cast<DWORD>(layout.nBlockSize);
+	blockHeader.dwItemCount = static_cast<DWORD>(m_arrTime.size());
+	blockHeader.dwDetailCount = static_cast<DWORD>(m_arrDetailCategory.size());
+	blockHeader.dwStringPoolSize = static_cast<DWORD>(m_arrStringPool.size());
+
+	// Serialize columns (padding bytes are zero-filled)
+	m_arrOutputBuff.assign(layout.nBlockSize, 0);
+	auto CopyColumn = [this](size_t nOffset, const void* pData, size_t nSize) {
+		if (nSize > 0) memcpy(m_arrOutputBuff.data() + nOffset, pData, nSize);
+	};
+	CopyColumn(0, &blockHeader, sizeof(blockHeader));
+	CopyColumn(layout.nTime, m_arrTime.data(), m_arrTime.size() * sizeof(INT64));
+	CopyColumn(layout.nProcessID, m_arrProcessID.data(), m_arrProcessID.size() * sizeof(DWORD));
+	CopyColumn(layout.nCategory, m_arrCategory.data(), m_arrCategory.size() * sizeof(USHORT));
+	CopyColumn(layout.nDescription, m_arrDescription.data(), m_arrDescription.size() * sizeof(DWORD));
+	CopyColumn(layout.nDetailEnd, m_arrDetailEnd.data(), m_arrDetailEnd.size() * sizeof(DWORD));
+	CopyColumn(layout.nDetailCategory, m_arrDetailCategory.data(), m_arrDetailCategory.size() * sizeof(USHORT));
+	CopyColumn(layout.nDetailFlag, m_arrDetailFlag.data(), m_arrDetailFlag.size() * sizeof(USHORT));
+	CopyColumn(layout.nDetailValue, m_arrDetailValue.data(), m_arrDetailValue.size() * sizeof(INT));
+	CopyColumn(layout.nDetailString, m_arrDetailString.data(), m_arrDetailString.size() * sizeof(DWORD));
+	CopyColumn(layout.nStringPool, m_arrStringPool.data(), m_arrStringPool.size() * sizeof(wchar_t));
+
+	// Write whole block at once
+	TRY {
+		storeFile.Write(m_arrOutputBuff.data(), static_cast<UINT>(m_arrOutputBuff.size()));
+		storeFile.Flush();
+	}
+	CATCH(CFileException, pException) {
+		TRACE_FORMAT("Error: Write log store block failed!!! (Code: 0x%08X)", pException->m_lOsError);
+		TRACE_DEBUG(__FUNCTION__, __FILENAME__, __LINE__);
+		return false;
+	}
+	END_CATCH
+
+	return true;
+}
+
+/**
+ * @brief	Add a string into the string pool
+ * @param	stringValue - String value
+ * @return	DWORD - String pool offset
+ */
+DWORD LogStoreBlock::AddString(const wchar_t* stringValue)
+{
+	if (stringValue == NULL)
+		return LogStore::nullString;
+
+	// Each string is stored only once per block
+	auto result = m_mapStringOffset.try_emplace(std::wstring(stringValue), static_cast<DWORD>(m_arrStringPool.size()));
+	if (result.second == true) {
+		size_t nLength = wcslen(stringValue);
+		m_arrStringPool.insert(m_arrStringPool.end(), stringValue, stringValue + nLength + 1);
+	}
+
+	return result.first->second;
+}
+
+
+/**
+ * @brief	Constructor
+ */
+LogStoreReader::LogStoreReader()
+{
+	m_nItemCount = 0;
+}
+
+/**
+ * @brief	Destructor
+ */
+LogStoreReader::~LogStoreReader()
+{
+	Close();
+}
+
+/**
+ * @brief	Open a store file and append its items
+ * @param	filePath - Store file path
+ * @return	true/false
+ * @note	Only the block headers are read, column data is accessed in place when needed.
+ *			An incomplete block at the end of file (being written) is ignored.
+ */
+bool LogStoreReader::Open(const wchar_t* filePath)
+{
+	// Other processes/threads may still be appending to the file
+	HANDLE hFile = CreateFile(filePath, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+		NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (hFile == INVALID_HANDLE_VALUE)
+		return false;
+
+	// Empty file can not be mapped
+	LARGE_INTEGER liFileSize{};
+	if (!GetFileSizeEx(hFile, &liFileSize)) {
+		CloseHandle(hFile);
+		return false;
+	}
+	if (liFileSize.QuadPart == 0) {
+		CloseHandle(hFile);
+		return true;
+	}
+
+	// Map the whole file
+	MAPPEDFILE mappedFile{};
+	mappedFile.hFile = hFile;
+	mappedFile.hMapping = CreateFileMapping(hFile, NULL, PAGE_READONLY, 0, 0, NULL);
+	if (mappedFile.hMapping != NULL) {
+		mappedFile.pView = static_cast<const BYTE*>(MapViewOfFile(mappedFile.hMapping, FILE_MAP_READ, 0, 0, 0));
+	}
+	if (mappedFile.pView == NULL) {
+		TRACE_FORMAT("Error: Log store file mapping failed!!! (Code: 0x%08X)", GetLastError());
+		TRACE_DEBUG(__FUNCTION__, __FILENAME__, __LINE__);
+		if (mappedFile.hMapping != NULL) CloseHandle(mappedFile.hMapping);
+		CloseHandle(hFile);
+		return false;
+	}
+	m_arrFiles.push_back(mappedFile);
+
+	// Walk through block headers
+	size_t nFileSize = static_cast<size_t>(liFileSize.QuadPart);
+	size_t nOffset = 0;
+	while ((nOffset + sizeof(LogStore::BLOCKHEADER)) <= nFileSize) {
+
+		// Check block header validity
+		const BYTE* pBlock = mappedFile.pView + nOffset;
+		const LogStore::BLOCKHEADER* pHeader = reinterpret_cast<const LogStore::BLOCKHEADER*>(pBlock);
+		if ((pHeader->dwMagic != LogStore::blockMagic) || (pHeader->wVersion != LogStore::formatVersion) ||
+			(pHeader->wHeaderSize != sizeof(LogStore::BLOCKHEADER)))
+			break;
+
+		LogStore::COLUMNLAYOUT layout;
+		LogStore::GetColumnLayout(pHeader->dwItemCount, pHeader->dwDetailCount, pHeader->dwStringPoolSize, layout);
+		if ((pHeader->dwBlockSize != layout.nBlockSize) || ((nOffset + layout.nBlockSize) > nFileSize))
+			break;
+
+		// Block view
+		BLOCKVIEW blockView{};
+		blockView.nFirstItem = m_nItemCount;
+		blockView.nItemCount = pHeader->dwItemCount;
+		blockView.nDetailCount = pHeader->dwDetailCount;
+		blockView.nStringPoolSize = pHeader->dwStringPoolSize;
+		blockView.pTime = reinterpret_cast<const INT64*>(pBlock + layout.nTime);
+		blockView.pProcessID = reinterpret_cast<const DWORD*>(pBlock + layout.nProcessID);
+		blockView.pCategory = reinterpret_cast<const USHORT*>(pBlock + layout.nCategory);
+		blockView.pDescription = reinterpret_cast<const DWORD*>(pBlock + layout.nDescription);
+		blockView.pDetailEnd = reinterpret_cast<const DWORD*>(pBlock + layout.nDetailEnd);
+		blockView.pDetailCategory = reinterpret_cast<const USHORT*>(pBlock + layout.nDetailCategory);
+		blockView.pDetailFlag = reinterpret_cast<const USHORT*>(pBlock + layout.nDetailFlag);
+		blockView.pDetailValue = reinterpret_cast<const INT*>(pBlock + layout.nDetailValue);
+		blockView.pDetailString = reinterpret_cast<const DWORD*>(pBlock + layout.nDetailString);
+		blockView.pStringPool = reinterpret_cast<const wchar_t*>(pBlock + layout.nStringPool);
+
+		if (blockView.nItemCount > 0) {
+			m_arrBlocks.push_back(blockView);
+			m_nItemCount += blockView.nItemCount;
+		}
+		nOffset += layout.nBlockSize;
+	}
+
+	return true;
+}
+
+/**
+ * @brief	Unmap and close all files
+ * @param	None
+ * @return	None
+ */
+void LogStoreReader::Close(void) noexcept
+{
+	for (const MAPPEDFILE& mappedFile : m_arrFiles) {
+		UnmapViewOfFile(mappedFile.pView);
+		CloseHandle(mappedFile.hMapping);
+		CloseHandle(mappedFile.hFile);
+	}
+	m_arrFiles.clear();
+	m_arrBlocks.clear();
+	m_nItemCount = 0;
+}
+
+/**
+ * @brief	Get log time of an item
+ * @param	nIndex - Item index
+ * @return	DateTime
+ */
+DateTime LogStoreReader::GetTime(size_t nIndex) const
+{
+	size_t nLocalIndex = 0;
+	const BLOCKVIEW* pBlockView = FindBlock(nIndex, nLocalIndex);
+	if (pBlockView == NULL)
+		return DateTime();
+
+	std::chrono::milliseconds msTime(pBlockView->pTime[nLocalIndex]);
+	return DateTime(std::chrono::system_clock::time_point(msTime));
+}
+
+/**
+ * @brief	Get process ID of an item
+ * @param	nIndex - Item index
+ * @return	DWORD
+ */
+DWORD LogStoreReader::GetProcessID(size_t nIndex) const
+{
+	size_t nLocalIndex = 0;
+	const BLOCKVIEW* pBlockView = FindBlock(nIndex, nLocalIndex);
+	return (pBlockView != NULL) ? pBlockView->pProcessID[nLocalIndex] : 0;
+}
+
+/**
+ * @brief	Get log category of an item
+ * @param	nIndex - Item index
+ * @return	USHORT
+ */
+USHORT LogStoreReader::GetCategory(size_t nIndex) const
+{
+	size_t nLocalIndex = 0;
+	const BLOCKVIEW* pBlockView = FindBlock(nIndex, nLocalIndex);
+	return (pBlockView != NULL) ? pBlockView->pCategory[nLocalIndex] : 0;
+}
+
+/**
+ * @brief	Get description string of an item
+ * @param	nIndex - Item index
+ * @return	const wchar_t* - String inside mapped view (valid until the reader is closed)
+ */
+const wchar_t* LogStoreReader::GetDescription(size_t nIndex) const
+{
+	size_t nLocalIndex = 0;
+	const BLOCKVIEW* pBlockView = FindBlock(nIndex, nLocalIndex);
+	if (pBlockView == NULL)
+		return Constant::String::Empty;
+
+	return GetPoolString(*pBlockView, pBlockView->pDescription[nLocalIndex]);
+}
+
+/**
+ * @brief	Get number of detail items of an item
+ * @param	nIndex - Item index
+ * @return	size_t
+ */
+size_t LogStoreReader::GetDetailCount(size_t nIndex) const
+{
+	size_t nLocalIndex = 0;
+	const BLOCKVIEW* pBlockView = FindBlock(nIndex, nLocalIndex);
+	if (pBlockView == NULL)
+		return 0;
+
+	size_t nDetailBegin = (nLocalIndex > 0) ? pBlockView->pDetailEnd[nLocalIndex - 1] : 0;
+	size_t nDetailEnd = pBlockView->pDetailEnd[nLocalIndex];
+	return ((nDetailBegin <= nDetailEnd) && (nDetailEnd <= pBlockView->nDetailCount)) ? (nDetailEnd - nDetailBegin) : 0;
+}
+
+/**
+ * @brief	Read whole log item data
+ * @param	nIndex	- Item index
+ * @param	logItem - Log item (output)
+ * @return	true/false
+ */
+bool LogStoreReader::ReadLogItem(size_t nIndex, LOGITEM& logItem) const
+{
+	size_t nLocalIndex = 0;
+	const BLOCKVIEW* pBlockView = FindBlock(nIndex, nLocalIndex);
+	if (pBlockView == NULL)
+		return false;
+
+	// Log item base info
+	std::chrono::milliseconds msTime(pBlockView->pTime[nLocalIndex]);
+	logItem.RemoveAll();
+	logItem.SetTime(DateTime(std::chrono::system_clock::time_point(msTime)));
+	logItem.SetProcessID(pBlockView->pProcessID[nLocalIndex]);
+	logItem.SetCategory(pBlockView->pCategory[nLocalIndex]);
+	logItem.SetLogString(GetPoolString(*pBlockView, pBlockView->pDescription[nLocalIndex]));
+
+	// Log item detail info
+	size_t nDetailBegin = (nLocalIndex > 0) ? pBlockView->pDetailEnd[nLocalIndex - 1] : 0;
+	size_t nDetailEnd = pBlockView->pDetailEnd[nLocalIndex];
+	if ((nDetailBegin > nDetailEnd) || (nDetailEnd > pBlockView->nDetailCount))
+		return true;
+
+	for (size_t nDetail = nDetailBegin; nDetail < nDetailEnd; nDetail++) {
+		logItem.AddDetail(pBlockView->pDetailCategory[nDetail], pBlockView->pDetailValue[nDetail],
+			GetPoolString(*pBlockView, pBlockView->pDetailString[nDetail]), pBlockView->pDetailFlag[nDetail]);
+	}
+
+	return true;
+}
+
+/**
+ * @brief	Find the block which contains an item
+ * @param	nIndex		- Item index (in whole store)
+ * @param	nLocalIndex - Item index inside the block (output)
+ * @return	const BLOCKVIEW* - NULL if index is out of range
+ */
+const LogStoreReader::BLOCKVIEW* LogStoreReader::FindBlock(size_t nIndex, size_t& nLocalIndex) const
+{
+	if (nIndex >= m_nItemCount)
+		return NULL;
+
+	// Binary search by first item index
+	auto iter = std::upper_bound(m_arrBlocks.begin(), m_arrBlocks.end(), nIndex,
+		[](size_t nValue, const BLOCKVIEW& blockView) { return (nValue < blockView.nFirstItem); });
+	const BLOCKVIEW& blockView = *(--iter);
+
+	nLocalIndex = nIndex - blockView.nFirstItem;
+	return &blockView;
+}
+
+/**
+ * @brief	Get a string from string pool of a block
+ * @param	blockView - Block view
+ * @param	dwOffset  - String pool offset
+ * @return	const wchar_t* - Empty string if offset is invalid
+ */
+const wchar_t* LogStoreReader::GetPoolString(const BLOCKVIEW& blockView, DWORD dwOffset)
+{
+	if ((dwOffset == LogStore::nullString) || (dwOffset >= blockView.nStringPoolSize))
+		return Constant::String::Empty;
+
+	// String pool always ends with a terminating character
+	if (blockView.pStringPool[blockView.nStringPoolSize - 1] != L'\0')
+		return Constant::String::Empty;
+
+	return (blockView.pStringPool + dwOffset);
+}
+
+
+/**
+ * @brief	Get store file path of a YAML log file
+ * @param	logFilePath - YAML log file path
+ * @return	String - Store file path
+ */
+String LogStoreUtils::GetStoreFilePath(const wchar_t* logFilePath)
+{
+	String storeFilePath = logFilePath;
+
+	// Replace log file extension
+	int nLength = storeFilePath.GetLength();
+	int nExtLength = static_cast<int>(wcslen(Constant::File::Extension::Log));
+	if ((nLength >= nExtLength) && (_wcsicmp(storeFilePath.GetString() + (nLength - nExtLength), Constant::File::Extension::Log) == 0)) {
+		storeFilePath.Truncate(nLength - nExtLength);
+	}
+	storeFilePath.Append(Constant::File::Extension::LogStore);
+
+	return storeFilePath;
+}
+
+/**
+ * @brief	Split a YAML log line into key name and value
+ * @param	lineString	- Line string (without line break)
+ * @param	keyName		- Key name (output)
+ * @param	value		- Value (output)
+ * @param	bIndented	- Whether the line is indented (output)
+ * @return	true/false - false if the line is not a key-value pair
+ */
+static bool ParseYAMLLine(std::wstring_view lineString, std::wstring_view& keyName, std::wstring_view& value, bool& bIndented)
+{
+	// Indentation
+	size_t nStart = lineString.find_first_not_of(L' ');
+	if (nStart == std::wstring_view::npos)
+		return false;
+	bIndented = (nStart > 0);
+	lineString.remove_prefix(nStart);
+
+	// Key name
+	size_t nSeparator = lineString.find(L':');
+	if (nSeparator == std::wstring_view::npos)
+		return false;
+	keyName = lineString.substr(0, nSeparator);
+
+	// Value (quoted, or empty for object name)
+	value = lineString.substr(nSeparator + 1);
+	size_t nQuoteBegin = value.find(L'\"');
+	size_t nQuoteEnd = value.rfind(L'\"');
+	if ((nQuoteBegin != std::wstring_view::npos) && (nQuoteEnd > nQuoteBegin)) {
+		value = value.substr(nQuoteBegin + 1, nQuoteEnd - nQuoteBegin - 1);
+	}
+	else {
+		value = std::wstring_view();
+	}
+
+	return true;
+}
+
+/**
+ * @brief	Convert a YAML log file into a store file
+ * @param	yamlFilePath  - YAML log file path
+ * @param	storeFilePath - Store file path (will be overwritten)
+ * @param	byLogType	  - Log type
+ * @param	pnItemCount	  - Number of converted items (output, optional)
+ * @return	true/false
+ */
+bool LogStoreUtils::ConvertYAMLFile(const wchar_t* yamlFilePath, const wchar_t* storeFilePath, byte byLogType, size_t* pnItemCount /* = NULL */)
+{
+	if (pnItemCount != NULL) *pnItemCount = 0;
+
+	// Read whole YAML log file (UTF-16 text)
+	CFile fYAMLFile;
+	if (!fYAMLFile.Open(yamlFilePath, CFile::modeRead | CFile::shareDenyNone))
+		return false;
+	ULONGLONG ullFileLength = fYAMLFile.GetLength();
+	if (ullFileLength > INT_MAX) {
+		fYAMLFile.Close();
+		return false;
+	}
+	std::vector<wchar_t> arrYAMLBuff(static_cast<size_t>(ullFileLength / sizeof(wchar_t)));
+	UINT nReadLength = (arrYAMLBuff.empty()) ? 0 : fYAMLFile.Read(arrYAMLBuff.data(), static_cast<UINT>(arrYAMLBuff.size() * sizeof(wchar_t)));
+	fYAMLFile.Close();
+	std::wstring_view yamlText(arrYAMLBuff.data(), nReadLength / sizeof(wchar_t));
+	if ((!yamlText.empty()) && (yamlText.front() == 0xFEFF)) {
+		yamlText.remove_prefix(1);
+	}
+
+	// Reverse lookup: log category names (default language)
+	std::unordered_map<std::wstring_view, USHORT> mapCategory;
+	LANGTABLE_PTR pDefLang = LoadLanguageTable(NULL);
+	if (pDefLang != NULL) {
+		for (const LANGTEXT& langText : *pDefLang) {
+			unsigned nMacro = (langText.id >> 8);
+			if ((langText.id <= USHRT_MAX) && (nMacro >= LOG_MACRO_EVENT_APP) && (nMacro <= LOG_MACRO_HISTORY)) {
+				mapCategory.try_emplace(langText.langString, static_cast<USHORT>(langText.id));
+			}
+		}
+	}
+
+	// Reverse lookup: detail key names of current log type
+	std::unordered_map<std::wstring_view, USHORT> mapDetailKey;
+	unsigned nFirstDetailID = (byLogType == LOGTYPE_HISTORY_LOG) ? HistoryDetail::Category : EventDetail::ResourceID;
+	unsigned nLastDetailID = (byLogType == LOGTYPE_HISTORY_LOG) ? HistoryDetail::ActionError : EventDetail::EventError;
+	for (unsigned nDetailID = nFirstDetailID; nDetailID <= nLastDetailID; nDetailID++) {
+		mapDetailKey.try_emplace(GetString(StringTable::LogKey, nDetailID), static_cast<USHORT>(nDetailID));
+	}
+
+	// Base log key names
+	const std::wstring_view timeKey = GetString(StringTable::LogKey, BaseLog::Time);
+	const std::wstring_view pidKey = GetString(StringTable::LogKey, BaseLog::PID);
+	const std::wstring_view categoryKey = GetString(StringTable::LogKey, BaseLog::LogCategory);
+	const std::wstring_view descriptionKey = GetString(StringTable::LogKey, BaseLog::Description);
+	const std::wstring_view detailsKey = GetString(StringTable::LogKey, BaseLog::Details);
+
+	// Output to a temporary file first, so that an interrupted conversion never leaves a broken store file
+	String tempFilePath = storeFilePath;
+	tempFilePath.Append(Constant::File::Extension::Backup);
+	CFile fStoreFile;
+	if (!fStoreFile.Open(tempFilePath, CFile::modeCreate | CFile::modeWrite | CFile::shareDenyWrite))
+		return false;
+
+	LogStoreBlock storeBlock;
+	LOGITEM logItem;
+	bool bHasItem = false;
+	bool bResult = true;
+	size_t nItemCount = 0;
+
+	// Add current item into the block, write the block when it's full
+	auto CommitItem = [&]() {
+		if (bHasItem == true) {
+			storeBlock.AddItem(logItem);
+			nItemCount++;
+		}
+		logItem.RemoveAll();
+		bHasItem = false;
+		if (storeBlock.GetItemCount() >= LogStore::maxBlockItemCount) {
+			bResult &= storeBlock.Write(fStoreFile);
+			storeBlock.Clear();
+		}
+	};
+
+	// Parse line by line
+	std::wstring valueString;
+	while (!yamlText.empty()) {
+
+		// Get next line
+		size_t nLineEnd = yamlText.find(L'\n');
+		std::wstring_view lineString = yamlText.substr(0, nLineEnd);
+		yamlText.remove_prefix((nLineEnd == std::wstring_view::npos) ? yamlText.size() : (nLineEnd + 1));
+		while ((!lineString.empty()) && ((lineString.back() == L'\r') || (lineString.back() == L' '))) {
+			lineString.remove_suffix(1);
+		}
+
+		// Empty line: end of item
+		std::wstring_view keyName, value;
+		bool bIndented = false;
+		if (lineString.empty()) {
+			CommitItem();
+			continue;
+		}
+		if (!ParseYAMLLine(lineString, keyName, value, bIndented))
+			continue;
+		valueString.assign(value);
+
+		if ((bIndented == true) || ((keyName != timeKey) && (keyName != pidKey) && (keyName != categoryKey) &&
+			(keyName != descriptionKey) && (keyName != detailsKey))) {
+
+			// Detail item: look up the key of current log type
+			auto iterKey = mapDetailKey.find(keyName);
+			if (iterKey == mapDetailKey.end())
+				continue;
+
+			// Integer, dictionary value or string
+			wchar_t* pEnd = NULL;
+			long lValue = wcstol(valueString.c_str(), &pEnd, 10);
+			if ((!valueString.empty()) && (pEnd != NULL) && (*pEnd == L'\0')) {
+				logItem.AddDetail(iterKey->second, static_cast<int>(lValue), LogDetailFlag::Write_Int);
+			}
+			else {
+				unsigned nValueID = GetStringID(StringTable::LogValue, valueString.c_str());
+				if (nValueID != static_cast<unsigned>(INT_INVALID))
+					logItem.AddDetail(iterKey->second, static_cast<int>(nValueID), LogDetailFlag::LookUp_Dict);
+				else
+					logItem.AddDetail(iterKey->second, valueString.c_str(), LogDetailFlag::Write_String);
+			}
+		}
+		else if (keyName == timeKey) {
+			// A new item starts with its log time
+			if (bHasItem == true) CommitItem();
+			int nYear = 0, nMonth = 0, nDay = 0, nHour = 0, nMinute = 0, nSecond = 0, nMillisecs = 0;
+			if (swscanf_s(valueString.c_str(), L"%d/%d/%d %d:%d:%d.%d", &nYear, &nMonth, &nDay, &nHour, &nMinute, &nSecond, &nMillisecs) >= 6) {
+				logItem.SetTime(DateTime(nYear, nMonth, nDay, nHour, nMinute, nSecond, nMillisecs));
+			}
+			bHasItem = true;
+		}
+		else if (keyName == pidKey) {
+			logItem.SetProcessID(static_cast<DWORD>(wcstoul(valueString.c_str(), NULL, 10)));
+			bHasItem = true;
+		}
+		else if (keyName == categoryKey) {
+			auto iterCategory = mapCategory.find(value);
+			if (iterCategory != mapCategory.end())
+				logItem.SetCategory(iterCategory->second);
+			bHasItem = true;
+		}
+		else if (keyName == descriptionKey) {
+			logItem.SetLogString(valueString.c_str());
+			bHasItem = true;
+		}
+	}
+
+	// Write remaining items
+	CommitItem();
+	bResult &= storeBlock.Write(fStoreFile);
+	fStoreFile.Close();
+
+	// Replace store file
+	if ((bResult != true) || (!MoveFileEx(tempFilePath, storeFilePath, MOVEFILE_REPLACE_EXISTING))) {
+		DeleteFile(tempFilePath);
+		return false;
+	}
+
+	if (pnItemCount != NULL) *pnItemCount = nItemCount;
+	return true;
+}
@@ -0,0 +1,664 @@
+﻿/**
+ * @file		LogWriter.cpp
+ * @brief		Implement background log writer
+ * @author		AnthonyLeeStark
+ * @date		2026.10.17
+ *
+ * @copyright 	Copyright (c) 2015-2025 AnthonyLeeStark
+ */
+
+#include "AppCore/LogWriter.h"
+
+#include <algorithm>
+
+#ifdef _DEBUG
+#define new DEBUG_NEW
+#endif
+
+
+/**
+ * @brief	Constructor
+ * @param	byLogType - Log type
+ * @param	nCapacity - Queue capacity (rounded up to power of 2)
+ */
+LogWriter::LogWriter(byte byLogType, size_t nCapacity /* = defaultCapacity */)
+{
+	// Properties
+	m_byLogType = byLogType;
+	m_strFolderPath = Constant::String::Empty;
+	m_dwLastError.store(APP_ERROR_SUCCESS);
+
+	// Initialize queue
+	m_nCapacity = 2;
+	while (m_nCapacity < nCapacity) m_nCapacity <<= 1;
+	m_arrSlots.reset(new Slot[m_nCapacity]);
+	for (size_t nIndex = 0; nIndex < m_nCapacity; nIndex++) {
+		m_arrSlots[nIndex].nSequence.store(nIndex, std::memory_order_relaxed);
+	}
+	m_nEnqueuePos.store(0, std::memory_order_relaxed);
+	m_nDequeuePos.store(0, std::memory_order_relaxed);
+
+	// Writer thread
+	m_hWakeEvent = NULL;
+	m_hFlushedEvent = NULL;
+	m_bStopRequest.store(false);
+	m_nFlushRequest.store(0);
+	m_nFlushDone = 0;
+
+	// Output file
+	m_strCurFilePath = Constant::String::Empty;
+	m_strCurStorePath = Constant::String::Empty;
+
+	// Pending items
+	m_nPendingPos = 0;
+
+	// Journal
+	m_nCheckpointPos = 0;
+	m_bWriteFailed.store(false);
+}
+
+/**
+ * @brief	Destructor
+ */
+LogWriter::~LogWriter()
+{
+	// Write all pending items and stop the writer thread
+	Stop();
+}
+
+/**
+ * @brief	Start the writer thread
+ * @param	None
+ * @return	true/false
+ */
+bool LogWriter::Start(void)
+{
+	// Already running
+	if (IsRunning())
+		return true;
+
+	// Resolve log folder on the caller thread
+	m_strFolderPath = StringUtils::GetSubFolderPath(Constant::Folder::Log);
+
+	// Create events
+	m_hWakeEvent = CreateEvent(NULL, FALSE, FALSE, NULL);
+	m_hFlushedEvent = CreateEvent(NULL, FALSE, FALSE, NULL);
+	if ((m_hWakeEvent == NULL) || (m_hFlushedEvent == NULL)) {
+		TRACE_FORMAT("Error: Log writer event creation failed!!! (Code: 0x%08X)", GetLastError());
+		TRACE_DEBUG(__FUNCTION__, __FILENAME__, __LINE__);
+		if (m_hWakeEvent != NULL) CloseHandle(m_hWakeEvent);
+		if (m_hFlushedEvent != NULL) CloseHandle(m_hFlushedEvent);
+		m_hWakeEvent = m_hFlushedEvent = NULL;
+		return false;
+	}
+
+	// Write items left in journal by previous session, then start a new journal
+	// Replayed items which still fail to be written are recorded into the new journal before any new item is queued,
+	// and the writer thread retries them first
+	String journalFilePath = LogJournal::GetFilePath(m_byLogType, m_strFolderPath);
+	bool bReplayResult = ReplayJournal(journalFilePath);
+	m_journal.Create(journalFilePath);
+	if (bReplayResult == false) {
+		TRACE_WARNING(L"{} replayed log item(s) failed to be written, retry later (log type: {})", m_arrPendingItems.size(), static_cast<int>(m_byLogType));
+		RecordPendingItems();
+	}
+
+	// Start writer thread
+	m_bStopRequest.store(false);
+	m_nCheckpointPos = m_nPendingPos;
+	m_bWriteFailed.store(!bReplayResult);
+	m_thrWriter = std::thread(&LogWriter::Run, this);
+
+	return true;
+}
+
+/**
+ * @brief	Write all pending items and stop the writer thread
+ * @param	None
+ * @return	None
+ */
+void LogWriter::Stop(void)
+{
+	if (!IsRunning())
+		return;
+
+	// Request to stop and wait for the writer to drain the queue
+	m_bStopRequest.store(true);
+	SetEvent(m_hWakeEvent);
+	m_thrWriter.join();
+
+	// Clean-up events
+	CloseHandle(m_hWakeEvent);
+	CloseHandle(m_hFlushedEvent);
+	m_hWakeEvent = m_hFlushedEvent = NULL;
+
+	// Remove journal only if all queued items are written, otherwise keep it to replay them next time
+	if (m_arrPendingItems.empty() && (m_nDequeuePos.load() == m_nEnqueuePos.load())) {
+		m_journal.Remove();
+	}
+	else {
+		TRACE_WARNING(L"Log items are not fully written, journal is kept for replay (log type: {})", static_cast<int>(m_byLogType));
+	}
+}
+
+/**
+ * @brief	Push a log item into the queue
+ * @param	logItem - Log item
+ * @return	true/false - false if queue is full
+ */
+bool LogWriter::Enqueue(const LOGITEM& logItem)
+{
+	size_t nPos = 0;
+	Slot* pSlot = ClaimSlot(nPos);
+	if (pSlot == NULL) return false;
+
+	// Record in journal, then fill the slot and publish it to the writer
+	m_journal.AppendItem(nPos, logItem);
+	pSlot->logItem = logItem;
+	PublishSlot(pSlot, nPos);
+	return true;
+}
+
+/**
+ * @brief	Move a log item into the queue
+ * @param	logItem - Log item (only moved if the item is queued)
+ * @return	true/false - false if queue is full
+ */
+bool LogWriter::Enqueue(LOGITEM&& logItem)
+{
+	size_t nPos = 0;
+	Slot* pSlot = ClaimSlot(nPos);
+	if (pSlot == NULL) return false;
+
+	// Record in journal, then fill the slot and publish it to the writer
+	m_journal.AppendItem(nPos, logItem);
+	pSlot->logItem = std::move(logItem);
+	PublishSlot(pSlot, nPos);
+	return true;
+}
+
+/**
+ * @brief	Claim a free queue slot
+ * @param	nPos - Claimed queue position (out)
+ * @return	Slot* - NULL if queue is full
+ */
+LogWriter::Slot* LogWriter::ClaimSlot(size_t& nPos)
+{
+	Slot* pSlot = NULL;
+	nPos = m_nEnqueuePos.load(std::memory_order_relaxed);
+
+	for (;;) {
+		pSlot = &m_arrSlots[nPos & (m_nCapacity - 1)];
+		size_t nSequence = pSlot->nSequence.load(std::memory_order_acquire);
+		intptr_t nDiff = static_cast<intptr_t>(nSequence) - static_cast<intptr_t>(nPos);
+		if (nDiff == 0) {
+			if (m_nEnqueuePos.compare_exchange_weak(nPos, nPos + 1, std::memory_order_relaxed))
+				return pSlot;
+		}
+		else if (nDiff < 0) {
+			// Queue is full
+			return NULL;
+		}
+		else {
+			nPos = m_nEnqueuePos.load(std::memory_order_relaxed);
+		}
+	}
+}
+
+/**
+ * @brief	Publish a filled slot to the writer
+ * @param	pSlot - Filled slot
+ * @param	nPos  - Queue position of the slot
+ * @return	None
+ */
+void LogWriter::PublishSlot(Slot* pSlot, size_t nPos)
+{
+	pSlot->nSequence.store(nPos + 1, std::memory_order_release);
+
+	// Wake the writer up if a full batch is pending
+	if ((GetPendingCount() >= defaultBatchSize) && (m_hWakeEvent != NULL)) {
+		SetEvent(m_hWakeEvent);
+	}
+}
+
+/**
+ * @brief	Move queue positions (queue must be empty and writer thread must not be running)
+ * @param	nStartPos - New queue position
+ * @return	None
+ */
+void LogWriter::ResetQueue(size_t nStartPos)
+{
+	for (size_t nPos = nStartPos; nPos < (nStartPos + m_nCapacity); nPos++) {
+		m_arrSlots[nPos & (m_nCapacity - 1)].nSequence.store(nPos, std::memory_order_relaxed);
+	}
+	m_nEnqueuePos.store(nStartPos, std::memory_order_relaxed);
+	m_nDequeuePos.store(nStartPos, std::memory_order_relaxed);
+}
+
+/**
+ * @brief	Wait until all items queued so far are written
+ * @param	dwTimeout - Wait timeout (in milliseconds)
+ * @return	true/false - false if timed out or some items failed to be written (they are retried later)
+ */
+bool LogWriter::Flush(DWORD dwTimeout /* = INFINITE */)
+{
+	if (!IsRunning())
+		return false;
+
+	// Request a flush and wait for the writer to complete it
+	// Clear a completion signal left by an earlier flush which was not waited for (timed out)
+	ResetEvent(m_hFlushedEvent);
+	m_nFlushRequest.fetch_add(1);
+	SetEvent(m_hWakeEvent);
+	if (WaitForSingleObject(m_hFlushedEvent, dwTimeout) != WAIT_OBJECT_0)
+		return false;
+
+	return (m_bWriteFailed.load() == false);
+}
+
+/**
+ * @brief	Get output log file path of a log item
+ * @param	byLogType  - Log type
+ * @param	logTime	   - Log item time
+ * @param	folderPath - Log folder path
+ * @param	filePath   - Output file path (ref-value)
+ * @return	true/false
+ */
+bool LogWriter::GetLogFilePath(byte byLogType, const DateTime& logTime, const wchar_t* folderPath, String& filePath)
+{
+	String fileName;
+
+	switch (byLogType)
+	{
+	case LOGTYPE_APP_EVENT:
+	{
+		// Format app event log filename
+		const DateTime::Fields timeFields = logTime.Decompose();
+		fileName.Format(Constant::File::Name::AppEventLog, timeFields.year, timeFields.month);
+		break;
+	}
+
+	case LOGTYPE_HISTORY_LOG:
+		// App history log
+		fileName = Constant::File::Name::AppHistory;
+		break;
+
+	default:
+		// Wrong argument
+		return false;
+	}
+
+	filePath = StringUtils::MakeFilePath(folderPath, fileName, Constant::File::Extension::Log);
+	return true;
+}
+
+/**
+ * @brief	Write items left in a journal file into log files (before writer thread is started)
+ *			The old journal is kept until this is done, so a crash here only causes items to be written again
+ *			Items which fail to be written are kept as pending items, in front of all new items
+ * @param	journalFilePath - Journal file path
+ * @return	true/false - false if some items failed to be written
+ */
+bool LogWriter::ReplayJournal(const String& journalFilePath)
+{
+	LOGDATA arrReplayItems;
+	std::vector<WORD> arrWrittenFiles;
+	if (!LogJournal::ReadItems(journalFilePath, arrReplayItems, &arrWrittenFiles) || arrReplayItems.empty())
+		return true;
+
+	TRACE_INFO(L"Replay {} log item(s) from journal (log type: {})", arrReplayItems.size(), static_cast<int>(m_byLogType));
+
+	// Replayed items take the queue positions right before new items
+	size_t nReplayPos = m_nDequeuePos.load();
+	ResetQueue(nReplayPos + arrReplayItems.size());
+	m_nPendingPos = nReplayPos;
+	m_arrPendingItems = std::move(arrReplayItems);
+	m_arrPendingWritten = std::move(arrWrittenFiles);
+
+	// Only output files which do not have the items yet are written
+	bool bResult = WritePendingItems();
+	CloseLogFile();
+	return bResult;
+}
+
+/**
+ * @brief	Record pending items into the journal again (before writer thread is started)
+ * @param	None
+ * @return	None
+ */
+void LogWriter::RecordPendingItems(void)
+{
+	for (size_t nIndex = 0; nIndex < m_arrPendingItems.size(); nIndex++) {
+		m_journal.AppendItem(m_nPendingPos + nIndex, m_arrPendingItems[nIndex]);
+	}
+
+	// Output files which already have the items
+	size_t nFirst = 0;
+	for (size_t nIndex = 1; nIndex <= m_arrPendingWritten.size(); nIndex++) {
+		if ((nIndex < m_arrPendingWritten.size()) && (m_arrPendingWritten[nIndex] == m_arrPendingWritten[nFirst]))
+			continue;
+		if (m_arrPendingWritten[nFirst] != 0) {
+			m_journal.AppendWritten(m_nPendingPos + nFirst, nIndex - nFirst, m_arrPendingWritten[nFirst]);
+		}
+		nFirst = nIndex;
+	}
+}
+
+/**
+ * @brief	Writer thread procedure
+ * @param	None
+ * @return	None
+ */
+void LogWriter::Run(void)
+{
+	for (;;) {
+		// Sleep until a batch is ready, a flush/stop is requested or the flush interval is elapsed
+		WaitForSingleObject(m_hWakeEvent, defaultFlushInterval);
+		bool bStopRequest = m_bStopRequest.load();
+		size_t nFlushRequest = m_nFlushRequest.load();
+
+		// Write all pending items, items which failed to be written are retried on next pass
+		m_bWriteFailed.store(!WriteBatch());
+
+		// Mark written items in journal (all items before the first pending item)
+		// Once failed items are written, checkpoints move on and the journal can be emptied again
+		if (m_nPendingPos != m_nCheckpointPos) {
+			m_journal.AppendCheckpoint(m_nPendingPos, m_nEnqueuePos);
+			m_nCheckpointPos = m_nPendingPos;
+		}
+
+		// Notify flush completion
+		if (nFlushRequest != m_nFlushDone) {
+			m_nFlushDone = nFlushRequest;
+			SetEvent(m_hFlushedEvent);
+		}
+
+		if (bStopRequest == true)
+			break;
+	}
+
+	CloseLogFile();
+}
+
+/**
+ * @brief	Pop a log item out of the queue (writer thread only)
+ * @param	logItem - Log item (output)
+ * @return	true/false - false if queue is empty
+ */
+bool LogWriter::Dequeue(LOGITEM& logItem)
+{
+	size_t nPos = m_nDequeuePos.load(std::memory_order_relaxed);
+	Slot& slot = m_arrSlots[nPos & (m_nCapacity - 1)];
+	size_t nSequence = slot.nSequence.load(std::memory_order_acquire);
+	if (static_cast<intptr_t>(nSequence) - static_cast<intptr_t>(nPos + 1) < 0)
+		return false;
+
+	// Take the item and release slot memory
+	logItem = std::move(slot.logItem);
+	slot.logItem.RemoveAll();
+
+	// Give the slot back to producers
+	slot.nSequence.store(nPos + m_nCapacity, std::memory_order_release);
+	m_nDequeuePos.store(nPos + 1, std::memory_order_relaxed);
+	return true;
+}
+
+/**
+ * @brief	Write items which failed last time, then all queued items (writer thread only)
+ * @param	None
+ * @return	true/false - false if any item failed to be written
+ */
+bool LogWriter::WriteBatch(void)
+{
+	// Retry failed items first, new items wait in the queue until they're written (items are written in queue order)
+	if (!m_arrPendingItems.empty() && !WritePendingItems())
+		return false;
+
+	// Take all queued items
+	LOGITEM logItem;
+	while (Dequeue(logItem)) {
+		m_arrPendingItems.push_back(std::move(logItem));
+		m_arrPendingWritten.push_back(0);
+	}
+
+	return WritePendingItems();
+}
+
+/**
+ * @brief	Format and write pending items in batches of the same output file (writer thread only)
+ *			Stop at the first batch which fails, it is kept with all following items to be retried
+ * @param	None
+ * @return	true/false - false if some items are still pending
+ */
+bool LogWriter::WritePendingItems(void)
+{
+	bool bResult = true;
+	size_t nWrittenCount = 0;
+	String filePath;
+	String itemFilePath;
+	String batchString;
+
+	while (nWrittenCount < m_arrPendingItems.size()) {
+
+		// Get output file of the batch (items which have no output file are skipped)
+		if (!GetLogFilePath(m_byLogType, m_arrPendingItems[nWrittenCount].GetTime(), m_strFolderPath, filePath)) {
+			nWrittenCount++;
+			continue;
+		}
+
+		// Collect following items of the same file which are written into the same output files so far
+		// (a batch can't span next month's log file)
+		WORD wWrittenFiles = m_arrPendingWritten[nWrittenCount];
+		size_t nBatchEnd = nWrittenCount;
+		do {
+			// Format output log strings and store columns (only for output files which do not have them yet)
+			const LOGITEM& logItem = m_arrPendingItems[nBatchEnd];
+			if (!(wWrittenFiles & LogJournal::LogFile)) logItem.FormatOutput(batchString);
+			if (!(wWrittenFiles & LogJournal::StoreFile)) m_storeBlock.AddItem(logItem);
+			nBatchEnd++;
+		} while ((nBatchEnd < m_arrPendingItems.size()) && (m_arrPendingWritten[nBatchEnd] == wWrittenFiles) &&
+				 GetLogFilePath(m_byLogType, m_arrPendingItems[nBatchEnd].GetTime(), m_strFolderPath, itemFilePath) &&
+				 (itemFilePath == filePath));
+
+		WORD wNewWrittenFiles = WriteBatchFiles(filePath, batchString, wWrittenFiles);
+		if (wNewWrittenFiles != LogJournal::AllFiles) {
+			// Keep the batch, and mark output files which have it now, so that they're not written twice
+			if (wNewWrittenFiles != wWrittenFiles) {
+				std::fill(m_arrPendingWritten.begin() + nWrittenCount, m_arrPendingWritten.begin() + nBatchEnd, wNewWrittenFiles);
+				m_journal.AppendWritten(m_nPendingPos + nWrittenCount, nBatchEnd - nWrittenCount, wNewWrittenFiles);
+			}
+			bResult = false;
+			break;
+		}
+
+		nWrittenCount = nBatchEnd;
+	}
+
+	// Remove written items
+	m_arrPendingItems.erase(m_arrPendingItems.begin(), m_arrPendingItems.begin() + nWrittenCount);
+	m_arrPendingWritten.erase(m_arrPendingWritten.begin(), m_arrPendingWritten.begin() + nWrittenCount);
+	m_nPendingPos += nWrittenCount;
+
+	return bResult;
+}
+
+/**
+ * @brief	Write current batch into the output files which do not have it yet, then clear the batch
+ * @param	filePath	  - Log file path
+ * @param	logString	  - Log strings (cleared after writing)
+ * @param	wWrittenFiles - Output files which already have the batch (LogJournal::OutputFile flags)
+ * @return	WORD - Output files which have the batch now
+ */
+WORD LogWriter::WriteBatchFiles(const String& filePath, String& logString, WORD wWrittenFiles)
+{
+	// Store file goes first, so that the existing YAML log can be converted before this batch is appended
+	// If it fails, the log file is not written either, otherwise the batch would be converted into the store file
+	// together with the log file when it is retried, and then appended once more
+	if (!(wWrittenFiles & LogJournal::StoreFile) && WriteToStore(filePath)) {
+		wWrittenFiles |= LogJournal::StoreFile;
+	}
+	if ((wWrittenFiles & LogJournal::StoreFile) && !(wWrittenFiles & LogJournal::LogFile) && WriteToFile(filePath, logString)) {
+		wWrittenFiles |= LogJournal::LogFile;
+	}
+
+	logString.Empty();
+	m_storeBlock.Clear();
+
+	return wWrittenFiles;
+}
+
+/**
+ * @brief	Write log strings into a log file, keep the file open for next batches
+ * @param	filePath  - Log file path
+ * @param	logString - Log strings
+ * @return	true/false
+ */
+bool LogWriter::WriteToFile(const String& filePath, const String& logString)
+{
+	// Switch to another file
+	if ((m_fLogFile.m_hFile != CFile::hFileNull) && (filePath != m_strCurFilePath)) {
+		CloseLogFile();
+	}
+
+	// Check if file is opening, if not, open it
+	if (m_fLogFile.m_hFile == CFile::hFileNull) {
+		if (!m_fLogFile.Open(filePath, CFile::modeCreate | CFile::modeNoTruncate | CFile::modeWrite | CFile::shareDenyWrite)) {
+			// Open file failed --> Keep error code for the caller thread to report
+			m_dwLastError.store(GetLastError());
+			return false;
+		}
+
+		m_strCurFilePath = filePath;
+	}
+
+	// Go to end of file
+	ULONGLONG ullFileLength = 0;
+	TRY {
+		ullFileLength = m_fLogFile.SeekToEnd();
+	}
+	CATCH(CFileException, pException) {
+		m_dwLastError.store(pException->m_lOsError);
+		CloseOutputFile(m_fLogFile, m_strCurFilePath);
+		return false;
+	}
+	END_CATCH
+
+	// Write log strings to file
+	// Flush once per batch, so that a crash loses at most one batch
+	TRY {
+		m_fLogFile.Write(logString, logString.GetLength() * sizeof(wchar_t));
+		m_fLogFile.Flush();
+	}
+	CATCH(CFileException, pException) {
+		m_dwLastError.store(pException->m_lOsError);
+
+		// Cut off partially written data, so that the batch is not written twice when it is retried
+		TRY {
+			m_fLogFile.SetLength(ullFileLength);
+		}
+		CATCH(CFileException, pTruncException) {
+			// Keep the write error code
+		}
+		END_CATCH
+		CloseOutputFile(m_fLogFile, m_strCurFilePath);
+		return false;
+	}
+	END_CATCH
+
+	return true;
+}
+
+/**
+ * @brief	Append current store block into the log store file of a log file
+ * @param	filePath - Log file path
+ * @return	true/false
+ */
+bool LogWriter::WriteToStore(const String& filePath)
+{
+	String storeFilePath = LogStoreUtils::GetStoreFilePath(filePath);
+
+	// Switch to another file
+	if ((m_fStoreFile.m_hFile != CFile::hFileNull) && (storeFilePath != m_strCurStorePath)) {
+		m_fStoreFile.Close();
+	}
+
+	// Check if file is opening, if not, open it
+	if (m_fStoreFile.m_hFile == CFile::hFileNull) {
+
+		// Store file does not exist yet: convert items of the existing YAML log file first
+		CFileFind Finder;
+		if ((Finder.FindFile(storeFilePath) != TRUE) && (Finder.FindFile(filePath) == TRUE)) {
+			LogStoreUtils::ConvertYAMLFile(filePath, storeFilePath, m_byLogType);
+		}
+
+		if (!m_fStoreFile.Open(storeFilePath, CFile::modeCreate | CFile::modeNoTruncate | CFile::modeWrite | CFile::shareDenyWrite)) {
+			// Open file failed --> Keep error code for the caller thread to report
+			m_dwLastError.store(GetLastError());
+			return false;
+		}
+
+		m_strCurStorePath = storeFilePath;
+	}
+
+	// Go to end of file
+	ULONGLONG ullFileLength = 0;
+	TRY {
+		ullFileLength = m_fStoreFile.SeekToEnd();
+	}
+	CATCH(CFileException, pException) {
+		m_dwLastError.store(pException->m_lOsError);
+		CloseOutputFile(m_fStoreFile, m_strCurStorePath);
+		return false;
+	}
+	END_CATCH
+
+	// Write the whole block at once
+	if (!m_storeBlock.Write(m_fStoreFile)) {
+		m_dwLastError.store(APP_ERROR_FAILED);
+
+		// Cut off partially written data, so that the next blocks can still be read
+		TRY {
+			m_fStoreFile.SetLength(ullFileLength);
+		}
+		CATCH(CFileException, pTruncException) {
+			// Keep the write error code
+		}
+		END_CATCH
+		CloseOutputFile(m_fStoreFile, m_strCurStorePath);
+		return false;
+	}
+
+	return true;
+}
+
+/**
+ * @brief	Close the opening log files (writer thread only)
+ * @param	None
+ * @return	None
+ */
+void LogWriter::CloseLogFile(void)
+{
+	if (m_fLogFile.m_hFile != CFile::hFileNull) {
+		m_fLogFile.Close();
+	}
+	if (m_fStoreFile.m_hFile != CFile::hFileNull) {
+		m_fStoreFile.Close();
+	}
+	m_strCurFilePath.Empty();
+	m_strCurStorePath.Empty();
+}
+
+/**
+ * @brief	Close an output file after a write error without throwing (writer thread only)
+ *			The file is opened again by the next write
+ * @param	outputFile - Output file
+ * @param	filePath   - Opening file path (emptied)
+ * @return	None
+ */
+void LogWriter::CloseOutputFile(CFile& outputFile, String& filePath)
+{
+	if (outputFile.m_hFile != CFile::hFileNull) {
+		outputFile.Abort();
+	}
+	filePath.Empty();
+}
@@ -8,6 +8,9 @@
  */
 
 #include "AppCore/Logging.h"
+#include "AppCore/LogWriter.h"
+#include "AppCore/LogIndex.h"
+#include "AppCore/LogSpill.h"
 
 #ifdef _DEBUG
 #define new DEBUG_NEW
@@ -18,6 +21,12 @@ using namespace Language;
 using namespace AppCore;
 
 
+// Debug log file write buffer constants
+constexpr const int debugLogBufferLength = 8192;			// Buffer length which triggers writing (in characters)
+constexpr const ULONGLONG debugLogFlushInterval = 1000;		// Max time a log string stays in buffer (in milliseconds)
+constexpr const size_t maxTraceRecordCount = 256;			// Max number of trace records waiting for formatting
+
+
 /**
  * @brief	Get size of data by data type
  * @param	byDataType - Data type
@@ -85,10 +94,10 @@ LogDetail::LogDetail()
 	m_usCategory = INT_NULL;								// Detail category
 	m_nFlag = LogDetailFlag::Flag_Null;						// Detail info flag
 	m_nDetailValue = INT_NULL;								// Detail value (integer)
-	m_strDetailInfo.Empty();								// Detail info (string)
+	m_pszDetailInfo = Constant::String::Empty;				// Detail info (string)
 	m_ptrDetailData = NULL;									// Detail data (pointer)
 	m_byPointerType = LogDataType::Void;					// Detail info pointer data type
-	m_szPointerSize = INT_NULL;								// Detail info pointer data size
+	m_dwPointerSize = INT_NULL;								// Detail info pointer data size
 }
 
 /**
@@ -102,16 +111,17 @@ void LogDetail::Init(void) noexcept
 	m_usCategory = INT_NULL;								// Detail category
 	m_nFlag = LogDetailFlag::Flag_Null;						// Detail info flag
 	m_nDetailValue = INT_NULL;								// Detail value (integer)
-	m_strDetailInfo.Empty();								// Detail info (string)
+	m_pszDetailInfo = Constant::String::Empty;				// Detail info (string)
 	m_ptrDetailData = NULL;									// Detail data (pointer)
 	m_byPointerType = LogDataType::Void;					// Detail info pointer data type
-	m_szPointerSize = INT_NULL;								// Detail info pointer data sizesize
+	m_dwPointerSize = INT_NULL;								// Detail info pointer data size
 }
 
 /**
  * @brief	Copy data from another item
  * @param	other - Pointer of input item
  * @return	None
+ * @note	String and pointer data are shared, both items must be kept in detail info sharing the same arena
  */
 void LogDetail::Copy(const LogDetail& other) noexcept
 {
@@ -122,7 +132,7 @@ void LogDetail::Copy(const LogDetail& other) noexcept
 	m_usCategory = other.m_usCategory;						// Detail category
 	m_nFlag = other.m_nFlag;								// Detail flag
 	m_nDetailValue = other.m_nDetailValue;					// Detail value (integer)
-	m_strDetailInfo = other.m_strDetailInfo;				// Detail info (string)
+	m_pszDetailInfo = other.m_pszDetailInfo;				// Detail info (string)
 	PointerCopy(other);										// Detail data (pointer)
 }
 
@@ -130,15 +140,16 @@ void LogDetail::Copy(const LogDetail& other) noexcept
  * @brief	Copy detail info pointer
  * @param	other - Pointer of input item
  * @return	None
+ * @note	Pointer data is shared (it is never changed once stored in arena)
  */
-void LogDetail::PointerCopy(const LogDetail& other)
+void LogDetail::PointerCopy(const LogDetail& other) noexcept
 {
 	// Copy pointer properties
 	m_byPointerType = other.m_byPointerType;					// Detail info pointer data type
-	m_szPointerSize = other.m_szPointerSize;					// Detail info pointer data size
+	m_dwPointerSize = other.m_dwPointerSize;					// Detail info pointer data size
 
 	// Copy pointer data
-	memcpy(m_ptrDetailData, other.m_ptrDetailData, other.m_szPointerSize);
+	m_ptrDetailData = other.m_ptrDetailData;
 }
 
 /**
@@ -154,7 +165,7 @@ bool LogDetail::Compare(const LogDetail& other) const
 	bRet &= (m_usCategory == other.m_usCategory);				// Detail category
 	bRet &= (m_nFlag == other.m_nFlag);							// Detail flag
 	bRet &= (m_nDetailValue == other.m_nDetailValue);			// Detail value (integer)
-	bRet &= (m_strDetailInfo == other.m_strDetailInfo);			// Detail info (string)
+	bRet &= (_tcscmp(m_pszDetailInfo, other.m_pszDetailInfo) == 0);	// Detail info (string)
 	bRet &= PointerCompare(other);								// Detail data (pointer)
 
 	return bRet;
@@ -171,11 +182,11 @@ bool LogDetail::PointerCompare(const LogDetail& other) const
 
 	// Compare properties
 	bRet &= (m_byPointerType == other.m_byPointerType);			// Detail info pointer data type
-	bRet &= (m_szPointerSize == other.m_szPointerSize);			// Detail info pointer data size
+	bRet &= (m_dwPointerSize == other.m_dwPointerSize);			// Detail info pointer data size
 
 	// Only compare pointer values if properties are matching
-	if (bRet != false) {
-		bRet &= memcmp(m_ptrDetailData, other.m_ptrDetailData, m_szPointerSize);
+	if ((bRet != false) && (m_ptrDetailData != NULL) && (other.m_ptrDetailData != NULL)) {
+		bRet &= (memcmp(m_ptrDetailData, other.m_ptrDetailData, m_dwPointerSize) == 0);
 	}
 
 	return bRet;
@@ -197,13 +208,18 @@ bool LogDetail::IsEmpty(void) const noexcept
 
 /**
  * @brief	Set detail info pointer data
+ * @param	arena		- Arena to store data copy
  * @param	pDataBuff	- Data buffer (pointer)
  * @param	byDataType	- Data type
  * @param	szDataSize	- Data size
  * @return	true/false
  */
-bool LogDetail::SetPointerData(PVOID pDataBuff, byte byDataType /* = DATA_TYPE_UNSPECIFIED */, size_t szDataSize /* = 0 */)
+bool LogDetail::SetPointerData(LogArena& arena, const void* pDataBuff, byte byDataType /* = DATA_TYPE_UNSPECIFIED */, size_t szDataSize /* = 0 */)
 {
+	// No source data
+	if (pDataBuff == NULL)
+		return false;
+
 	// If data type is void (unusable), do nothing
 	if (byDataType == LogDataType::Void)
 		return false;
@@ -222,13 +238,53 @@ bool LogDetail::SetPointerData(PVOID pDataBuff, byte byDataType /* = DATA_TYPE_U
 			return false;
 	}
 
-	// Otherwise, set normally
+	// Otherwise, store a copy of data in arena
+	void* pDataCopy = arena.Allocate(szDataSize, alignof(std::max_align_t));
+	memcpy(pDataCopy, pDataBuff, szDataSize);
 	m_byPointerType = byDataType;
-	m_szPointerSize = szDataSize;
-	memcpy(m_ptrDetailData, pDataBuff, szDataSize);
+	m_dwPointerSize = static_cast<DWORD>(szDataSize);
+	m_ptrDetailData = pDataCopy;
 	return true;
 }
 
+/**
+ * @brief	Add log detail info item
+ * @param	logDetail - Log detail item
+ * @return	None
+ * @note	String and pointer data of the item are copied into arena of this detail info
+ */
+void LogDetailInfo::AddDetail(const LOGDETAIL& logDetail)
+{
+	LOGDETAIL logDetailCopy;
+	logDetailCopy.Copy(logDetail);
+	logDetailCopy.SetDetailString(GetArena().CopyString(logDetail.GetDetailString()));
+	if (logDetail.GetPointerData() != NULL) {
+		logDetailCopy.SetPointerData(GetArena(), logDetail.GetPointerData(), logDetail.GetPointerType(), logDetail.GetPointerSize());
+	}
+	this->push_back(std::move(logDetailCopy));
+}
+
+/**
+ * @brief	Copy data from another detail info
+ * @param	other - Source detail info
+ * @return	None
+ * @note	Also take over the arena of source data, so that copied items share its string and pointer data
+ */
+void LogDetailInfo::CopyData(const LogDetailInfo& other)
+{
+	// Do not copy itself
+	if (this == &other) return;
+
+	LOGDETAILARRAY arrDetailCopy(other.get_allocator());
+	arrDetailCopy.reserve(other.size());
+	for (const LOGDETAIL& logDetail : other) {
+		LOGDETAIL logDetailCopy;
+		logDetailCopy.Copy(logDetail);
+		arrDetailCopy.push_back(std::move(logDetailCopy));
+	}
+	LOGDETAILARRAY::swap(arrDetailCopy);
+}
+
 /**
  * @brief	Add log detail info item
  * @param	logDetail	  - Log detail item
@@ -247,7 +303,7 @@ void LogDetailInfo::AddDetail(USHORT usCategory, int nDetailInfo, int nFlag /* =
 	logDetail.SetFlag(nFlag);
 
 	// Add detail info item
-	this->AddDetail(logDetail);
+	this->push_back(std::move(logDetail));
 }
 
 void LogDetailInfo::AddDetail(USHORT usCategory, const wchar_t* detailInfo, int nFlag /* = LogDetailFlag::Flag_Null */)
@@ -255,11 +311,11 @@ void LogDetailInfo::AddDetail(USHORT usCategory, const wchar_t* detailInfo, int
 	// Prepare detail info item
 	LOGDETAIL logDetail;
 	logDetail.SetCategory(usCategory);
-	logDetail.SetDetailString(detailInfo);
+	logDetail.SetDetailString(GetArena().CopyString(detailInfo));
 	logDetail.SetFlag(nFlag);
 
 	// Add detail info item
-	this->AddDetail(logDetail);
+	this->push_back(std::move(logDetail));
 }
 
 void LogDetailInfo::AddDetail(USHORT usCategory, int nDetailInfo, const wchar_t* detailInfo, int nFlag /* = LogDetailFlag::Flag_Null */)
@@ -268,11 +324,11 @@ void LogDetailInfo::AddDetail(USHORT usCategory, int nDetailInfo, const wchar_t*
 	LOGDETAIL logDetail;
 	logDetail.SetCategory(usCategory);
 	logDetail.SetDetailValue(nDetailInfo);
-	logDetail.SetDetailString(detailInfo);
+	logDetail.SetDetailString(GetArena().CopyString(detailInfo));
 	logDetail.SetFlag(nFlag);
 
 	// Add detail info item
-	this->AddDetail(logDetail);
+	this->push_back(std::move(logDetail));
 }
 
 /**
@@ -288,6 +344,33 @@ LogItem::LogItem()
 	m_arrDetailInfo.clear();								// Log detail info
 }
 
+/**
+ * @brief	Move constructor
+ */
+LogItem::LogItem(LogItem&& other) noexcept
+	: m_stTime(other.m_stTime),
+	m_dwProcessID(other.m_dwProcessID),
+	m_usCategory(other.m_usCategory),
+	m_strLogString(std::move(other.m_strLogString)),
+	m_arrDetailInfo(std::move(other.m_arrDetailInfo))
+{
+}
+
+/**
+ * @brief	Move assignment operator
+ */
+LogItem& LogItem::operator=(LogItem&& other) noexcept
+{
+	if (this != &other) {
+		m_stTime = other.m_stTime;							// Log time
+		m_dwProcessID = other.m_dwProcessID;				// Process ID
+		m_usCategory = other.m_usCategory;					// Log category
+		m_strLogString = std::move(other.m_strLogString);	// Log string
+		m_arrDetailInfo = std::move(other.m_arrDetailInfo);	// Log detail info
+	}
+	return *this;
+}
+
 /**
  * @brief	Copy data from another log item
  * @param	other - Pointer of input item
@@ -374,10 +457,22 @@ void LogItem::RemoveAll(void) noexcept
  */
 String LogItem::FormatDateTime(void) const
 {
-	const wchar_t* middayFlag = (m_stTime.Hour() >= 12) ? Constant::Symbol::PostMeridiem : Constant::Symbol::AnteMeridiem;
-	String templateFormatStr = StringUtils::LoadResourceString(IDS_FORMAT_FULLDATETIME);
-	String timeFormatString = StringUtils::StringFormat(templateFormatStr, m_stTime.Year(), m_stTime.Month(), m_stTime.Day(),
-		m_stTime.Hour(), m_stTime.Minute(), m_stTime.Second(), m_stTime.Millisecond(), middayFlag);
+	return FormatDateTime(m_stTime);
+}
+
+/**
+ * @brief	Return a formatted log date/time string
+ * @param	stTime - Log time
+ * @return	String - Formatted result
+ */
+String LogItem::FormatDateTime(const DateTime& stTime)
+{
+	// Resource format template string is loaded only once
+	static const String templateFormatStr = StringUtils::LoadResourceString(IDS_FORMAT_FULLDATETIME);
+	const DateTime::Fields timeFields = stTime.Decompose();
+	const wchar_t* middayFlag = (timeFields.hour >= 12) ? Constant::Symbol::PostMeridiem : Constant::Symbol::AnteMeridiem;
+	String timeFormatString = StringUtils::StringFormat(templateFormatStr, timeFields.year, timeFields.month, timeFields.day,
+		timeFields.hour, timeFields.minute, timeFields.second, timeFields.millisecond, middayFlag);
 
 	return timeFormatString;
 }
@@ -388,6 +483,174 @@ String LogItem::FormatDateTime(void) const
  * @return	String - Formatted result
  */
 String LogItem::FormatOutput(void) const
+{
+	String logYAMLFormat;
+	FormatOutput(logYAMLFormat);
+	return logYAMLFormat;
+}
+
+/**
+ * @brief	Append a YAML key-value property into output buffer
+ * @param	outputBuffer - Output buffer
+ * @param	indentation	 - Indentation string
+ * @param	keyName		 - Key name
+ * @param	value		 - Value string
+ * @return	None
+ */
+static void AppendYAMLProperty(String& outputBuffer, const wchar_t* indentation, const wchar_t* keyName, const wchar_t* value)
+{
+	outputBuffer.Append(indentation);
+	outputBuffer.Append(keyName);
+	outputBuffer.Append(_T(": \""));
+	outputBuffer.Append(value);
+	outputBuffer.Append(_T("\"\n"));
+}
+
+/**
+ * @brief	Get output key and value of a log detail item
+ * @param	logDetail - Log detail item
+ * @param	keyName	  - Output key name (ref-value)
+ * @param	value	  - Output string value, NULL for integer value (ref-value)
+ * @return	true/false - Whether the item is written to file
+ */
+static bool GetDetailOutput(const LOGDETAIL& logDetail, const wchar_t*& keyName, const wchar_t*& value)
+{
+	// Skip if detail item is read-only
+	int nDetailFlag = logDetail.GetFlag();
+	if (nDetailFlag & LogDetailFlag::ReadOnly_Data)
+		return false;
+
+	// NULL flag --> apply default flags
+	if (nDetailFlag == LogDetailFlag::Flag_Null) {
+		nDetailFlag = LogDetailFlag::Write_Int;
+	}
+
+	// Detail info category and value
+	keyName = GetString(StringTable::LogKey, logDetail.GetCategory());
+	value = NULL;
+	if (nDetailFlag & LogDetailFlag::Write_Int)
+		return true;
+	else if (nDetailFlag & LogDetailFlag::LookUp_Dict)
+		value = GetString(StringTable::LogValue, logDetail.GetDetailValue());
+	else if (nDetailFlag & LogDetailFlag::Write_String)
+		value = logDetail.GetDetailString();
+	else
+		return false;
+
+	return true;
+}
+
+/**
+ * @brief	Append formatted output log string (YAML format) into output buffer
+ * @param	outputBuffer - Output buffer (formatted result is appended)
+ * @return	None
+ * @note	Output is identical to the JSON data tree path (FormatOutputJSON),
+ *			but written directly without building the tree
+ */
+void LogItem::FormatOutput(String& outputBuffer) const
+{
+	// Load default language table package
+	LANGTABLE_PTR pDefLang = LoadLanguageTable(NULL);
+
+	// Number conversion buffer
+	wchar_t numberBuff[16];
+
+	/*********************************************************************/
+	/*																	 */
+	/*						Output log item base info					 */
+	/*																	 */
+	/*********************************************************************/
+
+	// Log time
+	// Resource format template string is loaded only once
+	static const String templateFormatStr = StringUtils::LoadResourceString(IDS_FORMAT_FULLDATETIME);
+	const DateTime::Fields timeFields = m_stTime.Decompose();
+	const wchar_t* middayFlag = (timeFields.hour >= 12) ? Constant::Symbol::PostMeridiem : Constant::Symbol::AnteMeridiem;
+	wchar_t dateTimeBuff[128];
+	int nLength = std::swprintf(dateTimeBuff, _countof(dateTimeBuff), templateFormatStr.GetString(), timeFields.year, timeFields.month,
+		timeFields.day, timeFields.hour, timeFields.minute, timeFields.second, timeFields.millisecond, middayFlag);
+	if (nLength >= 0) {
+		AppendYAMLProperty(outputBuffer, Constant::String::Empty, GetString(StringTable::LogKey, BaseLog::Time), dateTimeBuff);
+	}
+	else {
+		AppendYAMLProperty(outputBuffer, Constant::String::Empty, GetString(StringTable::LogKey, BaseLog::Time), FormatDateTime());
+	}
+
+	// Process ID
+	_itow_s(static_cast<int>(m_dwProcessID), numberBuff, 10);
+	AppendYAMLProperty(outputBuffer, Constant::String::Empty, GetString(StringTable::LogKey, BaseLog::PID), numberBuff);
+
+	// Log category
+	AppendYAMLProperty(outputBuffer, Constant::String::Empty, GetString(StringTable::LogKey, BaseLog::LogCategory), GetLanguageString(pDefLang, m_usCategory));
+
+	// Log description string
+	AppendYAMLProperty(outputBuffer, Constant::String::Empty, GetString(StringTable::LogKey, BaseLog::Description), m_strLogString.GetString());
+
+	/*********************************************************************/
+	/*																	 */
+	/*						Output log item detail info					 */
+	/*																	 */
+	/*********************************************************************/
+
+	if (!m_arrDetailInfo.empty()) {
+
+		// Object name: Details
+		const wchar_t* indentation = Constant::String::Empty;
+		const wchar_t* detailsName = GetString(StringTable::LogKey, BaseLog::Details);
+		if (_tcslen(detailsName) > 0) {
+			outputBuffer.Append(detailsName);
+			outputBuffer.Append(_T(":\n"));
+			indentation = Constant::Symbol::YAML_Indent;
+		}
+
+		const wchar_t* keyName = NULL;
+		const wchar_t* value = NULL;
+		const wchar_t* otherKeyName = NULL;
+		const wchar_t* otherValue = NULL;
+		size_t nDetailCount = m_arrDetailInfo.size();
+		for (size_t nIndex = 0; nIndex < nDetailCount; nIndex++) {
+
+			if (!GetDetailOutput(m_arrDetailInfo.at(nIndex), keyName, value))
+				continue;
+
+			// A duplicated key only keeps its first position, with the last value
+			// (same as JSON::AddString which replaces existing value)
+			bool bDuplicated = false;
+			for (size_t nPrevIndex = 0; (nPrevIndex < nIndex) && (bDuplicated == false); nPrevIndex++) {
+				if (GetDetailOutput(m_arrDetailInfo.at(nPrevIndex), otherKeyName, otherValue))
+					bDuplicated = (_tcscmp(otherKeyName, keyName) == 0);
+			}
+			if (bDuplicated == true)
+				continue;
+
+			size_t nValueIndex = nIndex;
+			for (size_t nNextIndex = nIndex + 1; nNextIndex < nDetailCount; nNextIndex++) {
+				if (GetDetailOutput(m_arrDetailInfo.at(nNextIndex), otherKeyName, otherValue) && (_tcscmp(otherKeyName, keyName) == 0)) {
+					nValueIndex = nNextIndex;
+					value = otherValue;
+				}
+			}
+
+			// Integer value
+			if (value == NULL) {
+				_itow_s(m_arrDetailInfo.at(nValueIndex).GetDetailValue(), numberBuff, 10);
+				value = numberBuff;
+			}
+
+			AppendYAMLProperty(outputBuffer, indentation, keyName, value);
+		}
+	}
+
+	outputBuffer.Append(Constant::String::NewLine);
+}
+
+/**
+ * @brief	Return formatted output log string by converting into JSON data tree
+ * @param	None
+ * @return	String - Formatted result
+ * @note	Reference implementation of output format (used for verification and benchmarking)
+ */
+String LogItem::FormatOutputJSON(void) const
 {
 	// Create JSON data object
 	JSONDATA jsonData;
@@ -443,7 +706,7 @@ String LogItem::FormatOutput(void) const
 		for (int nIndex = 0; nIndex < (m_arrDetailInfo.size()); nIndex++) {
 
 			// Get detail info item
-			LOGDETAIL logDetail = m_arrDetailInfo.at(nIndex);
+			const LOGDETAIL& logDetail = m_arrDetailInfo.at(nIndex);
 
 			// Skip if detail item is read-only
 			int nDetailFlag = logDetail.GetFlag();
@@ -747,7 +1010,7 @@ void JSON::AddString(const wchar_t* keyName, const wchar_t* value)
 void JSON::AddInteger(const wchar_t* keyName, int nValue)
 {
 	// Convert integer to string
-	String valueStr = StringUtils::StringFormat(_T("%d"), nValue);
+	String valueStr = String::FromNumber(nValue);
 
 	// Add property
 	AddString(keyName, valueStr);
@@ -763,7 +1026,7 @@ void JSON::AddInteger(const wchar_t* keyName, int nValue)
 void JSON::AddFloat(const wchar_t* keyName, DOUBLE dbValue)
 {
 	// Convert float number to string
-	String valueStr = StringUtils::StringFormat(_T("%f"), dbValue);
+	String valueStr = String::FromNumber(dbValue);
 
 	// Add property
 	AddString(keyName, valueStr);
@@ -840,12 +1103,9 @@ void JSON::Print(String& outputString, int nIndent, bool bSeparator, bool bMulti
 	// Add indentation
 	outputString.Append(indentationStr);
 
-	String formatStr = Constant::String::Empty;
-
 	// Print object name (if set)
 	if (!this->m_strObjectName.IsEmpty()) {
-		formatStr.Format(_T("\"%s\": "), this->m_strObjectName.GetString());
-		outputString.Append(formatStr);
+		outputString.AppendFormat(_T("\"%s\": "), this->m_strObjectName.GetString());
 	}
 
 	// Opening bracket
@@ -869,16 +1129,14 @@ void JSON::Print(String& outputString, int nIndent, bool bSeparator, bool bMulti
 			((this->m_nChildObjectCount <= 0) || (this->m_apChildObjectList == NULL))) {
 
 			// Last property (no other child object following) has no comma in the end
-			formatStr.Format(_T("\t\"%s\": \"%s\" "), jsonEntry.strKey.GetString(), jsonEntry.strValue.GetString());
-			outputString.Append(formatStr);
+			outputString.AppendFormat(_T("\t\"%s\": \"%s\" "), jsonEntry.strKey.GetString(), jsonEntry.strValue.GetString());
 			if (bMultiline == true) {
 				outputString.Append(Constant::String::EndLine);
 			}
 		}
 		else {
 			// Add comma character at the end of each property
-			formatStr.Format(_T("\t\"%s\": \"%s\", "), jsonEntry.strKey.GetString(), jsonEntry.strValue.GetString());
-			outputString.Append(formatStr);
+			outputString.AppendFormat(_T("\t\"%s\": \"%s\", "), jsonEntry.strKey.GetString(), jsonEntry.strValue.GetString());
 			if (bMultiline == true) {
 				outputString.Append(Constant::String::EndLine);
 			}
@@ -927,28 +1185,24 @@ void JSON::PrintYAML(String& outputString, int nIndent) const
 		indentationStr.Append(Constant::Symbol::YAML_Indent);
 	}
 
-	String formatStr = Constant::String::Empty;
-
 	// Print object name (if set)
 	if (!this->m_strObjectName.IsEmpty()) {
-		formatStr = StringUtils::StringFormat(_T("%s%s:\n"), indentationStr.GetString(), this->m_strObjectName.GetString());
-		outputString.Append(formatStr);
+		outputString.AppendFormat(_T("%s%s:\n"), indentationStr.GetString(), this->m_strObjectName.GetString());
 		indentationStr.Append(Constant::Symbol::YAML_Indent); // Add one more indent for properties
 	}
 
 	// Print key-value pairs
 	for (int nIndex = 0; nIndex < this->m_arrKeyValuePairs.size(); nIndex++) {
 		const JSON_ENTRY& jsonEntry = this->m_arrKeyValuePairs.at(nIndex);
-		formatStr = StringUtils::StringFormat(_T("%s%s: \"%s\"\n"), indentationStr.GetString(), jsonEntry.strKey.GetString(), jsonEntry.strValue.GetString());
-		outputString.Append(formatStr);
+		outputString.AppendFormat(_T("%s%s: \"%s\"\n"), indentationStr.GetString(), jsonEntry.strKey.GetString(), jsonEntry.strValue.GetString());
 	}
 
 	// Print child objects
 	if ((this->m_nChildObjectCount > 0) && (this->m_apChildObjectList != NULL)) {
+		String subItemOutput;
 		for (int nCount = 0; nCount < this->m_nChildObjectCount; nCount++) {
 			PJSONDATA pSubItem = this->m_apChildObjectList[nCount];
 			if (pSubItem != NULL) {
-				String subItemOutput;
 				pSubItem->PrintYAML(subItemOutput, nIndent + 1);
 				outputString.Append(subItemOutput);
 			}
@@ -970,6 +1224,22 @@ SLogging::SLogging(byte byLogType)
 	m_nMaxSize = INT_INFINITE;
 	m_strFilePath = Constant::String::Empty;
 	m_pItemDefTemplate = NULL;
+
+	// Background writer
+	m_pLogWriter = NULL;
+	m_nWrittenCount = 0;
+
+	// Search index
+	m_pLogIndex = NULL;
+
+	// Ring buffer mode
+	m_nRingCapacity = 0;
+	m_nSegmentSize = 0;
+	m_nRingHead = 0;
+	m_nMemoryCount = 0;
+	m_nSpilledCount = 0;
+	m_pLogSpill = NULL;
+	m_nSpillCacheIndex = INT_INFINITE;
 }
 
 /**
@@ -977,9 +1247,21 @@ SLogging::SLogging(byte byLogType)
  */
 SLogging::~SLogging()
 {
+	// Stop background writer
+	StopWriter();
+
+	// Stop indexing
+	StopIndexing();
+
 	// Clean up log data
 	m_arrLogData.clear();
 
+	// Remove spill file
+	if (m_pLogSpill != NULL) {
+		delete m_pLogSpill;
+		m_pLogSpill = NULL;
+	}
+
 	// Clean up default item template
 	if (m_pItemDefTemplate != NULL) {
 		delete m_pItemDefTemplate;
@@ -987,17 +1269,71 @@ SLogging::~SLogging()
 	}
 }
 
+/**
+ * @brief	Initialize log data
+ * @param	None
+ * @return	None
+ */
+void SLogging::Init(void) noexcept
+{
+	m_arrLogData.clear();
+	m_nWrittenCount = 0;
+
+	// Reset ring buffer and remove spilled items
+	m_nRingHead = 0;
+	m_nMemoryCount = 0;
+	m_nSpilledCount = 0;
+	m_nSpillCacheIndex = INT_INFINITE;
+	m_spillCacheItem.RemoveAll();
+	if (m_pLogSpill != NULL) {
+		m_pLogSpill->Reset();
+	}
+
+	if (m_pLogIndex != NULL) {
+		m_pLogIndex->Clear();
+	}
+}
+
+/**
+ * @brief	Remove all log data
+ * @param	None
+ * @return	None
+ */
+void SLogging::DeleteAll(void) noexcept
+{
+	m_arrLogData.clear();
+	m_nWrittenCount = 0;
+
+	// Reset ring buffer and remove spilled items
+	m_nRingHead = 0;
+	m_nMemoryCount = 0;
+	m_nSpilledCount = 0;
+	m_nSpillCacheIndex = INT_INFINITE;
+	m_spillCacheItem.RemoveAll();
+	if (m_pLogSpill != NULL) {
+		m_pLogSpill->Reset();
+	}
+
+	if (m_pLogIndex != NULL) {
+		m_pLogIndex->Clear();
+	}
+}
+
 /**
  * @brief	Return a specific log item of log list
  * @param	nIndex - Item index
  * @return	LOGITEM - Return log item
+ * @note	Items spilled to disk can not be changed, use the const version to read them
  */
 LOGITEM& SLogging::GetLogItem(int nIndex)
 {
+	// Empty dummy item
+	static LOGITEM logDummyItem;
+
 	// If current log data is empty
 	if (this->IsEmpty()) {
 		// Return an empty dummy item
-		static LOGITEM logDummyItem;
+		logDummyItem.RemoveAll();
 		return logDummyItem;
 	}
 
@@ -1011,9 +1347,24 @@ LOGITEM& SLogging::GetLogItem(int nIndex)
 		nIndex = (GetLogCount() - 1);
 	}
 
-	return m_arrLogData.at(nIndex);
+	// Item was spilled to disk: its data can not be changed
+	if (static_cast<size_t>(nIndex) < m_nSpilledCount) {
+		ATLASSERT(FALSE);
+		TRACE_FORMAT("Error: Spilled log item can not be changed!!! (Index: %d)", nIndex);
+		logDummyItem.RemoveAll();
+		return logDummyItem;
+	}
+
+	return m_arrLogData.at(GetRingPosition(nIndex - m_nSpilledCount));
 }
 
+/**
+ * @brief	Return a specific log item of log list (read-only)
+ * @param	nIndex - Item index
+ * @return	LOGITEM - Return log item
+ * @note	A spilled item is read back into a cache item which is reused by the next call,
+ *			so the returned reference is only valid until the next call
+ */
 const LOGITEM& SLogging::GetLogItem(int nIndex) const
 {
 	// If current log data is empty
@@ -1033,7 +1384,11 @@ const LOGITEM& SLogging::GetLogItem(int nIndex) const
 		nIndex = (GetLogCount() - 1);
 	}
 
-	return m_arrLogData.at(nIndex);
+	// Item was spilled to disk
+	if (static_cast<size_t>(nIndex) < m_nSpilledCount)
+		return ReadSpilledItem(nIndex);
+
+	return m_arrLogData.at(GetRingPosition(nIndex - m_nSpilledCount));
 }
 
 /**
@@ -1066,10 +1421,34 @@ void SLogging::SetDefaultTemplate(const LOGITEM& logItemTemplate) noexcept
  * @return	None
  */
 void SLogging::OutputItem(const LOGITEM& logItem)
+{
+	OutputItem(LOGITEM(logItem));
+}
+
+/**
+ * @brief	Add a log item into log data (item data is moved into log data)
+ * @param	logItem	- Log item to write
+ * @return	None
+ */
+void SLogging::OutputItem(LOGITEM&& logItem)
 {
 	if (GetWriteMode() == LogWriteMode::WriteInstantly) {
-		// Write instantly
-		Write(logItem);
+		if (IsWriterRunning()) {
+			// Hand over to background writer (items kept from last time go first)
+			// If the queue is full, wait for the writer to catch up once
+			if (!EnqueueInstantItem(logItem)) {
+				m_pLogWriter->Flush();
+				if (!EnqueueInstantItem(logItem)) {
+					// Still full: keep the item in log data, it will be handed over with the next items
+					m_arrLogData.push_back(std::move(logItem));
+					m_nMemoryCount++;
+				}
+			}
+		}
+		else {
+			// Write instantly
+			Write(logItem);
+		}
 	}
 	else {
 		// If already reached max data size
@@ -1080,11 +1459,81 @@ void SLogging::OutputItem(const LOGITEM& logItem)
 			return;
 		}
 
-		// Store log data
-		m_arrLogData.push_back(logItem);
+		// Ring buffer is full: spill the oldest items to disk
+		if (IsRingBufferEnabled() && (m_nMemoryCount >= m_nRingCapacity)) {
+			SpillOldestSegment();
+		}
+
+		// Index new item (in background)
+		if (m_pLogIndex != NULL) {
+			m_pLogIndex->AddItem(logItem);
+		}
+
+		// Store log data (reuse a free ring buffer slot if available)
+		if (m_nMemoryCount < m_arrLogData.size()) {
+			m_arrLogData.at(GetRingPosition(m_nMemoryCount)) = std::move(logItem);
+		}
+		else {
+			m_arrLogData.push_back(std::move(logItem));
+		}
+		m_nMemoryCount++;
+
+		// Hand over new items to background writer
+		HandOffPendingItems();
+	}
+
+	// Report errors from background writer
+	if (IsWriterRunning()) {
+		DWORD dwErrCode = m_pLogWriter->TakeLastError();
+		if (dwErrCode != APP_ERROR_SUCCESS) {
+			TRACE_FORMAT("Write log failed: Can not open/create log file!!! (Code: 0x%08X)", dwErrCode);
+			PostMessage(GET_HANDLE_MAINWND(), SM_APP_ERROR_MESSAGE, (WPARAM)dwErrCode, NULL);
+		}
+	}
+
+	// Report errors from spill thread (failed segments are kept in memory)
+	if (m_pLogSpill != NULL) {
+		DWORD dwErrCode = m_pLogSpill->TakeLastError();
+		if (dwErrCode != APP_ERROR_SUCCESS) {
+			TRACE_FORMAT("Spill log data failed: Can not write spill file!!! (Code: 0x%08X)", dwErrCode);
+		}
 	}
 }
 
+/**
+ * @brief	Enable ring buffer mode: keep only the latest items in memory
+ *			and spill older items to disk in the background
+ * @param	nCapacity	 - Ring buffer capacity (max number of in-memory items)
+ * @param	nSegmentSize - Number of items spilled at once
+ * @return	true/false
+ */
+bool SLogging::EnableRingBuffer(size_t nCapacity, size_t nSegmentSize)
+{
+	// Can only be enabled before any item is stored
+	if (!IsEmpty())
+		return false;
+
+	// Each segment is written as one log store block
+	nSegmentSize = (std::min)(nSegmentSize, LogStore::maxBlockItemCount);
+	if ((nSegmentSize == 0) || (nSegmentSize > nCapacity))
+		return false;
+
+	// Initialize spill file
+	if (m_pLogSpill == NULL) {
+		m_pLogSpill = new LogSpill(m_byLogType);
+		if (m_pLogSpill == NULL) {
+			TRACE_ERROR("Log spill initialization failed!!!");
+			TRACE_DEBUG(__FUNCTION__, __FILENAME__, __LINE__);
+			return false;
+		}
+	}
+
+	m_nRingCapacity = nCapacity;
+	m_nSegmentSize = nSegmentSize;
+	m_arrLogData.reserve(nCapacity);
+	return true;
+}
+
 /**
  * @brief	Add a log string into log list data
  * @param	logString - Log string
@@ -1112,7 +1561,7 @@ void SLogging::OutputString(const wchar_t* logString, bool bUseLastTemplate /* =
 			}
 			else {
 				// Copy template
-				logItem.Copy(this->GetLogItem(GetLogCount() - 1));
+				logItem.Copy(std::as_const(*this).GetLogItem(GetLogCount() - 1));
 			}
 		}
 		else {
@@ -1131,7 +1580,7 @@ void SLogging::OutputString(const wchar_t* logString, bool bUseLastTemplate /* =
 		// Update log item data
 		logItem.SetTime(stLogTime);
 		logItem.SetLogString(logString);
-		OutputItem(logItem);
+		OutputItem(std::move(logItem));
 	}
 }
 
@@ -1146,6 +1595,18 @@ bool SLogging::Write(void)
 	DWORD dwErrCode;
 	HWND hMainWnd = GET_HANDLE_MAINWND();
 
+	// Background writer is running: hand over all remaining items and wait until they're written
+	if ((this->GetWriteMode() != LogWriteMode::ReadOnly) && IsWriterRunning()) {
+		HandOffPendingItems();
+		while (m_nWrittenCount < GetLogCount()) {
+			// Writer is retrying failed items: the rest are kept in log data and handed over next time
+			if (!m_pLogWriter->Flush())
+				return false;
+			HandOffPendingItems();
+		}
+		return m_pLogWriter->Flush();
+	}
+
 	// Quit if current log is set as Read-only
 	// or current log mode is write instantly mode
 	if ((this->GetWriteMode() == LogWriteMode::ReadOnly) ||
@@ -1168,18 +1629,21 @@ bool SLogging::Write(void)
 	PerformanceCounter counter;
 	counter.Start();
 
-	for (int nIndex = 0; nIndex < GetLogCount(); nIndex++)
+	// Skip items which are already written
+	for (int nIndex = static_cast<int>(m_nWrittenCount); nIndex < GetLogCount(); nIndex++)
 	{
 		// Get log item
-		logItem = GetLogItem(nIndex);
+		logItem = std::as_const(*this).GetLogItem(nIndex);
 		stTemp = logItem.GetTime();
 
 		// Get filename according to type of logs
 		switch (m_byLogType)
 		{
 		case LOGTYPE_APP_EVENT:
+		{
 			// Format app event log filename
-			fileName.Format(Constant::File::Name::AppEventLog, stTemp.Year(), stTemp.Month());
+			const DateTime::Fields timeFields = stTemp.Decompose();
+			fileName.Format(Constant::File::Name::AppEventLog, timeFields.year, timeFields.month);
 			filePath = StringUtils::MakeFilePath(folderPath, fileName, Constant::File::Extension::Log);
 			if (currentFileName.IsEmpty()) {
 				// Set current file name
@@ -1206,6 +1670,7 @@ bool SLogging::Write(void)
 				currentFileName = fileName;
 			}
 			break;
+		}
 
 		case LOGTYPE_HISTORY_LOG:
 			// App history log
@@ -1246,7 +1711,7 @@ bool SLogging::Write(void)
 		}
 
 		// Format output log strings
-		logFormatString += logItem.FormatOutput();
+		logItem.FormatOutput(logFormatString);
 	}
 
 	if (!logFormatString.IsEmpty()) {
@@ -1259,6 +1724,7 @@ bool SLogging::Write(void)
 	if (fLogFile.m_hFile != CFile::hFileNull) {
 		fLogFile.Close();
 	}
+	m_nWrittenCount = GetLogCount();
 
 	// Display performance counter
 	counter.Stop();
@@ -1295,9 +1761,12 @@ bool SLogging::Write(const LOGITEM& logItem, const wchar_t* /* filePath = NULL *
 	switch (m_byLogType)
 	{
 	case LOGTYPE_APP_EVENT:
+	{
 		// Format app event log filename
-		fileName.Format(Constant::File::Name::AppEventLog, stTimeTemp.Year(), stTimeTemp.Month());
+		const DateTime::Fields timeFields = stTimeTemp.Decompose();
+		fileName.Format(Constant::File::Name::AppEventLog, timeFields.year, timeFields.month);
 		break;
+	}
 
 	case LOGTYPE_HISTORY_LOG:
 		// App history log
@@ -1386,9 +1855,12 @@ bool SLogging::Write(const wchar_t* logString, const wchar_t* /* filePath  = NUL
 	switch (m_byLogType)
 	{
 	case LOGTYPE_APP_EVENT:
+	{
 		// Format app event log filename
-		fileName.Format(Constant::File::Name::AppEventLog, stCurTime.Year(), stCurTime.Month());
+		const DateTime::Fields timeFields = stCurTime.Decompose();
+		fileName.Format(Constant::File::Name::AppEventLog, timeFields.year, timeFields.month);
 		break;
+	}
 
 	case LOGTYPE_HISTORY_LOG:
 		// App history log
@@ -1454,6 +1926,202 @@ bool SLogging::Write(const wchar_t* logString, const wchar_t* /* filePath  = NUL
 	return true;
 }
 
+/**
+ * @brief	Start background writer for current log write mode
+ * @param	None
+ * @return	true/false
+ */
+bool SLogging::StartWriter(void)
+{
+	// Read-only log data can not be written
+	if (GetWriteMode() == LogWriteMode::ReadOnly)
+		return false;
+
+	// Initialize writer
+	if (m_pLogWriter == NULL) {
+		m_pLogWriter = new LogWriter(m_byLogType);
+		if (m_pLogWriter == NULL) {
+			TRACE_ERROR("Background log writer initialization failed!!!");
+			TRACE_DEBUG(__FUNCTION__, __FILENAME__, __LINE__);
+			return false;
+		}
+	}
+
+	// Start writer thread
+	if (!m_pLogWriter->Start())
+		return false;
+
+	// Hand over items which are not written yet
+	HandOffPendingItems();
+	return true;
+}
+
+/**
+ * @brief	Write all pending items and stop background writer
+ * @param	None
+ * @return	None
+ */
+void SLogging::StopWriter(void)
+{
+	if (m_pLogWriter == NULL)
+		return;
+
+	// Hand over items which are not queued yet (kept while the queue was full)
+	while (IsWriterRunning() && (m_nWrittenCount < GetLogCount())) {
+		HandOffPendingItems();
+		if (m_nWrittenCount < GetLogCount()) {
+			// Writer is retrying failed items, so the queue won't be drained
+			if (!m_pLogWriter->Flush())
+				break;
+		}
+	}
+
+	// Wait for all pending items to be written
+	m_pLogWriter->Stop();
+
+	delete m_pLogWriter;
+	m_pLogWriter = NULL;
+}
+
+/**
+ * @brief	Check if background writer is running
+ * @param	None
+ * @return	true/false
+ */
+bool SLogging::IsWriterRunning(void) const noexcept
+{
+	return ((m_pLogWriter != NULL) && (m_pLogWriter->IsRunning()));
+}
+
+/**
+ * @brief	Start building search index of log data in background
+ * @param	None
+ * @return	true/false
+ */
+bool SLogging::StartIndexing(void)
+{
+	// Initialize index with current log data
+	if (m_pLogIndex == NULL) {
+		m_pLogIndex = new LogIndex;
+		if (m_pLogIndex == NULL) {
+			TRACE_ERROR("Log index initialization failed!!!");
+			TRACE_DEBUG(__FUNCTION__, __FILENAME__, __LINE__);
+			return false;
+		}
+		for (size_t nIndex = 0; nIndex < GetLogCount(); nIndex++) {
+			m_pLogIndex->AddItem(std::as_const(*this).GetLogItem(static_cast<int>(nIndex)));
+		}
+	}
+
+	// Start indexing thread
+	return m_pLogIndex->Start();
+}
+
+/**
+ * @brief	Stop indexing and release search index
+ * @param	None
+ * @return	None
+ */
+void SLogging::StopIndexing(void)
+{
+	if (m_pLogIndex == NULL)
+		return;
+
+	m_pLogIndex->Stop();
+
+	delete m_pLogIndex;
+	m_pLogIndex = NULL;
+}
+
+/**
+ * @brief	Hand over log data items which are not written yet to background writer
+ * @param	None
+ * @return	None
+ */
+void SLogging::HandOffPendingItems(void)
+{
+	if (!IsWriterRunning())
+		return;
+
+	// If the queue is full, remaining items will be handed over next time
+	while (m_nWrittenCount < GetLogCount()) {
+		if (!m_pLogWriter->Enqueue(std::as_const(*this).GetLogItem(static_cast<int>(m_nWrittenCount))))
+			break;
+		m_nWrittenCount++;
+	}
+}
+
+/**
+ * @brief	Hand over a log item to background writer in write instantly mode
+ * @param	logItem - Log item (only moved if the item is queued)
+ * @return	true/false - false if the queue is full
+ * @note	Items kept in log data while the queue was full are handed over first
+ */
+bool SLogging::EnqueueInstantItem(LOGITEM& logItem)
+{
+	HandOffPendingItems();
+	if (m_nWrittenCount < GetLogCount())
+		return false;
+
+	// All kept items are queued, release them
+	if (m_nMemoryCount > 0) {
+		m_arrLogData.clear();
+		m_nMemoryCount = 0;
+		m_nRingHead = 0;
+		m_nWrittenCount = 0;
+	}
+
+	return m_pLogWriter->Enqueue(std::move(logItem));
+}
+
+/**
+ * @brief	Move the oldest segment of in-memory items to spill file
+ * @param	None
+ * @return	None
+ */
+void SLogging::SpillOldestSegment(void)
+{
+	size_t nCount = (std::min)(m_nSegmentSize, m_nMemoryCount);
+	if ((m_pLogSpill == NULL) || (nCount == 0))
+		return;
+
+	// Move items out of the ring buffer (their slots are reused by new items)
+	LogSpill::SEGMENT segment;
+	segment.reserve(nCount);
+	for (size_t nIndex = 0; nIndex < nCount; nIndex++) {
+		segment.push_back(std::move(m_arrLogData.at(GetRingPosition(nIndex))));
+	}
+	m_nRingHead = GetRingPosition(nCount);
+	m_nMemoryCount -= nCount;
+	m_nSpilledCount += nCount;
+
+	// Hand over to spill thread
+	m_pLogSpill->AddSegment(std::move(segment));
+}
+
+/**
+ * @brief	Read a spilled item back (the last read item is cached)
+ * @param	nIndex - Item index
+ * @return	LOGITEM - Log item (an empty item if it can not be read)
+ * @note	The returned cache item is overwritten by the next read of another index
+ */
+LOGITEM& SLogging::ReadSpilledItem(size_t nIndex) const
+{
+	if (nIndex != m_nSpillCacheIndex) {
+		LOGITEM logItem;
+		if (m_pLogSpill->ReadItem(nIndex, logItem)) {
+			m_nSpillCacheIndex = nIndex;
+		}
+		else {
+			TRACE_FORMAT("Error: Read spilled log item failed!!! (Index: %d)", static_cast<int>(nIndex));
+			m_nSpillCacheIndex = INT_INFINITE;
+		}
+		m_spillCacheItem = std::move(logItem);
+	}
+
+	return m_spillCacheItem;
+}
+
 
 /**
  * @brief	Constructor
@@ -1469,6 +2137,14 @@ DebugLogging::DebugLogging()
 	m_pExcLogTraceError = NULL;
 	m_pExcLogTraceDebug = NULL;
 	m_pExcLogDebugInfo = NULL;
+
+	// Cached format templates (loaded on first use)
+	m_strDateTimeFormat = Constant::String::Empty;
+	m_strLogStringFormat = Constant::String::Empty;
+
+	// Flush notification
+	m_hFlushNotifyWnd = NULL;
+	m_bFlushRequested = false;
 }
 
 /**
@@ -1476,6 +2152,9 @@ DebugLogging::DebugLogging()
  */
 DebugLogging::~DebugLogging()
 {
+	// Write pending trace records
+	WriteTraceRecords();
+
 	// Release and clean-up file pointers
 	ReleaseTraceErrorLogFile();
 	ReleaseTraceDebugLogFile();
@@ -1505,6 +2184,8 @@ DebugLogging::~DebugLogging()
  */
 bool DebugLogging::InitTraceErrorLogFile(void)
 {
+	std::lock_guard<std::recursive_mutex> lock(m_mtxLogFile);
+
 	// Verify global trace error log file pointer initialization
 	VERIFY_INITIALIZATION(m_pFileLogTraceError, CFile);
 
@@ -1544,6 +2225,11 @@ bool DebugLogging::InitTraceErrorLogFile(void)
 			// Step3: Create new file and reopen
 			continue;
 		}
+
+		// Track file size in memory from now on
+		m_bufLogTraceError.strBuffer.Empty();
+		m_bufLogTraceError.ullFileSize = ullFileSize;
+		m_bufLogTraceError.ullLastFlushTime = GetTickCount64();
 	}
 
 	return true;
@@ -1558,11 +2244,14 @@ bool DebugLogging::InitTraceErrorLogFile(void)
  */
 void DebugLogging::ReleaseTraceErrorLogFile(void)
 {
+	std::lock_guard<std::recursive_mutex> lock(m_mtxLogFile);
+
 	// Clean up trace error log file pointer
 	if (m_pFileLogTraceError != NULL) {
 
 		// Close file if is opening
 		if (m_pFileLogTraceError->m_hFile != CFile::hFileNull) {
+			FlushLogFileBuffer(m_pFileLogTraceError, m_bufLogTraceError);
 			m_pFileLogTraceError->Flush();
 			m_pFileLogTraceError->Close();
 		}
@@ -1580,6 +2269,8 @@ void DebugLogging::ReleaseTraceErrorLogFile(void)
  */
 bool DebugLogging::InitTraceDebugLogFile(void)
 {
+	std::lock_guard<std::recursive_mutex> lock(m_mtxLogFile);
+
 	// Verify global trace debug log file pointer initialization
 	VERIFY_INITIALIZATION(m_pFileLogTraceDebug, CFile);
 
@@ -1619,6 +2310,11 @@ bool DebugLogging::InitTraceDebugLogFile(void)
 			// Step3: Create new file and reopen
 			continue;
 		}
+
+		// Track file size in memory from now on
+		m_bufLogTraceDebug.strBuffer.Empty();
+		m_bufLogTraceDebug.ullFileSize = ullFileSize;
+		m_bufLogTraceDebug.ullLastFlushTime = GetTickCount64();
 	}
 
 	return true;
@@ -1633,11 +2329,14 @@ bool DebugLogging::InitTraceDebugLogFile(void)
  */
 void DebugLogging::ReleaseTraceDebugLogFile(void)
 {
+	std::lock_guard<std::recursive_mutex> lock(m_mtxLogFile);
+
 	// Clean up trace debug info log file pointer
 	if (m_pFileLogTraceDebug != NULL) {
 
 		// Close file if is opening
 		if (m_pFileLogTraceDebug->m_hFile != CFile::hFileNull) {
+			FlushLogFileBuffer(m_pFileLogTraceDebug, m_bufLogTraceDebug);
 			m_pFileLogTraceDebug->Flush();
 			m_pFileLogTraceDebug->Close();
 		}
@@ -1655,6 +2354,8 @@ void DebugLogging::ReleaseTraceDebugLogFile(void)
  */
 bool DebugLogging::InitDebugInfoLogFile(void)
 {
+	std::lock_guard<std::recursive_mutex> lock(m_mtxLogFile);
+
 	// Verify global debug info log file pointer initialization
 	VERIFY_INITIALIZATION(m_pFileLogDebugInfo, CFile);
 
@@ -1694,6 +2395,11 @@ bool DebugLogging::InitDebugInfoLogFile(void)
 			// Step3: Create new file and reopen
 			continue;
 		}
+
+		// Track file size in memory from now on
+		m_bufLogDebugInfo.strBuffer.Empty();
+		m_bufLogDebugInfo.ullFileSize = ullFileSize;
+		m_bufLogDebugInfo.ullLastFlushTime = GetTickCount64();
 	}
 
 	return true;
@@ -1708,11 +2414,14 @@ bool DebugLogging::InitDebugInfoLogFile(void)
  */
 void DebugLogging::ReleaseDebugInfoLogFile(void)
 {
+	std::lock_guard<std::recursive_mutex> lock(m_mtxLogFile);
+
 	// Clean up debug info log file pointer
 	if (m_pFileLogDebugInfo != NULL) {
 
 		// Close file if is opening
 		if (m_pFileLogDebugInfo->m_hFile != CFile::hFileNull) {
+			FlushLogFileBuffer(m_pFileLogDebugInfo, m_bufLogDebugInfo);
 			m_pFileLogDebugInfo->Flush();
 			m_pFileLogDebugInfo->Close();
 		}
@@ -1721,6 +2430,46 @@ void DebugLogging::ReleaseDebugInfoLogFile(void)
 	}
 }
 
+/**
+ * @brief	Write all buffered log strings to log files
+ * @param	None
+ * @return	None
+ */
+void DebugLogging::FlushLogFiles(void)
+{
+	std::lock_guard<std::recursive_mutex> lock(m_mtxLogFile);
+
+	// Format and buffer pending trace records
+	WriteTraceRecords();
+
+	FlushLogFileBuffer(m_pFileLogTraceError, m_bufLogTraceError);
+	FlushLogFileBuffer(m_pFileLogTraceDebug, m_bufLogTraceDebug);
+	FlushLogFileBuffer(m_pFileLogDebugInfo, m_bufLogDebugInfo);
+
+	// Next buffered log string will request a new flush
+	m_bFlushRequested = false;
+}
+
+/**
+ * @brief	Set the window which flushes buffered log strings
+ * @param	hWnd - Window handle (NULL to stop notifying)
+ * @return	None
+ * @note	The window receives SM_APP_DEBUGLOG_BUFFERED once when log strings are
+ *			buffered, and is expected to call FlushLogFiles shortly after that.
+ *			It can keep its flush timer off while nothing is buffered.
+ */
+void DebugLogging::SetFlushNotifyWnd(HWND hWnd)
+{
+	std::lock_guard<std::recursive_mutex> lock(m_mtxLogFile);
+	m_hFlushNotifyWnd = hWnd;
+	m_bFlushRequested = false;
+
+	// Log strings buffered before the window was set
+	if (HasBufferedData()) {
+		RequestFlush();
+	}
+}
+
 /**
  * @brief	Backup old log file
  * @param	filePath	- File path (in/out)
@@ -1768,24 +2517,18 @@ bool DebugLogging::BackupOldLogFile(const String& filePath, const wchar_t* logFi
 /**
  * @brief	Write trace error log string to file
  * @param	logStringW	- Log string
+ * @param	pLogTime	- Log time (current time if not specified)
  * @return	None
  * @note	Destination file: TraceError.log
  * @note	To output trace error detail log strings
  */
-void DebugLogging::WriteTraceErrorLogFile(const wchar_t* logStringW)
+void DebugLogging::WriteTraceErrorLogFile(const wchar_t* logStringW, const DateTime* pLogTime /* = NULL */)
 {
-	// Get current time up to milisecs
-	DateTime currentDateTime = DateTimeUtils::GetCurrentDateTime();
-
-	// Format log date/time
-	const wchar_t* middayFlag = (currentDateTime.Hour() >= 12) ? _T("PM") : _T("AM");
-	String templateFormat = StringUtils::LoadResourceString(IDS_FORMAT_FULLDATETIME);
-	String timeFormatString = StringUtils::StringFormat(templateFormat, currentDateTime.Year(), currentDateTime.Month(), currentDateTime.Day(),
-		currentDateTime.Hour(), currentDateTime.Minute(), currentDateTime.Second(), currentDateTime.Millisecond(), middayFlag);
+	std::lock_guard<std::recursive_mutex> lock(m_mtxLogFile);
 
 	// Format output log string
-	templateFormat = StringUtils::LoadResourceString(IDS_FORMAT_LOGSTRING);
-	String logOutputFormatString = StringUtils::StringFormat(templateFormat, timeFormatString.GetString(), logStringW, Constant::String::Empty);
+	String logOutputFormatString;
+	FormatLogString(logStringW, logOutputFormatString, pLogTime);
 
 	// If output log string is empty, do nothing
 	if (logOutputFormatString.IsEmpty())
@@ -1800,61 +2543,43 @@ void DebugLogging::WriteTraceErrorLogFile(const wchar_t* logStringW)
 	// Re-acquire trace log file pointer
 	CFile* pTraceErrorLogFile = GetTraceErrorLogFile();
 	NULL_POINTER_BREAK(pTraceErrorLogFile, return NOTHING);
-	{
-		// Write log string to file
-		pTraceErrorLogFile->Write(logOutputFormatString, logOutputFormatString.GetLength() * sizeof(wchar_t));
-		pTraceErrorLogFile->Flush();
-	}
-
-	// Re-check file size after writing
-	{
-		// Go to end of file
-		ULONGLONG ullFileSize = pTraceErrorLogFile->SeekToEnd();
-
-		// If the file line number is already out of limit
-		if (ullFileSize >= Constant::Max::LogFileSize) {
 
-			// Step1: Close file
-			pTraceErrorLogFile->Close();
+	// Buffer log string (file size is tracked in memory)
+	if (!WriteLogFileBuffer(pTraceErrorLogFile, m_bufLogTraceError, logOutputFormatString))
+		return;
 
-			// Step2: Rename file extension to BAK
-			String strFolderPath = StringUtils::GetSubFolderPath(Constant::Folder::Log);
-			String strOrgFilePath = StringUtils::MakeFilePath(strFolderPath.GetString(), Constant::File::Name::TraceError, Constant::File::Extension::Log);
-			if (!BackupOldLogFile(strOrgFilePath, Constant::File::Name::TraceError))
-				return;
+	// If the file size is already out of limit
+	{
+		// Step1: Write remaining log strings and release log file pointer
+		// New file will be re-initialized in the next function call
+		ReleaseTraceErrorLogFile();
 
-			// Step3: Release log file pointer --> Quit
-			// New file will be re-initialized in the next function call
-			ReleaseTraceErrorLogFile();
-			return;
-		}
+		// Step2: Rename file extension to BAK
+		String strFolderPath = StringUtils::GetSubFolderPath(Constant::Folder::Log);
+		String strOrgFilePath = StringUtils::MakeFilePath(strFolderPath, Constant::File::Name::TraceError, Constant::File::Extension::Log);
+		BackupOldLogFile(strOrgFilePath, Constant::File::Name::TraceError);
 	}
 }
 
 /**
  * @brief	Write trace debug log string to file
  * @param	logStringW	- Log string
+ * @param	pLogTime	- Log time (current time if not specified)
  * @return	None
  * @note	Destination file: TraceDebug.log
  * @note	To output trace debug log strings (including the function name, code file and line where it failed)
  */
-void DebugLogging::WriteTraceDebugLogFile(const wchar_t* logStringW)
+void DebugLogging::WriteTraceDebugLogFile(const wchar_t* logStringW, const DateTime* pLogTime /* = NULL */)
 {
-	// Get current time up to milisecs
-	DateTime currentDateTime = DateTimeUtils::GetCurrentDateTime();
-
-	// Format log date/time
-	const wchar_t* middayFlag = (currentDateTime.Hour() >= 12) ? _T("PM") : _T("AM");
-	String templateFormat = StringUtils::LoadResourceString(IDS_FORMAT_FULLDATETIME);
-	String timeFormatString = StringUtils::StringFormat(templateFormat, currentDateTime.Year(), currentDateTime.Month(), currentDateTime.Day(),
-		currentDateTime.Hour(), currentDateTime.Minute(), currentDateTime.Second(), currentDateTime.Millisecond(), middayFlag);
+	std::lock_guard<std::recursive_mutex> lock(m_mtxLogFile);
 
 	// Format output log string
-	templateFormat = StringUtils::LoadResourceString(IDS_FORMAT_LOGSTRING);
-	String logOutputFormatString = StringUtils::StringFormat(templateFormat, timeFormatString.GetString(), logStringW, Constant::String::Empty);
+	String logOutputFormatString;
+	FormatLogString(logStringW, logOutputFormatString, pLogTime);
 
 	// If output log string is empty, do nothing
-	if (logOutputFormatString.IsEmpty()) return;
+	if (logOutputFormatString.IsEmpty())
+		return;
 
 	// If the file is not initialized or had been released
 	if (GetTraceDebugLogFile() == NULL) {
@@ -1865,61 +2590,43 @@ void DebugLogging::WriteTraceDebugLogFile(const wchar_t* logStringW)
 	// Re-acquire trace debug log file pointer
 	CFile* pTraceDebugLogFile = GetTraceDebugLogFile();
 	NULL_POINTER_BREAK(pTraceDebugLogFile, return NOTHING);
-	{
-		// Write log string to file
-		pTraceDebugLogFile->Write(logOutputFormatString, logOutputFormatString.GetLength() * sizeof(wchar_t));
-		pTraceDebugLogFile->Flush();
-	}
-
-	// Re-check file size after writing
-	{
-		// Go to end of file
-		ULONGLONG ullFileSize = pTraceDebugLogFile->SeekToEnd();
-
-		// If the file line number is already out of limit
-		if (ullFileSize >= Constant::Max::LogFileSize) {
 
-			// Step1: Close file
-			pTraceDebugLogFile->Close();
+	// Buffer log string (file size is tracked in memory)
+	if (!WriteLogFileBuffer(pTraceDebugLogFile, m_bufLogTraceDebug, logOutputFormatString))
+		return;
 
-			// Step2: Rename file extension to BAK
-			String strFolderPath = StringUtils::GetSubFolderPath(Constant::Folder::Log);
-			String strOrgFilePath = StringUtils::MakeFilePath(strFolderPath, Constant::File::Name::TraceDebug, Constant::File::Extension::Log);
-			if (!BackupOldLogFile(strOrgFilePath, Constant::File::Name::TraceDebug))
-				return;
+	// If the file size is already out of limit
+	{
+		// Step1: Write remaining log strings and release log file pointer
+		// New file will be re-initialized in the next function call
+		ReleaseTraceDebugLogFile();
 
-			// Step3: Release log file pointer --> Quit
-			// New file will be re-initialized in the next function call
-			ReleaseTraceDebugLogFile();
-			return;
-		}
+		// Step2: Rename file extension to BAK
+		String strFolderPath = StringUtils::GetSubFolderPath(Constant::Folder::Log);
+		String strOrgFilePath = StringUtils::MakeFilePath(strFolderPath, Constant::File::Name::TraceDebug, Constant::File::Extension::Log);
+		BackupOldLogFile(strOrgFilePath, Constant::File::Name::TraceDebug);
 	}
 }
 
 /**
  * @brief	Write debug info output log string to file
  * @param	lpszLogStringW	- Log string
+ * @param	pLogTime	- Log time (current time if not specified)
  * @return	None
  * @note	Destination file: DebugInfo.log
  * @note	To output debug info log strings (similar to OutputDebugString, but output to file instead)
  */
-void DebugLogging::WriteDebugInfoLogFile(const wchar_t* logStringW)
+void DebugLogging::WriteDebugInfoLogFile(const wchar_t* logStringW, const DateTime* pLogTime /* = NULL */)
 {
-	// Get current time up to milisecs
-	DateTime currentDateTime = DateTimeUtils::GetCurrentDateTime();
-
-	// Format log date/time
-	const wchar_t* middayFlag = (currentDateTime.Hour() >= 12) ? _T("PM") : _T("AM");
-	String templateFormat = StringUtils::LoadResourceString(IDS_FORMAT_FULLDATETIME);
-	String timeFormatString = StringUtils::StringFormat(templateFormat, currentDateTime.Year(), currentDateTime.Month(), currentDateTime.Day(),
-		currentDateTime.Hour(), currentDateTime.Minute(), currentDateTime.Second(), currentDateTime.Millisecond(), middayFlag);
+	std::lock_guard<std::recursive_mutex> lock(m_mtxLogFile);
 
 	// Format output log string
-	templateFormat = StringUtils::LoadResourceString(IDS_FORMAT_LOGSTRING);
-	String logOutputFormatString = StringUtils::StringFormat(templateFormat, timeFormatString.GetString(), logStringW, Constant::String::Empty);
+	String logOutputFormatString;
+	FormatLogString(logStringW, logOutputFormatString, pLogTime);
 
 	// If output log string is empty, do nothing
-	if (logOutputFormatString.IsEmpty()) return;
+	if (logOutputFormatString.IsEmpty())
+		return;
 
 	// If the file is not initialized or had been released
 	if (GetDebugInfoLogFile() == NULL) {
@@ -1930,34 +2637,21 @@ void DebugLogging::WriteDebugInfoLogFile(const wchar_t* logStringW)
 	// Re-acquire debug info log file pointer
 	CFile* pDebugInfoLogFile = GetDebugInfoLogFile();
 	NULL_POINTER_BREAK(pDebugInfoLogFile, return NOTHING);
-	{
-		// Write log string to file
-		pDebugInfoLogFile->Write(logOutputFormatString, logOutputFormatString.GetLength() * sizeof(wchar_t));
-		pDebugInfoLogFile->Flush();
-	}
-
-	// Recheck file size after writing
-	{
-		// Go to end of file
-		ULONGLONG ullFileSize = pDebugInfoLogFile->SeekToEnd();
 
-		// If the file line number is already out of limit
-		if (ullFileSize >= Constant::Max::LogFileSize) {
-
-			// Step1: Close file
-			pDebugInfoLogFile->Close();
+	// Buffer log string (file size is tracked in memory)
+	if (!WriteLogFileBuffer(pDebugInfoLogFile, m_bufLogDebugInfo, logOutputFormatString))
+		return;
 
-			// Step2: Rename file extension to BAK
-			String strFolderPath = StringUtils::GetSubFolderPath(Constant::Folder::Log);
-			String strOrgFilePath = StringUtils::MakeFilePath(strFolderPath, Constant::File::Name::DebugInfo, Constant::File::Extension::Log);
-			if (!BackupOldLogFile(strOrgFilePath, Constant::File::Name::DebugInfo))
-				return;
+	// If the file size is already out of limit
+	{
+		// Step1: Write remaining log strings and release log file pointer
+		// New file will be re-initialized in the next function call
+		ReleaseDebugInfoLogFile();
 
-			// Step3: Release log file pointer --> Quit
-			// New file will be re-initialized in the next function call
-			ReleaseDebugInfoLogFile();
-			return;
-		}
+		// Step2: Rename file extension to BAK
+		String strFolderPath = StringUtils::GetSubFolderPath(Constant::Folder::Log);
+		String strOrgFilePath = StringUtils::MakeFilePath(strFolderPath, Constant::File::Name::DebugInfo, Constant::File::Extension::Log);
+		BackupOldLogFile(strOrgFilePath, Constant::File::Name::DebugInfo);
 	}
 }
 
@@ -1966,76 +2660,125 @@ void DebugLogging::WriteDebugInfoLogFile(const wchar_t* logStringW)
  * @param	lpszFileName	- Log file name
  * @param	lpszLogStringW	- Log string
  * @return	None
- * @note	Base function - No longer used
+ * @note	Base function - Redirected to buffered log files
  */
 void DebugLogging::WriteTraceNDebugLogFileBase(const wchar_t* fileName, const wchar_t* logStringW)
 {
-	// Log file path
-	String filePath = StringUtils::MakeFilePath(Constant::Folder::Log, fileName, Constant::File::Extension::Log);
-
-	CFile fTrcDbgLogFile;
+	// Write through the corresponding buffered log file
+	if (fileName == NULL) return;
+	if (!_tcscmp(fileName, Constant::File::Name::TraceError)) {
+		WriteTraceErrorLogFile(logStringW);
+	}
+	else if (!_tcscmp(fileName, Constant::File::Name::TraceDebug)) {
+		WriteTraceDebugLogFile(logStringW);
+	}
+	else if (!_tcscmp(fileName, Constant::File::Name::DebugInfo)) {
+		WriteDebugInfoLogFile(logStringW);
+	}
+}
 
-	// Check if file is opening, if not, open it
-	while (fTrcDbgLogFile.m_hFile == CFile::hFileNull) {
+/**
+ * @brief	Format a log string line (with current date/time)
+ * @param	logStringW	 - Log string
+ * @param	outputString - Output log string line
+ * @param	pLogTime	 - Log time (current time if not specified)
+ * @return	None
+ */
+void DebugLogging::FormatLogString(const wchar_t* logStringW, String& outputString, const DateTime* pLogTime /* = NULL */)
+{
+	// Load format templates once
+	if (m_strDateTimeFormat.IsEmpty()) {
+		m_strDateTimeFormat = StringUtils::LoadResourceString(IDS_FORMAT_FULLDATETIME);
+	}
+	if (m_strLogStringFormat.IsEmpty()) {
+		m_strLogStringFormat = StringUtils::LoadResourceString(IDS_FORMAT_LOGSTRING);
+	}
 
-		bool bResult = fTrcDbgLogFile.Open(filePath, CFile::modeCreate | CFile::modeNoTruncate | CFile::modeWrite);
-		if (bResult == false) {
-			// Show error message
-			DWORD dwErrorCode = GetLastError();
-			LPARAM lParam = reinterpret_cast<LPARAM>(fileName);
-			ShowErrorMessage(NULL, NULL, dwErrorCode, lParam);
-			return;
-		}
+	// Get log time (or current time) up to milisecs
+	DateTime currentDateTime = (pLogTime != NULL) ? *pLogTime : DateTimeUtils::GetCurrentDateTime();
 
-		// Go to end of file
-		ULONGLONG ullFileSize = fTrcDbgLogFile.SeekToEnd();
+	// Format log date/time
+	const DateTime::Fields timeFields = currentDateTime.Decompose();
+	const wchar_t* middayFlag = (timeFields.hour >= 12) ? _T("PM") : _T("AM");
+	String timeFormatString = StringUtils::StringFormat(m_strDateTimeFormat, timeFields.year, timeFields.month, timeFields.day,
+		timeFields.hour, timeFields.minute, timeFields.second, timeFields.millisecond, middayFlag);
 
-		// If the file line number is already out of limit
-		if (ullFileSize >= Constant::Max::LogFileSize) {
+	// Format output log string
+	outputString.Format(m_strLogStringFormat, timeFormatString.GetString(), logStringW, Constant::String::Empty);
+}
 
-			// Step1: Close file
-			fTrcDbgLogFile.Close();
+/**
+ * @brief	Add a log string into log file write buffer
+ * @param	pLogFile   - Log file pointer
+ * @param	fileBuffer - Log file write buffer
+ * @param	logString  - Log string
+ * @return	true - File size is out of limit, false - Otherwise
+ */
+bool DebugLogging::WriteLogFileBuffer(CFile* pLogFile, LOGFILEBUFFER& fileBuffer, const String& logString)
+{
+	// Buffer log string
+	fileBuffer.strBuffer.Append(logString);
+	fileBuffer.ullFileSize += (logString.GetLength() * sizeof(wchar_t));
 
-			// Step2: Rename file extension to BAK
-			CFileFind Finder;
-			String backupFilePath;
-			for (int nNum = 0; nNum < Constant::Max::BackupFileNumber; nNum++) {
-				backupFilePath.Format((filePath + Constant::File::Extension::Backup_Log), nNum);
-				if (Finder.FindFile(backupFilePath) == true) {
-					if (nNum == (Constant::Max::BackupFileNumber - 1)) return;
-					else continue;
-				}
-				CFile::Rename(filePath, backupFilePath);
-				break;
-			}
+	// Write buffered strings if buffer is full or they have been kept for too long
+	if ((fileBuffer.strBuffer.GetLength() >= debugLogBufferLength) ||
+		((GetTickCount64() - fileBuffer.ullLastFlushTime) >= debugLogFlushInterval)) {
+		FlushLogFileBuffer(pLogFile, fileBuffer);
+	}
 
-			// Step3: Create new file and reopen
-			continue;
-		}
+	// Strings left in buffer are written by the next flush
+	if (!fileBuffer.strBuffer.IsEmpty()) {
+		RequestFlush();
 	}
 
-	// Get current time up to milisecs
-	DateTime currentDateTime = DateTimeUtils::GetCurrentDateTime();
+	return (fileBuffer.ullFileSize >= Constant::Max::LogFileSize);
+}
 
-	// Format log date/time
-	const wchar_t* middayFlag = (currentDateTime.Hour() >= 12) ? _T("PM") : _T("AM");
-	String templateFormat = StringUtils::LoadResourceString(IDS_FORMAT_FULLDATETIME);
-	String timeFormatString = StringUtils::StringFormat(templateFormat, currentDateTime.Year(), currentDateTime.Month(), currentDateTime.Day(),
-		currentDateTime.Hour(), currentDateTime.Minute(), currentDateTime.Second(), currentDateTime.Millisecond(), middayFlag);
+/**
+ * @brief	Write buffered log strings to log file
+ * @param	pLogFile   - Log file pointer
+ * @param	fileBuffer - Log file write buffer
+ * @return	None
+ */
+void DebugLogging::FlushLogFileBuffer(CFile* pLogFile, LOGFILEBUFFER& fileBuffer)
+{
+	fileBuffer.ullLastFlushTime = GetTickCount64();
 
-	// Format output log string
-	templateFormat = StringUtils::LoadResourceString(IDS_FORMAT_LOGSTRING);
-	String logOutputFormatString = StringUtils::StringFormat(templateFormat, timeFormatString.GetString(), logStringW, Constant::String::Empty);
+	// Nothing to write
+	if (fileBuffer.strBuffer.IsEmpty()) return;
+	if ((pLogFile == NULL) || (pLogFile->m_hFile == CFile::hFileNull)) return;
 
-	if (!logOutputFormatString.IsEmpty()) {
-		// Write log string to file
-		fTrcDbgLogFile.Write(logOutputFormatString, logOutputFormatString.GetLength() * sizeof(wchar_t));
-		fTrcDbgLogFile.Flush();
-	}
+	// Write all buffered strings at once (buffer memory is kept for reuse)
+	pLogFile->Write(fileBuffer.strBuffer, fileBuffer.strBuffer.GetLength() * sizeof(wchar_t));
+	fileBuffer.strBuffer.Empty();
+}
 
-	// Close file after done writing
-	if (fTrcDbgLogFile.m_hFile != CFile::hFileNull) {
-		fTrcDbgLogFile.Close();
+/**
+ * @brief	Check if there are log strings or trace records waiting for writing
+ * @param	None
+ * @return	true/false
+ */
+bool DebugLogging::HasBufferedData(void) const
+{
+	return (!m_arrTraceRecords.empty() ||
+			!m_bufLogTraceError.strBuffer.IsEmpty() ||
+			!m_bufLogTraceDebug.strBuffer.IsEmpty() ||
+			!m_bufLogDebugInfo.strBuffer.IsEmpty());
+}
+
+/**
+ * @brief	Ask the notify window to flush buffered log strings
+ * @param	None
+ * @return	None
+ * @note	Posted only once until the next flush, the caller must hold the log file lock
+ */
+void DebugLogging::RequestFlush(void)
+{
+	if (m_bFlushRequested || (m_hFlushNotifyWnd == NULL)) return;
+
+	// The notify window arms its flush timer on its own thread
+	if (::PostMessage(m_hFlushNotifyWnd, SM_APP_DEBUGLOG_BUFFERED, NULL, NULL)) {
+		m_bFlushRequested = true;
 	}
 }
 
@@ -2112,9 +2855,12 @@ void DebugLogging::TraceErrorFormat(const wchar_t* traceLogFormatW, ...)
  * @param	lpszFileName - Code file name
  * @param	nLineIndex	 - Code line number
  * @return	None
+ * @note	Written to file right away together with the error traced before it
  */
 void DebugLogging::TraceDebugInfo(const char* funcName, const char* fileName, int lineIndex)
 {
+	std::lock_guard<std::recursive_mutex> lock(m_mtxLogFile);
+
 	// Debug trace info
 	const wchar_t* _funcName = MAKEUNICODE(funcName);
 	const wchar_t* _fileName = MAKEUNICODE(fileName);
@@ -2122,8 +2868,82 @@ void DebugLogging::TraceDebugInfo(const char* funcName, const char* fileName, in
 	// Format debug trace log
 	String debugTraceFormat = StringUtils::StringFormat(_T("Function: %s, File: %s(%d)"), _funcName, _fileName, lineIndex);
 
+	// Pending trace records go first, so that log files keep the call order
+	WriteTraceRecords();
+
 	// Write debug trace log: TraceDebug.log
 	WriteTraceDebugLogFile(debugTraceFormat.GetString());
+
+	// Do not keep it in buffer (and the error it belongs to)
+	FlushLogFileBuffer(m_pFileLogTraceError, m_bufLogTraceError);
+	FlushLogFileBuffer(m_pFileLogTraceDebug, m_bufLogTraceDebug);
+}
+
+/**
+ * @brief	Add a leveled trace record (written on next flush)
+ * @param	pRecord - Trace record
+ * @return	None
+ */
+void DebugLogging::AddTraceRecord(std::unique_ptr<TraceLog::Record>&& pRecord)
+{
+	std::lock_guard<std::recursive_mutex> lock(m_mtxLogFile);
+	m_arrTraceRecords.push_back(std::move(pRecord));
+
+	// Errors are written right away, others are kept until flushing or until the queue is full
+	if ((m_arrTraceRecords.back()->GetLevel() >= TraceLog::Error) || (m_arrTraceRecords.size() >= maxTraceRecordCount)) {
+		WriteTraceRecords();
+	}
+	else {
+		RequestFlush();
+	}
+}
+
+/**
+ * @brief	Format pending trace records and write them to log files
+ * @param	None
+ * @return	None
+ * @note	Warnings and errors go to TraceError.log, info to DebugInfo.log, others to TraceDebug.log
+ */
+void DebugLogging::WriteTraceRecords(void)
+{
+	std::lock_guard<std::recursive_mutex> lock(m_mtxLogFile);
+	if (m_arrTraceRecords.empty()) return;
+
+	// Take pending records (writing may add new trace records)
+	std::vector<std::unique_ptr<TraceLog::Record>> arrRecords;
+	arrRecords.swap(m_arrTraceRecords);
+
+	std::wstring traceString;
+	for (const std::unique_ptr<TraceLog::Record>& pRecord : arrRecords) {
+
+		// Format trace string: [Level] Message - Function: ..., File: ...(Line)
+		const std::source_location& location = pRecord->GetLocation();
+		const char* fileName = strrchr(location.file_name(), '\\');
+		fileName = (fileName != NULL) ? (fileName + 1) : location.file_name();
+		traceString.assign(L"[").append(TraceLog::GetLevelName(pRecord->GetLevel())).append(L"] ");
+		size_t nMessagePos = traceString.size();
+		pRecord->FormatText(traceString);
+		if (traceString.size() > nMessagePos) {
+			traceString.append(L" - ");
+		}
+		std::format_to(std::back_inserter(traceString), L"Function: {}, File: {}({})", TraceLog::Capture(location.function_name()),
+			TraceLog::Capture(fileName), location.line());
+
+		// Write to log file
+		switch (pRecord->GetLevel())
+		{
+		case TraceLog::Warning:
+		case TraceLog::Error:
+			WriteTraceErrorLogFile(traceString.c_str(), &pRecord->GetTime());
+			break;
+		case TraceLog::Info:
+			WriteDebugInfoLogFile(traceString.c_str(), &pRecord->GetTime());
+			break;
+		default:
+			WriteTraceDebugLogFile(traceString.c_str(), &pRecord->GetTime());
+			break;
+		}
+	}
 }
 
 /**
@@ -24,74 +24,63 @@
 unsigned MapTable::GetPairedID(IDMAPTABLE_REF pIDTableRef, unsigned nID, bool bReverse /* = false */)
 {
 	// Return INVALID if ID mapping table is invalid
-	ASSERT(pIDTableRef != NULL);
-	if (pIDTableRef == NULL) {
+	ASSERT((pIDTableRef.pByFirst != NULL) && (pIDTableRef.pBySecond != NULL));
+	if ((pIDTableRef.pByFirst == NULL) || (pIDTableRef.pBySecond == NULL)) {
 		return (unsigned)INT_INVALID;
 	}
 
-	// Find and return corresponding ID paired with specified macro ID
-	int nIndex = 0;
-	do {
-		// Get ID pair entry
-		IDPAIR idPair = pIDTableRef[nIndex++];
-
-		// End of table
-		if (idPair.first == INFINITE)
-			break;
-
-		// Reverse search
-		if (bReverse == true) {
-			if (idPair.second == nID)
-				return idPair.first;
-		}
-		else {
-			if (idPair.first == nID)
-				return idPair.second;
-		}
-	} while (nIndex < MAX_TABLESIZE);
+	// Binary search on the sorted index column
+	// If an ID is duplicated, the first declared entry will be returned
+	if (bReverse == true) {
+		const IDPAIR* pEnd = pIDTableRef.pBySecond + pIDTableRef.nSize;
+		const IDPAIR* pFound = std::lower_bound(pIDTableRef.pBySecond, pEnd, nID,
+			[](const IDPAIR& idPair, unsigned nValue) { return (idPair.second < nValue); });
+		if ((pFound != pEnd) && (pFound->second == nID))
+			return pFound->first;
+	}
+	else {
+		const IDPAIR* pEnd = pIDTableRef.pByFirst + pIDTableRef.nSize;
+		const IDPAIR* pFound = std::lower_bound(pIDTableRef.pByFirst, pEnd, nID,
+			[](const IDPAIR& idPair, unsigned nValue) { return (idPair.first < nValue); });
+		if ((pFound != pEnd) && (pFound->first == nID))
+			return pFound->second;
+	}
 
 	// Return INVALID if not found
 	return (unsigned)INT_INVALID;
 }
 
 /**
- * @brief	Find and return ID paired with given string
+ * @brief	Find and return ID paired with given string (case-insensitive)
  * @param	pStringTableRef - Reference string table
  * @param	input			- Given string
  * @return	unsigned - String ID
  */
 unsigned MapTable::GetStringID(STRINGTABLE_REF pStringTableRef, const wchar_t* input)
 {
-	// Return NULL string if language table is invalid
-	ASSERT(pStringTableRef != NULL);
-	if (pStringTableRef == NULL) {
+	// Return INVALID if string table is invalid
+	ASSERT((pStringTableRef.pEntries != NULL) && (pStringTableRef.pByKey != NULL));
+	if ((pStringTableRef.pEntries == NULL) || (pStringTableRef.pByKey == NULL) || (input == NULL)) {
 		return (unsigned)INT_INVALID;
 	}
 
-	// Convert input string to lowercase
-	String inputString(input);
-	inputString.ToLower();
-
-	// Find and return corresponding ID paired with specified string
-	int nIndex = 0;
-	String pairedString;
-	do {
-		// Get string pair entry
-		LANGTEXT stringPair = pStringTableRef[nIndex++];
-
-		// End of table
-		if (stringPair.id == INFINITE)
-			break;
-
-		// Also convert language string to lower for easier comparison
-		pairedString = stringPair.langString;
-		pairedString.ToLower();
-
-		// Compare string ID
-		if (!_tcscmp(pairedString, inputString)) {
-			return stringPair.id;
+	// Find all keys which have the same case-folded hash
+	unsigned nKeyHash = HashFoldedString(input);
+	const STRINGKEY* pEnd = pStringTableRef.pByKey + pStringTableRef.nSize;
+	const STRINGKEY* pFound = std::lower_bound(pStringTableRef.pByKey, pEnd, nKeyHash,
+		[](const STRINGKEY& stringKey, unsigned nValue) { return (stringKey.nKeyHash < nValue); });
+
+	// Compare the candidates case-insensitively (in declaration order)
+	for (; (pFound != pEnd) && (pFound->nKeyHash == nKeyHash); pFound++) {
+		const LANGTEXT& stringPair = pStringTableRef.pEntries[pFound->nIndex];
+		const wchar_t* lpszLeft = stringPair.langString;
+		const wchar_t* lpszRight = input;
+		while ((*lpszLeft != L'\0') && (FoldCase(*lpszLeft) == FoldCase(*lpszRight))) {
+			lpszLeft++; lpszRight++;
 		}
-	} while (nIndex < MAX_TABLESIZE);
+		if ((*lpszLeft == L'\0') && (*lpszRight == L'\0'))
+			return stringPair.id;
+	}
 
 	// Return INVALID if not found
 	return (unsigned)INT_INVALID;
@@ -105,26 +94,17 @@ unsigned MapTable::GetStringID(STRINGTABLE_REF pStringTableRef, const wchar_t* i
  */
 const wchar_t* MapTable::GetString(STRINGTABLE_REF pStringTableRef, unsigned nID)
 {
-	// Return NULL string if language table is invalid
-	ASSERT(pStringTableRef != NULL);
-	if (pStringTableRef == NULL)
+	// Return NULL string if string table is invalid
+	ASSERT(pStringTableRef.pByID != NULL);
+	if (pStringTableRef.pByID == NULL)
 		return Constant::String::Null;
 
-	// Find and return corresponding string paired with specified ID
-	int nIndex = 0;
-	do {
-		// Get string pair entry
-		LANGTEXT stringPair = pStringTableRef[nIndex++];
-
-		// End of table
-		if (stringPair.id == INFINITE)
-			break;
-
-		// Compare string
-		if (stringPair.id == nID)
-			return stringPair.langString;
-
-	} while (nIndex < MAX_TABLESIZE);
+	// Binary search on the ID-sorted index column
+	const LANGTEXT* pEnd = pStringTableRef.pByID + pStringTableRef.nSize;
+	const LANGTEXT* pFound = std::lower_bound(pStringTableRef.pByID, pEnd, nID,
+		[](const LANGTEXT& stringPair, unsigned nValue) { return (stringPair.id < nValue); });
+	if ((pFound != pEnd) && (pFound->id == nID))
+		return pFound->langString;
 
 	return Constant::String::Null;
 }
@@ -0,0 +1,322 @@
+﻿/**
+ * @file		ScheduleEngine.cpp
+ * @brief		Implement the event-driven schedule engine
+ * @author		AnthonyLeeStark
+ * @date		2026.10.17
+ *
+ * @copyright 	Copyright (c) 2015-2025 AnthonyLeeStark
+ */
+
+#include "AppCore/ScheduleEngine.h"
+
+using namespace std::chrono;
+
+
+/**
+ * @brief	Constructor
+ * @param	fnClock - Clock source (local wall-clock time)
+ */
+ScheduleEngine::ScheduleEngine(ClockFunc fnClock /* = &std::chrono::system_clock::now */)
+	: m_fnClock(std::move(fnClock))
+{
+	// Initialize
+	m_nNotifyOffset = defaultNotifyOffset;
+	m_nLateTolerance = defaultLateTolerance;
+}
+
+
+/**
+ * @brief	Rebuild all pending events from schedule entries
+ * @param	arrEntries - Schedule entries
+ * @return	None
+ */
+void ScheduleEngine::Rebuild(const EntryList& arrEntries)
+{
+	// Update entry list
+	m_arrEntries = arrEntries;
+
+	// Keep snoozed events of items which still exist
+	m_arrEventHeap.erase(std::remove_if(m_arrEventHeap.begin(), m_arrEventHeap.end(),
+		[this](const Event& schEvent) {
+			return ((schEvent.eType != snoozeEvent) || (FindEntry(schEvent.nItemID) == NULL));
+		}), m_arrEventHeap.end());
+	std::make_heap(m_arrEventHeap.begin(), m_arrEventHeap.end(), &ScheduleEngine::CompareEvent);
+
+	// Clean-up handled occurrences which are already out of date
+	TimePoint tpNow = Now();
+	TimePoint tpLateBound = tpNow - seconds(m_nLateTolerance);
+	m_arrHandled.erase(std::remove_if(m_arrHandled.begin(), m_arrHandled.end(),
+		[tpLateBound](const Event& schEvent) { return (schEvent.tpOccurrence < tpLateBound); }), m_arrHandled.end());
+
+	// Schedule next occurrence of each entry
+	// Start from the late bound so that an occurrence which is being due won't be missed
+	for (const Entry& schEntry : m_arrEntries) {
+		if (schEntry.bEnabled != true) continue;
+		ScheduleOccurrence(schEntry, tpLateBound);
+	}
+}
+
+
+/**
+ * @brief	Remove all entries and pending events
+ * @param	None
+ * @return	None
+ */
+void ScheduleEngine::Clear(void) noexcept
+{
+	m_arrEntries.clear();
+	m_arrEventHeap.clear();
+	m_arrHandled.clear();
+}
+
+
+/**
+ * @brief	Snooze an item and fire a snoozed action after the interval
+ * @param	nItemID	  - Schedule item ID
+ * @param	nInterval - Snooze interval (in seconds)
+ * @return	None
+ */
+void ScheduleEngine::Snooze(unsigned nItemID, int nInterval)
+{
+	// Only one snoozed event per item
+	CancelSnooze(nItemID);
+
+	// Prepare snoozed event
+	Event schEvent{};
+	schEvent.tpFireTime = Now() + seconds(nInterval);
+	schEvent.tpOccurrence = schEvent.tpFireTime;
+	schEvent.nItemID = nItemID;
+	schEvent.eType = snoozeEvent;
+
+	PushEvent(schEvent);
+}
+
+
+/**
+ * @brief	Cancel snoozed event of an item
+ * @param	nItemID - Schedule item ID
+ * @return	None
+ */
+void ScheduleEngine::CancelSnooze(unsigned nItemID)
+{
+	m_arrEventHeap.erase(std::remove_if(m_arrEventHeap.begin(), m_arrEventHeap.end(),
+		[nItemID](const Event& schEvent) {
+			return ((schEvent.eType == snoozeEvent) && (schEvent.nItemID == nItemID));
+		}), m_arrEventHeap.end());
+	std::make_heap(m_arrEventHeap.begin(), m_arrEventHeap.end(), &ScheduleEngine::CompareEvent);
+}
+
+
+/**
+ * @brief	Get time remaining until the next deadline
+ * @param	None
+ * @return	milliseconds - Remaining time (max value if there's no pending event)
+ */
+milliseconds ScheduleEngine::GetTimeToNextDeadline(void) const
+{
+	if (IsEmpty())
+		return milliseconds::max();
+
+	// Round up, so that the deadline will be already passed when the timer fires
+	milliseconds msRemain = ceil<milliseconds>(GetNextDeadline() - Now());
+	return (std::max)(msRemain, milliseconds::zero());
+}
+
+
+/**
+ * @brief	Pop all events which are due at current time, and re-schedule next occurrences
+ * @param	arrDueEvents - Due events (output, in order of fire time)
+ * @return	size_t - Number of due events
+ */
+size_t ScheduleEngine::CollectDueEvents(EventList& arrDueEvents)
+{
+	arrDueEvents.clear();
+
+	TimePoint tpNow = Now();
+	while ((!IsEmpty()) && (m_arrEventHeap.front().tpFireTime <= tpNow)) {
+
+		// Get the earliest event
+		Event schEvent = PopEvent();
+		bool bIsDue = false;
+
+		if (schEvent.eType == notifyEvent) {
+			// Only notify if schedule time is not passed yet
+			bIsDue = (tpNow <= schEvent.tpOccurrence);
+		}
+		else {
+			// Drop the event if it's been late for too long (system sleep, clock change, ...)
+			bIsDue = ((tpNow - schEvent.tpFireTime) <= seconds(m_nLateTolerance));
+
+			// Re-schedule next occurrence of the item
+			if (schEvent.eType == actionEvent) {
+				const Entry* pschEntry = FindEntry(schEvent.nItemID);
+				if ((pschEntry != NULL) && (pschEntry->bEnabled == true)) {
+					ScheduleOccurrence(*pschEntry, schEvent.tpOccurrence + seconds(1));
+				}
+			}
+		}
+
+		if ((bIsDue == true) && (!IsHandled(schEvent))) {
+			MarkHandled(schEvent);
+			arrDueEvents.push_back(schEvent);
+		}
+	}
+
+	return arrDueEvents.size();
+}
+
+
+/**
+ * @brief	Calculate next fire time of an entry at or after given time point
+ * @param	schEntry   - Schedule entry
+ * @param	tpFrom	   - Time point to start searching from
+ * @param	tpNextFire - Next fire time (output)
+ * @return	true/false - Whether an occurrence is found within one week
+ */
+bool ScheduleEngine::CalcNextFireTime(const Entry& schEntry, TimePoint tpFrom, TimePoint& tpNextFire)
+{
+	// Repeat with no active day will never fire
+	if ((schEntry.bRepeat == true) && (schEntry.byActiveDays == 0))
+		return false;
+
+	sys_days dayStart = floor<days>(tpFrom);
+	for (int nDayOffset = 0; nDayOffset <= 7; nDayOffset++) {
+
+		// If repeat option is ON, skip days which are not active
+		sys_days curDay = dayStart + days(nDayOffset);
+		if (schEntry.bRepeat == true) {
+			unsigned nDayOfWeek = weekday(curDay).c_encoding();
+			if ((schEntry.byActiveDays & (1 << nDayOfWeek)) == 0)
+				continue;
+		}
+
+		TimePoint tpCandidate = curDay + seconds(schEntry.nTimeOfDay);
+		if (tpCandidate >= tpFrom) {
+			tpNextFire = tpCandidate;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+
+/**
+ * @brief	Push an event into the min-heap
+ * @param	schEvent - Event to push
+ * @return	None
+ */
+void ScheduleEngine::PushEvent(const Event& schEvent)
+{
+	m_arrEventHeap.push_back(schEvent);
+	std::push_heap(m_arrEventHeap.begin(), m_arrEventHeap.end(), &ScheduleEngine::CompareEvent);
+}
+
+
+/**
+ * @brief	Pop the earliest event out of the min-heap
+ * @param	None
+ * @return	Event - The earliest event
+ */
+ScheduleEngine::Event ScheduleEngine::PopEvent(void)
+{
+	std::pop_heap(m_arrEventHeap.begin(), m_arrEventHeap.end(), &ScheduleEngine::CompareEvent);
+	Event schEvent = m_arrEventHeap.back();
+	m_arrEventHeap.pop_back();
+	return schEvent;
+}
+
+
+/**
+ * @brief	Schedule events for next occurrence of an entry
+ * @param	schEntry - Schedule entry
+ * @param	tpFrom	 - Time point to start searching from
+ * @return	None
+ */
+void ScheduleEngine::ScheduleOccurrence(const Entry& schEntry, TimePoint tpFrom)
+{
+	TimePoint tpOccurrence;
+	if (!CalcNextFireTime(schEntry, tpFrom, tpOccurrence))
+		return;
+
+	// Action event
+	Event schEvent{};
+	schEvent.tpFireTime = tpOccurrence;
+	schEvent.tpOccurrence = tpOccurrence;
+	schEvent.nItemID = schEntry.nItemID;
+	schEvent.eType = actionEvent;
+
+	// If this occurrence has already been fired, move on to the next one
+	if (IsHandled(schEvent)) {
+		if (!CalcNextFireTime(schEntry, tpOccurrence + seconds(1), tpOccurrence))
+			return;
+		schEvent.tpFireTime = tpOccurrence;
+		schEvent.tpOccurrence = tpOccurrence;
+	}
+	PushEvent(schEvent);
+
+	// Notify event
+	if (m_nNotifyOffset > 0) {
+		schEvent.tpFireTime = tpOccurrence - seconds(m_nNotifyOffset);
+		schEvent.eType = notifyEvent;
+		if (!IsHandled(schEvent)) {
+			PushEvent(schEvent);
+		}
+	}
+}
+
+
+/**
+ * @brief	Find schedule entry by item ID
+ * @param	nItemID - Schedule item ID
+ * @return	const Entry* - Entry pointer (NULL if not found)
+ */
+const ScheduleEngine::Entry* ScheduleEngine::FindEntry(unsigned nItemID) const noexcept
+{
+	for (const Entry& schEntry : m_arrEntries) {
+		if (schEntry.nItemID == nItemID)
+			return &schEntry;
+	}
+
+	return NULL;
+}
+
+
+/**
+ * @brief	Check if an event occurrence is already handled
+ * @param	schEvent - Event to check
+ * @return	true/false
+ */
+bool ScheduleEngine::IsHandled(const Event& schEvent) const noexcept
+{
+	// Snoozed events are always unique
+	if (schEvent.eType == snoozeEvent)
+		return false;
+
+	for (const Event& handledEvent : m_arrHandled) {
+		if ((handledEvent.nItemID == schEvent.nItemID) && (handledEvent.eType == schEvent.eType) &&
+			(handledEvent.tpOccurrence == schEvent.tpOccurrence))
+			return true;
+	}
+
+	return false;
+}
+
+
+/**
+ * @brief	Mark an event occurrence as handled
+ * @param	schEvent - Handled event
+ * @return	None
+ */
+void ScheduleEngine::MarkHandled(const Event& schEvent)
+{
+	if (schEvent.eType == snoozeEvent)
+		return;
+
+	// Clean-up out-of-date records
+	TimePoint tpLateBound = schEvent.tpFireTime - seconds(m_nLateTolerance);
+	m_arrHandled.erase(std::remove_if(m_arrHandled.begin(), m_arrHandled.end(),
+		[tpLateBound](const Event& handledEvent) { return (handledEvent.tpOccurrence < tpLateBound); }), m_arrHandled.end());
+
+	m_arrHandled.push_back(schEvent);
+}
@@ -10,6 +10,8 @@
 #include "AppCore/Serialization.h"
 #include "AppCore/Logging.h"
 
+#include <algorithm>
+
 #ifdef _DEBUG
 #define new DEBUG_NEW
 #endif
@@ -17,6 +19,35 @@
 using namespace AppCore;
 
 
+// Snapshot serving registry reads (NULL: read from registry)
+static const SettingsStore::Snapshot* s_pReadSnapshot = NULL;
+
+
+/**
+ * @brief	Get a value from the read snapshot
+ * @param	sectionName	   - Section name
+ * @param	subSectionName - Sub section name
+ * @param	keyName		   - Key name
+ * @param	pValue		   - Value found in snapshot (NULL if not exists) (out)
+ * @return	true/false - Section is served by the read snapshot or not
+ */
+static bool GetReadSnapshotValue(const wchar_t* sectionName, const wchar_t* subSectionName, const wchar_t* keyName, const SettingsStore::Value*& pValue)
+{
+	pValue = NULL;
+	if ((s_pReadSnapshot == NULL) || (s_pReadSnapshot->find(sectionName) == s_pReadSnapshot->end()))
+		return false;
+
+	auto itSection = s_pReadSnapshot->find(SettingsStore::MakeSectionPath(sectionName, subSectionName));
+	if (itSection != s_pReadSnapshot->end()) {
+		auto itKey = itSection->second.find(keyName);
+		if (itKey != itSection->second.end()) {
+			pValue = &itKey->second;
+		}
+	}
+	return true;
+}
+
+
 /*----------------- Base functions for reading/writing registry values ----------------*/
 
 
@@ -31,6 +62,13 @@ using namespace AppCore;
  */
 unsigned AppRegistry::GetRegistryValueInt(const wchar_t* sectionName, const wchar_t* subSectionName, const wchar_t* keyName)
 {
+	// Get snapshot value
+	const SettingsStore::Value* pValue = NULL;
+	if (GetReadSnapshotValue(sectionName, subSectionName, keyName, pValue)) {
+		const int* pnValue = (pValue != NULL) ? std::get_if<int>(pValue) : NULL;
+		return (pnValue != NULL) ? static_cast<unsigned>(*pnValue) : UINT_MAX;
+	}
+
 	// Format section name
 	String sectionNameFormat;
 	if (subSectionName != NULL) {
@@ -74,6 +112,13 @@ bool AppRegistry::WriteRegistryValueInt(const wchar_t* sectionName, const wchar_
  */
 String AppRegistry::GetRegistryValueString(const wchar_t* sectionName, const wchar_t* subSectionName, const wchar_t* keyName)
 {
+	// Get snapshot value
+	const SettingsStore::Value* pValue = NULL;
+	if (GetReadSnapshotValue(sectionName, subSectionName, keyName, pValue)) {
+		const std::wstring* pstrValue = (pValue != NULL) ? std::get_if<std::wstring>(pValue) : NULL;
+		return (pstrValue != NULL) ? String(pstrValue->c_str()) : String(Constant::String::Null);
+	}
+
 	// Format section name
 	String sectionNameFormat;
 	if (subSectionName != NULL) {
@@ -130,6 +175,17 @@ bool AppRegistry::DeleteRegistrySection(const wchar_t* sectionName, const wchar_
 }
 
 
+/**
+ * @brief	Serve reads of the sections contained in a snapshot from that snapshot
+ * @param	pSnapshot - Settings snapshot (NULL: read from registry)
+ * @return	None
+ */
+void AppRegistry::SetReadSnapshot(const SettingsStore::Snapshot* pSnapshot)
+{
+	s_pReadSnapshot = pSnapshot;
+}
+
+
 /*--------------- Functions for reading/writing application profile info ---------------*/
 
 
@@ -598,6 +654,429 @@ bool AppRegistry::WriteGlobalData(const wchar_t* subSectionName, const wchar_t*
 	return WriteRegistryValueString(Section::GlobalData, subSectionName, keyName, value);
 }
 
+/**
+ * @brief	Using for reading app data snapshot serial number
+ * @param	keyName - Key name
+ * @param	nRef	- Result value (ref-value)
+ * @return	bool - Result of reading process
+ */
+bool AppRegistry::GetDataSnapshotSerial(const wchar_t* keyName, int& nRef)
+{
+	// Get registry value
+	int nRet = GetRegistryValueInt(Section::AppDataSnapshot, NULL, keyName);
+	if (nRet == UINT_MAX) return false;
+	nRef = nRet; // Copy returned value
+	return true;
+}
+
+
+/*------------- Functions for setting data values into a settings snapshot -------------*/
+
+
+/**
+ * @brief	Using for setting config values into settings snapshot
+ * @param	snapshot - Settings snapshot
+ * @param	keyName	 - Key name
+ * @param	nValue	 - Value to set
+ * @return	None
+ */
+void AppRegistry::SetConfig(SettingsStore::Snapshot& snapshot, const wchar_t* keyName, int nValue)
+{
+	SettingsStore::SetValue(snapshot, Section::ConfigData, NULL, keyName, nValue);
+}
+
+/**
+ * @brief	Using for setting schedule values into settings snapshot
+ * @param	snapshot	- Settings snapshot
+ * @param	nItemIndex	- Schedule extra item index
+ * @param	keyName		- Key name
+ * @param	nValue		- Value to set
+ * @return	None
+ */
+void AppRegistry::SetDefaultSchedule(SettingsStore::Snapshot& snapshot, const wchar_t* keyName, int nValue)
+{
+	SettingsStore::SetValue(snapshot, Section::ScheduleData, Section::Schedule::DefautItem, keyName, nValue);
+}
+
+void AppRegistry::SetScheduleExtraItemNum(SettingsStore::Snapshot& snapshot, const wchar_t* keyName, int nValue)
+{
+	SettingsStore::SetValue(snapshot, Section::ScheduleData, NULL, keyName, nValue);
+}
+
+void AppRegistry::SetScheduleExtra(SettingsStore::Snapshot& snapshot, int nItemIndex, const wchar_t* keyName, int nValue)
+{
+	SettingsStore::SetValue(snapshot, Section::ScheduleData, Section::Schedule::Item(nItemIndex), keyName, nValue);
+}
+
+/**
+ * @brief	Using for setting HotkeySet values into settings snapshot
+ * @param	snapshot	- Settings snapshot
+ * @param	nItemIndex	- Hotkey item index
+ * @param	keyName		- Key name
+ * @param	nValue		- Value to set
+ * @return	None
+ */
+void AppRegistry::SetHotkeyItemNum(SettingsStore::Snapshot& snapshot, const wchar_t* keyName, int nValue)
+{
+	SettingsStore::SetValue(snapshot, Section::HotkeySetData, NULL, keyName, nValue);
+}
+
+void AppRegistry::SetHotkeySet(SettingsStore::Snapshot& snapshot, int nItemIndex, const wchar_t* keyName, int nValue)
+{
+	SettingsStore::SetValue(snapshot, Section::HotkeySetData, Section::HotkeySet::Item(nItemIndex), keyName, nValue);
+}
+
+/**
+ * @brief	Using for setting Power Reminder values into settings snapshot
+ * @param	snapshot	- Settings snapshot
+ * @param	nItemIndex	- Power Reminder item index
+ * @param	keyName		- Key name
+ * @param	nValue		- Value to set (integer)
+ * @param	value		- Value to set (string)
+ * @return	None
+ */
+void AppRegistry::SetPwrReminderCommonStyle(SettingsStore::Snapshot& snapshot, const wchar_t* keyName, int nValue)
+{
+	SettingsStore::SetValue(snapshot, Section::PwrReminderData, Section::PwrReminder::CommonStyle, keyName, nValue);
+}
+
+void AppRegistry::SetPwrReminderCommonStyle(SettingsStore::Snapshot& snapshot, const wchar_t* keyName, const wchar_t* value)
+{
+	SettingsStore::SetValue(snapshot, Section::PwrReminderData, Section::PwrReminder::CommonStyle, keyName, value);
+}
+
+void AppRegistry::SetPwrReminderItemNum(SettingsStore::Snapshot& snapshot, const wchar_t* keyName, int nValue)
+{
+	SettingsStore::SetValue(snapshot, Section::PwrReminderData, NULL, keyName, nValue);
+}
+
+void AppRegistry::SetPwrReminder(SettingsStore::Snapshot& snapshot, int nItemIndex, const wchar_t* keyName, int nValue)
+{
+	SettingsStore::SetValue(snapshot, Section::PwrReminderData, Section::PwrReminder::Item(nItemIndex), keyName, nValue);
+}
+
+void AppRegistry::SetPwrReminder(SettingsStore::Snapshot& snapshot, int nItemIndex, const wchar_t* keyName, const wchar_t* value)
+{
+	SettingsStore::SetValue(snapshot, Section::PwrReminderData, Section::PwrReminder::Item(nItemIndex), keyName, value);
+}
+
+/**
+ * @brief	Using for setting app data snapshot serial number into settings snapshot
+ * @param	snapshot - Settings snapshot
+ * @param	keyName	 - Key name
+ * @param	nValue	 - Value to set
+ * @return	None
+ */
+void AppRegistry::SetDataSnapshotSerial(SettingsStore::Snapshot& snapshot, const wchar_t* keyName, int nValue)
+{
+	SettingsStore::SetValue(snapshot, Section::AppDataSnapshot, NULL, keyName, nValue);
+}
+
+
+/*------------------ Implementation of RegistrySettingsBackend class -------------------*/
+
+
+/**
+ * @brief	Constructor
+ */
+RegistrySettingsBackend::RegistrySettingsBackend()
+	: m_hTransaction(NULL), m_bInTransaction(false)
+{
+}
+
+/**
+ * @brief	Destructor
+ */
+RegistrySettingsBackend::~RegistrySettingsBackend()
+{
+	// Uncommitted changes are discarded
+	if (m_bInTransaction) {
+		RollbackTransaction();
+	}
+}
+
+/**
+ * @brief	Read a root section (including all subsections) into snapshot
+ * @param	rootSection - Root section name
+ * @param	snapshot	- Result snapshot (out)
+ * @return	true/false
+ */
+bool RegistrySettingsBackend::ReadSection(const std::wstring& rootSection, SettingsStore::Snapshot& snapshot)
+{
+	std::wstring keyPath = SettingsStore::MakeSectionPath(Registry::Path::Application, rootSection.c_str());
+
+	HKEY hKey = NULL;
+	LSTATUS lResult = RegOpenKeyEx(HKEY_CURRENT_USER, keyPath.c_str(), 0, KEY_READ, &hKey);
+	if (lResult == ERROR_FILE_NOT_FOUND) return true;	// Section does not exist yet
+	if (lResult != ERROR_SUCCESS) return false;
+
+	bool bRet = ReadKey(hKey, rootSection, snapshot);
+	RegCloseKey(hKey);
+	return bRet;
+}
+
+/**
+ * @brief	Read values and subkeys of a registry key recursively
+ * @param	hKey		- Registry key handle
+ * @param	sectionPath - Section path of the key
+ * @param	snapshot	- Result snapshot (out)
+ * @return	true/false
+ */
+bool RegistrySettingsBackend::ReadKey(HKEY hKey, const std::wstring& sectionPath, SettingsStore::Snapshot& snapshot)
+{
+	DWORD dwSubKeyNum = 0, dwMaxSubKeyLen = 0, dwValueNum = 0, dwMaxValueNameLen = 0, dwMaxValueLen = 0;
+	if (RegQueryInfoKey(hKey, NULL, NULL, NULL, &dwSubKeyNum, &dwMaxSubKeyLen, NULL, &dwValueNum,
+						&dwMaxValueNameLen, &dwMaxValueLen, NULL, NULL) != ERROR_SUCCESS)
+		return false;
+
+	// Read values
+	SettingsStore::KeyMap& keyMap = snapshot[sectionPath];
+	std::vector<wchar_t> nameBuffer(static_cast<size_t>((std::max)(dwMaxValueNameLen, dwMaxSubKeyLen)) + 1);
+	std::vector<BYTE> dataBuffer(static_cast<size_t>(dwMaxValueLen) + sizeof(wchar_t));
+	for (DWORD dwIndex = 0; dwIndex < dwValueNum; dwIndex++) {
+		DWORD dwNameLen = static_cast<DWORD>(nameBuffer.size());
+		DWORD dwDataLen = static_cast<DWORD>(dataBuffer.size());
+		DWORD dwType = REG_NONE;
+		if (RegEnumValue(hKey, dwIndex, nameBuffer.data(), &dwNameLen, NULL, &dwType, dataBuffer.data(), &dwDataLen) != ERROR_SUCCESS)
+			continue;
+
+		std::wstring keyName(nameBuffer.data(), dwNameLen);
+		if ((dwType == REG_DWORD) && (dwDataLen == sizeof(DWORD))) {
+			keyMap[keyName] = static_cast<int>(*reinterpret_cast<const DWORD*>(dataBuffer.data()));
+		}
+		else if (dwType == REG_SZ) {
+			std::wstring value(reinterpret_cast<const wchar_t*>(dataBuffer.data()), dwDataLen / sizeof(wchar_t));
+			while (!value.empty() && (value.back() == L'\0')) value.pop_back();
+			keyMap[keyName] = std::move(value);
+		}
+	}
+
+	// Read subkeys
+	for (DWORD dwIndex = 0; dwIndex < dwSubKeyNum; dwIndex++) {
+		DWORD dwNameLen = static_cast<DWORD>(nameBuffer.size());
+		if (RegEnumKeyEx(hKey, dwIndex, nameBuffer.data(), &dwNameLen, NULL, NULL, NULL, NULL) != ERROR_SUCCESS)
+			continue;
+
+		std::wstring subSectionName(nameBuffer.data(), dwNameLen);
+		HKEY hSubKey = NULL;
+		if (RegOpenKeyEx(hKey, subSectionName.c_str(), 0, KEY_READ, &hSubKey) != ERROR_SUCCESS)
+			return false;
+
+		bool bRet = ReadKey(hSubKey, SettingsStore::MakeSectionPath(sectionPath.c_str(), subSectionName.c_str()), snapshot);
+		RegCloseKey(hSubKey);
+		if (bRet == false) return false;
+	}
+
+	return true;
+}
+
+/**
+ * @brief	Begin a registry transaction
+ * @param	None
+ * @return	true/false
+ */
+bool RegistrySettingsBackend::BeginTransaction(void)
+{
+	if (m_bInTransaction) return false;
+
+	// Create kernel transaction (if not available, changes are written directly)
+	m_hTransaction = ::CreateTransaction(NULL, NULL, 0, 0, 0, 0, NULL);
+	if (m_hTransaction == INVALID_HANDLE_VALUE) {
+		m_hTransaction = NULL;
+		TRACE_WARNING(L"Registry transaction is not available (error: {}), settings are written directly", GetLastError());
+	}
+
+	m_bInTransaction = true;
+	return true;
+}
+
+/**
+ * @brief	Commit/rollback the current registry transaction
+ * @param	None
+ * @return	true/false
+ */
+bool RegistrySettingsBackend::CommitTransaction(void)
+{
+	if (!m_bInTransaction) return false;
+
+	// Transacted key handles must be closed before committing
+	CloseSectionKeys();
+
+	bool bRet = true;
+	if (m_hTransaction != NULL) {
+		bRet = (::CommitTransaction(m_hTransaction) != FALSE);
+		if (bRet == false) {
+			TRACE_LOG(TraceLog::Error, L"Registry transaction commit failed (error: {})", GetLastError());
+		}
+	}
+
+	EndTransaction();
+	return bRet;
+}
+
+void RegistrySettingsBackend::RollbackTransaction(void)
+{
+	if (!m_bInTransaction) return;
+
+	CloseSectionKeys();
+	if (m_hTransaction != NULL) {
+		::RollbackTransaction(m_hTransaction);
+	}
+
+	EndTransaction();
+}
+
+/**
+ * @brief	Release the current transaction
+ * @param	None
+ * @return	None
+ */
+void RegistrySettingsBackend::EndTransaction(void)
+{
+	if (m_hTransaction != NULL) {
+		CloseHandle(m_hTransaction);
+		m_hTransaction = NULL;
+	}
+	m_bInTransaction = false;
+}
+
+/**
+ * @brief	Write/delete data inside the current transaction
+ * @param	sectionPath - Section path
+ * @param	keyName		- Key name
+ * @param	value		- Value
+ * @return	true/false
+ */
+bool RegistrySettingsBackend::WriteValue(const std::wstring& sectionPath, const std::wstring& keyName, const SettingsStore::Value& value)
+{
+	HKEY hKey = OpenSectionKey(sectionPath, true);
+	if (hKey == NULL) return false;
+
+	LSTATUS lResult = ERROR_SUCCESS;
+	if (const int* pnValue = std::get_if<int>(&value)) {
+		DWORD dwValue = static_cast<DWORD>(*pnValue);
+		lResult = RegSetValueEx(hKey, keyName.c_str(), 0, REG_DWORD, reinterpret_cast<const BYTE*>(&dwValue), sizeof(DWORD));
+	}
+	else {
+		const std::wstring& stringValue = std::get<std::wstring>(value);
+		DWORD dwDataSize = static_cast<DWORD>((stringValue.size() + 1) * sizeof(wchar_t));
+		lResult = RegSetValueEx(hKey, keyName.c_str(), 0, REG_SZ, reinterpret_cast<const BYTE*>(stringValue.c_str()), dwDataSize);
+	}
+
+	if (lResult != ERROR_SUCCESS) {
+		TRACE_WARNING(L"Write registry value failed: {}\\{} (error: {})", sectionPath, keyName, lResult);
+		return false;
+	}
+
+	return true;
+}
+
+bool RegistrySettingsBackend::DeleteValue(const std::wstring& sectionPath, const std::wstring& keyName)
+{
+	HKEY hKey = OpenSectionKey(sectionPath, false);
+	if (hKey == NULL) return true;	// Section does not exist
+
+	LSTATUS lResult = RegDeleteValue(hKey, keyName.c_str());
+	if ((lResult != ERROR_SUCCESS) && (lResult != ERROR_FILE_NOT_FOUND)) {
+		TRACE_WARNING(L"Delete registry value failed: {}\\{} (error: {})", sectionPath, keyName, lResult);
+		return false;
+	}
+
+	return true;
+}
+
+bool RegistrySettingsBackend::DeleteSection(const std::wstring& sectionPath)
+{
+	// Close cached handles of the section and its subsections
+	std::wstring subSectionPrefix = sectionPath + L'\\';
+	std::erase_if(m_mapKeyHandles, [&](const auto& keyHandle) {
+		if ((keyHandle.first != sectionPath) && (keyHandle.first.compare(0, subSectionPrefix.size(), subSectionPrefix) != 0))
+			return false;
+		RegCloseKey(keyHandle.second);
+		return true;
+	});
+
+	// Delete section tree from its parent key
+	size_t nSeparatorPos = sectionPath.rfind(L'\\');
+	std::wstring parentPath = (nSeparatorPos != std::wstring::npos) ? sectionPath.substr(0, nSeparatorPos) : std::wstring();
+	std::wstring sectionName = (nSeparatorPos != std::wstring::npos) ? sectionPath.substr(nSeparatorPos + 1) : sectionPath;
+
+	HKEY hParentKey = OpenSectionKey(parentPath, false);
+	if (hParentKey == NULL) return true;	// Parent does not exist
+
+	LSTATUS lResult = RegDeleteTree(hParentKey, sectionName.c_str());
+	if ((lResult != ERROR_SUCCESS) && (lResult != ERROR_FILE_NOT_FOUND)) {
+		TRACE_WARNING(L"Delete registry key failed: {} (error: {})", sectionPath, lResult);
+		return false;
+	}
+
+	return true;
+}
+
+/**
+ * @brief	Open (or create) section key inside the current transaction
+ * @param	sectionPath - Section path (empty: application root key)
+ * @param	bCreate		- Create key if not exists
+ * @return	HKEY - Cached key handle (NULL if failed or not exists)
+ */
+HKEY RegistrySettingsBackend::OpenSectionKey(const std::wstring& sectionPath, bool bCreate)
+{
+	if (!m_bInTransaction) return NULL;
+
+	// Get cached handle
+	auto itKeyHandle = m_mapKeyHandles.find(sectionPath);
+	if (itKeyHandle != m_mapKeyHandles.end())
+		return itKeyHandle->second;
+
+	// Key full path
+	std::wstring keyPath = sectionPath.empty() ? std::wstring(Registry::Path::Application)
+		: SettingsStore::MakeSectionPath(Registry::Path::Application, sectionPath.c_str());
+
+	HKEY hKey = NULL;
+	LSTATUS lResult = ERROR_SUCCESS;
+	if (bCreate == true) {
+		if (m_hTransaction != NULL) {
+			lResult = RegCreateKeyTransacted(HKEY_CURRENT_USER, keyPath.c_str(), 0, NULL, REG_OPTION_NON_VOLATILE,
+											 KEY_READ | KEY_WRITE, NULL, &hKey, NULL, m_hTransaction, NULL);
+		}
+		else {
+			lResult = RegCreateKeyEx(HKEY_CURRENT_USER, keyPath.c_str(), 0, NULL, REG_OPTION_NON_VOLATILE,
+									 KEY_READ | KEY_WRITE, NULL, &hKey, NULL);
+		}
+	}
+	else {
+		if (m_hTransaction != NULL) {
+			lResult = RegOpenKeyTransacted(HKEY_CURRENT_USER, keyPath.c_str(), 0, KEY_READ | KEY_WRITE, &hKey, m_hTransaction, NULL);
+		}
+		else {
+			lResult = RegOpenKeyEx(HKEY_CURRENT_USER, keyPath.c_str(), 0, KEY_READ | KEY_WRITE, &hKey);
+		}
+	}
+
+	if (lResult != ERROR_SUCCESS) {
+		if ((bCreate == true) || (lResult != ERROR_FILE_NOT_FOUND)) {
+			TRACE_WARNING(L"Open registry key failed: {} (error: {})", keyPath, lResult);
+		}
+		return NULL;
+	}
+
+	m_mapKeyHandles.emplace(sectionPath, hKey);
+	return hKey;
+}
+
+/**
+ * @brief	Close all cached section key handles
+ * @param	None
+ * @return	None
+ */
+void RegistrySettingsBackend::CloseSectionKeys(void)
+{
+	for (auto& keyHandle : m_mapKeyHandles) {
+		RegCloseKey(keyHandle.second);
+	}
+	m_mapKeyHandles.clear();
+}
+
 
 /*----------------------- Implementation of BackupSystem class -------------------------*/
 
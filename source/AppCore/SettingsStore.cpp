@@ -0,0 +1,565 @@
+﻿/**
+ * @file		SettingsStore.cpp
+ * @brief		Implement transactional, diff-based settings persistence
+ * @author		AnthonyLeeStark
+ * @date		2026.10.17
+ *
+ * @copyright 	Copyright (c) 2015-2025 AnthonyLeeStark
+ */
+
+#include "AppCore/SettingsStore.h"
+
+#include <array>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+
+#ifdef _DEBUG
+#define new DEBUG_NEW
+#endif
+
+
+// Settings file header
+constexpr const uint32_t settingsFileSignature = 0x54535050;		// "PPST"
+constexpr const uint32_t settingsFileVersion = 2;
+
+
+/**
+ * @brief	Check if a section path belongs to a root section
+ * @param	sectionPath - Section path
+ * @param	rootSection - Root section name
+ * @return	true/false
+ */
+static bool IsInRootSection(const std::wstring& sectionPath, const std::wstring& rootSection)
+{
+	if (sectionPath.compare(0, rootSection.size(), rootSection) != 0) return false;
+	return ((sectionPath.size() == rootSection.size()) || (sectionPath[rootSection.size()] == L'\\'));
+}
+
+/**
+ * @brief	Append/read binary data to/from serialized data buffer
+ * @param	buffer	- Data buffer
+ * @param	nValue	- Integer value
+ * @param	text	- String value
+ * @param	nOffset	- Read offset (in/out)
+ * @return	true/false
+ */
+static void AppendUInt32(std::vector<uint8_t>& buffer, uint32_t nValue)
+{
+	const uint8_t* pData = reinterpret_cast<const uint8_t*>(&nValue);
+	buffer.insert(buffer.end(), pData, pData + sizeof(nValue));
+}
+
+static void AppendText(std::vector<uint8_t>& buffer, const std::wstring& text)
+{
+	AppendUInt32(buffer, static_cast<uint32_t>(text.size()));
+	const uint8_t* pData = reinterpret_cast<const uint8_t*>(text.data());
+	buffer.insert(buffer.end(), pData, pData + text.size() * sizeof(wchar_t));
+}
+
+static bool ReadUInt32(const uint8_t* pData, size_t nSize, size_t& nOffset, uint32_t& nValue)
+{
+	if ((nSize < sizeof(nValue)) || (nOffset > nSize - sizeof(nValue))) return false;
+	memcpy(&nValue, pData + nOffset, sizeof(nValue));
+	nOffset += sizeof(nValue);
+	return true;
+}
+
+static bool ReadText(const uint8_t* pData, size_t nSize, size_t& nOffset, std::wstring& text)
+{
+	uint32_t nLength = 0;
+	if (!ReadUInt32(pData, nSize, nOffset, nLength)) return false;
+	size_t nByteCount = static_cast<size_t>(nLength) * sizeof(wchar_t);
+	if (nByteCount > nSize - nOffset) return false;
+	text.resize(nLength);
+	memcpy(text.data(), pData + nOffset, nByteCount);
+	nOffset += nByteCount;
+	return true;
+}
+
+
+/*----------------------- Implementation of SettingsStore class ------------------------*/
+
+
+/**
+ * @brief	Constructor
+ * @param	pBackend - Storage backend
+ */
+SettingsStore::SettingsStore(std::unique_ptr<Backend>&& pBackend)
+	: m_pBackend(std::move(pBackend)), m_nLastWriteCount(0), m_nLastDeleteCount(0)
+{
+}
+
+/**
+ * @brief	Make section path from section and subsection name
+ * @param	sectionName	   - Section name
+ * @param	subSectionName - Sub section name (can be NULL)
+ * @return	std::wstring
+ */
+std::wstring SettingsStore::MakeSectionPath(const wchar_t* sectionName, const wchar_t* subSectionName /* = nullptr */)
+{
+	std::wstring sectionPath(sectionName);
+	if (subSectionName != nullptr) {
+		sectionPath += L'\\';
+		sectionPath += subSectionName;
+	}
+	return sectionPath;
+}
+
+/**
+ * @brief	Set a value in settings snapshot
+ * @param	snapshot	   - Settings snapshot
+ * @param	sectionName	   - Section name
+ * @param	subSectionName - Sub section name (can be NULL)
+ * @param	keyName		   - Key name
+ * @param	nValue		   - Value (integer)
+ * @param	value		   - Value (string)
+ * @return	None
+ */
+void SettingsStore::SetValue(Snapshot& snapshot, const wchar_t* sectionName, const wchar_t* subSectionName, const wchar_t* keyName, int nValue)
+{
+	snapshot[MakeSectionPath(sectionName, subSectionName)][keyName] = nValue;
+}
+
+void SettingsStore::SetValue(Snapshot& snapshot, const wchar_t* sectionName, const wchar_t* subSectionName, const wchar_t* keyName, const wchar_t* value)
+{
+	snapshot[MakeSectionPath(sectionName, subSectionName)][keyName] = std::wstring((value != nullptr) ? value : L"");
+}
+
+/**
+ * @brief	Persist the given root sections of snapshot
+ * @param	snapshot	 - Settings snapshot (new data)
+ * @param	rootSections - Root sections to persist (sections missing in snapshot are deleted)
+ * @return	true/false - Result of committing (on failure, no change is persisted)
+ */
+bool SettingsStore::Commit(const Snapshot& snapshot, const std::vector<std::wstring>& rootSections)
+{
+	std::lock_guard<std::mutex> lock(m_mtxStore);
+
+	m_nLastWriteCount = 0;
+	m_nLastDeleteCount = 0;
+	if (m_pBackend == nullptr) return false;
+
+	// Get last persisted data (read from backend at first use)
+	for (const std::wstring& rootSection : rootSections) {
+		if (m_mapPersisted.find(rootSection) != m_mapPersisted.end()) continue;
+		Snapshot persisted;
+		if (!m_pBackend->ReadSection(rootSection, persisted)) return false;
+		m_mapPersisted.emplace(rootSection, std::move(persisted));
+	}
+
+	// Apply changes of all root sections in one transaction
+	if (!m_pBackend->BeginTransaction()) return false;
+
+	std::map<std::wstring, Snapshot> mapCommitted;
+	bool bResult = true;
+	for (const std::wstring& rootSection : rootSections) {
+		Snapshot& newData = mapCommitted[rootSection];
+		ExtractSection(snapshot, rootSection, newData);
+		bResult = CommitSection(m_mapPersisted[rootSection], newData);
+		if (bResult == false) break;
+	}
+
+	if (bResult == true) {
+		bResult = m_pBackend->CommitTransaction();
+	}
+	else {
+		m_pBackend->RollbackTransaction();
+	}
+
+	if (bResult == true) {
+		// Update last persisted snapshot
+		for (auto& [rootSection, newData] : mapCommitted) {
+			m_mapPersisted[rootSection] = std::move(newData);
+		}
+	}
+	else {
+		// Persisted state is unknown, read it again on next commit
+		for (const std::wstring& rootSection : rootSections) {
+			m_mapPersisted.erase(rootSection);
+		}
+		m_nLastWriteCount = 0;
+		m_nLastDeleteCount = 0;
+	}
+
+	return bResult;
+}
+
+/**
+ * @brief	Forget last persisted snapshot
+ * @param	rootSection - Root section name (NULL: all sections)
+ * @return	None
+ */
+void SettingsStore::Invalidate(const wchar_t* rootSection /* = nullptr */)
+{
+	std::lock_guard<std::mutex> lock(m_mtxStore);
+	if (rootSection == nullptr) {
+		m_mapPersisted.clear();
+	}
+	else {
+		m_mapPersisted.erase(rootSection);
+	}
+}
+
+/**
+ * @brief	Set last persisted snapshot of root sections (when it is already known,
+ *			e.g: loaded from a snapshot file which matches the backend data)
+ * @param	snapshot	 - Settings snapshot
+ * @param	rootSections - Root sections
+ * @return	None
+ */
+void SettingsStore::SetPersistedData(const Snapshot& snapshot, const std::vector<std::wstring>& rootSections)
+{
+	std::lock_guard<std::mutex> lock(m_mtxStore);
+	for (const std::wstring& rootSection : rootSections) {
+		Snapshot& persisted = m_mapPersisted[rootSection];
+		persisted.clear();
+		ExtractSection(snapshot, rootSection, persisted);
+	}
+}
+
+/**
+ * @brief	Get last persisted snapshot of root sections (read from backend if not known yet)
+ * @param	rootSections - Root sections
+ * @param	snapshot	 - Result snapshot (out)
+ * @return	true/false
+ */
+bool SettingsStore::GetPersistedData(const std::vector<std::wstring>& rootSections, Snapshot& snapshot)
+{
+	std::lock_guard<std::mutex> lock(m_mtxStore);
+	if (m_pBackend == nullptr) return false;
+
+	for (const std::wstring& rootSection : rootSections) {
+		auto itPersisted = m_mapPersisted.find(rootSection);
+		if (itPersisted == m_mapPersisted.end()) {
+			Snapshot persisted;
+			if (!m_pBackend->ReadSection(rootSection, persisted)) return false;
+			itPersisted = m_mapPersisted.emplace(rootSection, std::move(persisted)).first;
+		}
+		snapshot.insert(itPersisted->second.begin(), itPersisted->second.end());
+	}
+
+	return true;
+}
+
+/**
+ * @brief	Diff and write a root section inside the current transaction
+ * @param	persisted - Last persisted data of the root section
+ * @param	snapshot  - New data of the root section
+ * @return	true/false
+ */
+bool SettingsStore::CommitSection(const Snapshot& persisted, const Snapshot& snapshot)
+{
+	// Delete sections and keys which no longer exist
+	for (const auto& [sectionPath, oldKeys] : persisted) {
+		auto itNewSection = snapshot.find(sectionPath);
+		if (itNewSection == snapshot.end()) {
+			if (!m_pBackend->DeleteSection(sectionPath)) return false;
+			m_nLastDeleteCount++;
+			continue;
+		}
+		for (const auto& oldKey : oldKeys) {
+			if (itNewSection->second.find(oldKey.first) != itNewSection->second.end()) continue;
+			if (!m_pBackend->DeleteValue(sectionPath, oldKey.first)) return false;
+			m_nLastDeleteCount++;
+		}
+	}
+
+	// Write new and changed values
+	for (const auto& [sectionPath, newKeys] : snapshot) {
+		auto itOldSection = persisted.find(sectionPath);
+		for (const auto& [keyName, value] : newKeys) {
+			if (itOldSection != persisted.end()) {
+				auto itOldKey = itOldSection->second.find(keyName);
+				if ((itOldKey != itOldSection->second.end()) && (itOldKey->second == value)) continue;
+			}
+			if (!m_pBackend->WriteValue(sectionPath, keyName, value)) return false;
+			m_nLastWriteCount++;
+		}
+	}
+
+	return true;
+}
+
+/**
+ * @brief	Get all sections belonging to a root section
+ * @param	snapshot	- Settings snapshot
+ * @param	rootSection - Root section name
+ * @param	result		- Result snapshot (out)
+ * @return	None
+ */
+void SettingsStore::ExtractSection(const Snapshot& snapshot, const std::wstring& rootSection, Snapshot& result)
+{
+	for (auto it = snapshot.lower_bound(rootSection); it != snapshot.end(); it++) {
+		if (it->first.compare(0, rootSection.size(), rootSection) != 0) break;
+		if (IsInRootSection(it->first, rootSection)) {
+			result.insert(*it);
+		}
+	}
+}
+
+
+/**
+ * @brief	Serialize snapshot data into a binary buffer
+ * @param	snapshot - Settings snapshot
+ * @param	buffer	 - Output buffer (data is appended)
+ * @return	None
+ */
+void SettingsStore::Serialize(const Snapshot& snapshot, std::vector<uint8_t>& buffer)
+{
+	AppendUInt32(buffer, static_cast<uint32_t>(sizeof(wchar_t)));
+	AppendUInt32(buffer, static_cast<uint32_t>(snapshot.size()));
+	for (const auto& [sectionPath, keyMap] : snapshot) {
+		AppendText(buffer, sectionPath);
+		AppendUInt32(buffer, static_cast<uint32_t>(keyMap.size()));
+		for (const auto& [keyName, value] : keyMap) {
+			AppendText(buffer, keyName);
+			AppendUInt32(buffer, static_cast<uint32_t>(value.index()));
+			if (const int* pnValue = std::get_if<int>(&value)) {
+				AppendUInt32(buffer, static_cast<uint32_t>(*pnValue));
+			}
+			else {
+				AppendText(buffer, std::get<std::wstring>(value));
+			}
+		}
+	}
+}
+
+/**
+ * @brief	Deserialize snapshot data from a binary buffer
+ * @param	pData	 - Serialized data
+ * @param	nSize	 - Data size (in bytes)
+ * @param	snapshot - Result snapshot (out)
+ * @return	true/false - Data is valid or not
+ */
+bool SettingsStore::Deserialize(const uint8_t* pData, size_t nSize, Snapshot& snapshot)
+{
+	size_t nOffset = 0;
+	uint32_t nCharSize = 0, nSectionCount = 0;
+	if (!ReadUInt32(pData, nSize, nOffset, nCharSize) || (nCharSize != sizeof(wchar_t))) return false;
+	if (!ReadUInt32(pData, nSize, nOffset, nSectionCount)) return false;
+
+	Snapshot result;
+	for (uint32_t nSection = 0; nSection < nSectionCount; nSection++) {
+		std::wstring sectionPath;
+		uint32_t nKeyCount = 0;
+		if (!ReadText(pData, nSize, nOffset, sectionPath) || !ReadUInt32(pData, nSize, nOffset, nKeyCount)) return false;
+
+		KeyMap& keyMap = result[sectionPath];
+		for (uint32_t nKey = 0; nKey < nKeyCount; nKey++) {
+			std::wstring keyName;
+			uint32_t nType = 0;
+			if (!ReadText(pData, nSize, nOffset, keyName) || !ReadUInt32(pData, nSize, nOffset, nType)) return false;
+			if (nType == 0) {
+				uint32_t nValue = 0;
+				if (!ReadUInt32(pData, nSize, nOffset, nValue)) return false;
+				keyMap[keyName] = static_cast<int>(nValue);
+			}
+			else if (nType == 1) {
+				std::wstring textValue;
+				if (!ReadText(pData, nSize, nOffset, textValue)) return false;
+				keyMap[keyName] = std::move(textValue);
+			}
+			else return false;
+		}
+	}
+
+	if (nOffset != nSize) return false;
+	snapshot.swap(result);
+	return true;
+}
+
+/**
+ * @brief	Calculate checksum (CRC-32) of data
+ * @param	pData - Data
+ * @param	nSize - Data size (in bytes)
+ * @return	uint32_t
+ */
+uint32_t SettingsStore::Checksum(const uint8_t* pData, size_t nSize) noexcept
+{
+	// CRC-32 (IEEE 802.3) lookup table
+	static constexpr auto crcTable = [] {
+		std::array<uint32_t, 256> table{};
+		for (uint32_t nIndex = 0; nIndex < 256; nIndex++) {
+			uint32_t nValue = nIndex;
+			for (int nBit = 0; nBit < 8; nBit++) {
+				nValue = (nValue & 1) ? (0xEDB88320u ^ (nValue >> 1)) : (nValue >> 1);
+			}
+			table[nIndex] = nValue;
+		}
+		return table;
+	}();
+
+	uint32_t nCrc = 0xFFFFFFFFu;
+	for (size_t nIndex = 0; nIndex < nSize; nIndex++) {
+		nCrc = crcTable[(nCrc ^ pData[nIndex]) & 0xFF] ^ (nCrc >> 8);
+	}
+	return (nCrc ^ 0xFFFFFFFFu);
+}
+
+
+/*------------------- Implementation of MemorySettingsBackend class --------------------*/
+
+
+/**
+ * @brief	Constructor
+ * @param	filePath - Backing file path
+ */
+MemorySettingsBackend::MemorySettingsBackend() : m_bInTransaction(false)
+{
+}
+
+MemorySettingsBackend::MemorySettingsBackend(const std::filesystem::path& filePath)
+	: m_bInTransaction(false), m_filePath(filePath)
+{
+	LoadFile();
+}
+
+/**
+ * @brief	Read a root section (including all subsections) into snapshot
+ * @param	rootSection - Root section name
+ * @param	snapshot	- Result snapshot (out)
+ * @return	true/false
+ */
+bool MemorySettingsBackend::ReadSection(const std::wstring& rootSection, SettingsStore::Snapshot& snapshot)
+{
+	for (const auto& section : m_mapData) {
+		if (IsInRootSection(section.first, rootSection)) {
+			snapshot.insert(section);
+		}
+	}
+	return true;
+}
+
+/**
+ * @brief	Transaction control
+ * @param	None
+ * @return	true/false
+ */
+bool MemorySettingsBackend::BeginTransaction(void)
+{
+	if (m_bInTransaction) return false;
+	m_mapStaged = m_mapData;
+	m_bInTransaction = true;
+	return true;
+}
+
+bool MemorySettingsBackend::CommitTransaction(void)
+{
+	if (!m_bInTransaction) return false;
+	m_bInTransaction = false;
+
+	// Save backing file first, committed data is kept unchanged on failure
+	if (!m_filePath.empty() && !SaveFile(m_mapStaged)) {
+		m_mapStaged.clear();
+		return false;
+	}
+
+	m_mapData.swap(m_mapStaged);
+	m_mapStaged.clear();
+	return true;
+}
+
+void MemorySettingsBackend::RollbackTransaction(void)
+{
+	m_bInTransaction = false;
+	m_mapStaged.clear();
+}
+
+/**
+ * @brief	Write/delete data inside the current transaction
+ * @param	sectionPath - Section path
+ * @param	keyName		- Key name
+ * @param	value		- Value
+ * @return	true/false
+ */
+bool MemorySettingsBackend::WriteValue(const std::wstring& sectionPath, const std::wstring& keyName, const SettingsStore::Value& value)
+{
+	if (!m_bInTransaction) return false;
+	m_mapStaged[sectionPath][keyName] = value;
+	return true;
+}
+
+bool MemorySettingsBackend::DeleteValue(const std::wstring& sectionPath, const std::wstring& keyName)
+{
+	if (!m_bInTransaction) return false;
+	auto itSection = m_mapStaged.find(sectionPath);
+	if (itSection != m_mapStaged.end()) {
+		itSection->second.erase(keyName);
+	}
+	return true;
+}
+
+bool MemorySettingsBackend::DeleteSection(const std::wstring& sectionPath)
+{
+	if (!m_bInTransaction) return false;
+	std::erase_if(m_mapStaged, [&sectionPath](const auto& section) {
+		return IsInRootSection(section.first, sectionPath);
+	});
+	return true;
+}
+
+/**
+ * @brief	Load data from backing file
+ * @param	None
+ * @return	true/false
+ */
+bool MemorySettingsBackend::LoadFile(void)
+{
+	std::ifstream fileStream(m_filePath, std::ios::binary);
+	if (!fileStream.is_open()) return false;
+
+	// Read whole file
+	std::vector<uint8_t> fileData((std::istreambuf_iterator<char>(fileStream)), std::istreambuf_iterator<char>());
+
+	// Check header: [Signature][Version][Checksum][Data]
+	size_t nOffset = 0;
+	uint32_t nSignature = 0, nVersion = 0, nChecksum = 0;
+	if (!ReadUInt32(fileData.data(), fileData.size(), nOffset, nSignature) || (nSignature != settingsFileSignature)) return false;
+	if (!ReadUInt32(fileData.data(), fileData.size(), nOffset, nVersion) || (nVersion != settingsFileVersion)) return false;
+	if (!ReadUInt32(fileData.data(), fileData.size(), nOffset, nChecksum)) return false;
+
+	const uint8_t* pData = fileData.data() + nOffset;
+	size_t nDataSize = fileData.size() - nOffset;
+	if (SettingsStore::Checksum(pData, nDataSize) != nChecksum) return false;
+
+	return SettingsStore::Deserialize(pData, nDataSize, m_mapData);
+}
+
+/**
+ * @brief	Save data to backing file (atomically replace the old file)
+ * @param	data - Data to save
+ * @return	true/false
+ */
+bool MemorySettingsBackend::SaveFile(const SettingsStore::Snapshot& data) const
+{
+	std::vector<uint8_t> dataBuffer;
+	SettingsStore::Serialize(data, dataBuffer);
+
+	std::vector<uint8_t> fileData;
+	AppendUInt32(fileData, settingsFileSignature);
+	AppendUInt32(fileData, settingsFileVersion);
+	AppendUInt32(fileData, SettingsStore::Checksum(dataBuffer.data(), dataBuffer.size()));
+	fileData.insert(fileData.end(), dataBuffer.begin(), dataBuffer.end());
+
+	// Write temporary file
+	std::filesystem::path tempFilePath = m_filePath;
+	tempFilePath += L".tmp";
+	{
+		std::ofstream fileStream(tempFilePath, std::ios::binary | std::ios::trunc);
+		if (!fileStream.is_open()) return false;
+		fileStream.write(reinterpret_cast<const char*>(fileData.data()), static_cast<std::streamsize>(fileData.size()));
+		fileStream.flush();
+		if (!fileStream.good()) return false;
+	}
+
+	// Replace old file
+	std::error_code errorCode;
+	std::filesystem::rename(tempFilePath, m_filePath, errorCode);
+	if (errorCode) {
+		std::filesystem::remove(tempFilePath, errorCode);
+		return false;
+	}
+
+	return true;
+}
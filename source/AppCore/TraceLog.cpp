@@ -0,0 +1,54 @@
+﻿/**
+ * @file		TraceLog.cpp
+ * @brief		Implement leveled trace logging
+ * @author		AnthonyLeeStark
+ * @date		2026.10.17
+ *
+ * @copyright 	Copyright (c) 2015-2025 AnthonyLeeStark
+ */
+
+#include "AppCore/Logging.h"
+
+#ifdef _DEBUG
+#define new DEBUG_NEW
+#endif
+
+
+// Runtime level threshold (default: same as trace debug info log)
+std::atomic<int> TraceLog::runtimeLevel = TraceLog::Debug;
+
+
+/**
+ * @brief	Get trace level name
+ * @param	nLevel - Trace level
+ * @return	const wchar_t*
+ */
+const wchar_t* TraceLog::GetLevelName(int nLevel) noexcept
+{
+	switch (nLevel)
+	{
+	case Verbose:
+		return _T("VERBOSE");
+	case Debug:
+		return _T("DEBUG");
+	case Info:
+		return _T("INFO");
+	case Warning:
+		return _T("WARNING");
+	case Error:
+		return _T("ERROR");
+	default:
+		return Constant::String::Empty;
+	}
+}
+
+/**
+ * @brief	Hand a trace record over to the debug logger
+ * @param	pRecord - Trace record
+ * @return	None
+ */
+void TraceLog::Submit(std::unique_ptr<Record>&& pRecord)
+{
+	if (pRecord == nullptr) return;
+	DebugLogging::GetDebugLogger().AddTraceRecord(std::move(pRecord));
+}
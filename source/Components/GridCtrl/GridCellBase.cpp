@@ -285,7 +285,7 @@ BOOL CGridCellBase::Draw(CDC* pDC, int nRow, int nCol, CRect rect,  BOOL bEraseB
     // Draw sort arrow
     if (pGrid->GetSortColumn() == nCol && nRow == 0)
     {
-        CSize size = pDC->GetTextExtent(_T("M"));
+        CSize size = pGrid->GetTextExtentCache().GetTextExtent(pDC, GetFont(), _T("M"), 1);
         int nOffset = 2;
 
         // Base the size of the triangle on the smaller of the column
@@ -491,23 +491,29 @@ CSize CGridCellBase::GetTextExtent(LPCTSTR szText, CDC* pDC /*= NULL*/)
     CSize size;
     int nFormat = GetFormat();
 
+    // Extents are looked up in the grid's cache before measuring (by font, so
+    // only when the cell font is selected)
+    CGridTextExtentCache& cache = pGrid->GetTextExtentCache();
+    LOGFONT *pLF = GetFont();
+    const LOGFONT *pCacheLF = (pFont)? pLF : NULL;
+
     // If the cell is a multiline cell, then use the width of the cell
     // to get the height
     if ((nFormat & DT_WORDBREAK) && !(nFormat & DT_SINGLELINE))
     {
-        CString str = szText;
         int nMaxWidth = 0;
+        LPCTSTR pszLine = szText;
         while (TRUE)
         {
-            int nPos = str.Find(_T('\n'));
-            CString TempStr = (nPos < 0)? str : str.Left(nPos);
-            int nTempWidth = pDC->GetTextExtent(TempStr).cx;
+            LPCTSTR pszEnd = _tcschr(pszLine, _T('\n'));
+            int nLength = (pszEnd == NULL)? (int)_tcslen(pszLine) : (int)(pszEnd - pszLine);
+            int nTempWidth = cache.GetTextExtent(pDC, pCacheLF, pszLine, nLength).cx;
             if (nTempWidth > nMaxWidth)
                 nMaxWidth = nTempWidth;
 
-            if (nPos < 0)
+            if (pszEnd == NULL)
                 break;
-            str = str.Mid(nPos + 1);    // Bug fix by Thomas Steinborn
+            pszLine = pszEnd + 1;
         }
         
         CRect rect;
@@ -516,7 +522,7 @@ CSize CGridCellBase::GetTextExtent(LPCTSTR szText, CDC* pDC /*= NULL*/)
         size = rect.Size();
     }
     else
-        size = pDC->GetTextExtent(szText, (int)_tcslen(szText));
+        size = cache.GetTextExtent(pDC, pCacheLF, szText);
 
     // Removed by Yogurt
     //TEXTMETRIC tm;
@@ -529,7 +535,6 @@ CSize CGridCellBase::GetTextExtent(LPCTSTR szText, CDC* pDC /*= NULL*/)
     size += CSize(2*GetMargin(), 2*GetMargin());
 
     // Kludge for vertical text
-    LOGFONT *pLF = GetFont();
     if (pLF->lfEscapement == 900 || pLF->lfEscapement == -900)
     {
         int nTemp = size.cx;
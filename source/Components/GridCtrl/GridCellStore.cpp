@@ -0,0 +1,421 @@
+﻿/**
+ * @file		GridCellStore.cpp
+ * @brief		Compact column-wise cell storage for the grid control
+ * @author		AnthonyLeeStark
+ * @date		2026.10.17
+ *
+ * @copyright 	Copyright (c) 2015-2025 AnthonyLeeStark
+ */
+
+#include "Components/GridCtrl/GridCellStore.h"
+#include <algorithm>
+#include <iterator>
+
+#ifdef _DEBUG
+#define new DEBUG_NEW
+#undef THIS_FILE
+static char THIS_FILE[] = __FILE__;
+#endif
+
+/////////////////////////////////////////////////////////////////////////////
+// CGridStringPool
+
+CGridStringPool::CGridStringPool()
+{
+    RemoveAll();
+}
+
+// Returns the ID of the given string, adding it to the pool if necessary
+UINT CGridStringPool::Add(LPCTSTR lpszText)
+{
+    if (lpszText == NULL || lpszText[0] == _T('\0'))
+        return 0;
+
+    std::basic_string_view<TCHAR> strText(lpszText);
+    auto it = m_mapStrings.find(strText);
+    if (it != m_mapStrings.end())
+        return it->second;
+
+    // Copy the string into the last block, or into a new one if it does not fit
+    size_t nLength = strText.size() + 1;
+    if (nLength > m_nBlockFree)
+    {
+        size_t nBlockSize = (nLength > BLOCK_SIZE) ? nLength : BLOCK_SIZE;
+        m_arBlocks.push_back(std::make_unique<TCHAR[]>(nBlockSize));
+        m_pszBlockFree = m_arBlocks.back().get();
+        m_nBlockFree = nBlockSize;
+        m_nCharCount += nBlockSize;
+    }
+
+    TCHAR* pszCopy = m_pszBlockFree;
+    memcpy(pszCopy, lpszText, nLength * sizeof(TCHAR));
+    m_pszBlockFree += nLength;
+    m_nBlockFree -= nLength;
+
+    UINT nID = (UINT)m_arStrings.size();
+    m_arStrings.push_back(pszCopy);
+    m_mapStrings.emplace(std::basic_string_view<TCHAR>(pszCopy, nLength - 1), nID);
+
+    return nID;
+}
+
+LPCTSTR CGridStringPool::GetAt(UINT nID) const
+{
+    ASSERT(nID < m_arStrings.size());
+    if (nID >= m_arStrings.size())
+        return _T("");
+
+    return m_arStrings[nID];
+}
+
+void CGridStringPool::RemoveAll()
+{
+    m_arBlocks.clear();
+    m_pszBlockFree = NULL;
+    m_nBlockFree = 0;
+    m_nCharCount = 0;
+    m_mapStrings.clear();
+    m_arStrings.clear();
+    m_arStrings.push_back(_T(""));
+}
+
+size_t CGridStringPool::GetMemoryUsage() const
+{
+    // Hash nodes hold a view, an ID and a next pointer
+    return m_nCharCount * sizeof(TCHAR)
+         + m_arStrings.capacity() * sizeof(LPCTSTR)
+         + m_mapStrings.size() * (sizeof(std::basic_string_view<TCHAR>) + 2 * sizeof(void*))
+         + m_mapStrings.bucket_count() * sizeof(void*);
+}
+
+/////////////////////////////////////////////////////////////////////////////
+// CGridCellStore
+
+CGridCellStore::CGridCellStore()
+{
+    RemoveAll();
+}
+
+void CGridCellStore::SetRowCount(int nRows)
+{
+    ASSERT(nRows >= 0);
+    if (nRows < m_nRows)
+        RemoveRows(nRows, m_nRows - nRows);
+    else if (nRows > m_nRows)
+        InsertRows(m_nRows, nRows - m_nRows);
+}
+
+void CGridCellStore::SetColumnCount(int nCols)
+{
+    ASSERT(nCols >= 0);
+    if (nCols < GetColumnCount())
+        RemoveColumns(nCols, GetColumnCount() - nCols);
+    else if (nCols > GetColumnCount())
+        InsertColumns(GetColumnCount(), nCols - GetColumnCount());
+}
+
+void CGridCellStore::InsertRows(int nRow, int nCount /*=1*/)
+{
+    ASSERT(nRow >= 0 && nRow <= m_nRows && nCount >= 0);
+
+    for (GRID_COLUMN& column : m_arColumns)
+    {
+        column.arText.insert(column.arText.begin() + nRow, nCount, 0);
+        column.arStyle.insert(column.arStyle.begin() + nRow, nCount, 0);
+        if (!column.arData.empty())
+            column.arData.insert(column.arData.begin() + nRow, nCount, 0);
+    }
+    m_nRows += nCount;
+}
+
+void CGridCellStore::RemoveRows(int nRow, int nCount /*=1*/)
+{
+    ASSERT(nRow >= 0 && nCount >= 0 && nRow + nCount <= m_nRows);
+
+    m_nRows -= nCount;
+    for (GRID_COLUMN& column : m_arColumns)
+    {
+        column.arText.erase(column.arText.begin() + nRow, column.arText.begin() + nRow + nCount);
+        column.arStyle.erase(column.arStyle.begin() + nRow, column.arStyle.begin() + nRow + nCount);
+        if (!column.arData.empty())
+            column.arData.erase(column.arData.begin() + nRow, column.arData.begin() + nRow + nCount);
+
+        // Nothing refers to the pool any more
+        if (m_nRows == 0)
+            column.strings.RemoveAll();
+    }
+}
+
+void CGridCellStore::InsertColumns(int nCol, int nCount /*=1*/)
+{
+    ASSERT(nCol >= 0 && nCol <= GetColumnCount() && nCount >= 0);
+
+    std::vector<GRID_COLUMN> arNewColumns(nCount);
+    for (GRID_COLUMN& column : arNewColumns)
+    {
+        column.arText.assign(m_nRows, 0);
+        column.arStyle.assign(m_nRows, 0);
+    }
+    m_arColumns.insert(m_arColumns.begin() + nCol,
+                       std::make_move_iterator(arNewColumns.begin()),
+                       std::make_move_iterator(arNewColumns.end()));
+}
+
+void CGridCellStore::RemoveColumns(int nCol, int nCount /*=1*/)
+{
+    ASSERT(nCol >= 0 && nCount >= 0 && nCol + nCount <= GetColumnCount());
+    m_arColumns.erase(m_arColumns.begin() + nCol, m_arColumns.begin() + nCol + nCount);
+}
+
+void CGridCellStore::RemoveAll()
+{
+    m_nRows = 0;
+    m_arColumns.clear();
+    m_arFonts.clear();
+    m_arStyles.clear();
+    m_mapStyles.clear();
+
+    // Style 0 is always the default style
+    AddStyle(GetDefaultStyle());
+}
+
+void CGridCellStore::PermuteRows(int nFirstRow, const std::vector<int>& arOrder)
+{
+    int nCount = (int)arOrder.size();
+    ASSERT(nFirstRow >= 0 && nFirstRow + nCount <= m_nRows);
+
+    std::vector<UINT> arTemp(nCount);
+    std::vector<LPARAM> arTempData;
+    for (GRID_COLUMN& column : m_arColumns)
+    {
+        for (int i = 0; i < nCount; i++)
+            arTemp[i] = column.arText[arOrder[i]];
+        std::copy(arTemp.begin(), arTemp.end(), column.arText.begin() + nFirstRow);
+
+        for (int i = 0; i < nCount; i++)
+            arTemp[i] = column.arStyle[arOrder[i]];
+        std::copy(arTemp.begin(), arTemp.end(), column.arStyle.begin() + nFirstRow);
+
+        if (!column.arData.empty())
+        {
+            arTempData.resize(nCount);
+            for (int i = 0; i < nCount; i++)
+                arTempData[i] = column.arData[arOrder[i]];
+            std::copy(arTempData.begin(), arTempData.end(), column.arData.begin() + nFirstRow);
+        }
+    }
+}
+
+LPCTSTR CGridCellStore::GetText(int nRow, int nCol) const
+{
+    ASSERT(nRow >= 0 && nRow < m_nRows && nCol >= 0 && nCol < GetColumnCount());
+    const GRID_COLUMN& column = m_arColumns[nCol];
+    return column.strings.GetAt(column.arText[nRow]);
+}
+
+void CGridCellStore::SetText(int nRow, int nCol, LPCTSTR lpszText)
+{
+    ASSERT(nRow >= 0 && nRow < m_nRows && nCol >= 0 && nCol < GetColumnCount());
+    GRID_COLUMN& column = m_arColumns[nCol];
+    column.arText[nRow] = column.strings.Add(lpszText);
+
+    // Replaced strings stay in the pool: drop them once they outnumber the rows
+    if (column.strings.GetCount() > (UINT)(2 * m_nRows + 1024))
+        CompactStrings(column);
+}
+
+LPARAM CGridCellStore::GetData(int nRow, int nCol) const
+{
+    ASSERT(nRow >= 0 && nRow < m_nRows && nCol >= 0 && nCol < GetColumnCount());
+    const GRID_COLUMN& column = m_arColumns[nCol];
+    return column.arData.empty() ? 0 : column.arData[nRow];
+}
+
+void CGridCellStore::SetData(int nRow, int nCol, LPARAM lParam)
+{
+    ASSERT(nRow >= 0 && nRow < m_nRows && nCol >= 0 && nCol < GetColumnCount());
+    GRID_COLUMN& column = m_arColumns[nCol];
+    if (column.arData.empty())
+    {
+        if (lParam == 0)
+            return;
+        column.arData.assign(m_nRows, 0);
+    }
+    column.arData[nRow] = lParam;
+}
+
+UINT CGridCellStore::GetStyleID(int nRow, int nCol) const
+{
+    ASSERT(nRow >= 0 && nRow < m_nRows && nCol >= 0 && nCol < GetColumnCount());
+    return m_arColumns[nCol].arStyle[nRow];
+}
+
+void CGridCellStore::SetStyleID(int nRow, int nCol, UINT nStyleID)
+{
+    ASSERT(nRow >= 0 && nRow < m_nRows && nCol >= 0 && nCol < GetColumnCount());
+    ASSERT(nStyleID < m_arStyles.size());
+    m_arColumns[nCol].arStyle[nRow] = nStyleID;
+}
+
+void CGridCellStore::FillStyleID(int nCol, int nFirstRow, int nLastRow, UINT nStyleID)
+{
+    ASSERT(nCol >= 0 && nCol < GetColumnCount());
+    ASSERT(nFirstRow >= 0 && nLastRow <= m_nRows && nStyleID < m_arStyles.size());
+    if (nFirstRow >= nLastRow)
+        return;
+
+    std::vector<UINT>& arStyle = m_arColumns[nCol].arStyle;
+    std::fill(arStyle.begin() + nFirstRow, arStyle.begin() + nLastRow, nStyleID);
+}
+
+// Attributes of a CGridCell after Reset()
+GRID_CELL_STYLE CGridCellStore::GetDefaultStyle()
+{
+    GRID_CELL_STYLE style;
+    style.nFormat  = (DWORD)-1;
+    style.nState   = 0;
+    style.crFgClr  = CLR_DEFAULT;
+    style.crBkClr  = CLR_DEFAULT;
+    style.crHFgClr = CLR_DEFAULT;
+    style.crHBkClr = CLR_DEFAULT;
+    style.nImage   = -1;
+    style.nMargin  = (UINT)-1;
+    style.nFont    = -1;
+
+    return style;
+}
+
+const GRID_CELL_STYLE& CGridCellStore::GetStyle(UINT nStyleID) const
+{
+    ASSERT(nStyleID < m_arStyles.size());
+    if (nStyleID >= m_arStyles.size())
+        return m_arStyles[0];
+
+    return m_arStyles[nStyleID];
+}
+
+UINT CGridCellStore::AddStyle(const GRID_CELL_STYLE& style)
+{
+    auto it = m_mapStyles.find(style);
+    if (it != m_mapStyles.end())
+        return it->second;
+
+    UINT nStyleID = (UINT)m_arStyles.size();
+    m_arStyles.push_back(style);
+    m_mapStyles.emplace(style, nStyleID);
+
+    return nStyleID;
+}
+
+// Returns the ID of the style of a cell object
+UINT CGridCellStore::AddCellStyle(const CGridCell* pCell)
+{
+    ASSERT(pCell);
+
+    GRID_CELL_STYLE style;
+    style.nFormat  = pCell->m_nFormat;
+    style.nState   = pCell->GetState();
+    style.crFgClr  = pCell->m_crFgClr;
+    style.crBkClr  = pCell->m_crBkClr;
+    style.crHFgClr = pCell->m_crHFgClr;
+    style.crHBkClr = pCell->m_crHBkClr;
+    style.nImage   = pCell->m_nImage;
+    style.nMargin  = pCell->m_nMargin;
+    style.nFont    = -1;
+
+    // Few distinct fonts are used in a grid
+    if (pCell->m_plfFont)
+    {
+        for (size_t i = 0; i < m_arFonts.size(); i++)
+        {
+            if (memcmp(&m_arFonts[i], pCell->m_plfFont, sizeof(LOGFONT)) == 0)
+            {
+                style.nFont = (int)i;
+                break;
+            }
+        }
+        if (style.nFont < 0)
+        {
+            style.nFont = (int)m_arFonts.size();
+            m_arFonts.push_back(*pCell->m_plfFont);
+        }
+    }
+
+    return AddStyle(style);
+}
+
+void CGridCellStore::LoadCell(int nRow, int nCol, CGridCell* pCell) const
+{
+    ASSERT(pCell);
+
+    const GRID_CELL_STYLE& style = GetStyle(GetStyleID(nRow, nCol));
+    pCell->m_strText  = GetText(nRow, nCol);
+    pCell->m_lParam   = GetData(nRow, nCol);
+    pCell->m_nImage   = style.nImage;
+    pCell->m_nFormat  = style.nFormat;
+    pCell->m_crFgClr  = style.crFgClr;
+    pCell->m_crBkClr  = style.crBkClr;
+    pCell->m_crHFgClr = style.crHFgClr;
+    pCell->m_crHBkClr = style.crHBkClr;
+    pCell->m_nMargin  = style.nMargin;
+    pCell->SetState(style.nState);
+    pCell->CGridCell::SetFont((style.nFont >= 0) ? &m_arFonts[style.nFont] : NULL);
+}
+
+void CGridCellStore::StoreCell(int nRow, int nCol, const CGridCell* pCell)
+{
+    ASSERT(pCell);
+
+    SetText(nRow, nCol, pCell->GetText());
+    SetData(nRow, nCol, pCell->m_lParam);
+    SetStyleID(nRow, nCol, AddCellStyle(pCell));
+}
+
+size_t CGridCellStore::GetMemoryUsage() const
+{
+    size_t nSize = m_arStyles.capacity() * sizeof(GRID_CELL_STYLE)
+                 + m_mapStyles.size() * (sizeof(GRID_CELL_STYLE) + sizeof(UINT) + 2 * sizeof(void*))
+                 + m_arFonts.capacity() * sizeof(LOGFONT);
+
+    for (const GRID_COLUMN& column : m_arColumns)
+    {
+        nSize += sizeof(GRID_COLUMN)
+               + column.strings.GetMemoryUsage()
+               + column.arText.capacity() * sizeof(UINT)
+               + column.arStyle.capacity() * sizeof(UINT)
+               + column.arData.capacity() * sizeof(LPARAM);
+    }
+
+    return nSize;
+}
+
+size_t CGridCellStore::STYLE_HASH::operator()(const GRID_CELL_STYLE& style) const
+{
+    // FNV-1a over the style fields (no padding: all fields are 32-bit)
+    const BYTE* pData = (const BYTE*)&style;
+    size_t nHash = (size_t)14695981039346656037ULL;
+    for (size_t i = 0; i < sizeof(GRID_CELL_STYLE); i++)
+    {
+        nHash ^= pData[i];
+        nHash *= (size_t)1099511628211ULL;
+    }
+
+    return nHash;
+}
+
+// Rebuild the string pool of a column with the strings still in use
+void CGridCellStore::CompactStrings(GRID_COLUMN& column)
+{
+    CGridStringPool newStrings;
+    std::vector<UINT> arNewID(column.strings.GetCount(), (UINT)-1);
+    arNewID[0] = 0;
+
+    for (UINT& nTextID : column.arText)
+    {
+        if (arNewID[nTextID] == (UINT)-1)
+            arNewID[nTextID] = newStrings.Add(column.strings.GetAt(nTextID));
+        nTextID = arNewID[nTextID];
+    }
+
+    column.strings = std::move(newStrings);
+}
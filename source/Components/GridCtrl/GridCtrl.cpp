@@ -7,6 +7,9 @@
 //#include "MemDC.h"
 #include "Components/GridCtrl/GridCtrl.h"
 #include <algorithm>
+#include <cfloat>
+#include <execution>
+#include <ATLComTime.h>
 using namespace std;
 
 // OLE stuff for clipboard operations
@@ -84,6 +87,7 @@ CGridCtrl::CGridCtrl(int nRows, int nCols, int nFixedRows, int nFixedCols)
 	m_InDestructor        = false;
 
     m_bVirtualMode        = FALSE;
+    m_bCompactMode        = FALSE;
     m_pfnCallback         = NULL;
 
     m_nVScrollMax         = 0;          // Scroll position
@@ -114,6 +118,11 @@ CGridCtrl::CGridCtrl(int nRows, int nCols, int nFixedRows, int nFixedCols)
 #else
     m_bDoubleBuffer       = TRUE;       // Use double buffering to avoid flicker?
 #endif
+    m_bScrollBlit         = TRUE;       // Move the drawn cells when scrolling
+    m_pOldBackBitmap      = NULL;
+    m_sizeBackBuffer      = CSize(0, 0);
+    m_bBackBufferValid    = FALSE;
+    ResetPaintStats();
     m_bTitleTips          = TRUE;       // show cell title tips
 
     m_bWysiwygPrinting    = FALSE;      // use size-to-width printing
@@ -129,6 +138,9 @@ CGridCtrl::CGridCtrl(int nRows, int nCols, int nFixedRows, int nFixedCols)
 	m_pfnCompare		  = NULL;
 	m_pfnVirtualCompare   = NULL;
     m_nAutoSizeColumnStyle = GVS_BOTH;  // Autosize grid using header and data info
+    m_nAutoSizeSampleRows = 0;          // Measure all rows when autosizing columns
+    m_bAutoSizePending    = FALSE;
+    m_nDeferredAutoSizeStyle = GVS_DEFAULT;
 	m_bForceVScroll        = FALSE;
 	m_bForceHScroll        = FALSE;
     m_nTimerID            = 0;          // For drag-selection
@@ -143,6 +155,7 @@ CGridCtrl::CGridCtrl(int nRows, int nCols, int nFixedRows, int nFixedCols)
 	m_AllowReorderColumn	= false;
 	m_QuitFocusOnTab = false;
 	m_AllowSelectRowInFixedCol = false;
+	m_bDefaultColOrder = TRUE;
 	m_bDragRowMode = TRUE; // allow to drop a line over another one to change row order
     m_pRtcDefault = RUNTIME_CLASS(CGridCell);
 
@@ -182,6 +195,7 @@ CGridCtrl::~CGridCtrl()
 {
 	m_InDestructor = true;
     DeleteAllItems();
+    ReleaseBackBuffer();
 
 #ifndef GRIDCONTROL_NO_TITLETIPS
     if (m_bTitleTips && ::IsWindow(m_TitleTip.GetSafeHwnd())) 
@@ -407,7 +421,7 @@ int CGridCtrl::GetLayer(int** pLayer) // used to save and restore order of colum
 	Layer[0]= LAYER_SIGNATURE;
 	Layer[1]= GetColumnCount();
 	memcpy(&Layer[2], &m_arColOrder[0], GetColumnCount()*sizeof(int));
-	memcpy(&Layer[2+GetColumnCount()], &m_arColWidths[0], GetColumnCount()*sizeof(int));
+	memcpy(&Layer[2+GetColumnCount()], m_arColWidths.GetData(), GetColumnCount()*sizeof(int));
 	*pLayer = Layer;
 	return Length;
 }
@@ -432,7 +446,8 @@ void CGridCtrl::SetLayer(int* pLayer)
 	ASSERT(m_arColWidths[2]==pLayer[4+3]);
 	ASSERT(GetColumnCount()==3);
 */	memcpy(&m_arColOrder[0],&pLayer[2], GetColumnCount()*sizeof(int));
-	memcpy(&m_arColWidths[0],&pLayer[2+GetColumnCount()], GetColumnCount()*sizeof(int));
+	m_arColWidths.SetData((const UINT*)&pLayer[2+GetColumnCount()], GetColumnCount());
+	UpdateColumnOrderState();
 }
 
 BEGIN_MESSAGE_MAP(CGridCtrl, CWnd)
@@ -492,17 +507,81 @@ void CGridCtrl::OnPaint()
 {
     CPaintDC dc(this);      // device context for painting
 
-    if (m_bDoubleBuffer)    // Use a memory DC to remove flicker
+    LARGE_INTEGER liFrequency, liStart, liEnd;
+    QueryPerformanceFrequency(&liFrequency);
+    QueryPerformanceCounter(&liStart);
+
+    CRect rect;
+    GetClientRect(&rect);
+
+    // Use the back buffer to remove flicker: only the update region is drawn,
+    // unless the buffer does not match the window (whole client area)
+    if (m_bDoubleBuffer && PrepareBackBuffer(&dc, rect.Size()))
     {
-        CRect rect;
-        GetClientRect(&rect);
-        CMemDC MemDC(dc, rect);
-        auto& mDC = MemDC.GetDC();
-        OnDraw(&mDC);
+        CRect rectPaint(dc.m_ps.rcPaint);
+        CRect rectDraw = m_bBackBufferValid ? rectPaint : rect;
+
+        int nSavedDC = m_dcBackBuffer.SaveDC();
+        m_dcBackBuffer.IntersectClipRect(rectDraw);
+        OnDraw(&m_dcBackBuffer);
+        m_dcBackBuffer.RestoreDC(nSavedDC);
+        m_bBackBufferValid = TRUE;
+
+        dc.BitBlt(rectPaint.left, rectPaint.top, rectPaint.Width(), rectPaint.Height(),
+                  &m_dcBackBuffer, rectPaint.left, rectPaint.top, SRCCOPY);
     }
     else {                   // Draw raw - this helps in debugging vis problems.
+        m_bBackBufferValid = FALSE;
         OnDraw(&dc);
     }
+
+    QueryPerformanceCounter(&liEnd);
+    double dTime = (double)(liEnd.QuadPart - liStart.QuadPart) * 1000.0 / (double)liFrequency.QuadPart;
+    m_PaintStats.nPaintCount++;
+    m_PaintStats.dTotalTime += dTime;
+    m_PaintStats.dLastTime = dTime;
+    if (dTime > m_PaintStats.dMaxTime)
+        m_PaintStats.dMaxTime = dTime;
+}
+
+// Creates the back buffer, or a bigger one if the client area has grown
+BOOL CGridCtrl::PrepareBackBuffer(CDC* pDC, const CSize& size)
+{
+    if (size.cx <= 0 || size.cy <= 0)
+        return FALSE;
+
+    if (m_dcBackBuffer.GetSafeHdc() && size.cx <= m_sizeBackBuffer.cx && size.cy <= m_sizeBackBuffer.cy)
+        return TRUE;
+
+    ReleaseBackBuffer();
+
+    if (!m_dcBackBuffer.CreateCompatibleDC(pDC) ||
+        !m_bmpBackBuffer.CreateCompatibleBitmap(pDC, size.cx, size.cy))
+    {
+        ReleaseBackBuffer();
+        return FALSE;
+    }
+
+    m_pOldBackBitmap = m_dcBackBuffer.SelectObject(&m_bmpBackBuffer);
+    m_sizeBackBuffer = size;
+    m_bBackBufferValid = FALSE;
+
+    return TRUE;
+}
+
+void CGridCtrl::ReleaseBackBuffer()
+{
+    if (m_dcBackBuffer.GetSafeHdc())
+    {
+        if (m_pOldBackBitmap)
+            m_dcBackBuffer.SelectObject(m_pOldBackBitmap);
+        m_dcBackBuffer.DeleteDC();
+    }
+    m_bmpBackBuffer.DeleteObject();
+
+    m_pOldBackBitmap = NULL;
+    m_sizeBackBuffer = CSize(0, 0);
+    m_bBackBufferValid = FALSE;
 }
 
 BOOL CGridCtrl::OnEraseBkgnd(CDC* /*pDC*/)
@@ -590,6 +669,7 @@ void CGridCtrl::OnSize(UINT nType, int cx, int cy)
 
     EndEditing();        // destroy any InPlaceEdit's
     CWnd::OnSize(nType, cx, cy);
+    m_bBackBufferValid = FALSE;
     ResetScrollBars();
 
     // End re-entry blocking
@@ -670,6 +750,9 @@ void CGridCtrl::OnSettingChange(UINT uFlags, LPCTSTR lpszSection)
 {
     CWnd::OnSettingChange(uFlags, lpszSection);
 
+    // Font settings may have changed, so measure text again
+    m_TextExtentCache.RemoveAll();
+
     if (GetDefaultCell(FALSE, FALSE)->GetTextClr() == m_crWindowText)                   // Still using system colours
         GetDefaultCell(FALSE, FALSE)->SetTextClr(::GetSysColor(COLOR_WINDOWTEXT));      // set to new system colour
     if (GetDefaultCell(FALSE, FALSE)->GetBackClr() == m_crWindowColour)
@@ -706,6 +789,12 @@ void CGridCtrl::OnSettingChange(UINT uFlags, LPCTSTR lpszSection)
 // TODO: decrease timer interval over time to speed up selection over time
 void CGridCtrl::OnTimer(UINT_PTR nIDEvent)
 {
+    if (nIDEvent == GRID_AUTOSIZE_TIMERID)
+    {
+        OnDeferredAutoSize();
+        return;
+    }
+
     ASSERT(nIDEvent == WM_LBUTTONDOWN);
     if (nIDEvent != WM_LBUTTONDOWN)
         return;
@@ -1379,7 +1468,7 @@ void CGridCtrl::OnHScroll(UINT nSBCode, UINT /*nPos*/, CScrollBar* /*pScrollBar*
 
             rect.left = GetFixedColumnWidth(bIncludeFreezedCells);
 
-            InvalidateRect(rect);
+            ScrollCells(idTopLeft, rect);
         }
         break;
 
@@ -1397,7 +1486,7 @@ void CGridCtrl::OnHScroll(UINT nSBCode, UINT /*nPos*/, CScrollBar* /*pScrollBar*
             int xScroll = GetColumnWidth(iColToUse);
             SetScrollPos32(SB_HORZ, __max(0, scrollPos - xScroll));
             rect.left = GetFixedColumnWidth(bIncludeFreezedCells);
-            InvalidateRect(rect);
+            ScrollCells(idTopLeft, rect);
         }
         break;
 
@@ -1409,7 +1498,7 @@ void CGridCtrl::OnHScroll(UINT nSBCode, UINT /*nPos*/, CScrollBar* /*pScrollBar*
             int pos = min(m_nHScrollMax, scrollPos + offset);
             SetScrollPos32(SB_HORZ, pos);
             rect.left = GetFixedColumnWidth(bIncludeFreezedCells);
-            InvalidateRect(rect);
+            ScrollCells(idTopLeft, rect);
         }
         break;
         
@@ -1421,7 +1510,7 @@ void CGridCtrl::OnHScroll(UINT nSBCode, UINT /*nPos*/, CScrollBar* /*pScrollBar*
             int pos = __max(0, scrollPos + offset);
             SetScrollPos32(SB_HORZ, pos);
             rect.left = GetFixedColumnWidth(bIncludeFreezedCells);
-            InvalidateRect(rect);
+            ScrollCells(idTopLeft, rect);
         }
         break;
         
@@ -1434,7 +1523,7 @@ void CGridCtrl::OnHScroll(UINT nSBCode, UINT /*nPos*/, CScrollBar* /*pScrollBar*
             if (idNewTopLeft != idTopLeft)
             {
                 rect.left = GetFixedColumnWidth(bIncludeFreezedCells);
-                InvalidateRect(rect);
+                ScrollCells(idTopLeft, rect);
             }
         }
         break;
@@ -1497,7 +1586,7 @@ void CGridCtrl::OnVScroll(UINT nSBCode, UINT /*nPos*/, CScrollBar* /*pScrollBar*
                 break;          // didn't work
 
             rect.top = GetFixedRowHeight(bIncludeFreezedCells);
-            InvalidateRect(rect);
+            ScrollCells(idTopLeft, rect);
         }
         break;
         
@@ -1515,7 +1604,7 @@ void CGridCtrl::OnVScroll(UINT nSBCode, UINT /*nPos*/, CScrollBar* /*pScrollBar*
             int yScroll = GetRowHeight( iRowToUse);
             SetScrollPos32(SB_VERT, __max(0, scrollPos - yScroll));
 			rect.top = GetFixedRowHeight(bIncludeFreezedCells);
-            InvalidateRect(rect);
+            ScrollCells(idTopLeft, rect);
         }
         break;
         
@@ -1526,7 +1615,7 @@ void CGridCtrl::OnVScroll(UINT nSBCode, UINT /*nPos*/, CScrollBar* /*pScrollBar*
             scrollPos = min(m_nVScrollMax, scrollPos + rect.Height());
             SetScrollPos32(SB_VERT, scrollPos);
             rect.top = GetFixedRowHeight(bIncludeFreezedCells);
-            InvalidateRect(rect);
+            ScrollCells(idTopLeft, rect);
         }
         break;
         
@@ -1538,7 +1627,7 @@ void CGridCtrl::OnVScroll(UINT nSBCode, UINT /*nPos*/, CScrollBar* /*pScrollBar*
             int pos = __max(0, scrollPos + offset);
             SetScrollPos32(SB_VERT, pos);
             rect.top = GetFixedRowHeight(bIncludeFreezedCells);
-            InvalidateRect(rect);
+            ScrollCells(idTopLeft, rect);
         }
         break;
         
@@ -1551,7 +1640,7 @@ void CGridCtrl::OnVScroll(UINT nSBCode, UINT /*nPos*/, CScrollBar* /*pScrollBar*
             if (idNewTopLeft != idTopLeft)
             {
                 rect.top = GetFixedRowHeight(bIncludeFreezedCells);
-                InvalidateRect(rect);
+                ScrollCells(idTopLeft, rect);
             }
         }
         break;
@@ -1577,6 +1666,40 @@ void CGridCtrl::OnVScroll(UINT nSBCode, UINT /*nPos*/, CScrollBar* /*pScrollBar*
     }
 }
 
+// Updates the scrolled cell area after the top-left cell has changed. Cells are drawn
+// from the top-left cell, so the cells already drawn are moved (in the window and in
+// the back buffer) and only the rows/columns which come into view are redrawn.
+void CGridCtrl::ScrollCells(const CCellID& idOldTopLeft, const CRect& rectScroll)
+{
+    CCellID idNewTopLeft = GetTopleftNonFixedCell();
+    int dx = (int)(GetColumnOffset(idOldTopLeft.col) - GetColumnOffset(idNewTopLeft.col));
+    int dy = (int)(GetRowOffset(idOldTopLeft.row) - GetRowOffset(idNewTopLeft.row));
+    if (dx == 0 && dy == 0)
+        return;
+
+    // Redraw everything when the drawing does not simply move with the cells
+    // (freezed panes, merged cells, filled area right of the last column), or
+    // when a part of the window still has to be painted
+    BOOL bRedrawAll = !m_bScrollBlit || m_nSkipRedraw > 0
+        || m_nFreezedRows > 0 || m_nFreezedCols > 0 || m_arMergedCells.GetSize() > 0 || !m_bShowHorzNonGridArea
+        || abs(dx) >= rectScroll.Width() || abs(dy) >= rectScroll.Height()
+        || (m_bDoubleBuffer && !m_bBackBufferValid) || GetUpdateRect(NULL, FALSE);
+
+    if (bRedrawAll)
+    {
+        InvalidateRect(rectScroll);
+        return;
+    }
+
+    if (m_bDoubleBuffer)
+        m_dcBackBuffer.ScrollDC(dx, dy, rectScroll, rectScroll, NULL, NULL);
+    ScrollWindowEx(dx, dy, rectScroll, rectScroll, NULL, NULL, SW_INVALIDATE);
+    m_PaintStats.nScrollCount++;
+
+    // Draw the exposed cells now, so that the next scroll can move them as well
+    UpdateWindow();
+}
+
 /////////////////////////////////////////////////////////////////////////////
 // CGridCtrl implementation functions
 
@@ -1981,6 +2104,15 @@ BOOL CGridCtrl::RedrawCell(int nRow, int nCol, CDC* pDC /* = NULL */)
 
     if (pDC)
     {
+        // Draw into the back buffer too, so that it keeps matching the window
+        CDC* pWndDC = pDC;
+        int nSavedDC = 0;
+        if (m_bDoubleBuffer && m_bBackBufferValid)
+        {
+            pDC = &m_dcBackBuffer;
+            nSavedDC = pDC->SaveDC();
+        }
+
         // Redraw cells directly
         if (nRow < m_nFixedRows || nCol < m_nFixedCols)
         {
@@ -2011,6 +2143,14 @@ BOOL CGridCtrl::RedrawCell(int nRow, int nCol, CDC* pDC /* = NULL */)
             }
             pDC->SelectObject(pOldPen);
         }
+
+        if (pDC != pWndDC)
+        {
+            pDC->RestoreDC(nSavedDC);
+            pWndDC->BitBlt(rect.left, rect.top, rect.Width() + 1, rect.Height() + 1,
+                           pDC, rect.left, rect.top, SRCCOPY);
+            pDC = pWndDC;
+        }
     } else
         InvalidateRect(rect, TRUE);     // Could not get a DC - invalidate it anyway
     // and hope that OnPaint manages to get one
@@ -2848,6 +2988,7 @@ BOOL CGridCtrl::OnDrop(COleDataObject* pDataObject, DROPEFFECT /*dropEffect*/,
 			int New = m_arColOrder[m_CurCol];
 			m_arColOrder.erase(m_arColOrder.begin()+m_CurCol);
 			m_arColOrder.insert(m_arColOrder.begin()+m_LastDragOverCell.col, New);
+			UpdateColumnOrderState();
 			m_CurCol=-1;
 			Invalidate();
 			return TRUE;
@@ -3039,30 +3180,12 @@ CCellID CGridCtrl::GetCellFromPt(CPoint point, BOOL bAllowFixedCellCheck/* =TRUE
         cellID.col = -1;
     else if (point.x < fixedColWidth) // in fixed col
     {
-        int xpos = 0;
-        int col = 0;
-
-        while (col < nFixedCols)
-        {
-            xpos += GetColumnWidth(col);
-            if (xpos > point.x)
-                break;
-			col++;
-        }
-
-        cellID.col = col;
+        cellID.col = min(GetColumnFromOffset(point.x), nFixedCols);
     }
     else    // in non-fixed col
     {
-        int xpos = fixedColWidth;
-		int col = idTopLeft.col; //m_nFixedCols;
-        while ( col < GetColumnCount())
-        {
-            xpos += GetColumnWidth(col);
-            if (xpos > point.x)
-                break;
-			col++;
-        }
+        // Columns are laid out from the top-left cell right after the fixed columns
+        int col = GetColumnFromOffset(GetColumnOffset(idTopLeft.col) + point.x - fixedColWidth);
 
         if (col >= GetColumnCount())
             cellID.col = -1;
@@ -3076,30 +3199,13 @@ CCellID CGridCtrl::GetCellFromPt(CPoint point, BOOL bAllowFixedCellCheck/* =TRUE
         cellID.row = -1;
     else if (point.y < fixedRowHeight) // in fixed col
     {
-        int ypos = 0;
-        int row = 0;
-
 		int nFixedRows = m_nFixedRows + m_nFreezedRows;
-        while (row < nFixedRows) 
-        {
-            ypos += GetRowHeight(row);
-            if (ypos > point.y)
-                break;
-			row++;
-        }
-        cellID.row = row;
+        cellID.row = min(GetRowFromOffset(point.y), nFixedRows);
     }
     else
     {
-        int ypos = fixedRowHeight;
-		int row = idTopLeft.row; //m_nFixedRows;
-        while ( row < GetRowCount() )
-        {
-            ypos += GetRowHeight(row);
-            if (ypos > point.y)
-                break;
-			row++;
-        }
+        // Rows are laid out from the top-left cell right below the fixed rows
+        int row = GetRowFromOffset(GetRowOffset(idTopLeft.row) + point.y - fixedRowHeight);
 
         if (row >= GetRowCount())
             cellID.row = -1;
@@ -3129,16 +3235,20 @@ CCellID CGridCtrl::GetTopleftNonFixedCell(BOOL bForceRecalculation /*=FALSE*/)
     int nVertScroll = GetScrollPos(SB_VERT), 
         nHorzScroll = GetScrollPos(SB_HORZ);
 
+    // The top-left cell is the first one whose left/top edge is at or past the scroll position
     m_idTopLeftCell.col = m_nFixedCols + m_nFreezedCols;
-    int nRight = 0;
-    while (nRight < nHorzScroll && m_idTopLeftCell.col < (GetColumnCount()-1))
-        nRight += GetColumnWidth(m_idTopLeftCell.col++);
+    if (nHorzScroll > 0 && m_idTopLeftCell.col < (GetColumnCount()-1))
+    {
+        long lRight = GetColumnOffset(m_idTopLeftCell.col) + nHorzScroll;
+        m_idTopLeftCell.col = min(GetColumnFromOffset(lRight - 1) + 1, GetColumnCount()-1);
+    }
 
     m_idTopLeftCell.row = m_nFixedRows + m_nFreezedRows;
-
-    int nTop = 0;
-    while (nTop < nVertScroll && m_idTopLeftCell.row < (GetRowCount()-1))
-        nTop += GetRowHeight(m_idTopLeftCell.row++);
+    if (nVertScroll > 0 && m_idTopLeftCell.row < (GetRowCount()-1))
+    {
+        long lTop = GetRowOffset(m_idTopLeftCell.row) + nVertScroll;
+        m_idTopLeftCell.row = min(GetRowFromOffset(lTop - 1) + 1, GetRowCount()-1);
+    }
 
 	SendMessageToParent(m_idTopLeftCell.row, m_idTopLeftCell.col, GVN_VIEWPOSUPDATE);
 	
@@ -3158,23 +3268,17 @@ void CGridCtrl::SetTopleftNonFixedCell(int nRow, int nCol)
 
 	// Ignore if it is not non-fixed column
 	if (nCol >= nFixedCols && nCol < m_nCols) {
-		idTopLeft.col = nFixedCols;
-
-		int nHScroll = 0;
-		while (idTopLeft.col < nCol)
-			nHScroll += GetColumnWidth(idTopLeft.col++);
+		idTopLeft.col = nCol;
 
+		int nHScroll = (int)(GetColumnOffset(nCol) - GetColumnOffset(nFixedCols));
 		SetScrollPos32(SB_HORZ, nHScroll);
 	}
 	
 	// Ignore if it is not non-fixed row
 	if (nRow >= nFixedRows && nRow < m_nRows) {
-		idTopLeft.row = nFixedRows;
-
-		int nVScroll = 0;
-		while (idTopLeft.row < nRow)
-			nVScroll += GetRowHeight(idTopLeft.row++);
+		idTopLeft.row = nRow;
 
+		int nVScroll = (int)(GetRowOffset(nRow) - GetRowOffset(nFixedRows));
 		SetScrollPos32(SB_VERT, nVScroll);
 	}
 
@@ -3197,43 +3301,36 @@ CCellRange CGridCtrl::GetVisibleNonFixedCellRange(LPRECT pRect /*=NULL*/,
 
     CCellID idTopLeft = GetTopleftNonFixedCell(bForceRecalculation);
 
-    // calc bottom
+    // calc bottom (freezed rows first, then scrollable rows from the top-left cell)
     int bottom = GetFixedRowHeight();
+	int nFixedRows = m_nFixedRows + m_nFreezedRows;
 
-	for (i = m_nFixedRows; i < GetRowCount(); i++)
+	for (i = m_nFixedRows; i < nFixedRows && i < GetRowCount(); i++)
     {
-		if(i == (m_nFixedRows+ m_nFreezedRows))
-		{
-			i = idTopLeft.row;
-		}
-
         bottom += GetRowHeight(i);
         if (bottom >= rect.bottom)
-        {
-            bottom = rect.bottom;
             break;
-        }
     }
+	if (i >= nFixedRows)
+		i = FindLastVisibleRow(idTopLeft.row, bottom, rect.bottom, bottom);
+    if (bottom >= rect.bottom)
+        bottom = rect.bottom;
     int maxVisibleRow = min(i, GetRowCount() - 1);
 
-    // calc right
+    // calc right (freezed columns first, then scrollable columns from the top-left cell)
     int right = GetFixedColumnWidth();
+	int nFixedCols = m_nFixedCols + m_nFreezedCols;
 
-	for (i = m_nFixedCols; i < GetColumnCount(); i++)
+	for (i = m_nFixedCols; i < nFixedCols && i < GetColumnCount(); i++)
     {
-
-		if(i == (m_nFixedCols + m_nFreezedCols))
-		{
-			i = idTopLeft.col;
-		}
-
         right += GetColumnWidth(i);
         if (right >= rect.right)
-        {
-            right = rect.right;
             break;
-        }
     }
+	if (i >= nFixedCols)
+		i = FindLastVisibleColumn(idTopLeft.col, right, rect.right, right);
+    if (right >= rect.right)
+        right = rect.right;
     int maxVisibleCol = min(i, GetColumnCount() - 1);
     if (pRect)
     {
@@ -3274,15 +3371,9 @@ CCellRange CGridCtrl::GetVisibleFixedCellRange(LPRECT pRect /*=NULL*/,
     // calc bottom
     int bottom = GetFixedRowHeight(m_bExcludeFreezedRowsFromSelection);
 
-    for (i = idTopLeft.row; i < GetRowCount(); i++)
-    {
-        bottom += GetRowHeight(i);
-        if (bottom >= rect.bottom)
-        {
-            bottom = rect.bottom;
-            break;
-        }
-    }
+    i = FindLastVisibleRow(idTopLeft.row, bottom, rect.bottom, bottom);
+    if (bottom >= rect.bottom)
+        bottom = rect.bottom;
     int maxVisibleRow = min(i, GetRowCount() - 1);
 
     // calc right
@@ -3322,24 +3413,14 @@ CCellRange CGridCtrl::GetUnobstructedNonFixedCellRange(BOOL bForceRecalculation
     // calc bottom
     int i;
     int bottom = GetFixedRowHeight();
-    for (i = idTopLeft.row; i < GetRowCount(); i++)
-    {
-        bottom += GetRowHeight(i);
-        if (bottom >= rect.bottom)
-            break;
-    }
+    i = FindLastVisibleRow(idTopLeft.row, bottom, rect.bottom, bottom);
     int maxVisibleRow = min(i, GetRowCount() - 1);
     if (maxVisibleRow > 0 && bottom > rect.bottom)
         maxVisibleRow--;
 
     // calc right
     int right = GetFixedColumnWidth();
-    for (i = idTopLeft.col; i < GetColumnCount(); i++)
-    {
-        right += GetColumnWidth(i);
-        if (right >= rect.right)
-            break;
-    }
+    i = FindLastVisibleColumn(idTopLeft.col, right, rect.right, right);
     int maxVisibleCol = min(i, GetColumnCount() - 1);
     if (maxVisibleCol > 0 && right > rect.right)
         maxVisibleCol--;
@@ -3597,8 +3678,6 @@ void CGridCtrl::ResetScrollBars()
 // returns the top left point of the cell. Returns FALSE if cell not visible.
 BOOL CGridCtrl::GetCellOrigin(int nRow, int nCol, LPPOINT p)
 {
-    int i;
-
     if (!IsValid(nRow, nCol))
         return FALSE;
 
@@ -3613,31 +3692,17 @@ BOOL CGridCtrl::GetCellOrigin(int nRow, int nCol, LPPOINT p)
         (nCol>= nFixedCols && nCol < idTopLeft.col))
         return FALSE;
 
-    p->x = 0;
     if (nCol < nFixedCols)                      // is a fixed column
-        for (i = 0; i < nCol; i++)
-            p->x += GetColumnWidth(i);
-        else 
-        {                                        // is a scrollable data column
-            for (i = 0; i < nFixedCols; i++)
-                p->x += GetColumnWidth(i);
-            for (i = idTopLeft.col; i < nCol; i++)
-                p->x += GetColumnWidth(i);
-        }
-        
-        p->y = 0;
-        if (nRow < nFixedRows)                      // is a fixed row
-            for (i = 0; i < nRow; i++)
-                p->y += GetRowHeight(i);
-            else 
-            {                                        // is a scrollable data row
-                for (i = 0; i < nFixedRows; i++)
-                    p->y += GetRowHeight(i);
-                for (i = idTopLeft.row; i < nRow; i++)
-                    p->y += GetRowHeight(i);
-            }
-            
-            return TRUE;
+        p->x = GetColumnOffset(nCol);
+    else                                        // is a scrollable data column
+        p->x = GetColumnOffset(nFixedCols) + GetColumnOffset(nCol) - GetColumnOffset(idTopLeft.col);
+
+    if (nRow < nFixedRows)                      // is a fixed row
+        p->y = GetRowOffset(nRow);
+    else                                        // is a scrollable data row
+        p->y = GetRowOffset(nFixedRows) + GetRowOffset(nRow) - GetRowOffset(idTopLeft.row);
+
+    return TRUE;
 }
 
 BOOL CGridCtrl::GetCellOrigin(const CCellID& cell, LPPOINT p)
@@ -3901,7 +3966,9 @@ BOOL CGridCtrl::SetRowCount(int nRows)
     // in each column within each row
     if (addedRows < 0)
     {
-        if (!GetVirtualMode())
+        if (GetCompactMode())
+            RemoveCompactRows(nRows, m_nRows - nRows);
+        else if (!GetVirtualMode())
         {
             for (int row = nRows; row < m_nRows; row++)
             {
@@ -3933,6 +4000,19 @@ BOOL CGridCtrl::SetRowCount(int nRows)
             }
 			ResetVirtualOrder();
         }
+        else if (GetCompactMode())
+        {
+            // Only the cell store grows: no cell object is created
+            if (addedRows > 0)
+            {
+                int startRow = nRows - addedRows;
+                for (int row = startRow; row < nRows; row++)
+                    m_arRowHeights[row] = m_cellDefault.GetHeight();
+
+                InsertCompactRows(startRow, addedRows);
+            }
+            m_nRows = nRows;
+        }
         else
         {
             // Change the number of rows.
@@ -3997,7 +4077,9 @@ BOOL CGridCtrl::SetColumnCount(int nCols)
 
     // If we are about to lose columns, then we need to delete the GridCell objects
     // within each column
-    if (addedCols < 0 && !GetVirtualMode())
+    if (addedCols < 0 && GetCompactMode())
+        RemoveCompactColumns(nCols, m_nCols - nCols);
+    else if (addedCols < 0 && !GetVirtualMode())
     {
         for (int row = 0; row < m_nRows; row++)
             for (int col = nCols; col < GetColumnCount(); col++)
@@ -4010,7 +4092,7 @@ BOOL CGridCtrl::SetColumnCount(int nCols)
         m_arColWidths.SetSize(nCols);
     
         // Change the number of columns in each row.
-        if (!GetVirtualMode())
+        if (!GetVirtualMode() && !GetCompactMode())
             for (int i = 0; i < m_nRows; i++)
                 if (m_RowData[i])
                     m_RowData[i]->SetSize(nCols);
@@ -4027,7 +4109,9 @@ BOOL CGridCtrl::SetColumnCount(int nCols)
                 m_arColWidths[col] = m_cellFixedColDef.GetWidth();
         
             // initialise column data
-            if (!GetVirtualMode())
+            if (GetCompactMode())
+                InsertCompactColumns(startCol, addedCols);
+            else if (!GetVirtualMode())
             {
                 for (row = 0; row < m_nRows; row++)
                     for (col = startCol; col < nCols; col++)
@@ -4053,6 +4137,7 @@ BOOL CGridCtrl::SetColumnCount(int nCols)
 	{
 		m_arColOrder[i] = i;	
 	}
+	m_bDefaultColOrder = TRUE;
 
     m_nCols = nCols;
 
@@ -4102,7 +4187,9 @@ int CGridCtrl::InsertColumn(LPCTSTR strHeading,
         {
             nColumn = m_nCols;
             m_arColWidths.Add(0);
-            if (!GetVirtualMode())
+            if (GetCompactMode())
+                InsertCompactColumns(nColumn, 1);
+            else if (!GetVirtualMode())
             {
                 for (int row = 0; row < m_nRows; row++)
                 {
@@ -4116,7 +4203,9 @@ int CGridCtrl::InsertColumn(LPCTSTR strHeading,
         else
         {
             m_arColWidths.InsertAt(nColumn, (UINT)0);
-            if (!GetVirtualMode())
+            if (GetCompactMode())
+                InsertCompactColumns(nColumn, 1);
+            else if (!GetVirtualMode())
             {
                 for (int row = 0; row < m_nRows; row++) 
                 {
@@ -4185,7 +4274,9 @@ int CGridCtrl::InsertRow(LPCTSTR strHeading, int nRow /* = -1 */)
         {
             nRow = m_nRows;
             m_arRowHeights.Add(0);
-            if (!GetVirtualMode())
+            if (GetCompactMode())
+                InsertCompactRows(nRow, 1);
+            else if (!GetVirtualMode())
                 m_RowData.Add(new GRID_ROW);
 			else
 				m_arRowOrder.push_back(m_nRows);
@@ -4194,7 +4285,9 @@ int CGridCtrl::InsertRow(LPCTSTR strHeading, int nRow /* = -1 */)
         else
         {
             m_arRowHeights.InsertAt(nRow, (UINT)0);
-            if (!GetVirtualMode())
+            if (GetCompactMode())
+                InsertCompactRows(nRow, 1);
+            else if (!GetVirtualMode())
                 m_RowData.InsertAt(nRow, new GRID_ROW);
 			else
 			{
@@ -4202,7 +4295,7 @@ int CGridCtrl::InsertRow(LPCTSTR strHeading, int nRow /* = -1 */)
 			}
         }
 
-        if (!GetVirtualMode())
+        if (!GetVirtualMode() && !GetCompactMode())
             m_RowData[nRow]->SetSize(m_nCols);
     }
     CATCH (CMemoryException, e)
@@ -4215,7 +4308,7 @@ int CGridCtrl::InsertRow(LPCTSTR strHeading, int nRow /* = -1 */)
     m_nRows++;
 
     // Initialise cell data
-    if (!GetVirtualMode())
+    if (!GetVirtualMode() && !GetCompactMode())
     {
         for (int col = 0; col < m_nCols; col++)
         {
@@ -4283,6 +4376,12 @@ BOOL CGridCtrl::SetDefaultCellType( CRuntimeClass* pRuntimeClass)
         ASSERT( FALSE);
         return FALSE;
     }
+    // Compact mode only stores plain cells (use SetCellType for other cells)
+    if (GetCompactMode() && pRuntimeClass != RUNTIME_CLASS(CGridCell))
+    {
+        ASSERT( FALSE);
+        return FALSE;
+    }
     m_pRtcDefault = pRuntimeClass;
     return TRUE;
 }
@@ -4324,7 +4423,211 @@ BOOL CGridCtrl::SetDefaultCellType( CRuntimeClass* pRuntimeClass)
     // will remove the cell from the selected list.
     SetItemState(nRow, nCol, 0);
 
-    delete GetCell(nRow, nCol);
+    // Cell objects of the compact mode are owned by the cell cache
+    if (!GetCompactMode())
+        delete GetCell(nRow, nCol);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Compact mode cell objects
+
+// Returns the cell object of a cell (nCol is the physical column), creating it
+// if necessary. Cached CGridCell objects are kept in order of use: when the cache
+// is full, the least recently used one is written back to the cell store and reused.
+CGridCellBase* CGridCtrl::GetCompactCell(int nRow, int nCol) const
+{
+    ULONGLONG nKey = GetCompactCellKey(nRow, nCol);
+    auto it = m_mapCompactCells.find(nKey);
+    if (it != m_mapCompactCells.end())
+    {
+        // Most recently used cell goes last
+        if (it->second.posCache != m_lstCompactCache.end())
+            m_lstCompactCache.splice(m_lstCompactCache.end(), m_lstCompactCache, it->second.posCache);
+        return it->second.pCell;
+    }
+
+    CGridCell* pCell = NULL;
+    for (size_t nTries = m_lstCompactCache.size(); nTries > 0 && !pCell
+         && m_lstCompactCache.size() >= GRID_COMPACT_CACHE_SIZE; nTries--)
+    {
+        auto posOld = m_lstCompactCache.begin();
+        ULONGLONG nOldKey = *posOld;
+
+        // Never reuse a cell which is being edited
+        CGridCell* pOldCell = (CGridCell*)m_mapCompactCells[nOldKey].pCell;
+        if (pOldCell->IsEditing())
+        {
+            m_lstCompactCache.splice(m_lstCompactCache.end(), m_lstCompactCache, posOld);
+            continue;
+        }
+
+        m_CellStore.StoreCell((int)(nOldKey >> 32), (int)(UINT)nOldKey, pOldCell);
+        m_mapCompactCells.erase(nOldKey);
+        m_lstCompactCache.erase(posOld);
+        pOldCell->Reset();
+        pCell = pOldCell;
+    }
+
+    if (!pCell)
+        pCell = new CGridCell;
+
+    pCell->SetGrid((CGridCtrl*)this);
+    pCell->SetCoords(nRow, nCol);
+    m_CellStore.LoadCell(nRow, nCol, pCell);
+
+    m_lstCompactCache.push_back(nKey);
+    m_mapCompactCells[nKey] = { pCell, std::prev(m_lstCompactCache.end()) };
+
+    return pCell;
+}
+
+// Writes all cached CGridCell objects back to the cell store and deletes them
+void CGridCtrl::ReleaseCompactCells()
+{
+    for (ULONGLONG nKey : m_lstCompactCache)
+    {
+        auto it = m_mapCompactCells.find(nKey);
+        m_CellStore.StoreCell((int)(nKey >> 32), (int)(UINT)nKey, (CGridCell*)it->second.pCell);
+        delete it->second.pCell;
+        m_mapCompactCells.erase(it);
+    }
+    m_lstCompactCache.clear();
+}
+
+// Deletes all cell objects without writing them back
+void CGridCtrl::DeleteCompactCells()
+{
+    for (auto& item : m_mapCompactCells)
+        delete item.second.pCell;
+
+    m_mapCompactCells.clear();
+    m_lstCompactCache.clear();
+}
+
+// Moves the kept cell objects after rows/columns were inserted or removed
+// (the cache must have been released first)
+void CGridCtrl::ShiftCompactCells(int nFirstRow, int nRowShift, int nFirstCol, int nColShift)
+{
+    ASSERT(m_lstCompactCache.empty());
+    if (m_mapCompactCells.empty())
+        return;
+
+    std::unordered_map<ULONGLONG, COMPACT_CELL> mapCells;
+    for (auto& item : m_mapCompactCells)
+    {
+        int row = (int)(item.first >> 32), col = (int)(UINT)item.first;
+        if (row >= nFirstRow)
+            row += nRowShift;
+        if (col >= nFirstCol)
+            col += nColShift;
+
+        item.second.pCell->SetCoords(row, col);
+        mapCells[GetCompactCellKey(row, col)] = item.second;
+    }
+    m_mapCompactCells.swap(mapCells);
+}
+
+// Gives new cells the attributes set by CreateCell, one style per grid region
+void CGridCtrl::FillCompactCellStyles(int nFirstRow, int nLastRow, int nFirstCol, int nLastCol)
+{
+    int nFixedEnd = min(max(nFirstRow, m_nFixedRows), nLastRow);
+    for (int col = nFirstCol; col < nLastCol; col++)
+    {
+        if (nFirstRow < nFixedEnd)
+        {
+            CGridCell* pTemplate = (CGridCell*)CreateCell(nFirstRow, col);
+            m_CellStore.FillStyleID(col, nFirstRow, nFixedEnd, m_CellStore.AddCellStyle(pTemplate));
+            delete pTemplate;
+        }
+        if (nFixedEnd < nLastRow)
+        {
+            CGridCell* pTemplate = (CGridCell*)CreateCell(nFixedEnd, col);
+            m_CellStore.FillStyleID(col, nFixedEnd, nLastRow, m_CellStore.AddCellStyle(pTemplate));
+            delete pTemplate;
+        }
+    }
+}
+
+void CGridCtrl::InsertCompactRows(int nRow, int nCount)
+{
+    ReleaseCompactCells();
+    ShiftCompactCells(nRow, nCount, 0, 0);
+
+    m_CellStore.InsertRows(nRow, nCount);
+    FillCompactCellStyles(nRow, nRow + nCount, 0, m_CellStore.GetColumnCount());
+}
+
+void CGridCtrl::RemoveCompactRows(int nRow, int nCount)
+{
+    ReleaseCompactCells();
+
+    // Delete the kept cell objects of the removed rows
+    for (auto it = m_mapCompactCells.begin(); it != m_mapCompactCells.end(); )
+    {
+        int row = (int)(it->first >> 32);
+        if (row >= nRow && row < nRow + nCount)
+        {
+            delete it->second.pCell;
+            it = m_mapCompactCells.erase(it);
+        }
+        else
+            ++it;
+    }
+    ShiftCompactCells(nRow + nCount, -nCount, 0, 0);
+
+    // Unselect the removed cells
+    POSITION pos = m_SelectedCellMap.GetStartPosition();
+    while (pos)
+    {
+        DWORD key;
+        CCellID cell;
+        m_SelectedCellMap.GetNextAssoc(pos, key, (CCellID&)cell);
+        if (cell.row >= nRow && cell.row < nRow + nCount)
+            m_SelectedCellMap.RemoveKey(key);
+    }
+
+    m_CellStore.RemoveRows(nRow, nCount);
+}
+
+void CGridCtrl::InsertCompactColumns(int nCol, int nCount)
+{
+    ReleaseCompactCells();
+    ShiftCompactCells(0, 0, nCol, nCount);
+
+    m_CellStore.InsertColumns(nCol, nCount);
+    FillCompactCellStyles(0, m_CellStore.GetRowCount(), nCol, nCol + nCount);
+}
+
+void CGridCtrl::RemoveCompactColumns(int nCol, int nCount)
+{
+    ReleaseCompactCells();
+
+    // Delete the kept cell objects of the removed columns
+    for (auto it = m_mapCompactCells.begin(); it != m_mapCompactCells.end(); )
+    {
+        int col = (int)(UINT)it->first;
+        if (col >= nCol && col < nCol + nCount)
+        {
+            delete it->second.pCell;
+            it = m_mapCompactCells.erase(it);
+        }
+        else
+            ++it;
+    }
+    ShiftCompactCells(0, 0, nCol + nCount, -nCount);
+
+    // Unselect the removed cells
+    POSITION pos = m_SelectedCellMap.GetStartPosition();
+    while (pos)
+    {
+        DWORD key;
+        CCellID cell;
+        m_SelectedCellMap.GetNextAssoc(pos, key, (CCellID&)cell);
+        if (cell.col >= nCol && cell.col < nCol + nCount)
+            m_SelectedCellMap.RemoveKey(key);
+    }
+
+    m_CellStore.RemoveColumns(nCol, nCount);
 }
 
 BOOL CGridCtrl::DeleteColumn(int nColumn)
@@ -4334,7 +4637,9 @@ BOOL CGridCtrl::DeleteColumn(int nColumn)
 
     ResetSelectedRange();
 
-    if (!GetVirtualMode())
+    if (GetCompactMode())
+        RemoveCompactColumns(nColumn, 1);
+    else if (!GetVirtualMode())
     {
         for (int row = 0; row < GetRowCount(); row++)
         {
@@ -4385,7 +4690,9 @@ BOOL CGridCtrl::DeleteRow(int nRow)
 
     ResetSelectedRange();
 
-    if (!GetVirtualMode())
+    if (GetCompactMode())
+        RemoveCompactRows(nRow, 1);
+    else if (!GetVirtualMode())
     {
         GRID_ROW* pRow = m_RowData[nRow];
         if (!pRow)
@@ -4436,6 +4743,15 @@ BOOL CGridCtrl::DeleteNonFixedRows()
 			SetModified();
 		}
 	}
+	else if (GetCompactMode())
+	{
+		// Rows are removed from the cell store at once
+		if (nCount != nFixed)
+		{
+			SetRowCount(nFixed);
+			m_idCurrentCell.row = m_idCurrentCell.col = -1;
+		}
+	}
 	else
 	{
     // Delete all data rows
@@ -4454,7 +4770,12 @@ BOOL CGridCtrl::DeleteAllItems()
     m_arRowHeights.RemoveAll();
 
     // Delete all cells in the grid
-    if (!GetVirtualMode())
+    if (GetCompactMode())
+    {
+        DeleteCompactCells();
+        m_CellStore.RemoveAll();
+    }
+    else if (!GetVirtualMode())
     {
         for (int row = 0; row < m_nRows; row++)
         {
@@ -4683,8 +5004,58 @@ int CALLBACK CGridCtrl::pfnCellNumericCompare(LPARAM lParam1, LPARAM lParam2, LP
 }
 
 
+int CALLBACK CGridCtrl::pfnCellDateCompare(LPARAM lParam1, LPARAM lParam2, LPARAM lParamSort)
+{
+	UNUSED_ALWAYS(lParamSort);
+
+	CGridCellBase* pCell1 = (CGridCellBase*) lParam1;
+	CGridCellBase* pCell2 = (CGridCellBase*) lParam2;
+	if (!pCell1 || !pCell2) return 0;
+
+	DATE dtDate1 = ParseCellDate(pCell1->GetText());
+	DATE dtDate2 = ParseCellDate(pCell2->GetText());
+
+	if (dtDate1 < dtDate2)
+		return -1;
+	else if (dtDate1 == dtDate2)
+		return 0;
+	else
+		return 1;
+}
+
+// Returns the date/time of a cell text, invalid dates come before all others
+DATE CGridCtrl::ParseCellDate(LPCTSTR lpszText)
+{
+	COleDateTime dtDate;
+	if (!lpszText || !lpszText[0] || !dtDate.ParseDateTime(lpszText) ||
+		dtDate.GetStatus() != COleDateTime::valid)
+		return -DBL_MAX;
+
+	return (DATE)dtDate;
+}
+
+// Sorts row numbers by keys of the rows (arKeys[row - nFirstRow]). Rows with equal keys
+// keep their order, so the result is the same as with a stable sort.
+template <typename KEY, typename COMPARE>
+static void SortRowOrder(std::vector<int>& arOrder, int nFirstRow, const std::vector<KEY>& arKeys,
+						 BOOL bAscending, COMPARE compareKeys)
+{
+	auto lessRow = [&](int nRow1, int nRow2)
+	{
+		int nResult = compareKeys(arKeys[nRow1 - nFirstRow], arKeys[nRow2 - nFirstRow]);
+		if (nResult == 0)
+			return (nRow1 < nRow2);
+		return bAscending ? (nResult < 0) : (nResult > 0);
+	};
+
+	if (arOrder.size() >= GRID_PARALLEL_SORT_ROWS)
+		std::sort(std::execution::par, arOrder.begin(), arOrder.end(), lessRow);
+	else
+		std::sort(arOrder.begin(), arOrder.end(), lessRow);
+}
+
 CGridCtrl *  CGridCtrl::m_This;
-// private recursive sort implementation
+// private sort implementation
 bool CGridCtrl::NotVirtualCompare(int c1, int c2)
 {
 	return ! CGridCtrl::m_This->m_pfnVirtualCompare(c1, c2);
@@ -4713,65 +5084,169 @@ BOOL CGridCtrl::SortItems(PFNLVCOMPARE pfnCompare, int nCol, BOOL bAscending, LP
                          bAscending ? m_pfnVirtualCompare : NotVirtualCompare);
 		return TRUE;
 	}
-   
-    
-    //LPARAM midItem = GetItemData((lo + hi)/2, nCol);
-	LPARAM pMidCell = (LPARAM) GetCell((lo + hi)/2, nCol);
-    
-    // loop through the list until indices cross
-    while (lo <= hi)
-    {
-        // Find the first element that is greater than or equal to the partition 
-        // element starting from the left Index.
-        if (bAscending)
-            while (lo < high  && pfnCompare( (LPARAM)GetCell(lo, nCol), (LPARAM) pMidCell, data) < 0)
-                ++lo;
-        else
-            while (lo < high && pfnCompare((LPARAM)GetCell(lo, nCol), pMidCell, data) > 0)
-				++lo;
-                
-		// Find an element that is smaller than or equal to  the partition 
-		// element starting from the right Index.
-		if (bAscending)
-			while (hi > low && pfnCompare((LPARAM)GetCell(hi, nCol), pMidCell, data) > 0)
-				--hi;
+
+	// Sort row numbers on keys taken from the sort column once, then move the rows at once
+	int nCount = high - low + 1;
+	std::vector<int> arOrder(nCount);
+	for (int i = 0; i < nCount; i++)
+		arOrder[i] = low + i;
+
+	if (GetCompactMode())
+		ReleaseCompactCells();
+
+	if (pfnCompare == pfnCellTextCompare || pfnCompare == pfnCellNumericCompare || pfnCompare == pfnCellDateCompare)
+	{
+		// Built-in comparisons only depend on the cell text
+		std::vector<LPCTSTR> arText(nCount);
+		for (int row = low; row <= high; row++)
+			arText[row - low] = GetSortKeyText(row, nCol);
+
+		if (pfnCompare == pfnCellTextCompare)
+		{
+			SortRowOrder(arOrder, low, arText, bAscending,
+						 [](LPCTSTR lpszText1, LPCTSTR lpszText2) { return _tcscmp(lpszText1, lpszText2); });
+		}
+		else if (pfnCompare == pfnCellNumericCompare)
+		{
+			std::vector<int> arValues(nCount);
+			for (int i = 0; i < nCount; i++)
+				arValues[i] = _ttol(arText[i]);
+			SortRowOrder(arOrder, low, arValues, bAscending,
+						 [](int nValue1, int nValue2) { return (nValue1 < nValue2) ? -1 : (nValue1 > nValue2); });
+		}
 		else
-			while (hi > low && pfnCompare((LPARAM)GetCell(hi, nCol), pMidCell, data) < 0)
-				--hi;
-                        
-        // If the indexes have not crossed, swap if the items are not equal
-        if (lo <= hi)
-        {
-			// swap only if the items are not equal
-            if (pfnCompare((LPARAM)GetCell(lo, nCol), (LPARAM)GetCell(hi, nCol), data) != 0)
-            {
-				for (int col = 0; col < GetColumnCount(); col++)
-                {
-					CGridCellBase *pCell = GetCell(lo, col);
-                    SetCell(lo, col, GetCell(hi, col));
-                    SetCell(hi, col, pCell);
-                }
-                UINT nRowHeight = m_arRowHeights[lo];
-                m_arRowHeights[lo] = m_arRowHeights[hi];
-                m_arRowHeights[hi] = nRowHeight;
-            }
-                            
-            ++lo;
-            --hi;
-         }
-    }
-    
-    // If the right index has not reached the left side of array
-    // must now sort the left partition.
-    if (low < hi)
-        SortItems(pfnCompare, nCol, bAscending, data, low, hi);
-    
-    // If the left index has not reached the right side of array
-    // must now sort the right partition.
-    if (lo < high)
-        SortItems(pfnCompare, nCol, bAscending, data, lo, high);
-    
-    return TRUE;
+		{
+			std::vector<DATE> arDates(nCount);
+			for (int i = 0; i < nCount; i++)
+				arDates[i] = ParseCellDate(arText[i]);
+			SortRowOrder(arOrder, low, arDates, bAscending,
+						 [](DATE dtDate1, DATE dtDate2) { return (dtDate1 < dtDate2) ? -1 : (dtDate1 > dtDate2); });
+		}
+	}
+	else
+	{
+		// Other comparisons get the cells (compact mode: temporary cells loaded from the store)
+		std::vector<CGridCellBase*> arKeyCells(nCount);
+		std::vector<CGridCell*> arTempCells;
+		for (int row = low; row <= high; row++)
+		{
+			CGridCellBase* pCell = NULL;
+			if (GetCompactMode())
+			{
+				int nKeyCol = m_arColOrder[nCol];
+				auto it = m_mapCompactCells.find(GetCompactCellKey(row, nKeyCol));
+				if (it != m_mapCompactCells.end())
+					pCell = it->second.pCell;
+				else
+				{
+					CGridCell* pTempCell = new CGridCell;
+					pTempCell->SetGrid(this);
+					pTempCell->SetCoords(row, nKeyCol);
+					m_CellStore.LoadCell(row, nKeyCol, pTempCell);
+					arTempCells.push_back(pTempCell);
+					pCell = pTempCell;
+				}
+			}
+			else
+				pCell = GetCell(row, nCol);
+
+			arKeyCells[row - low] = pCell;
+		}
+
+		// The compare function may not be thread safe: always sort sequentially
+		std::stable_sort(arOrder.begin(), arOrder.end(), [&](int nRow1, int nRow2)
+		{
+			int nResult = pfnCompare((LPARAM)arKeyCells[nRow1 - low], (LPARAM)arKeyCells[nRow2 - low], data);
+			return bAscending ? (nResult < 0) : (nResult > 0);
+		});
+
+		for (CGridCell* pCell : arTempCells)
+			delete pCell;
+	}
+
+	ApplyRowOrder(low, arOrder);
+
+	return TRUE;
+}
+
+// Returns the text of a cell used as a sort key (valid until the cells are modified)
+LPCTSTR CGridCtrl::GetSortKeyText(int nRow, int nCol) const
+{
+	if (GetCompactMode())
+	{
+		// The cell cache must have been written back
+		int nKeyCol = m_arColOrder[nCol];
+		auto it = m_mapCompactCells.find(GetCompactCellKey(nRow, nKeyCol));
+		if (it != m_mapCompactCells.end())
+			return it->second.pCell->GetText();
+
+		return m_CellStore.GetText(nRow, nKeyCol);
+	}
+
+	CGridCellBase* pCell = GetCell(nRow, nCol);
+	if (!pCell)
+		return _T("");
+
+	return pCell->GetText();
+}
+
+// Moves rows in one pass: arOrder[i] is the row to be placed at nFirstRow + i
+void CGridCtrl::ApplyRowOrder(int nFirstRow, const std::vector<int>& arOrder)
+{
+	int nCount = (int)arOrder.size();
+
+	if (GetCompactMode())
+	{
+		m_CellStore.PermuteRows(nFirstRow, arOrder);
+
+		// Cell objects which are kept follow their row
+		if (!m_mapCompactCells.empty())
+		{
+			std::vector<int> arNewRow(nCount);
+			for (int i = 0; i < nCount; i++)
+				arNewRow[arOrder[i] - nFirstRow] = nFirstRow + i;
+
+			// Only kept cells are left (the cache was released by SortItems)
+			ASSERT(m_lstCompactCache.empty());
+			std::unordered_map<ULONGLONG, COMPACT_CELL> mapCells;
+			for (auto& item : m_mapCompactCells)
+			{
+				int row = (int)(item.first >> 32), col = (int)(UINT)item.first;
+				if (row >= nFirstRow && row < nFirstRow + nCount)
+					row = arNewRow[row - nFirstRow];
+				item.second.pCell->SetCoords(row, col);
+				mapCells[GetCompactCellKey(row, col)] = item.second;
+			}
+			m_mapCompactCells.swap(mapCells);
+		}
+	}
+	else
+	{
+		// Whole rows are moved, so every column follows
+		std::vector<GRID_ROW*> arRows(nCount);
+		for (int i = 0; i < nCount; i++)
+			arRows[i] = m_RowData[arOrder[i]];
+		for (int i = 0; i < nCount; i++)
+		{
+			int row = nFirstRow + i;
+			m_RowData[row] = arRows[i];
+			if (arOrder[i] == row)
+				continue;
+
+			for (int col = 0; col < m_nCols; col++)
+			{
+				CGridCellBase* pCell = arRows[i]->GetAt(col);
+				if (pCell)
+					pCell->SetCoords(row, col);
+			}
+		}
+	}
+
+	std::vector<UINT> arHeights(nCount);
+	for (int i = 0; i < nCount; i++)
+		arHeights[i] = m_arRowHeights[arOrder[i]];
+	for (int i = 0; i < nCount; i++)
+		m_arRowHeights[nFirstRow + i] = arHeights[i];
 }
 
 /////////////////////////////////////////////////////////////////////////////
@@ -5160,22 +5635,117 @@ BOOL CGridCtrl::IsItemEditing(int nRow, int nCol)
 
 long CGridCtrl::GetVirtualWidth() const
 {
-    long lVirtualWidth = 0;
-    int iColCount = GetColumnCount();
-    for (int i = 0; i < iColCount; i++)
-        lVirtualWidth += m_arColWidths[i];
-
-    return lVirtualWidth;
+    return (long)m_arColWidths.GetTotal();
 }
 
 long CGridCtrl::GetVirtualHeight() const
 {
-    long lVirtualHeight = 0;
-    int iRowCount = GetRowCount();
-    for (int i = 0; i < iRowCount; i++)
-        lVirtualHeight += m_arRowHeights[i];
+    return (long)m_arRowHeights.GetTotal();
+}
+
+// Sum of the heights of rows [0, nRow)
+long CGridCtrl::GetRowOffset(int nRow) const
+{
+    nRow = max(0, min(nRow, (int)m_arRowHeights.GetSize()));
+    return (long)m_arRowHeights.GetSum(nRow);
+}
+
+// Sum of the widths of columns [0, nCol), in display order
+long CGridCtrl::GetColumnOffset(int nCol) const
+{
+    nCol = max(0, min(nCol, (int)m_arColWidths.GetSize()));
+    if (IsDefaultColumnOrder())
+        return (long)m_arColWidths.GetSum(nCol);
+
+    long lOffset = 0;
+    for (int i = 0; i < nCol; i++)
+        lOffset += GetColumnWidth(i);
+
+    return lOffset;
+}
+
+// Returns the row which covers the given offset from the first row
+// (hidden rows are skipped), or GetRowCount() if it is beyond the last row
+int CGridCtrl::GetRowFromOffset(long lOffset) const
+{
+    return (int)min(m_arRowHeights.FindIndex(lOffset), (INT_PTR)GetRowCount());
+}
+
+// Returns the column which covers the given offset from the first column
+// (hidden columns are skipped), or GetColumnCount() if it is beyond the last column
+int CGridCtrl::GetColumnFromOffset(long lOffset) const
+{
+    if (IsDefaultColumnOrder())
+        return (int)min(m_arColWidths.FindIndex(lOffset), (INT_PTR)GetColumnCount());
+
+    int nCol = 0;
+    long lRight = 0;
+    for ( ; nCol < GetColumnCount(); nCol++)
+    {
+        lRight += GetColumnWidth(nCol);
+        if (lRight > lOffset)
+            break;
+    }
 
-    return lVirtualHeight;
+    return nCol;
+}
+
+// Lays out rows from nFirstRow starting at nTop, and returns the first row whose
+// bottom edge reaches nBottom (GetRowCount() if none does). nRowBottom receives
+// the bottom edge of that row, or of the last row.
+int CGridCtrl::FindLastVisibleRow(int nFirstRow, int nTop, int nBottom, int& nRowBottom) const
+{
+    if (nFirstRow < 0 || nFirstRow >= GetRowCount())
+    {
+        nRowBottom = nTop;
+        return max(nFirstRow, GetRowCount());
+    }
+
+    // The first row is always laid out, even if nTop already reaches nBottom
+    long lFirst = GetRowOffset(nFirstRow);
+    int nRow = max(nFirstRow, GetRowFromOffset(lFirst + nBottom - nTop - 1));
+    nRowBottom = nTop + (int)(GetRowOffset(min(nRow + 1, GetRowCount())) - lFirst);
+
+    return nRow;
+}
+
+// Lays out columns from nFirstCol starting at nLeft, and returns the first column whose
+// right edge reaches nRight (GetColumnCount() if none does). nColRight receives
+// the right edge of that column, or of the last column.
+int CGridCtrl::FindLastVisibleColumn(int nFirstCol, int nLeft, int nRight, int& nColRight) const
+{
+    if (nFirstCol < 0 || nFirstCol >= GetColumnCount())
+    {
+        nColRight = nLeft;
+        return max(nFirstCol, GetColumnCount());
+    }
+
+    // The first column is always laid out, even if nLeft already reaches nRight
+    long lFirst = GetColumnOffset(nFirstCol);
+    int nCol = max(nFirstCol, GetColumnFromOffset(lFirst + nRight - nLeft - 1));
+    nColRight = nLeft + (int)(GetColumnOffset(min(nCol + 1, GetColumnCount())) - lFirst);
+
+    return nCol;
+}
+
+// Column widths are stored by physical column and summed up by index,
+// which matches the display order only if the columns are not reordered
+BOOL CGridCtrl::IsDefaultColumnOrder() const
+{
+    return m_bDefaultColOrder && ((int)m_arColOrder.size() == GetColumnCount());
+}
+
+void CGridCtrl::UpdateColumnOrderState()
+{
+    m_bDefaultColOrder = TRUE;
+    for (int i = 0; i < (int)m_arColOrder.size(); i++)
+    {
+        if (m_arColOrder[i] != i)
+        {
+            m_bDefaultColOrder = FALSE;
+            break;
+        }
+    }
 }
 
 int CGridCtrl::GetRowHeight(int nRow) const
@@ -5264,13 +5834,10 @@ BOOL CGridCtrl::AutoSizeColumn(int nCol, UINT nAutoSizeStyle /*=GVS_DEFAULT*/,
     if( GetColumnWidth( nCol) <=0 )
         return FALSE;
 
-    CSize size;
     CDC* pDC = GetDC();
     if (!pDC)
         return FALSE;
 
-    int nWidth = 0;
-
     ASSERT(GVS_DEFAULT <= nAutoSizeStyle && nAutoSizeStyle <= GVS_BOTH);
     if (nAutoSizeStyle == GVS_DEFAULT)
         nAutoSizeStyle = GetAutoSizeStyle();
@@ -5281,14 +5848,7 @@ BOOL CGridCtrl::AutoSizeColumn(int nCol, UINT nAutoSizeStyle /*=GVS_DEFAULT*/,
     if (GetVirtualMode())
         SendCacheHintToParent(CCellRange(nStartRow, nCol, nEndRow, nCol));
 
-    for (int nRow = nStartRow; nRow <= nEndRow; nRow++)
-    {
-        CGridCellBase* pCell = GetCell(nRow, nCol);
-        if (pCell)
-            size = pCell->GetCellExtent(pDC);
-        if (size.cx > nWidth)
-            nWidth = size.cx;
-    }
+    int nWidth = MeasureColumnWidth(pDC, nCol, nStartRow, nEndRow);
 
     if (GetVirtualMode())
         SendCacheHintToParent(CCellRange(-1,-1,-1,-1));
@@ -5302,6 +5862,74 @@ BOOL CGridCtrl::AutoSizeColumn(int nCol, UINT nAutoSizeStyle /*=GVS_DEFAULT*/,
     return TRUE;
 }
 
+// Step between the data rows measured by AutoSizeColumn (see SetAutoSizeSampleRows)
+int CGridCtrl::GetAutoSizeRowStep(int nStartRow, int nEndRow) const
+{
+    int nDataRows = nEndRow - max(nStartRow, m_nFixedRows) + 1;
+    if (m_nAutoSizeSampleRows <= 0 || nDataRows <= m_nAutoSizeSampleRows)
+        return 1;
+
+    return (nDataRows + m_nAutoSizeSampleRows - 1) / m_nAutoSizeSampleRows;
+}
+
+// Widest cell of the column in rows [nStartRow, nEndRow]. When there are more
+// data rows than the sample size, only the fixed rows, evenly spaced data rows
+// and the rows on screen are measured
+int CGridCtrl::MeasureColumnWidth(CDC* pDC, int nCol, int nStartRow, int nEndRow)
+{
+    int nWidth = 0;
+    int nStep = GetAutoSizeRowStep(nStartRow, nEndRow);
+
+    CSize size;
+    for (int nRow = nStartRow; nRow <= nEndRow; nRow += (nRow < m_nFixedRows)? 1 : nStep)
+    {
+        CGridCellBase* pCell = GetCell(nRow, nCol);
+        if (pCell)
+            size = pCell->GetCellExtent(pDC);
+        if (size.cx > nWidth)
+            nWidth = size.cx;
+    }
+
+    if (nStep > 1)
+    {
+        CCellRange VisCellRange = GetVisibleNonFixedCellRange();
+        int nFirstRow = max(VisCellRange.GetMinRow(), nStartRow);
+        int nLastRow  = min(VisCellRange.GetMaxRow(), nEndRow);
+        for (int nRow = nFirstRow; nRow <= nLastRow; nRow++)
+        {
+            CGridCellBase* pCell = GetCell(nRow, nCol);
+            if (pCell)
+                size = pCell->GetCellExtent(pDC);
+            if (size.cx > nWidth)
+                nWidth = size.cx;
+        }
+    }
+
+    return nWidth;
+}
+
+// Tallest cell of the row, hidden columns are skipped
+int CGridCtrl::MeasureRowHeight(CDC* pDC, int nRow)
+{
+    int nHeight = 1;
+    int nNumColumns = GetColumnCount();
+
+    CSize size;
+    for (int nCol = 0; nCol < nNumColumns; nCol++)
+    {
+        if (GetColumnWidth(nCol) <= 0)
+            continue;
+
+        CGridCellBase* pCell = GetCell(nRow, nCol);
+        if (pCell)
+            size = pCell->GetCellExtent(pDC);
+        if (size.cy > nHeight)
+            nHeight = size.cy;
+    }
+
+    return nHeight;
+}
+
 BOOL CGridCtrl::AutoSizeRow(int nRow, BOOL bResetScroll /*=TRUE*/)
 {
     ASSERT(nRow >= 0 && nRow < m_nRows);
@@ -5369,6 +5997,9 @@ void CGridCtrl::AutoSizeRows()
 
 // sizes all rows and columns
 // faster than calling both AutoSizeColumns() and AutoSizeRows()
+// When there are more data rows than the sample size (see SetAutoSizeSampleRows),
+// only the fixed rows, the sampled rows and the rows on screen are measured, and
+// the heights of the other rows are left as they are
 void CGridCtrl::AutoSize(UINT nAutoSizeStyle /*=GVS_DEFAULT*/)
 {
     CDC* pDC = GetDC();
@@ -5389,32 +6020,60 @@ void CGridCtrl::AutoSize(UINT nAutoSizeStyle /*=GVS_DEFAULT*/)
     if (GetVirtualMode())
         SendCacheHintToParent(CCellRange(nStartRow, 0, nEndRow, nNumColumns));
 
-    // Row initialisation - only work on rows whose height is > 0
-    for (nRow = nStartRow; nRow <= nEndRow; nRow++)
+    int nStep = GetAutoSizeRowStep(nStartRow, nEndRow);
+    if (nStep > 1)
     {
-        if( GetRowHeight( nRow) > 0 )
-            m_arRowHeights[nRow] = 1;
-    }
+        // Column widths from the sampled rows
+        for (nCol = 0; nCol < nNumColumns; nCol++)
+        {
+            if( GetColumnWidth( nCol) > 0 )
+                m_arColWidths[nCol] = MeasureColumnWidth(pDC, nCol, nStartRow, nEndRow);
+        }
 
-    CSize size;
-    for (nCol = 0; nCol < nNumColumns; nCol++)
+        // Row heights of the same rows (visible range uses the new column widths)
+        for (nRow = nStartRow; nRow <= nEndRow; nRow += (nRow < m_nFixedRows)? 1 : nStep)
+        {
+            if( GetRowHeight( nRow) > 0 )
+                m_arRowHeights[nRow] = MeasureRowHeight(pDC, nRow);
+        }
+
+        CCellRange VisCellRange = GetVisibleNonFixedCellRange();
+        int nLastRow = min(VisCellRange.GetMaxRow(), nEndRow);
+        for (nRow = max(VisCellRange.GetMinRow(), nStartRow); nRow <= nLastRow; nRow++)
+        {
+            if( GetRowHeight( nRow) > 0 )
+                m_arRowHeights[nRow] = MeasureRowHeight(pDC, nRow);
+        }
+    }
+    else
     {
-        //  Don't size hidden columns or rows
-        if( GetColumnWidth( nCol) > 0 )
+        // Row initialisation - only work on rows whose height is > 0
+        for (nRow = nStartRow; nRow <= nEndRow; nRow++)
+        {
+            if( GetRowHeight( nRow) > 0 )
+                m_arRowHeights[nRow] = 1;
+        }
+
+        CSize size;
+        for (nCol = 0; nCol < nNumColumns; nCol++)
         {
-            // Skip columns that are hidden, but now initialize
-            m_arColWidths[nCol] = 0;
-            for (nRow = nStartRow; nRow <= nEndRow; nRow++)
+            //  Don't size hidden columns or rows
+            if( GetColumnWidth( nCol) > 0 )
             {
-                if( GetRowHeight( nRow) > 0 )
+                // Skip columns that are hidden, but now initialize
+                m_arColWidths[nCol] = 0;
+                for (nRow = nStartRow; nRow <= nEndRow; nRow++)
                 {
-                    CGridCellBase* pCell = GetCell(nRow, nCol);
-                    if (pCell)
-                        size = pCell->GetCellExtent(pDC);
-                    if (size.cx >(int) m_arColWidths[nCol])
-                        m_arColWidths[nCol] = size.cx;
-                    if (size.cy >(int) m_arRowHeights[nRow])
-                        m_arRowHeights[nRow] = size.cy;
+                    if( GetRowHeight( nRow) > 0 )
+                    {
+                        CGridCellBase* pCell = GetCell(nRow, nCol);
+                        if (pCell)
+                            size = pCell->GetCellExtent(pDC);
+                        if (size.cx >(int) m_arColWidths[nCol])
+                            m_arColWidths[nCol] = size.cx;
+                        if (size.cy >(int) m_arRowHeights[nRow])
+                            m_arRowHeights[nRow] = size.cy;
+                    }
                 }
             }
         }
@@ -5429,6 +6088,31 @@ void CGridCtrl::AutoSize(UINT nAutoSizeStyle /*=GVS_DEFAULT*/)
     Refresh();
 }
 
+// Autosizes the grid once the message queue is idle (WM_TIMER is only sent when
+// no other message is waiting), so that a dialog which fills a large grid while
+// it is initialised is shown before the cells are measured. Calls made before
+// then are merged into one autosize using the last style.
+void CGridCtrl::AutoSizeDeferred(UINT nAutoSizeStyle /*=GVS_DEFAULT*/)
+{
+    m_nDeferredAutoSizeStyle = nAutoSizeStyle;
+
+    if (!m_bAutoSizePending && ::IsWindow(GetSafeHwnd()))
+        m_bAutoSizePending = (SetTimer(GRID_AUTOSIZE_TIMERID, USER_TIMER_MINIMUM, NULL) != 0);
+
+    if (!m_bAutoSizePending)
+        AutoSize(nAutoSizeStyle);
+}
+
+void CGridCtrl::OnDeferredAutoSize()
+{
+    KillTimer(GRID_AUTOSIZE_TIMERID);
+    if (!m_bAutoSizePending)
+        return;
+
+    m_bAutoSizePending = FALSE;
+    AutoSize(m_nDeferredAutoSizeStyle);
+}
+
 // Expands the columns to fit the screen space. If bExpandFixed is FALSE then fixed 
 // columns will not be affected
 void CGridCtrl::ExpandColumnsToFit(BOOL bExpandFixed /*=TRUE*/)
@@ -5626,6 +6310,20 @@ void CGridCtrl::SetVirtualMode(BOOL bVirtual)
     }
 }
 
+// Compact mode keeps the cell data column by column (see CGridCellStore) instead
+// of one cell object per cell. Cell objects are only created for the cells being
+// accessed, and the least recently used ones are reused: a pointer returned by
+// GetCell is only valid until GRID_COMPACT_CACHE_SIZE other cells have been
+// accessed since, and until its type is changed by SetCellType.
+void CGridCtrl::SetCompactMode(BOOL bCompact)
+{
+    DeleteAllItems();
+    m_bCompactMode = bCompact;
+
+    if (m_bCompactMode)
+        m_pRtcDefault = RUNTIME_CLASS(CGridCell);
+}
+
 void CGridCtrl::SetGridLines(int nWhichLines /*=GVL_BOTH*/) 
 {
     m_nGridLines = nWhichLines;
@@ -5738,25 +6436,27 @@ void CGridCtrl::EnsureVisible(int nRow, int nCol)
 	if (nCol >= nFixedCols && nCol < m_nCols) {
 
 		// If target column is on the left, scroll left
-		while (nCol < TopLeft.col) {
-			nHorzScroll -= GetColumnWidth(--TopLeft.col);
+		if (nCol < TopLeft.col) {
+			nHorzScroll -= (int)(GetColumnOffset(TopLeft.col) - GetColumnOffset(nCol));
+			TopLeft.col = nCol;
 		}
 
-		// If target column is on the right, scroll right
-		while (TopLeft.col < nCol) {
-			int width = GetFixedColumnWidth();
-			int col = TopLeft.col;
-			for (; col <= nCol; col++) {
-				width += GetColumnWidth(col);
-				if (width > rectWindow.right)
+		// If target column is on the right, scroll right until it is entirely visible
+		// (stop at a column which is wider than the window: no way we can reach it)
+		if (TopLeft.col < nCol) {
+			int nAvail = rectWindow.right - GetFixedColumnWidth();
+			long lTarget = GetColumnOffset(nCol + 1) - nAvail;
+			int nNewLeft = TopLeft.col;
+			if (lTarget > GetColumnOffset(TopLeft.col))
+				nNewLeft = min(GetColumnFromOffset(lTarget - 1) + 1, nCol);
+			for (int col = TopLeft.col; col < nNewLeft; col++) {
+				if (GetColumnWidth(col) > nAvail) {
+					nNewLeft = col;
 					break;
+				}
 			}
-			if (col <= TopLeft.col) break; // No way we can reach it
-			if (col <= nCol) {
-				nHorzScroll += GetColumnWidth(TopLeft.col);
-				TopLeft.col++;
-			}
-			else break;
+			nHorzScroll += (int)(GetColumnOffset(nNewLeft) - GetColumnOffset(TopLeft.col));
+			TopLeft.col = nNewLeft;
 		}
 	}
 
@@ -5764,25 +6464,27 @@ void CGridCtrl::EnsureVisible(int nRow, int nCol)
 	if (nRow >= nFixedRows && nRow < m_nRows) {
 
 		// If target row is on the above, scroll up
-		while (nRow < TopLeft.row) {
-			nVertScroll -= GetRowHeight(--TopLeft.row);
+		if (nRow < TopLeft.row) {
+			nVertScroll -= (int)(GetRowOffset(TopLeft.row) - GetRowOffset(nRow));
+			TopLeft.row = nRow;
 		}
 
-		// If target row is on the below, scroll down
-		while (TopLeft.row < nRow) {
-			int height = GetFixedRowHeight();
-			int row = TopLeft.row;
-			for (; row <= nRow; row++) {
-				height += GetRowHeight(row);
-				if (height > rectWindow.bottom)
+		// If target row is on the below, scroll down until it is entirely visible
+		// (stop at a row which is higher than the window: no way we can reach it)
+		if (TopLeft.row < nRow) {
+			int nAvail = rectWindow.bottom - GetFixedRowHeight();
+			long lTarget = GetRowOffset(nRow + 1) - nAvail;
+			int nNewTop = TopLeft.row;
+			if (lTarget > GetRowOffset(TopLeft.row))
+				nNewTop = min(GetRowFromOffset(lTarget - 1) + 1, nRow);
+			for (int row = TopLeft.row; row < nNewTop; row++) {
+				if (GetRowHeight(row) > nAvail) {
+					nNewTop = row;
 					break;
+				}
 			}
-			if (row <= TopLeft.row) break; // No way we can reach it
-			if (row <= nRow) {
-				nVertScroll += GetRowHeight(TopLeft.row);
-				TopLeft.row++;
-			}
-			else break;
+			nVertScroll += (int)(GetRowOffset(nNewTop) - GetRowOffset(TopLeft.row));
+			TopLeft.row = nNewTop;
 		}
 	}
 	if (nHorzScroll != 0) {
@@ -7875,10 +8577,10 @@ void CGridCtrl::OnEndEditCell(int nRow, int nCol, CString str)
 		{
             for (int col=m_nFixedCols; col<m_nCols; col++)
             {
-                GRID_ROW* pRow = m_RowData[row];
-                if (pRow)
+                GRID_ROW* pRow = GetCompactMode() ? NULL : m_RowData[row];
+                if (pRow || GetCompactMode())
 				{
-					CGridCellBase* pRowCell = pRow->GetAt(col);
+					CGridCellBase* pRowCell = pRow ? pRow->GetAt(col) : GetCompactCell(row, col);
 					CString strText = pRowCell->GetText();
 
 					if(nCol == col)
@@ -8058,6 +8760,9 @@ CGridCellBase* CGridCtrl::GetCell(int nRow, int nCol) const
 		return (CGridCellBase*)&cell;
 	}
 
+	if (GetCompactMode())
+		return GetCompactCell(nRow, m_arColOrder[nCol]);
+
 	GRID_ROW* pRow = m_RowData[nRow];
 	if (!pRow) return NULL;
 	return pRow->GetAt(m_arColOrder[nCol]);
@@ -8071,6 +8776,27 @@ BOOL CGridCtrl::SetCell(int nRow, int nCol, CGridCellBase* pCell)
 	if (nRow < 0 || nRow >= m_nRows || nCol < 0 || nCol >= m_nCols)
 		return FALSE;
 
+	if (GetCompactMode())
+	{
+		// The previous cell object now belongs to the caller
+		ULONGLONG nKey = GetCompactCellKey(nRow, nCol);
+		auto it = m_mapCompactCells.find(nKey);
+		if (it != m_mapCompactCells.end())
+		{
+			if (it->second.posCache != m_lstCompactCache.end())
+				m_lstCompactCache.erase(it->second.posCache);
+			m_mapCompactCells.erase(it);
+		}
+
+		pCell->SetCoords(nRow, nCol);
+		COMPACT_CELL compactCell = { pCell, m_lstCompactCache.end() };
+		if (pCell->GetRuntimeClass() == RUNTIME_CLASS(CGridCell))
+			compactCell.posCache = m_lstCompactCache.insert(m_lstCompactCache.end(), nKey);
+		m_mapCompactCells[nKey] = compactCell;
+
+		return TRUE;
+	}
+
 	GRID_ROW* pRow = m_RowData[nRow];
 	if (!pRow) return FALSE;
 
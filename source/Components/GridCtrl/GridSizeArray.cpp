@@ -0,0 +1,205 @@
+﻿/**
+ * @file		GridSizeArray.cpp
+ * @brief		Row heights / column widths array with a prefix sum index
+ * @author		AnthonyLeeStark
+ * @date		2026.10.17
+ *
+ * @copyright 	Copyright (c) 2015-2025 AnthonyLeeStark
+ */
+
+#include "Components/GridCtrl/GridSizeArray.h"
+
+#ifdef _DEBUG
+#define new DEBUG_NEW
+#undef THIS_FILE
+static char THIS_FILE[] = __FILE__;
+#endif
+
+/////////////////////////////////////////////////////////////////////////////
+// CGridSizeArray
+
+CGridSizeArray::CGridSizeArray()
+{
+    m_bTreeValid = TRUE;
+}
+
+UINT CGridSizeArray::GetAt(INT_PTR nIndex) const
+{
+    ASSERT(nIndex >= 0 && nIndex < GetSize());
+    return m_arSizes[nIndex];
+}
+
+void CGridSizeArray::SetAt(INT_PTR nIndex, UINT nSize)
+{
+    ASSERT(nIndex >= 0 && nIndex < GetSize());
+
+    LONGLONG lDelta = (LONGLONG)nSize - (LONGLONG)m_arSizes[nIndex];
+    m_arSizes[nIndex] = nSize;
+    if (lDelta != 0)
+        Update(nIndex, lDelta);
+}
+
+// Replace all sizes at once (used when restoring a saved layout)
+void CGridSizeArray::SetData(const UINT* pSizes, INT_PTR nCount)
+{
+    ASSERT(nCount >= 0 && (pSizes != NULL || nCount == 0));
+
+    m_arSizes.assign(pSizes, pSizes + nCount);
+    m_bTreeValid = FALSE;
+}
+
+void CGridSizeArray::SetSize(INT_PTR nNewSize)
+{
+    ASSERT(nNewSize >= 0);
+
+    INT_PTR nOldSize = GetSize();
+    if (nNewSize == nOldSize)
+        return;
+
+    m_arSizes.resize(nNewSize, 0);
+
+    // Tree nodes only cover preceding elements, so shrinking keeps them valid
+    if (nNewSize < nOldSize && m_bTreeValid)
+        m_arTree.resize(nNewSize);
+    else
+        m_bTreeValid = FALSE;
+}
+
+INT_PTR CGridSizeArray::Add(UINT nSize)
+{
+    m_arSizes.push_back(nSize);
+
+    // A Fenwick tree can be extended by one element in O(log n):
+    // the new node covers (n - lowbit(n), n], which are all known already
+    if (m_bTreeValid)
+    {
+        INT_PTR n = GetSize();
+        LONGLONG lNode = nSize;
+        INT_PTR nLowBit = n & (-n);
+        for (INT_PTR i = 1; i < nLowBit; i <<= 1)
+            lNode += m_arTree[n - i - 1];
+        m_arTree.push_back(lNode);
+    }
+
+    return GetSize() - 1;
+}
+
+void CGridSizeArray::InsertAt(INT_PTR nIndex, UINT nSize, INT_PTR nCount /*=1*/)
+{
+    ASSERT(nIndex >= 0 && nCount >= 0);
+
+    if (nIndex >= GetSize())
+    {
+        while (GetSize() < nIndex)
+            Add(0);
+        while (nCount-- > 0)
+            Add(nSize);
+        return;
+    }
+
+    m_arSizes.insert(m_arSizes.begin() + nIndex, nCount, nSize);
+    m_bTreeValid = FALSE;
+}
+
+void CGridSizeArray::RemoveAt(INT_PTR nIndex, INT_PTR nCount /*=1*/)
+{
+    ASSERT(nIndex >= 0 && nCount >= 0 && nIndex + nCount <= GetSize());
+
+    m_arSizes.erase(m_arSizes.begin() + nIndex, m_arSizes.begin() + nIndex + nCount);
+    m_bTreeValid = FALSE;
+}
+
+void CGridSizeArray::RemoveAll()
+{
+    m_arSizes.clear();
+    m_arTree.clear();
+    m_bTreeValid = TRUE;
+}
+
+// Sum of the first nCount sizes
+LONGLONG CGridSizeArray::GetSum(INT_PTR nCount) const
+{
+    ASSERT(nCount >= 0 && nCount <= GetSize());
+    if (nCount <= 0)
+        return 0;
+    if (nCount > GetSize())
+        nCount = GetSize();
+
+    Rebuild();
+
+    LONGLONG lSum = 0;
+    for (INT_PTR i = nCount; i > 0; i -= (i & (-i)))
+        lSum += m_arTree[i - 1];
+
+    return lSum;
+}
+
+// Sum of sizes [nFirst, nLast)
+LONGLONG CGridSizeArray::GetSum(INT_PTR nFirst, INT_PTR nLast) const
+{
+    if (nLast <= nFirst)
+        return 0;
+
+    return GetSum(nLast) - GetSum(nFirst);
+}
+
+// Returns the index of the element which covers the given offset from the
+// start, that is the largest index whose preceding sizes sum up to no more
+// than the offset (zero sized elements are skipped). Returns GetSize() if
+// the offset is beyond the total size.
+INT_PTR CGridSizeArray::FindIndex(LONGLONG lOffset) const
+{
+    if (lOffset < 0)
+        return 0;
+
+    Rebuild();
+
+    INT_PTR n = GetSize();
+    INT_PTR nStep = 1;
+    while ((nStep << 1) <= n)
+        nStep <<= 1;
+
+    // Binary lifting: find the largest count whose prefix sum <= offset
+    INT_PTR nPos = 0;
+    LONGLONG lRemain = lOffset;
+    for ( ; nStep > 0; nStep >>= 1)
+    {
+        INT_PTR nNext = nPos + nStep;
+        if (nNext <= n && m_arTree[nNext - 1] <= lRemain)
+        {
+            nPos = nNext;
+            lRemain -= m_arTree[nNext - 1];
+        }
+    }
+
+    return nPos;
+}
+
+// Rebuild the tree in O(n) after the array was shifted
+void CGridSizeArray::Rebuild() const
+{
+    if (m_bTreeValid)
+        return;
+
+    INT_PTR n = GetSize();
+    m_arTree.assign(m_arSizes.begin(), m_arSizes.end());
+    for (INT_PTR i = 1; i <= n; i++)
+    {
+        INT_PTR nParent = i + (i & (-i));
+        if (nParent <= n)
+            m_arTree[nParent - 1] += m_arTree[i - 1];
+    }
+
+    m_bTreeValid = TRUE;
+}
+
+void CGridSizeArray::Update(INT_PTR nIndex, LONGLONG lDelta)
+{
+    // Tree is rebuilt from the sizes on the next query anyway
+    if (!m_bTreeValid)
+        return;
+
+    INT_PTR n = GetSize();
+    for (INT_PTR i = nIndex + 1; i <= n; i += (i & (-i)))
+        m_arTree[i - 1] += lDelta;
+}
@@ -0,0 +1,119 @@
+﻿/**
+ * @file		GridTextCache.cpp
+ * @brief		Text extent cache for the grid control
+ * @author		AnthonyLeeStark
+ * @date		2026.10.17
+ *
+ * @copyright 	Copyright (c) 2015-2025 AnthonyLeeStark
+ */
+
+#include "Components/GridCtrl/GridTextCache.h"
+
+#ifdef _DEBUG
+#define new DEBUG_NEW
+#undef THIS_FILE
+static char THIS_FILE[] = __FILE__;
+#endif
+
+/////////////////////////////////////////////////////////////////////////////
+// CGridTextExtentCache
+
+CGridTextExtentCache::CGridTextExtentCache(size_t nCapacity /*=GRID_TEXTEXTENT_CACHE_SIZE*/)
+{
+    m_nCapacity = (nCapacity > 0)? nCapacity : 1;
+    m_nLastFont = -1;
+    m_nHits = m_nMisses = 0;
+}
+
+CSize CGridTextExtentCache::GetTextExtent(CDC* pDC, const LOGFONT* pLF, LPCTSTR lpszText,
+                                          int nLength /*=-1*/)
+{
+    ASSERT(pDC != NULL && lpszText != NULL);
+
+    if (nLength < 0)
+        nLength = (int)_tcslen(lpszText);
+
+    // Printer extents differ from the screen ones, and long texts are rarely repeated
+    if (pLF == NULL || pDC->IsPrinting() || nLength > MAX_TEXT_LENGTH)
+        return pDC->GetTextExtent(lpszText, nLength);
+
+    EXTENT_KEY key;
+    key.nFont = GetFontID(pLF);
+    key.strText = std::basic_string_view<TCHAR>(lpszText, nLength);
+
+    auto it = m_mapEntries.find(key);
+    if (it != m_mapEntries.end())
+    {
+        // Move to the front of the list
+        if (it->second != m_lstEntries.begin())
+            m_lstEntries.splice(m_lstEntries.begin(), m_lstEntries, it->second);
+        m_nHits++;
+        return it->second->size;
+    }
+
+    m_nMisses++;
+    CSize size = pDC->GetTextExtent(lpszText, nLength);
+
+    if (m_lstEntries.size() >= m_nCapacity)
+        RemoveOldest();
+
+    m_lstEntries.push_front(EXTENT_ENTRY{ key.nFont, std::basic_string<TCHAR>(lpszText, nLength), size });
+    key.strText = m_lstEntries.front().strText;
+    m_mapEntries.emplace(key, m_lstEntries.begin());
+
+    return size;
+}
+
+void CGridTextExtentCache::SetCapacity(size_t nCapacity)
+{
+    m_nCapacity = (nCapacity > 0)? nCapacity : 1;
+    while (m_lstEntries.size() > m_nCapacity)
+        RemoveOldest();
+}
+
+void CGridTextExtentCache::RemoveAll()
+{
+    m_mapEntries.clear();
+    m_lstEntries.clear();
+    m_arFonts.clear();
+    m_nLastFont = -1;
+}
+
+// Index of the font in the font table (cells of a grid use a handful of fonts)
+int CGridTextExtentCache::GetFontID(const LOGFONT* pLF)
+{
+    if (m_nLastFont >= 0 && !memcmp(&m_arFonts[m_nLastFont], pLF, sizeof(LOGFONT)))
+        return m_nLastFont;
+
+    for (int i = 0; i < (int)m_arFonts.size(); i++)
+    {
+        if (!memcmp(&m_arFonts[i], pLF, sizeof(LOGFONT)))
+            return (m_nLastFont = i);
+    }
+
+    // Font IDs are never reused, so start over when there are too many
+    if (m_arFonts.size() >= MAX_FONT_COUNT)
+        RemoveAll();
+
+    m_arFonts.push_back(*pLF);
+    return (m_nLastFont = (int)m_arFonts.size() - 1);
+}
+
+void CGridTextExtentCache::RemoveOldest()
+{
+    if (m_lstEntries.empty())
+        return;
+
+    const EXTENT_ENTRY& entry = m_lstEntries.back();
+    EXTENT_KEY key;
+    key.nFont = entry.nFont;
+    key.strText = entry.strText;
+    m_mapEntries.erase(key);
+    m_lstEntries.pop_back();
+}
+
+size_t CGridTextExtentCache::EXTENT_KEY_HASH::operator()(const EXTENT_KEY& key) const
+{
+    size_t nHash = std::hash<std::basic_string_view<TCHAR>>()(key.strText);
+    return nHash ^ ((size_t)key.nFont * (size_t)0x9E3779B97F4A7C15ULL);
+}
@@ -26,6 +26,9 @@ constexpr const int fixedColumnNum = 0;
 constexpr const int fixedRowNum = 1;
 constexpr const int startRowIndex = 1;
 
+// Filter refresh interval while the index is being built (in milliseconds)
+constexpr const unsigned filterRefreshInterval = 200;
+
 
 // Implement methods for CLogViewerDlg
 IMPLEMENT_DYNAMIC(CLogViewerDlg, SDialog)
@@ -42,6 +45,13 @@ CLogViewerDlg::CLogViewerDlg(CWnd* pParent /*=nullptr*/)
 	m_ptrAppEventLog = NULL;
 	m_nLogCount = 0;
 
+	// Saved log history
+	m_bUseLogStore = false;
+
+	// Filter
+	m_strFilter = Constant::String::Empty;
+	m_bFiltered = false;
+
 	// Table format and properties
 	m_nColNum = 0;
 	m_apGrdColFormat = NULL;
@@ -91,6 +101,7 @@ BEGIN_RESOURCEID_MAP(CLogViewerDlg)
 	ON_ID_CONTROL(IDC_LOGVIEWER_REMOVEALL_BTN,   "RemoveAllButton")
 	ON_ID_CONTROL(IDC_LOGVIEWER_DETAILS_BTN,	 "DetailButton")
 	ON_ID_CONTROL(IDC_LOGVIEWER_CLOSE_BTN,		 "CloseButton")
+	ON_ID_CONTROL(IDC_LOGVIEWER_FILTER_EDIT,	 "FilterEdit")
 END_RESOURCEID_MAP()
 
 
@@ -98,10 +109,13 @@ END_RESOURCEID_MAP()
 BEGIN_MESSAGE_MAP(CLogViewerDlg, SDialog)
 	ON_WM_CLOSE()
 	ON_WM_DESTROY()
+	ON_WM_TIMER()
 	ON_BN_CLICKED(IDC_LOGVIEWER_REMOVEALL_BTN,	&CLogViewerDlg::OnRemoveAllBtn)
 	ON_BN_CLICKED(IDC_LOGVIEWER_DETAILS_BTN,	&CLogViewerDlg::OnDetailBtn)
 	ON_BN_CLICKED(IDC_LOGVIEWER_CLOSE_BTN,		&CLogViewerDlg::OnCloseBtn)
 	ON_NOTIFY(LVN_ITEMCHANGED, IDC_LOGVIEWER_LOGDATA_LISTBOX, &CLogViewerDlg::OnSelectLogItem)
+	ON_NOTIFY(GVN_GETDISPINFO, IDC_LOGVIEWER_LOGDATA_LISTBOX, &CLogViewerDlg::OnGetLogItemDispInfo)
+	ON_EN_CHANGE(IDC_LOGVIEWER_FILTER_EDIT,		&CLogViewerDlg::OnFilterChange)
 END_MESSAGE_MAP()
 
 
@@ -164,6 +178,9 @@ void CLogViewerDlg::OnClose()
  */
 void CLogViewerDlg::OnDestroy()
 {
+	// Stop filter refresh timer
+	KillTimer(TIMERID_LOGVIEWER_FILTER);
+
 	// Save app event log if enabled
 	OutputEventLog(LOG_EVENT_DLG_DESTROYED, this->GetCaption());
 
@@ -236,6 +253,38 @@ void CLogViewerDlg::OnCloseBtn()
 	PostMessage(WM_CLOSE);
 }
 
+/**
+ * @brief	Handle text change event for filter edit box
+ * @param	None
+ * @return	None
+ */
+void CLogViewerDlg::OnFilterChange()
+{
+	// Get filter string
+	CString strFilter;
+	GetDlgItemText(IDC_LOGVIEWER_FILTER_EDIT, strFilter);
+	m_strFilter = strFilter.GetString();
+
+	// Update displayed rows
+	ApplyFilter();
+}
+
+/**
+ * @brief	OnTimer function
+ * @param	nIDEvent - Time event ID
+ * @return	None
+ */
+void CLogViewerDlg::OnTimer(UINT_PTR nIDEvent)
+{
+	// Refresh filter result while the index is being built
+	if (nIDEvent == TIMERID_LOGVIEWER_FILTER) {
+		ApplyFilter();
+	}
+
+	// Default
+	SDialog::OnTimer(nIDEvent);
+}
+
 /**
  * @brief	Setup language for dialog items
  * @param	None
@@ -262,6 +311,10 @@ void CLogViewerDlg::SetupLanguage(void)
 		case IDC_LOGVIEWER_DETAILS_BTN:
 			ShowItem(nID, false);
 			break;
+		case IDC_LOGVIEWER_FILTER_EDIT:
+			// Display hint text instead of edit text
+			((CEdit*)pWndChild)->SetCueBanner(GetLanguageString(pAppLang, nID));
+			break;
 		default:
 			SetControlText(pWndChild, nID, pAppLang);
 			break;
@@ -307,6 +360,9 @@ void CLogViewerDlg::SetupLogViewerList(LANGTABLE_PTR /*ptrLanguage*/)
 	// Destroy frame
 	pListFrameWnd->DestroyWindow();
 
+	// Virtual mode: cells are not stored, visible cells are requested via GVN_GETDISPINFO
+	m_pLogViewerList->SetVirtualMode(TRUE);
+
 	// Cell format
 	CGridDefaultCell* pCell = (CGridDefaultCell*)m_pLogViewerList->GetDefaultCell(FALSE, FALSE);
 	if (pCell == NULL) return;
@@ -359,17 +415,6 @@ void CLogViewerDlg::DrawLogViewerTable(void)
 	// Check table format data validity
 	if (m_pszTableFrameSize == NULL) return;
 
-	// Get app pointer
-	CPowerPlusApp* pApp = (CPowerPlusApp*)AfxGetApp();
-	if (pApp == NULL) return;
-
-	// Get app language package
-	LANGTABLE_PTR ptrLanguage = pApp->GetAppLanguage();
-
-	// Re-update default cell properties
-	CGridDefaultCell* pCell = (CGridDefaultCell*)m_pLogViewerList->GetDefaultCell(FALSE, FALSE);
-	if (pCell == NULL) return;
-
 	// Table properties
 	int nColNum = m_nColNum;
 	int nRowNum = (m_nLogCount + fixedRowNum);
@@ -395,18 +440,9 @@ void CLogViewerDlg::DrawLogViewerTable(void)
 		nFrameWidth -= (nScrollBarWidth + Constant::UI::Offset::Width::VScrollBar);
 	}
 
-	// Setup columns
+	// Setup column widths
+	// Header titles and cell styles are provided on demand (see OnGetLogItemDispInfo)
 	for (int nCol = 0; nCol < nColNum; nCol++) {
-		// Set header row style
-		SetFixedCellStyle(m_pLogViewerList, Constant::UI::GridCtrl::Index::Header_Row, nCol);
-
-		// Column header title
-		String headerTitle = Constant::String::Empty;
-		unsigned nHeaderTitleID = m_apGrdColFormat[nCol].nHeaderTitleID;
-		if (nHeaderTitleID != INT_NULL) {
-			headerTitle = GetLanguageString(ptrLanguage, nHeaderTitleID);
-		}
-		m_pLogViewerList->SetItemText(Constant::UI::GridCtrl::Index::Header_Row, nCol, headerTitle);
 
 		// Column width
 		int nColWidth = m_apGrdColFormat[nCol].nWidth;
@@ -423,62 +459,6 @@ void CLogViewerDlg::DrawLogViewerTable(void)
 			m_pLogViewerList->SetColumnWidth(nCol, nFrameWidth);
 		}
 	}
-
-	// Setup rows
-	int nColStyle = -1;
-	unsigned nItemState = INT_NULL;
-	for (int nRow = 1; nRow < nRowNum; nRow++) {
-		for (int nCol = 0; nCol < m_nColNum; nCol++) {
-
-			// Get column style & item state
-			nColStyle = m_apGrdColFormat[nCol].nColStyle;
-			nItemState = m_pLogViewerList->GetItemState(nRow, nCol);
-			nItemState |= GVIS_READONLY;
-
-			// Base column - header-like style
-			if (nColStyle == COLSTYLE_FIXED) {
-				// Set fixed cell style
-				SetFixedCellStyle(m_pLogViewerList, nRow, nCol);
-			}
-
-			// Checkbox column
-			else if (nColStyle == COLSTYLE_CHECKBOX) {
-				// Set cell type: Checkbox
-				if (!m_pLogViewerList->SetCellType(nRow, nCol, RUNTIME_CLASS(CGridCellCheck)))
-					continue;
-
-				// Get cell
-				CGridCellCheck* pCell = (CGridCellCheck*)m_pLogViewerList->GetCell(nRow, nCol);
-
-				// Set center alignment if defined
-				if (m_apGrdColFormat[nCol].bCenter == TRUE) {
-					if (pCell == NULL) continue;
-					pCell->SetCheckPlacement(SCP_CENTERING);
-				}
-			}
-
-			// Normal column
-			else if (nColStyle == COLSTYLE_NORMAL) {
-				// Set item state
-				if (!m_pLogViewerList->SetItemState(nRow, nCol, nItemState))
-					continue;
-
-				// Get cell
-				CGridCellBase* pCell = (CGridCellBase*)m_pLogViewerList->GetCell(nRow, nCol);
-
-				// Set center alignment if defined
-				if (m_apGrdColFormat[nCol].bCenter == TRUE) {
-					if (pCell == NULL) continue;
-					pCell->SetFormat(pCell->GetFormat() | DT_CENTER);
-				}
-				else {
-					// Set margin (left alignment)
-					if (pCell == NULL) continue;
-					pCell->SetMargin(Constant::UI::GridCtrl::Margin::Left);
-				}
-			}
-		}
-	}
 }
 
 /**
@@ -494,12 +474,73 @@ BOOL CLogViewerDlg::LoadAppEventLogData(void)
 	m_ptrAppEventLog = pApp->GetAppEventLog();
 	if (m_ptrAppEventLog == NULL) return FALSE;
 
+	// If app event log is being saved, display the saved history (including current session)
+	// Otherwise, only in-memory items of current session are available
+	if (!m_logStoreReader.IsOpen() && m_ptrAppEventLog->IsWriterRunning()) {
+		m_bUseLogStore = (LoadLogStoreData() == TRUE);
+	}
+
 	// Get log data item count
-	m_nLogCount = m_ptrAppEventLog->GetLogCount();
+	m_nLogCount = (m_bUseLogStore) ? m_logStoreReader.GetItemCount() : m_ptrAppEventLog->GetLogCount();
 
 	return TRUE;
 }
 
+/**
+ * @brief	Load saved app event log history from log store files
+ * @param	None
+ * @return	TRUE/FALSE
+ */
+BOOL CLogViewerDlg::LoadLogStoreData(void)
+{
+	// Make sure all items of current session are written
+	if (m_ptrAppEventLog == NULL) return FALSE;
+	m_ptrAppEventLog->Write();
+
+	// Search for monthly app event log files
+	String folderPath = StringUtils::GetSubFolderPath(Constant::Folder::Log);
+	String searchPattern = StringUtils::MakeFilePath(folderPath, _T("AppEventLog_*"), Constant::File::Extension::Log);
+	std::vector<String> arrLogFilePaths;
+	CFileFind Finder;
+	BOOL bFound = Finder.FindFile(searchPattern);
+	while (bFound) {
+		bFound = Finder.FindNextFile();
+		arrLogFilePaths.push_back(String(Finder.GetFilePath().GetString()));
+	}
+	Finder.Close();
+
+	// File names contain year and month, sorting by name gives chronological order
+	std::sort(arrLogFilePaths.begin(), arrLogFilePaths.end(),
+		[](const String& left, const String& right) { return (_tcsicmp(left, right) < 0); });
+
+	// Open store files, convert YAML log files which have not been converted yet
+	PerformanceCounter counter;
+	counter.Start();
+	for (const String& logFilePath : arrLogFilePaths) {
+		String storeFilePath = LogStoreUtils::GetStoreFilePath(logFilePath);
+		if (Finder.FindFile(storeFilePath) != TRUE) {
+			LogStoreUtils::ConvertYAMLFile(logFilePath, storeFilePath, LOGTYPE_APP_EVENT);
+		}
+		m_logStoreReader.Open(storeFilePath);
+	}
+	counter.Stop();
+
+	// Index saved items in background (for filtering)
+	// Items are read from the store by the indexing thread, filtering uses the part indexed so far
+	m_logStoreIndex.Clear();
+	m_logStoreIndex.SetSource([this, logItem = LOGITEM()](size_t nIndex, LogIndex::Entry& indexEntry) mutable {
+		if (!m_logStoreReader.ReadLogItem(nIndex, logItem)) return false;
+		LogIndex::MakeEntry(logItem, indexEntry);
+		return true;
+	}, m_logStoreReader.GetItemCount());
+	m_logStoreIndex.Start();
+
+	OutputDebugLogFormat(_T("Load log store: Files=%d, Items=%d, Time=%.4f (ms)"), static_cast<int>(arrLogFilePaths.size()),
+		static_cast<int>(m_logStoreReader.GetItemCount()), counter.GetElapsedTime(true));
+
+	return (m_logStoreReader.GetItemCount() > 0) ? TRUE : FALSE;
+}
+
 /**
  * @brief	Update logviewer list
  * @param	None
@@ -521,33 +562,174 @@ void CLogViewerDlg::UpdateLogViewer(void)
 		return;
 	}
 
+	// Update displayed rows
+	ApplyFilter();
+}
+
+/**
+ * @brief	Update displayed rows by current filter string
+ * @param	None
+ * @return	None
+ */
+void CLogViewerDlg::ApplyFilter(void)
+{
+	// Check list table validity
+	if (m_pLogViewerList == NULL) return;
+	KillTimer(TIMERID_LOGVIEWER_FILTER);
+
+	// Get log data index
+	const LogIndex* pLogIndex = NULL;
+	if (m_bUseLogStore) {
+		pLogIndex = &m_logStoreIndex;
+	}
+	else if (m_ptrAppEventLog != NULL) {
+		pLogIndex = m_ptrAppEventLog->GetLogIndex();
+	}
+
+	// Query matched items (without index, all items are displayed)
+	m_arrFilteredItems.clear();
+	m_bFiltered = ((!m_strFilter.IsEmpty()) && (pLogIndex != NULL));
+	if (m_bFiltered) {
+		PerformanceCounter counter;
+		counter.Start();
+		LANGTABLE_PTR pAppLang = ((CPowerPlusApp*)AfxGetApp())->GetAppLanguage();
+		pLogIndex->Query(m_strFilter, pAppLang, m_arrFilteredItems);
+
+		// Skip items which are added after the list was loaded
+		auto iterEnd = std::lower_bound(m_arrFilteredItems.begin(), m_arrFilteredItems.end(), static_cast<UINT>(m_nLogCount));
+		m_arrFilteredItems.erase(iterEnd, m_arrFilteredItems.end());
+		counter.Stop();
+		OutputDebugLogFormat(_T("LogViewer filter: Items=%d, Matched=%d, Time=%.4f (ms)"), static_cast<int>(m_nLogCount),
+			static_cast<int>(m_arrFilteredItems.size()), counter.GetElapsedTime(true));
+
+		// Items are still being indexed, refresh the result later
+		if (!pLogIndex->IsUpToDate()) {
+			SetTimer(TIMERID_LOGVIEWER_FILTER, filterRefreshInterval, NULL);
+		}
+	}
+
+	// Update row count, visible rows will be requested on demand
+	size_t nRowCount = (m_bFiltered) ? m_arrFilteredItems.size() : m_nLogCount;
+	m_nCurSelIndex = INT_INVALID;
+	m_pLogViewerList->SetRowCount(static_cast<int>(nRowCount) + fixedRowNum);
+	m_pLogViewerList->Invalidate();
+}
+
+/**
+ * @brief	Get log item index of a LogViewer list row
+ * @param	nRow - Row index
+ * @return	int - Item index (INT_INVALID if row is not a data row)
+ */
+int CLogViewerDlg::GetItemIndex(int nRow) const
+{
+	// Check row index validity
+	int nRowIndex = nRow - startRowIndex;
+	if (nRowIndex < 0) return INT_INVALID;
+
+	// Filtered rows
+	if (m_bFiltered) {
+		if (static_cast<size_t>(nRowIndex) >= m_arrFilteredItems.size()) return INT_INVALID;
+		return static_cast<int>(m_arrFilteredItems[nRowIndex]);
+	}
+
+	// All rows
+	if (static_cast<size_t>(nRowIndex) >= m_nLogCount) return INT_INVALID;
+	return nRowIndex;
+}
+
+/**
+ * @brief	Provide display info of a LogViewer list cell (virtual mode)
+ * @param	pNMHDR  - Default of notify/event handler
+ * @param	pResult - Default of notify/event handler
+ * @return	None
+ */
+void CLogViewerDlg::OnGetLogItemDispInfo(NMHDR* pNMHDR, LRESULT* pResult)
+{
+	GV_DISPINFO* pDispInfo = (GV_DISPINFO*)pNMHDR;
+	if (pResult != NULL) *pResult = 0;
+	if ((pDispInfo == NULL) || (m_apGrdColFormat == NULL)) return;
+
+	// Check cell validity
+	int nRow = pDispInfo->item.row;
+	int nCol = pDispInfo->item.col;
+	if ((nCol < 0) || (nCol >= m_nColNum)) return;
+
 	// Load app language package
 	CPowerPlusApp* pApp = (CPowerPlusApp*)AfxGetApp();
 	if (pApp == NULL) return;
 	LANGTABLE_PTR ptrLanguage = pApp->GetAppLanguage();
 
-	// Print items
-	int nItemIndex = 0;
-	for (int nRowIndex = startRowIndex; nRowIndex <= m_nLogCount; nRowIndex++) {
-		
-		// Get log item
-		nItemIndex = nRowIndex - startRowIndex;
-		Item logItem = m_ptrAppEventLog->GetLogItem(nItemIndex);
+	// Column format
+	const GRIDCTRLCOLFORMAT& colFormat = m_apGrdColFormat[nCol];
+
+	// Header row: column header title
+	if (nRow < fixedRowNum) {
+		pDispInfo->item.nFormat |= DT_CENTER;
+		pDispInfo->item.nMargin = 0;
+		pDispInfo->item.crBkClr = Color::Gray;
+		pDispInfo->item.crFgClr = Color::Black;
+		if (colFormat.nHeaderTitleID != INT_NULL) {
+			pDispInfo->item.strText = GetLanguageString(ptrLanguage, colFormat.nHeaderTitleID);
+		}
+		return;
+	}
+
+	// Cell style (by column)
+	pDispInfo->item.nState |= GVIS_READONLY;
+	if (colFormat.nColStyle == COLSTYLE_FIXED) {
+		// Base column - header-like style
+		pDispInfo->item.nFormat |= DT_CENTER;
+		pDispInfo->item.nMargin = 0;
+		pDispInfo->item.crBkClr = Color::Gray;
+		pDispInfo->item.crFgClr = Color::Black;
+	}
+	else if (colFormat.bCenter == TRUE) {
+		// Center alignment
+		pDispInfo->item.nFormat |= DT_CENTER;
+	}
+	else {
+		// Left alignment (with margin)
+		pDispInfo->item.nMargin = Constant::UI::GridCtrl::Margin::Left;
+	}
 
-		// If log item is empty
-		if (logItem.IsEmpty()) continue;
+	// Check item index validity
+	int nItemNumber = GetItemIndex(nRow);
+	if (nItemNumber == INT_INVALID) return;
+	size_t nItemIndex = static_cast<size_t>(nItemNumber);
 
-		// Date/time
-		String tempString = logItem.FormatDateTime();
-		m_pLogViewerList->SetItemText(nRowIndex, ColumnID::DateTime, tempString);
+	// Item data from saved history (read in place)
+	if (m_bUseLogStore) {
+		switch (nCol)
+		{
+		case ColumnID::DateTime:
+			pDispInfo->item.strText = LogItem::FormatDateTime(m_logStoreReader.GetTime(nItemIndex)).GetString();
+			break;
+		case ColumnID::CategoryID:
+			pDispInfo->item.strText = GetLanguageString(ptrLanguage, m_logStoreReader.GetCategory(nItemIndex));
+			break;
+		case ColumnID::Description:
+			pDispInfo->item.strText = m_logStoreReader.GetDescription(nItemIndex);
+			break;
+		}
+		return;
+	}
 
-		// Category
-		tempString = GetLanguageString(ptrLanguage, logItem.GetCategory());
-		m_pLogViewerList->SetItemText(nRowIndex, ColumnID::CategoryID, tempString);
+	// Item data from current session (by reference, not copied)
+	if (m_ptrAppEventLog == NULL) return;
+	Item logItem = std::as_const(*m_ptrAppEventLog).GetLogItem(static_cast<int>(nItemIndex));
+	if (logItem.IsEmpty()) return;
 
-		// Additional description
-		tempString = logItem.GetLogString();
-		m_pLogViewerList->SetItemText(nRowIndex, ColumnID::Description, tempString);
+	switch (nCol)
+	{
+	case ColumnID::DateTime:
+		pDispInfo->item.strText = logItem.FormatDateTime().GetString();
+		break;
+	case ColumnID::CategoryID:
+		pDispInfo->item.strText = GetLanguageString(ptrLanguage, logItem.GetCategory());
+		break;
+	case ColumnID::Description:
+		pDispInfo->item.strText = logItem.GetLogString().GetString();
+		break;
 	}
 }
 
@@ -568,8 +750,8 @@ void CLogViewerDlg::OnSelectLogItem(NMHDR* pNMHDR, LRESULT* /*pResult*/)
 	if (pItem == NULL) return;
 	int nRow = pItem->iRow;
 
-	//Get current selection index
-	m_nCurSelIndex = nRow - fixedRowNum;
+	//Get current selection index (log item index of selected row)
+	m_nCurSelIndex = GetItemIndex(nRow);
 
 	// Get app event logging pointer
 	if (m_ptrAppEventLog == NULL) return;
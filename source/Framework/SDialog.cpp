@@ -11,6 +11,8 @@
 #include "Framework/SWinApp.h"
 #include "Framework/SDialog.h"
 
+#include <afxpriv.h>
+
 #ifdef _DEBUG
 #define new DEBUG_NEW
 #endif
@@ -536,6 +538,39 @@ int SDialog::PreDestroyDialog()
  */
 LRESULT SDialog::WindowProc(UINT message, WPARAM wParam, LPARAM lParam)
 {
+	// Modal loop is idle after processing pending messages:
+	// dispatch flag change notifications once per message loop iteration
+	if ((message == WM_KICKIDLE) && (lParam == 0)) {
+		m_flagManager.DispatchNotifications();
+		((SWinApp*)AfxGetApp())->DispatchFlagNotifications();
+
+		// Update data of controls changed by their notifications
+		if (m_pCtrlManager != NULL) m_pCtrlManager->UpdateDirtyData();
+	}
+
+	// Control notifications: control state may have been changed,
+	// mark its data to be updated when idle
+	if ((m_pCtrlManager != NULL) && (!m_pCtrlManager->IsEmpty())) {
+		unsigned nCtrlID = NULL;
+		switch (message)
+		{
+		case WM_COMMAND:
+			if (lParam != NULL) nCtrlID = LOWORD(wParam);
+			break;
+		case WM_NOTIFY:
+			if ((lParam != NULL) && (((LPNMHDR)lParam)->code != NM_CUSTOMDRAW))
+				nCtrlID = static_cast<unsigned>(((LPNMHDR)lParam)->idFrom);
+			break;
+		case WM_HSCROLL:
+		case WM_VSCROLL:
+			if (lParam != NULL) nCtrlID = ::GetDlgCtrlID((HWND)lParam);
+			break;
+		}
+		if (nCtrlID != NULL) {
+			m_pCtrlManager->SetDirty(nCtrlID);
+		}
+	}
+
 	// Default
 	return CDialogEx::WindowProc(message, wParam, lParam);
 }
@@ -1174,7 +1209,7 @@ int SDialog::DisplayMessageBox(const wchar_t* prompt, const wchar_t* caption /*
  * @brief	Output application event log
  * @param	usEvent		- Event ID
  * @param	description - Additional description
- * @param	pDetailInfo	- Log detail info (array pointer)
+ * @param	pDetailInfo	- Log detail info (array pointer, data is moved into the log item)
  * @return	None
  */
 void SDialog::OutputEventLog(USHORT usEvent, const wchar_t* description /* = NULL */, LOGDETAILINFO* pDetailInfo /* = NULL */)
@@ -1189,10 +1224,8 @@ void SDialog::OutputEventLog(USHORT usEvent, const wchar_t* description /* = NUL
 		logItemDialogEvent.SetLogString(description);
 	}
 	if (pDetailInfo != NULL) {
-		// Include event detail info data
-		for (int nIndex = 0; nIndex < pDetailInfo->size(); nIndex++) {
-			logItemDialogEvent.AddDetail(pDetailInfo->at(nIndex));
-		}
+		// Include event detail info data (moved into the log item)
+		logItemDialogEvent.SetDetailInfo(std::move(*pDetailInfo));
 	}
 
 	// Output dialog event log
@@ -1200,7 +1233,7 @@ void SDialog::OutputEventLog(USHORT usEvent, const wchar_t* description /* = NUL
 	ASSERT(pApp);
 	if (pApp == NULL) return;
 	if (SLogging* ptrAppEventLog = pApp->GetAppEventLog()) {
-		ptrAppEventLog->OutputItem(logItemDialogEvent);
+		ptrAppEventLog->OutputItem(std::move(logItemDialogEvent));
 	}
 }
 
@@ -1331,6 +1364,7 @@ void SDialog::OutputComboBoxLog(USHORT usEvent, unsigned nComboID)
 		// Combo-box control info
 		SControlManager* pCtrlMan = GetControlManager();
 		if (pCtrlMan != NULL) {
+			pCtrlMan->UpdateData(nComboID);
 			SCtrlInfoWrap* pComboWrap = pCtrlMan->GetControl(nComboID);
 			if (pComboWrap != NULL) {
 				// Combo-box caption
@@ -1376,6 +1410,7 @@ void SDialog::OutputEditBoxLog(USHORT usEvent, unsigned nEditID)
 		// Edit box control info
 		SControlManager* pCtrlMan = GetControlManager();
 		if (pCtrlMan != NULL) {
+			pCtrlMan->UpdateData(nEditID);
 			SCtrlInfoWrap* pEditBoxWrap = pCtrlMan->GetControl(nEditID);
 			if (pEditBoxWrap != NULL) {
 				// Edit box caption
@@ -1418,6 +1453,7 @@ void SDialog::OutputListBoxLog(USHORT usEvent, unsigned nListBoxID)
 		// List box control info
 		SControlManager* pCtrlMan = GetControlManager();
 		if (pCtrlMan != NULL) {
+			pCtrlMan->UpdateData(nListBoxID);
 			SCtrlInfoWrap* pListBoxWrap = pCtrlMan->GetControl(nListBoxID);
 			if (pListBoxWrap != NULL) {
 				// List box caption
@@ -1590,6 +1626,7 @@ void SDialog::UpdateItemText(unsigned nCtrlID, const wchar_t* newCaption)
 
 	// Update item text
 	pCtrlWnd->SetWindowText(newCaption);
+	if (m_pCtrlManager != NULL) m_pCtrlManager->SetDirty(nCtrlID);
 }
 
 /**
@@ -1651,6 +1688,7 @@ void SDialog::SetControlText(CWnd* pCtrlWnd, unsigned nCtrlID, LANGTABLE_PTR ptr
 	
 	// Set control text
 	pCtrlWnd->SetWindowText(wndItemText);
+	if (m_pCtrlManager != NULL) m_pCtrlManager->SetDirty(nCtrlID);
 }
 
 /**
@@ -1776,6 +1814,7 @@ void SDialog::ShowItem(CWnd* pDlgItemWnd, bool bVisible)
 
 	// Show/hide control
 	pDlgItemWnd->ShowWindow(bVisible);
+	if (m_pCtrlManager != NULL) m_pCtrlManager->SetDirty(pDlgItemWnd->GetDlgCtrlID());
 }
 
 /**
@@ -1796,6 +1835,7 @@ void SDialog::EnableItem(CWnd* pDlgItemWnd, bool bEnabled)
 
 	// Enable/disable control
 	pDlgItemWnd->EnableWindow(bEnabled);
+	if (m_pCtrlManager != NULL) m_pCtrlManager->SetDirty(pDlgItemWnd->GetDlgCtrlID());
 }
 
 /**
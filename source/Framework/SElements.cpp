@@ -45,41 +45,17 @@ SCtrlInfoWrap::SCtrlInfoWrap() : CObject()
 	m_bEnabled = false;
 	m_bFocused = false;
 
-	// --- Control data values --- //
-
-	// Boolean data
-	m_pbCheck = NULL;
-
-	// Integer data
-	m_plValue = NULL;
-	m_plReserveValue = NULL;
-	m_plMinValue = NULL;
-	m_plMaxValue = NULL;
-
-	// Float data
-	m_pdbValue = NULL;
-	m_pdbReserveValue = NULL;
-	m_pdbMinValue = NULL;
-	m_pdbMaxValue = NULL;
-
-	// String data
-	m_pstrValue = NULL;
-	m_pstrReserveValue = NULL;
-
-	// Integer array data
-	m_paulValueList = NULL;
-	m_paulReserveValueList = NULL;
-
-	// String array data
-	m_pastrValueList = NULL;
-	m_pastrReserveValueList = NULL;
-
-	// Time data
-	m_pstTimeValue = NULL;
+	// Control data values
+	m_eValueKey = DataKey::None;
+	m_bDirty = true;
+}
 
-	// Custom data
-	m_ptrCustomData = NULL;
-	m_pszDataSize = NULL;
+/**
+ * @brief	Move constructor
+ */
+SCtrlInfoWrap::SCtrlInfoWrap(SCtrlInfoWrap&& other) noexcept : CObject()
+{
+	*this = std::move(other);
 }
 
 /**
@@ -87,115 +63,41 @@ SCtrlInfoWrap::SCtrlInfoWrap() : CObject()
  */
 SCtrlInfoWrap::~SCtrlInfoWrap()
 {
-	// Clean-up and destroy control data pointers
-	//
-
-	// Boolean data
-	if (m_pbCheck != NULL) {
-		delete m_pbCheck;
-		m_pbCheck = NULL;
-	}
-
-	// Integer data
-	if (m_plValue != NULL) {
-		delete m_plValue;
-		m_plValue = NULL;
-	}
-	if (m_plReserveValue != NULL) {
-		delete m_plReserveValue;
-		m_plReserveValue = NULL;
-	}
-	if (m_plMinValue != NULL) {
-		delete m_plMinValue;
-		m_plMinValue = NULL;
-	}
-	if (m_plMaxValue != NULL) {
-		delete m_plMaxValue;
-		m_plMaxValue = NULL;
-	}
-
-	// Float data
-	if (m_pdbValue != NULL) {
-		delete m_pdbValue;
-		m_pdbValue = NULL;
-	}
-	if (m_pdbReserveValue != NULL) {
-		delete m_pdbReserveValue;
-		m_pdbReserveValue = NULL;
-	}
-	if (m_pdbMinValue != NULL) {
-		delete m_pdbMinValue;
-		m_pdbMinValue = NULL;
-	}
-	if (m_pdbMaxValue != NULL) {
-		delete m_pdbMaxValue;
-		m_pdbMaxValue = NULL;
-	}
-
-	// String data
-	if (m_pstrValue != NULL) {
-		delete m_pstrValue;
-		m_pstrValue = NULL;
-	}
-	if (m_pstrReserveValue != NULL) {
-		delete m_pstrReserveValue;
-		m_pstrReserveValue = NULL;
-	}
+	// Control data values are stored inline, nothing to clean-up
+}
 
-	// Integer array data
-	if (m_paulValueList != NULL) {
-		// Cleanup array data
-		if (!m_paulValueList->empty()) {
-			m_paulValueList->clear();
-		}
-		delete m_paulValueList;
-		m_paulValueList = NULL;
-	}
-	if (m_paulReserveValueList != NULL) {
-		// Cleanup reserved array data
-		if (!m_paulReserveValueList->empty()) {
-			m_paulReserveValueList->clear();
-		}
-		delete m_paulReserveValueList;
-		m_paulReserveValueList = NULL;
-	}
+/**
+ * @brief	Move assignment operator
+ */
+SCtrlInfoWrap& SCtrlInfoWrap::operator=(SCtrlInfoWrap&& other) noexcept
+{
+	if (this == &other)
+		return *this;
 
-	// String array data
-	if (m_pastrValueList != NULL) {
-		// Cleanup array data
-		if (!m_pastrValueList->empty()) {
-			m_pastrValueList->clear();
-		}
-		delete m_pastrValueList;
-		m_pastrValueList = NULL;
-	}
-	if (m_pastrReserveValueList != NULL) {
-		// Cleanup reserved array data
-		if (!m_pastrReserveValueList->empty()) {
-			m_pastrReserveValueList->clear();
-		}
-		delete m_pastrReserveValueList;
-		m_pastrReserveValueList = NULL;
-	}
+	// Window pointers
+	m_pBaseControl = other.m_pBaseControl;
+	m_pParentWnd = other.m_pParentWnd;
+	m_pBuddyWnd = other.m_pBuddyWnd;
 
-	// Time data
-	if (m_pstTimeValue != NULL) {
-		delete m_pstTimeValue;
-		m_pstTimeValue = NULL;
-	}
+	// Control ID info
+	m_nTypeID = other.m_nTypeID;
+	m_nTemplateID = other.m_nTemplateID;
+	m_strTemplateID = std::move(other.m_strTemplateID);
 
-	// Custom data
-	if (m_ptrCustomData != NULL) {
-		// Note: Because this pointer is allocated using 'malloc', 
-		// we need to use 'free' for de-allocation to free its memory block; 
-		// we also cannot use 'delete' to free it, because it's a void pointer 
-		free(m_ptrCustomData);
-		m_ptrCustomData = NULL;
-	}
-	if (m_pszDataSize != NULL) {
-		delete m_pszDataSize;
-		m_pszDataSize = NULL;
-	}
+	// Control attributes
+	m_strCaption = std::move(other.m_strCaption);
+	m_bVisible = other.m_bVisible;
+	m_bEnabled = other.m_bEnabled;
+	m_bFocused = other.m_bFocused;
+
+	// Control data values
+	m_eValueKey = other.m_eValueKey;
+	m_value = std::move(other.m_value);
+	m_arrExtraValues = std::move(other.m_arrExtraValues);
+	m_arrCustomData = std::move(other.m_arrCustomData);
+	m_bDirty = other.m_bDirty;
+
+	return *this;
 }
 
 /**
@@ -315,6 +217,63 @@ void SCtrlInfoWrap::UpdateAttributes(void)
 	}
 }
 
+/**
+ * @brief	Find the data value slot of specified key
+ * @param	eKey - Data value key
+ * @return	const DataValue* (NULL if the value has not been set)
+ */
+const SCtrlInfoWrap::DataValue* SCtrlInfoWrap::FindValue(DataKey eKey) const
+{
+	// Inline value
+	if (m_eValueKey == eKey)
+		return &m_value;
+
+	// Extra values
+	for (const auto& extraValue : m_arrExtraValues) {
+		if (extraValue.first == eKey)
+			return &extraValue.second;
+	}
+
+	return NULL;
+}
+
+/**
+ * @brief	Get the data value slot of specified key (add a new slot if not found)
+ * @param	eKey - Data value key
+ * @return	DataValue&
+ */
+SCtrlInfoWrap::DataValue& SCtrlInfoWrap::AcquireValue(DataKey eKey)
+{
+	// Use the inline value if it is free or already holds this key
+	if ((m_eValueKey == eKey) || (m_eValueKey == DataKey::None)) {
+		m_eValueKey = eKey;
+		return m_value;
+	}
+
+	// Extra values
+	for (auto& extraValue : m_arrExtraValues) {
+		if (extraValue.first == eKey)
+			return extraValue.second;
+	}
+
+	return m_arrExtraValues.emplace_back(eKey, DataValue()).second;
+}
+
+/**
+ * @brief	Get the data value of specified key and type
+ * @param	eKey - Data value key
+ * @return	const VALUE_TYPE* (NULL if the value has not been set)
+ */
+template<typename VALUE_TYPE>
+const VALUE_TYPE* SCtrlInfoWrap::GetValuePtr(DataKey eKey) const
+{
+	const DataValue* pValue = FindValue(eKey);
+	if (pValue == NULL)
+		return NULL;
+
+	return std::get_if<VALUE_TYPE>(pValue);
+}
+
 /**
  * @brief	Get current control's checked state
  * @param	None
@@ -322,10 +281,8 @@ void SCtrlInfoWrap::UpdateAttributes(void)
  */
 bool SCtrlInfoWrap::GetCheck(void) const
 {
-	if (this->m_pbCheck == NULL)
-		return false;
-	else
-		return *(this->m_pbCheck);
+	const bool* pbCheck = GetValuePtr<bool>(DataKey::Check);
+	return (pbCheck != NULL) ? *pbCheck : false;
 }
 
 /**
@@ -335,18 +292,13 @@ bool SCtrlInfoWrap::GetCheck(void) const
  */
 LONG_PTR SCtrlInfoWrap::GetInteger(void) const
 {
-	if (this->m_plValue == NULL)
-		return INT_INVALID;
-	else
-		return *(this->m_plValue);
+	const LONG_PTR* plValue = GetValuePtr<LONG_PTR>(DataKey::Integer);
+	return (plValue != NULL) ? *plValue : INT_INVALID;
 }
 
 void SCtrlInfoWrap::GetInteger(_Out_ LONG_PTR& lValue) const
 {
-	if (this->m_plValue == NULL)
-		lValue = INT_INVALID;
-	else
-		lValue = *(this->m_plValue);
+	lValue = GetInteger();
 }
 
 /**
@@ -356,18 +308,13 @@ void SCtrlInfoWrap::GetInteger(_Out_ LONG_PTR& lValue) const
  */
 LONG_PTR SCtrlInfoWrap::GetReserveInteger(void) const
 {
-	if (this->m_plReserveValue == NULL)
-		return INT_INVALID;
-	else
-		return *(this->m_plReserveValue);
+	const LONG_PTR* plValue = GetValuePtr<LONG_PTR>(DataKey::ReserveInteger);
+	return (plValue != NULL) ? *plValue : INT_INVALID;
 }
 
 void SCtrlInfoWrap::GetReserveInteger(_Out_ LONG_PTR& lValue) const
 {
-	if (this->m_plReserveValue == NULL)
-		lValue = INT_INVALID;
-	else
-		lValue = *(this->m_plReserveValue);
+	lValue = GetReserveInteger();
 }
 
 /**
@@ -379,16 +326,12 @@ void SCtrlInfoWrap::GetReserveInteger(_Out_ LONG_PTR& lValue) const
 void SCtrlInfoWrap::GetMinMaxInt(_Out_ LONG_PTR& lMin, _Out_ LONG_PTR& lMax) const
 {
 	// Min value
-	if (this->m_plMinValue == NULL)
-		lMin = INT_INVALID;
-	else
-		lMin = *(this->m_plMinValue);
+	const LONG_PTR* plMinValue = GetValuePtr<LONG_PTR>(DataKey::MinInteger);
+	lMin = (plMinValue != NULL) ? *plMinValue : INT_INVALID;
 
 	// Max value
-	if (this->m_plMaxValue == NULL)
-		lMax = INT_INVALID;
-	else
-		lMax = *(this->m_plMaxValue);
+	const LONG_PTR* plMaxValue = GetValuePtr<LONG_PTR>(DataKey::MaxInteger);
+	lMax = (plMaxValue != NULL) ? *plMaxValue : INT_INVALID;
 }
 
 /**
@@ -398,18 +341,13 @@ void SCtrlInfoWrap::GetMinMaxInt(_Out_ LONG_PTR& lMin, _Out_ LONG_PTR& lMax) con
  */
 DOUBLE SCtrlInfoWrap::GetFloat(void) const
 {
-	if (this->m_pdbValue == NULL)
-		return FLOAT_INVALID;
-	else
-		return *(this->m_pdbValue);
+	const DOUBLE* pdbValue = GetValuePtr<DOUBLE>(DataKey::Float);
+	return (pdbValue != NULL) ? *pdbValue : FLOAT_INVALID;
 }
 
 void SCtrlInfoWrap::GetFloat(_Out_ DOUBLE& dbValue) const
 {
-	if (this->m_pdbValue == NULL)
-		dbValue = FLOAT_INVALID;
-	else
-		dbValue = *(this->m_pdbValue);
+	dbValue = GetFloat();
 }
 
 /**
@@ -419,18 +357,13 @@ void SCtrlInfoWrap::GetFloat(_Out_ DOUBLE& dbValue) const
  */
 DOUBLE SCtrlInfoWrap::GetReserveFloat(void) const
 {
-	if (this->m_pdbReserveValue == NULL)
-		return FLOAT_INVALID;
-	else
-		return *(this->m_pdbReserveValue);
+	const DOUBLE* pdbValue = GetValuePtr<DOUBLE>(DataKey::ReserveFloat);
+	return (pdbValue != NULL) ? *pdbValue : FLOAT_INVALID;
 }
 
 void SCtrlInfoWrap::GetReserveFloat(_Out_ DOUBLE& dbValue) const
 {
-	if (this->m_pdbReserveValue == NULL)
-		dbValue = FLOAT_INVALID;
-	else
-		dbValue = *(this->m_pdbReserveValue);
+	dbValue = GetReserveFloat();
 }
 
 /**
@@ -442,16 +375,12 @@ void SCtrlInfoWrap::GetReserveFloat(_Out_ DOUBLE& dbValue) const
 void SCtrlInfoWrap::GetMinMaxFloat(_Out_ DOUBLE& dbMin, _Out_ DOUBLE& dbMax) const
 {
 	// Min value
-	if (this->m_pdbMinValue == NULL)
-		dbMin = FLOAT_INVALID;
-	else
-		dbMin = *(this->m_pdbMinValue);
+	const DOUBLE* pdbMinValue = GetValuePtr<DOUBLE>(DataKey::MinFloat);
+	dbMin = (pdbMinValue != NULL) ? *pdbMinValue : FLOAT_INVALID;
 
 	// Max value
-	if (this->m_pdbMaxValue == NULL)
-		dbMax = FLOAT_INVALID;
-	else
-		dbMax = *(this->m_pdbMaxValue);
+	const DOUBLE* pdbMaxValue = GetValuePtr<DOUBLE>(DataKey::MaxFloat);
+	dbMax = (pdbMaxValue != NULL) ? *pdbMaxValue : FLOAT_INVALID;
 }
 
 /**
@@ -461,18 +390,13 @@ void SCtrlInfoWrap::GetMinMaxFloat(_Out_ DOUBLE& dbMin, _Out_ DOUBLE& dbMax) con
  */
 const wchar_t* SCtrlInfoWrap::GetString(void) const
 {
-	if (this->m_pstrValue == NULL)
-		return Constant::String::Empty;
-	else
-		return *(this->m_pstrValue);
+	const String* pstrValue = GetValuePtr<String>(DataKey::Text);
+	return (pstrValue != NULL) ? pstrValue->GetString() : Constant::String::Empty;
 }
 
 void SCtrlInfoWrap::GetString(_Out_ String& value) const
 {
-	if (this->m_pstrValue == NULL)
-		value = Constant::String::Empty;
-	else
-		value = *(this->m_pstrValue);
+	value = GetString();
 }
 
 /**
@@ -482,18 +406,13 @@ void SCtrlInfoWrap::GetString(_Out_ String& value) const
  */
 const wchar_t* SCtrlInfoWrap::GetReserveString(void) const
 {
-	if (this->m_pstrReserveValue == NULL)
-		return Constant::String::Empty;
-	else
-		return *(this->m_pstrReserveValue);
+	const String* pstrValue = GetValuePtr<String>(DataKey::ReserveText);
+	return (pstrValue != NULL) ? pstrValue->GetString() : Constant::String::Empty;
 }
 
 void SCtrlInfoWrap::GetReserveString(_Out_ String& value) const
 {
-	if (this->m_pstrReserveValue == NULL)
-		value = Constant::String::Empty;
-	else
-		value = *(this->m_pstrReserveValue);
+	value = GetReserveString();
 }
 
 /**
@@ -503,11 +422,12 @@ void SCtrlInfoWrap::GetReserveString(_Out_ String& value) const
  */
 void SCtrlInfoWrap::GetIntArray(_Out_ ULongArray& aulValue) const
 {
-	if (this->m_paulValueList == NULL) {
+	const ULongArray* paulValueList = GetValuePtr<ULongArray>(DataKey::IntArray);
+	if (paulValueList == NULL) {
 		aulValue.clear();
 	}
 	else {
-		aulValue = *(this->m_paulValueList);
+		aulValue = *paulValueList;
 	}
 }
 
@@ -518,11 +438,12 @@ void SCtrlInfoWrap::GetIntArray(_Out_ ULongArray& aulValue) const
  */
 void SCtrlInfoWrap::GetReserveIntArray(_Out_ ULongArray& aulValue) const
 {
-	if (this->m_paulReserveValueList == NULL) {
+	const ULongArray* paulValueList = GetValuePtr<ULongArray>(DataKey::ReserveIntArray);
+	if (paulValueList == NULL) {
 		aulValue.clear();
 	}
 	else {
-		aulValue = *(this->m_paulReserveValueList);
+		aulValue = *paulValueList;
 	}
 }
 
@@ -533,11 +454,12 @@ void SCtrlInfoWrap::GetReserveIntArray(_Out_ ULongArray& aulValue) const
  */
 void SCtrlInfoWrap::GetStringArray(_Out_ StringArray& astrValue) const
 {
-	if (this->m_pastrValueList == NULL) {
+	const StringArray* pastrValueList = GetValuePtr<StringArray>(DataKey::StrArray);
+	if (pastrValueList == NULL) {
 		astrValue.clear();
 	}
 	else {
-		astrValue = *(this->m_pastrValueList);
+		astrValue = *pastrValueList;
 	}
 }
 
@@ -548,11 +470,12 @@ void SCtrlInfoWrap::GetStringArray(_Out_ StringArray& astrValue) const
  */
 void SCtrlInfoWrap::GetReserveStringArray(_Out_ StringArray& astrValue) const
 {
-	if (this->m_pastrReserveValueList == NULL) {
+	const StringArray* pastrValueList = GetValuePtr<StringArray>(DataKey::ReserveStrArray);
+	if (pastrValueList == NULL) {
 		astrValue.clear();
 	}
 	else {
-		astrValue = *(this->m_pastrReserveValueList);
+		astrValue = *pastrValueList;
 	}
 }
 
@@ -563,18 +486,16 @@ void SCtrlInfoWrap::GetReserveStringArray(_Out_ StringArray& astrValue) const
  */
 SYSTEMTIME SCtrlInfoWrap::GetTime(void) const
 {
-	if (this->m_pstTimeValue == NULL)
+	const SYSTEMTIME* pstTimeValue = GetValuePtr<SYSTEMTIME>(DataKey::Time);
+	if (pstTimeValue == NULL)
 		return {0};
 	else
-		return *(this->m_pstTimeValue);
+		return *pstTimeValue;
 }
 
 void SCtrlInfoWrap::GetTime(_Out_ SYSTEMTIME& timeValue) const
 {
-	if (this->m_pstTimeValue == NULL)
-		timeValue = {0};
-	else
-		timeValue = *(this->m_pstTimeValue);
+	timeValue = GetTime();
 }
 
 /**
@@ -584,12 +505,7 @@ void SCtrlInfoWrap::GetTime(_Out_ SYSTEMTIME& timeValue) const
  */
 void SCtrlInfoWrap::SetCheck(_In_ const bool& bCheck)
 {
-	if (this->m_pbCheck == NULL)
-		this->m_pbCheck = new bool(bCheck);
-	else {
-		delete (this->m_pbCheck);
-		this->m_pbCheck = new bool(bCheck);
-	}
+	AcquireValue(DataKey::Check).emplace<bool>(bCheck);
 }
 
 /**
@@ -599,12 +515,7 @@ void SCtrlInfoWrap::SetCheck(_In_ const bool& bCheck)
  */
 void SCtrlInfoWrap::SetInteger(_In_ const LONG_PTR& lValue)
 {
-	if (this->m_plValue == NULL)
-		this->m_plValue = new LONG_PTR(lValue);
-	else {
-		delete (this->m_plValue);
-		this->m_plValue = new LONG_PTR(lValue);
-	}
+	AcquireValue(DataKey::Integer).emplace<LONG_PTR>(lValue);
 }
 
 /**
@@ -614,12 +525,7 @@ void SCtrlInfoWrap::SetInteger(_In_ const LONG_PTR& lValue)
  */
 void SCtrlInfoWrap::SetReserveInteger(_In_ const LONG_PTR& lValue)
 {
-	if (this->m_plReserveValue == NULL)
-		this->m_plReserveValue = new LONG_PTR(lValue);
-	else {
-		delete (this->m_plReserveValue);
-		this->m_plReserveValue = new LONG_PTR(lValue);
-	}
+	AcquireValue(DataKey::ReserveInteger).emplace<LONG_PTR>(lValue);
 }
 
 /**
@@ -630,21 +536,8 @@ void SCtrlInfoWrap::SetReserveInteger(_In_ const LONG_PTR& lValue)
  */
 void SCtrlInfoWrap::SetMinMaxInt(_In_ const LONG_PTR& lMin, _In_ const LONG_PTR& lMax)
 {
-	// Min value
-	if (this->m_plMinValue == NULL)
-		this->m_plMinValue = new LONG_PTR(lMin);
-	else {
-		delete (this->m_plMinValue);
-		this->m_plMinValue = new LONG_PTR(lMin);
-	}
-
-	// Max value
-	if (this->m_plMaxValue == NULL)
-		this->m_plMaxValue = new LONG_PTR(lMax);
-	else {
-		delete (this->m_plMaxValue);
-		this->m_plMaxValue = new LONG_PTR(lMax);
-	}
+	AcquireValue(DataKey::MinInteger).emplace<LONG_PTR>(lMin);
+	AcquireValue(DataKey::MaxInteger).emplace<LONG_PTR>(lMax);
 }
 
 /**
@@ -654,12 +547,7 @@ void SCtrlInfoWrap::SetMinMaxInt(_In_ const LONG_PTR& lMin, _In_ const LONG_PTR&
  */
 void SCtrlInfoWrap::SetFloat(_In_ const DOUBLE& dbValue)
 {
-	if (this->m_pdbValue == NULL)
-		this->m_pdbValue = new DOUBLE(dbValue);
-	else {
-		delete (this->m_pdbValue);
-		this->m_pdbValue = new DOUBLE(dbValue);
-	}
+	AcquireValue(DataKey::Float).emplace<DOUBLE>(dbValue);
 }
 
 /**
@@ -669,12 +557,7 @@ void SCtrlInfoWrap::SetFloat(_In_ const DOUBLE& dbValue)
  */
 void SCtrlInfoWrap::SetReserveFloat(_In_ const DOUBLE& dbValue)
 {
-	if (this->m_pdbReserveValue == NULL)
-		this->m_pdbReserveValue = new DOUBLE(dbValue);
-	else {
-		delete (this->m_pdbReserveValue);
-		this->m_pdbReserveValue = new DOUBLE(dbValue);
-	}
+	AcquireValue(DataKey::ReserveFloat).emplace<DOUBLE>(dbValue);
 }
 
 /**
@@ -685,21 +568,8 @@ void SCtrlInfoWrap::SetReserveFloat(_In_ const DOUBLE& dbValue)
  */
 void SCtrlInfoWrap::SetMinMaxFloat(_In_ const DOUBLE& dbMin, _In_ const DOUBLE& dbMax)
 {
-	// Min value
-	if (this->m_pdbMinValue == NULL)
-		this->m_pdbMinValue = new DOUBLE(dbMin);
-	else {
-		delete (this->m_pdbMinValue);
-		this->m_pdbMinValue = new DOUBLE(dbMin);
-	}
-
-	// Max value
-	if (this->m_pdbMaxValue == NULL)
-		this->m_pdbMaxValue = new DOUBLE(dbMax);
-	else {
-		delete (this->m_pdbMaxValue);
-		this->m_pdbMaxValue = new DOUBLE(dbMax);
-	}
+	AcquireValue(DataKey::MinFloat).emplace<DOUBLE>(dbMin);
+	AcquireValue(DataKey::MaxFloat).emplace<DOUBLE>(dbMax);
 }
 
 /**
@@ -709,12 +579,7 @@ void SCtrlInfoWrap::SetMinMaxFloat(_In_ const DOUBLE& dbMin, _In_ const DOUBLE&
  */
 void SCtrlInfoWrap::SetString(_In_ const wchar_t* value)
 {
-	if (this->m_pstrValue == NULL)
-		this->m_pstrValue = new String(value);
-	else {
-		delete (this->m_pstrValue);
-		this->m_pstrValue = new String(value);
-	}
+	AcquireValue(DataKey::Text).emplace<String>(value);
 }
 
 /**
@@ -724,12 +589,7 @@ void SCtrlInfoWrap::SetString(_In_ const wchar_t* value)
  */
 void SCtrlInfoWrap::SetReserveString(_In_ const wchar_t* value)
 {
-	if (this->m_pstrReserveValue == NULL)
-		this->m_pstrReserveValue = new String(value);
-	else {
-		delete (this->m_pstrReserveValue);
-		this->m_pstrReserveValue = new String(value);
-	}
+	AcquireValue(DataKey::ReserveText).emplace<String>(value);
 }
 
 /**
@@ -739,13 +599,7 @@ void SCtrlInfoWrap::SetReserveString(_In_ const wchar_t* value)
  */
 void SCtrlInfoWrap::SetIntArray(_In_ const ULongArray& aulValue)
 {
-	if (this->m_paulValueList == NULL)
-		this->m_paulValueList = new ULongArray();
-	
-	if (this->m_paulValueList != NULL) {
-		this->m_paulValueList->clear();
-		this->m_paulValueList->assign(aulValue.begin(), aulValue.end());
-	}
+	AcquireValue(DataKey::IntArray).emplace<ULongArray>(aulValue);
 }
 
 /**
@@ -755,13 +609,7 @@ void SCtrlInfoWrap::SetIntArray(_In_ const ULongArray& aulValue)
  */
 void SCtrlInfoWrap::SetReserveIntArray(_In_ const ULongArray& aulValue)
 {
-	if (this->m_paulReserveValueList == NULL)
-		this->m_paulReserveValueList = new ULongArray();
-
-	if (this->m_paulReserveValueList != NULL) {
-		this->m_paulReserveValueList->clear();
-		this->m_paulReserveValueList->assign(aulValue.begin(), aulValue.end());
-	}
+	AcquireValue(DataKey::ReserveIntArray).emplace<ULongArray>(aulValue);
 }
 
 /**
@@ -771,13 +619,7 @@ void SCtrlInfoWrap::SetReserveIntArray(_In_ const ULongArray& aulValue)
  */
 void SCtrlInfoWrap::SetStringArray(_In_ const StringArray& astrValue)
 {
-	if (this->m_pastrValueList == NULL)
-		this->m_pastrValueList = new StringArray();
-
-	if (this->m_pastrValueList != NULL) {
-		this->m_pastrValueList->clear();
-		this->m_pastrValueList->assign(astrValue.begin(), astrValue.end());
-	}
+	AcquireValue(DataKey::StrArray).emplace<StringArray>(astrValue);
 }
 
 /**
@@ -787,13 +629,7 @@ void SCtrlInfoWrap::SetStringArray(_In_ const StringArray& astrValue)
  */
 void SCtrlInfoWrap::SetReserveStringArray(_In_ const StringArray& astrValue)
 {
-	if (this->m_pastrReserveValueList == NULL)
-		this->m_pastrReserveValueList = new StringArray();
-
-	if (this->m_pastrReserveValueList != NULL) {
-		this->m_pastrReserveValueList->clear();
-		this->m_pastrReserveValueList->assign(astrValue.begin(), astrValue.end());
-	}
+	AcquireValue(DataKey::ReserveStrArray).emplace<StringArray>(astrValue);
 }
 
 /**
@@ -803,49 +639,32 @@ void SCtrlInfoWrap::SetReserveStringArray(_In_ const StringArray& astrValue)
  */
 void SCtrlInfoWrap::SetTime(_In_ const SYSTEMTIME& timeValue)
 {
-	if (this->m_pstTimeValue == NULL)
-		this->m_pstTimeValue = new SYSTEMTIME(timeValue);
-	else {
-		delete (this->m_pstTimeValue);
-		this->m_pstTimeValue = new SYSTEMTIME(timeValue);
-	}
+	AcquireValue(DataKey::Time).emplace<SYSTEMTIME>(timeValue);
 }
 
 /**
  * @brief	Get current control's custom data pointer
  * @param	lpOutput   - Output data pointer
- * @param	szDataSize - Data's total size in bytes (in/out)
+ * @param	szDataSize - Output buffer size in bytes (in), data's total size in bytes (out)
  * @return	true/false
  */
 template<typename DATA_TYPE>
 bool SCtrlInfoWrap::GetData(_Outptr_ DATA_TYPE* lpOutput, _Inout_opt_z_ SIZE_T& szDataSize) const
 {
-	// If pointers are invalid
-	if ((lpOutput == NULL) ||
-		(this->m_ptrCustomData == NULL) ||
-		(this->m_pszDataSize == NULL))
-		return false;	// Fail to retrieve data
-
-	// If size value is invalid
-	SIZE_T szCurDataSize = *(this->m_pszDataSize);
-	if ((szDataSize <= 0) || (szCurDataSize <= 0))
+	// If pointers are invalid or data is empty
+	if ((lpOutput == NULL) || (IsDataEmpty()))
 		return false;	// Fail to retrieve data
 
-	// If the output buffer size is insufficient
+	// If the output buffer size is insufficient,
+	// return the required size
+	SIZE_T szCurDataSize = m_arrCustomData.size();
 	if (szDataSize < szCurDataSize) {
-		// Re-allocate output data pointer
-		// we can 
-		delete[] lpOutput;
-		lpOutput = new DATA_TYPE[szCurDataSize / sizeof(DATA_TYPE)];
-		ASSERT(lpOutput != NULL);
-		if (lpOutput == NULL) {
-			throw std::bad_alloc();
-			return false;	// Allocation failed
-		}
+		szDataSize = szCurDataSize;
+		return false;
 	}
 
 	// Copy data and update the output data size
-	memcpy(lpOutput, this->m_ptrCustomData, szCurDataSize);
+	memcpy(lpOutput, m_arrCustomData.data(), szCurDataSize);
 	szDataSize = szCurDataSize;
 
 	return true;	// Get data successfully
@@ -864,41 +683,9 @@ bool SCtrlInfoWrap::SetData(_In_ const DATA_TYPE* lpInput, _In_ const SIZE_T& sz
 	if ((lpInput == NULL) || (szDataSize <= 0))
 		return false;	// Fail to set data
 
-	// If the current data pointer is not empty
-	// or its current total size in bytes is not large enough
-	if ((this->m_ptrCustomData != NULL) ||
-		((this->m_pszDataSize != NULL) && (*(this->m_pszDataSize) < szDataSize))) {
-		if (this->m_ptrCustomData != NULL) {
-			// Free the data pointer's existing memory
-			free(this->m_ptrCustomData);
-		}
-	}
-
-	// Allocate the data pointer if not available
-	if (this->m_ptrCustomData == NULL) {
-		this->m_ptrCustomData = malloc(szDataSize);
-		ASSERT(this->m_ptrCustomData != NULL);
-		if (this->m_ptrCustomData == NULL) {
-			throw std::bad_alloc();
-			return false;	// Allocation failed
-		}
-	}
-
-	// Allocate the data size pointer if not available
-	if (this->m_pszDataSize == NULL) {
-		this->m_pszDataSize = new SIZE_T;
-		ASSERT(this->m_pszDataSize != NULL);
-		if (this->m_pszDataSize == NULL) {
-			throw std::bad_alloc();
-			return false;	// Allocation failed
-		}
-	}
-
-	// Copy data
-	memcpy(this->m_ptrCustomData, lpInput, szDataSize);
-
-	// Update the data's new total size in bytes
-	*(this->m_pszDataSize) = szDataSize;
+	// Copy data (the buffer is re-allocated only if its capacity is not large enough)
+	const BYTE* pInputData = reinterpret_cast<const BYTE*>(lpInput);
+	m_arrCustomData.assign(pInputData, pInputData + szDataSize);
 
 	return true;	// Set data successfully
 }
@@ -910,17 +697,7 @@ bool SCtrlInfoWrap::SetData(_In_ const DATA_TYPE* lpInput, _In_ const SIZE_T& sz
  */
 bool SCtrlInfoWrap::IsDataEmpty(void) const
 {
-	// If the data pointer is not available, then it's indeed empty
-	if (this->m_ptrCustomData == NULL)
-		return true;
-
-	// If the data size is not available or invalid,
-	// the data can be considered empty
-	if ((this->m_pszDataSize == NULL) ||
-		(this->m_pszDataSize != NULL) && *(this->m_pszDataSize) <= 0)
-		return true;
-
-	return false;	// Not empty
+	return m_arrCustomData.empty();
 }
 
 /**
@@ -930,18 +707,9 @@ bool SCtrlInfoWrap::IsDataEmpty(void) const
  */
 SIZE_T SCtrlInfoWrap::GetDataSize(void) const
 {
-	// If the data is empty, return 0
-	if (IsDataEmpty())
-		return INT_NULL;
-
-	// Otherwise, return the size
-	if (this->m_pszDataSize != NULL)
-		return *(this->m_pszDataSize);
-
-	return INT_NULL;	// Default, return 0
+	return m_arrCustomData.size();
 }
 
-
 //////////////////////////////////////////////////////////////////////////
 //
 //	Implement methods for SMenu
@@ -985,9 +753,6 @@ IMPLEMENT_DYNAMIC(SControlManager, CObject)
  */
 SControlManager::SControlManager(CWnd* pParentWnd /* = NULL */) : CObject()
 {
-	// List of control info wrappers
-	m_pCtrlInfoArray = NULL;
-
 	// Parent window
 	m_pParentWnd = pParentWnd;
 }
@@ -998,11 +763,7 @@ SControlManager::SControlManager(CWnd* pParentWnd /* = NULL */) : CObject()
 SControlManager::~SControlManager()
 {
 	// List of control info wrappers
-	if (m_pCtrlInfoArray != NULL) {
-		this->DeleteAll();
-		delete m_pCtrlInfoArray;
-		m_pCtrlInfoArray = NULL;
-	}
+	this->DeleteAll();
 }
 
 /**
@@ -1012,17 +773,9 @@ SControlManager::~SControlManager()
  */
 bool SControlManager::Initialize(void)
 {
-	// Initialize control info list pointer
-	if (this->m_pCtrlInfoArray == NULL) {
-		this->m_pCtrlInfoArray = new SCtrlInfoList();
-
-		// Allocation failed
-		if (this->m_pCtrlInfoArray == NULL)
-			return false;
-	}
-
 	// Empty array data
-	m_pCtrlInfoArray->clear();
+	m_arrCtrlInfo.clear();
+	m_mapCtrlIndex.clear();
 
 	return true;
 }
@@ -1034,53 +787,31 @@ bool SControlManager::Initialize(void)
  */
 bool SControlManager::DeleteAll(void)
 {
-	// If data is not initialized
-	if (this->m_pCtrlInfoArray == NULL)
-		return false;
-
-	// Delete all control info wrapper pointers
-	for (int nIndex = 0; nIndex < (this->m_pCtrlInfoArray->size()); nIndex++) {
-		SCtrlInfoWrap* pExControl = m_pCtrlInfoArray->at(nIndex);
-		if (pExControl != NULL) {
-			delete pExControl;
-			pExControl = NULL;
-		}
-	}
-
 	// Empty array data
-	m_pCtrlInfoArray->clear();
+	m_arrCtrlInfo.clear();
+	m_mapCtrlIndex.clear();
 
 	return true;
 }
 
 /**
  * @brief	Add dialog/window control to management
- * @param	pControl - Dialog control item
+ * @param	control - Dialog control item (moved into management list)
  * @return	long long
  */
-long long SControlManager::AddControl(SCtrlInfoWrap* pControl)
+long long SControlManager::AddControl(SCtrlInfoWrap&& control)
 {
-	// Check for control pointer validity
-	if (pControl == NULL) 
-		return INT_INVALID;
-
-	// If data is not initialized
-	if (this->m_pCtrlInfoArray == NULL)
-		return INT_INVALID;
-
 	// Search if control ID had already existed
-	for (int nIndex = 0; nIndex < (this->m_pCtrlInfoArray->size()); nIndex++) {
-		SCtrlInfoWrap* pExControl = m_pCtrlInfoArray->at(nIndex);
-		if (pExControl == NULL) continue;
-		if (pExControl->GetTemplateID() == pControl->GetTemplateID()) {
-			// Return control index
-			return nIndex;
-		}
+	auto itIndex = m_mapCtrlIndex.find(control.GetTemplateID());
+	if (itIndex != m_mapCtrlIndex.end()) {
+		// Return control index
+		return static_cast<long long>(itIndex->second);
 	}
 
 	// Add control to list and return list size
-	this->m_pCtrlInfoArray->push_back(pControl);
-	return (this->m_pCtrlInfoArray->size());
+	m_mapCtrlIndex.emplace(control.GetTemplateID(), m_arrCtrlInfo.size());
+	m_arrCtrlInfo.push_back(std::move(control));
+	return static_cast<long long>(m_arrCtrlInfo.size());
 }
 
 /**
@@ -1100,18 +831,18 @@ long long SControlManager::AddControl(unsigned nCtrlID, unsigned nTypeID)
 	if (pCtrlWnd == NULL)
 		return INT_INVALID;
 
+	// If control ID had already existed, return its index
+	auto itIndex = m_mapCtrlIndex.find(nCtrlID);
+	if (itIndex != m_mapCtrlIndex.end())
+		return static_cast<long long>(itIndex->second);
+
 	// Initialize control info
-	SCtrlInfoWrap* pControl = new SCtrlInfoWrap();
-	pControl->Initialize(m_pParentWnd, NULL, nCtrlID, nTypeID);
+	SCtrlInfoWrap control;
+	if (!control.Initialize(m_pParentWnd, NULL, nCtrlID, nTypeID))
+		return INT_INVALID;
 
 	// Add control to management list
-	size_t nRetIndex = this->AddControl(pControl);
-	if (nRetIndex != -1)
-		return nRetIndex;
-
-	// Failed to add
-	delete pControl;
-	return INT_INVALID;
+	return this->AddControl(std::move(control));
 }
 
 /**
@@ -1121,47 +852,38 @@ long long SControlManager::AddControl(unsigned nCtrlID, unsigned nTypeID)
  */
 long long SControlManager::RemoveControl(unsigned nCtrlID)
 {
-	// If data is not initialized or is empty
-	if ((m_pCtrlInfoArray == NULL) || (this->IsEmpty()))
+	// Search for control ID
+	auto itIndex = m_mapCtrlIndex.find(nCtrlID);
+	if (itIndex == m_mapCtrlIndex.end()) {
+		// Control ID not found, return -1
 		return INT_INVALID;
+	}
 
-	// Search for control ID
-	for (int nIndex = 0; nIndex < (m_pCtrlInfoArray->size()); nIndex++) {
-		SCtrlInfoWrap* pExControl = m_pCtrlInfoArray->at(nIndex);
-		if (pExControl == NULL) continue;
-		if (pExControl->GetTemplateID() == nCtrlID) {
-			delete pExControl;
-
-			// Remove control from list
-			m_pCtrlInfoArray->erase(m_pCtrlInfoArray->begin() + nIndex);
-			return (m_pCtrlInfoArray->size());
-		}
+	// Move the last control into the removed slot, then remove the last slot
+	size_t nIndex = itIndex->second;
+	m_mapCtrlIndex.erase(itIndex);
+	if (nIndex != (m_arrCtrlInfo.size() - 1)) {
+		m_arrCtrlInfo[nIndex] = std::move(m_arrCtrlInfo.back());
+		m_mapCtrlIndex[m_arrCtrlInfo[nIndex].GetTemplateID()] = nIndex;
 	}
+	m_arrCtrlInfo.pop_back();
 
-	// Control ID not found, return -1
-	return INT_INVALID;
+	return static_cast<long long>(m_arrCtrlInfo.size());
 }
 
 /**
- * @brief	Remove dialog/window control from management
+ * @brief	Get dialog/window control info wrapper by ID
  * @param	nCtrlID - Dialog control ID
- * @return	None
+ * @return	SCtrlInfoWrap*
  */
 SCtrlInfoWrap* SControlManager::GetControl(unsigned nCtrlID)
 {
-	// If data is not initialized or is empty
-	if ((this->m_pCtrlInfoArray == NULL) || (this->IsEmpty()))
-		return NULL;
-
 	// Search for control ID
-	for (int nIndex = 0; nIndex < (this->m_pCtrlInfoArray->size()); nIndex++) {
-		SCtrlInfoWrap* pControl = m_pCtrlInfoArray->at(nIndex);
-		if (pControl == NULL) continue;
-		if (pControl->GetTemplateID() == nCtrlID)
-			return pControl;
-	}
+	auto itIndex = m_mapCtrlIndex.find(nCtrlID);
+	if (itIndex == m_mapCtrlIndex.end())
+		return NULL;
 
-	return NULL;
+	return &m_arrCtrlInfo[itIndex->second];
 }
 
 /**
@@ -1194,6 +916,28 @@ bool SControlManager::SetBuddy(unsigned nBaseCtrlID, unsigned nBuddyCtrlID)
 	return true;
 }
 
+/**
+ * @brief	Mark specified control or all controls to be updated on next data update
+ * @param	nCtrlID - Control ID (NULL means all controls)
+ * @return	None
+ */
+void SControlManager::SetDirty(unsigned nCtrlID /* = NULL */)
+{
+	// Mark all controls
+	if (nCtrlID == NULL) {
+		for (SCtrlInfoWrap& control : m_arrCtrlInfo) {
+			control.SetDirty(true);
+		}
+		return;
+	}
+
+	// Mark specified control
+	SCtrlInfoWrap* pControl = GetControl(nCtrlID);
+	if (pControl != NULL) {
+		pControl->SetDirty(true);
+	}
+}
+
 /**
  * @brief	Update data for specified control or all controls
  * @param	nCtrlID - Control ID (NULL means all controls)
@@ -1201,296 +945,310 @@ bool SControlManager::SetBuddy(unsigned nBaseCtrlID, unsigned nBuddyCtrlID)
  */
 void SControlManager::UpdateData(unsigned nCtrlID /* = NULL */)
 {
-	// If data is not initialized or is empty
-	if ((this->m_pCtrlInfoArray == NULL) || (this->IsEmpty()))
+	// If data is empty or parent window is not available
+	if ((this->IsEmpty()) || (this->m_pParentWnd == NULL))
 		return;
 
-	// If parent window is not available
-	if (this->m_pParentWnd == NULL)
+	// Only update data for specified control
+	if (nCtrlID != NULL) {
+		SCtrlInfoWrap* pControl = GetControl(nCtrlID);
+		if (pControl != NULL) {
+			UpdateControlData(*pControl);
+		}
 		return;
+	}
 
-	// Loop through control management list
-	int nTriggerForceRetFlag = FLAG_OFF;
-	for (int nIndex = 0; nIndex < (this->m_pCtrlInfoArray->size()); nIndex++) {
-
-		// If force return flag is ON, break the loop
-		if (nTriggerForceRetFlag == FLAG_ON)
-			break;
+	// Explicit update: control states might have been changed programmatically
+	// without any notification, so update all controls
+	for (SCtrlInfoWrap& control : m_arrCtrlInfo) {
+		UpdateControlData(control);
+	}
+}
 
-		// Get control wrapper pointer
-		SCtrlInfoWrap* pCurControl = m_pCtrlInfoArray->at(nIndex);
-		if (pCurControl == NULL) continue;
+/**
+ * @brief	Update data for controls which have been marked dirty since last update
+ * @param	None
+ * @return	None
+ */
+void SControlManager::UpdateDirtyData(void)
+{
+	// If data is empty or parent window is not available
+	if ((this->IsEmpty()) || (this->m_pParentWnd == NULL))
+		return;
 
-		// Only update data for specified control
-		if (nCtrlID != NULL) {
-			if (pCurControl->GetTemplateID() != nCtrlID) {
-				// Skip this control
-				continue;
-			}
-			else {
-				// Trigger force return flag 
-				// It will stop after updating for current control
-				nTriggerForceRetFlag = FLAG_ON;
-			}
+	for (SCtrlInfoWrap& control : m_arrCtrlInfo) {
+		if (control.IsDirty()) {
+			UpdateControlData(control);
 		}
+	}
+}
+
+/**
+ * @brief	Update data for a control from its window
+ * @param	control - Control info wrapper
+ * @return	None
+ */
+void SControlManager::UpdateControlData(SCtrlInfoWrap& control)
+{
+	// Clear dirty state
+	control.SetDirty(false);
 
-		// If base control is not available, skip updating
-		if (!pCurControl->IsBaseControlAvailable())
-			continue;
+	// If base control is not available, skip updating
+	if (!control.IsBaseControlAvailable())
+		return;
 
-		// Get base control pointer
-		CWnd* pBaseControl = pCurControl->GetBaseControl();
+	// Get control wrapper and base control pointer
+	SCtrlInfoWrap* pCurControl = &control;
+	CWnd* pBaseControl = pCurControl->GetBaseControl();
 
-		// Update control attributes
-		pCurControl->UpdateAttributes();
+	// Update control attributes
+	pCurControl->UpdateAttributes();
 
-		// Update data for control by type
-		switch (pCurControl->GetType())
+	// Update data for control by type
+	switch (pCurControl->GetType())
+	{
+		// Clickable and checkable controls
+		case Button:
+		case Check_Box:
+		case Radio_Button:
 		{
-			// Clickable and checkable controls
-			case Button:
-			case Check_Box:
-			case Radio_Button:
-			{
-				// Update control's checked state
-				bool bCheck = ((CButton*)pBaseControl)->GetCheck();
-				pCurControl->SetCheck(bCheck);
-			} break;
-
-			// Edit box
-			case Edit_Control:
-			{
-				// Update control's text value
-				const int textLength = ((CEdit*)pBaseControl)->GetWindowTextLength();
-				std::vector<wchar_t> tempBuff(textLength + 1);
-				((CEdit*)pBaseControl)->GetWindowText(tempBuff.data(), textLength + 1);
-				String tempText = tempBuff.data();
-				pCurControl->SetString(tempText);
-			} break;
-
-			// Combo-box
-			case Combo_Box:
-			{
-				// Update control's current selection index
-				size_t nCurSel = ((CComboBox*)pBaseControl)->GetCurSel();
-				pCurControl->SetInteger(nCurSel);
-				// Update all item strings
-				StringArray arrStringData;
-				size_t nCount = ((CComboBox*)pBaseControl)->GetCount();
-				arrStringData.reserve(nCount);
-				for (size_t nIndex = 0; nIndex < nCount; nIndex++) {
-					wchar_t tempBuff[Constant::Max::StringLength] = {0};
-					((CComboBox*)pBaseControl)->GetLBText(nIndex, tempBuff);
-					arrStringData.push_back(tempBuff);
-				}
-				pCurControl->SetStringArray(arrStringData);
-			} break;
-
-			// List box
-			case List_Box:
-			{
-				// Update control's current selection index
-				size_t nCurSel = ((CListBox*)pBaseControl)->GetCurSel();
-				pCurControl->SetInteger(nCurSel);
-				// Update all item strings
-				StringArray arrStringData;
-				size_t nCount = ((CListBox*)pBaseControl)->GetCount();
-				arrStringData.reserve(nCount);
-				for (size_t nIndex = 0; nIndex < nCount; nIndex++) {
-					wchar_t tempBuff[Constant::Max::StringLength] = {0};
-					((CListBox*)pBaseControl)->GetText(nIndex, tempBuff);
-					arrStringData.push_back(tempBuff);
-				}
-				pCurControl->SetStringArray(arrStringData);
-			} break;
-
-			// List control
-			case List_Control:
-			{
-				// Update number of items and columns
-				size_t nItemCount = ((CListCtrl*)pBaseControl)->GetItemCount();
-				pCurControl->SetInteger(nItemCount);
-				size_t nColumnCount = 0;
-				CHeaderCtrl* pHeaderCtrl = ((CListCtrl*)pBaseControl)->GetHeaderCtrl();
-				if (pHeaderCtrl != NULL) {
-					nColumnCount = pHeaderCtrl->GetItemCount();
-				}
-				pCurControl->SetReserveInteger(nColumnCount);
-				// Update control's data current selection index(es)
-				ULongArray arrSelection;
-				arrSelection.reserve(nItemCount);
-				for (size_t nIndex = 0; nIndex < nItemCount; nIndex++) {
-					// Get selection index
-					if ((((CListCtrl*)pBaseControl)->GetItemState(nIndex, LVIS_SELECTED) & LVIS_SELECTED) == LVIS_SELECTED) {
-						arrSelection.push_back(nIndex);
-					}
-				}
-				pCurControl->SetIntArray(arrSelection);
-				// Update all item strings
-				StringArray arrStringData;
-				arrStringData.reserve(nItemCount);
-				for (size_t nIndex = 0; nIndex < nItemCount; nIndex++) {
-					for (size_t nColIndex = 0; nColIndex < nColumnCount; nColIndex++) {
-						// Get item text
-						String tempText = ((CListCtrl*)pBaseControl)->GetItemText(nIndex, nColIndex).GetString();
-						arrStringData.push_back(tempText);
-					}
+			// Update control's checked state
+			bool bCheck = ((CButton*)pBaseControl)->GetCheck();
+			pCurControl->SetCheck(bCheck);
+		} break;
+
+		// Edit box
+		case Edit_Control:
+		{
+			// Update control's text value
+			const int textLength = ((CEdit*)pBaseControl)->GetWindowTextLength();
+			std::vector<wchar_t> tempBuff(textLength + 1);
+			((CEdit*)pBaseControl)->GetWindowText(tempBuff.data(), textLength + 1);
+			String tempText = tempBuff.data();
+			pCurControl->SetString(tempText);
+		} break;
+
+		// Combo-box
+		case Combo_Box:
+		{
+			// Update control's current selection index
+			size_t nCurSel = ((CComboBox*)pBaseControl)->GetCurSel();
+			pCurControl->SetInteger(nCurSel);
+			// Update all item strings
+			StringArray arrStringData;
+			size_t nCount = ((CComboBox*)pBaseControl)->GetCount();
+			arrStringData.reserve(nCount);
+			for (size_t nIndex = 0; nIndex < nCount; nIndex++) {
+				wchar_t tempBuff[Constant::Max::StringLength] = {0};
+				((CComboBox*)pBaseControl)->GetLBText(nIndex, tempBuff);
+				arrStringData.push_back(tempBuff);
+			}
+			pCurControl->SetStringArray(arrStringData);
+		} break;
+
+		// List box
+		case List_Box:
+		{
+			// Update control's current selection index
+			size_t nCurSel = ((CListBox*)pBaseControl)->GetCurSel();
+			pCurControl->SetInteger(nCurSel);
+			// Update all item strings
+			StringArray arrStringData;
+			size_t nCount = ((CListBox*)pBaseControl)->GetCount();
+			arrStringData.reserve(nCount);
+			for (size_t nIndex = 0; nIndex < nCount; nIndex++) {
+				wchar_t tempBuff[Constant::Max::StringLength] = {0};
+				((CListBox*)pBaseControl)->GetText(nIndex, tempBuff);
+				arrStringData.push_back(tempBuff);
+			}
+			pCurControl->SetStringArray(arrStringData);
+		} break;
+
+		// List control
+		case List_Control:
+		{
+			// Update number of items and columns
+			size_t nItemCount = ((CListCtrl*)pBaseControl)->GetItemCount();
+			pCurControl->SetInteger(nItemCount);
+			size_t nColumnCount = 0;
+			CHeaderCtrl* pHeaderCtrl = ((CListCtrl*)pBaseControl)->GetHeaderCtrl();
+			if (pHeaderCtrl != NULL) {
+				nColumnCount = pHeaderCtrl->GetItemCount();
+			}
+			pCurControl->SetReserveInteger(nColumnCount);
+			// Update control's data current selection index(es)
+			ULongArray arrSelection;
+			arrSelection.reserve(nItemCount);
+			for (size_t nIndex = 0; nIndex < nItemCount; nIndex++) {
+				// Get selection index
+				if ((((CListCtrl*)pBaseControl)->GetItemState(nIndex, LVIS_SELECTED) & LVIS_SELECTED) == LVIS_SELECTED) {
+					arrSelection.push_back(nIndex);
 				}
-				pCurControl->SetStringArray(arrStringData);
-			} break;
-
-			// Tab control
-			case Tab_Control:
-			{
-				// Update the number of tabs
-				size_t nTabCount = ((CTabCtrl*)pBaseControl)->GetItemCount();
-				// Update the currently selected tab index
-				size_t nCurSelTab = ((CTabCtrl*)pBaseControl)->GetCurSel();
-				pCurControl->SetInteger(nCurSelTab);
-				// Update all tab's title
-				TCITEM tabInfo;
-				StringArray arrTabTitles;
-				arrTabTitles.reserve(nTabCount);
-				for (size_t nIndex = 0; nIndex < nTabCount; nIndex++) {
-					String tempText = Constant::String::Empty;
-					bool bRet = ((CTabCtrl*)pBaseControl)->GetItem(nIndex, &tabInfo);
-					if (bRet == true && ((tabInfo.mask & TCIF_TEXT) != 0)) {
-						tempText = tabInfo.pszText;
-					}
-					arrTabTitles.push_back(tempText);
+			}
+			pCurControl->SetIntArray(arrSelection);
+			// Update all item strings
+			StringArray arrStringData;
+			arrStringData.reserve(nItemCount);
+			for (size_t nIndex = 0; nIndex < nItemCount; nIndex++) {
+				for (size_t nColIndex = 0; nColIndex < nColumnCount; nColIndex++) {
+					// Get item text
+					String tempText = ((CListCtrl*)pBaseControl)->GetItemText(nIndex, nColIndex).GetString();
+					arrStringData.push_back(tempText);
 				}
-				pCurControl->SetStringArray(arrTabTitles);
-			} break;
-
-			// Static text and decorating items
-			case Static_Text:
-			case Group_Box:
-			case SysLink_Control:
-			{
-				// Update control's text label
-				const int textLength = pBaseControl->GetWindowTextLength();
-				std::vector<wchar_t> tempBuff(textLength + 1);
-				pBaseControl->GetWindowText(tempBuff.data(), textLength + 1);
-				String captionString = tempBuff.data();
-				pCurControl->SetCaption(captionString);
-			} break;
-
-			// Scroll bars
-			case Horizontal_Scroll_Bar:
-			case Vertical_Scroll_Bar:
-			{
-				// Update control's current position
-				size_t nCurPos = ((CScrollBar*)pBaseControl)->GetScrollPos();
-				pCurControl->SetInteger(nCurPos);
-				// Update control's min/max range
-				int nMin = NULL, nMax = NULL;
-				((CScrollBar*)pBaseControl)->GetScrollRange(&nMin, &nMax);
-				pCurControl->SetMinMaxInt(nMin, nMax);
-			} break;
-
-			// Slider control
-			case Slider_Control:
-			{
-				// Update control's current position
-				size_t nCurPos = ((CSliderCtrl*)pBaseControl)->GetPos();
-				pCurControl->SetInteger(nCurPos);
-				// Update control's min/max range
-				size_t nMin = ((CSliderCtrl*)pBaseControl)->GetRangeMin();
-				size_t nMax = ((CSliderCtrl*)pBaseControl)->GetRangeMax();
-				pCurControl->SetMinMaxInt(nMin, nMax);
-			} break;
-
-			// Progress bar
-			case Progress_Control:
-			{
-				// Update control's current position
-				size_t nCurPos = ((CProgressCtrl*)pBaseControl)->GetPos();
-				pCurControl->SetInteger(nCurPos);
-				// Update control's min/max range
-				int nMin = NULL, nMax = NULL;
-				((CProgressCtrl*)pBaseControl)->GetRange(nMin, nMax);
-				pCurControl->SetMinMaxInt(nMin, nMax);
-			} break;
-
-			// Spin button control
-			case Spin_Control:
-			{
-				// Update control's current position
-				size_t nCurPos = ((CSpinButtonCtrl*)pBaseControl)->GetPos();
-				pCurControl->SetInteger(nCurPos);
-				// Update control's min/max range
-				int nMin = NULL, nMax = NULL;
-				((CSpinButtonCtrl*)pBaseControl)->GetRange(nMin, nMax);
-				pCurControl->SetMinMaxInt(nMin, nMax);
-			} break;
-
-			// Hot key control
-			case Hot_Key:
-			{
-				// Update control's current hotkey
-				DWORD dwHotkey = ((CHotKeyCtrl*)pBaseControl)->GetHotKey();
-				pCurControl->SetInteger(LOWORD(dwHotkey));			// Virtual keycode
-				pCurControl->SetReserveInteger(HIWORD(dwHotkey));	// Modifier flags
-			} break;
-
-			// IP address control
-			case IP_Address_Control:
-			{
-				// Update control's current IP address
-				DWORD dwAddress = 0;
-				byte byField0 = 0, byField1 = 0, byField2 = 0, byField3 = 0;
-				int nNonBlankFieldNum = ((CIPAddressCtrl*)pBaseControl)->GetAddress(dwAddress);
-				((CIPAddressCtrl*)pBaseControl)->GetAddress(byField0, byField1, byField2, byField3);
-				pCurControl->SetInteger(dwAddress);
-				pCurControl->SetReserveInteger(nNonBlankFieldNum);
-				// Store each field value separately into an integer array
-				ULongArray arrAddressFields;
-				arrAddressFields.resize(4);
-				arrAddressFields[0] = byField0;		// Field 0
-				arrAddressFields[1] = byField1;		// Field 1
-				arrAddressFields[2] = byField2;		// Field 2
-				arrAddressFields[3] = byField3;		// Field 3
-				pCurControl->SetIntArray(arrAddressFields);
-			} break;
-
-			// Network address control
-			case Network_Address_Control:
-			{
-				// Update control's current network address
-				NC_ADDRESS ncAddress;
-				NET_ADDRESS_INFO netAddressInfo;
-				ncAddress.pAddrInfo = &netAddressInfo;
-				HRESULT hRes = ((CNetAddressCtrl*)pBaseControl)->GetAddress(&ncAddress);
-				if (hRes == S_OK) {
-					// Save address and port info
-					String addressString = ncAddress.pAddrInfo->NamedAddress.Address;
-					String portString = ncAddress.pAddrInfo->NamedAddress.Port;
-					pCurControl->SetString(addressString);
-					pCurControl->SetReserveString(portString);
-					// Numeric data
-					pCurControl->SetInteger(ncAddress.PortNumber);
-					pCurControl->SetReserveInteger(ncAddress.PrefixLength);
+			}
+			pCurControl->SetStringArray(arrStringData);
+		} break;
+
+		// Tab control
+		case Tab_Control:
+		{
+			// Update the number of tabs
+			size_t nTabCount = ((CTabCtrl*)pBaseControl)->GetItemCount();
+			// Update the currently selected tab index
+			size_t nCurSelTab = ((CTabCtrl*)pBaseControl)->GetCurSel();
+			pCurControl->SetInteger(nCurSelTab);
+			// Update all tab's title
+			TCITEM tabInfo;
+			StringArray arrTabTitles;
+			arrTabTitles.reserve(nTabCount);
+			for (size_t nIndex = 0; nIndex < nTabCount; nIndex++) {
+				String tempText = Constant::String::Empty;
+				bool bRet = ((CTabCtrl*)pBaseControl)->GetItem(nIndex, &tabInfo);
+				if (bRet == true && ((tabInfo.mask & TCIF_TEXT) != 0)) {
+					tempText = tabInfo.pszText;
 				}
-			} break;
-
-			// Date time picker
-			case Date_Time_Picker:
-			{
-				// Update control's date/time value
-				SYSTEMTIME timeTemp{};
-				((CDateTimeCtrl*)pBaseControl)->GetTime(&timeTemp);
-				pCurControl->SetTime(timeTemp);
-			} break;
-
-			// Month calendar control
-			case Month_Calendar_Control:
-			{
-				// Update control's current selected date
-				SYSTEMTIME dateTemp{};
-				((CMonthCalCtrl*)pBaseControl)->GetCurSel(&dateTemp);
-				pCurControl->SetTime(dateTemp);
-			} break;
-		}
+				arrTabTitles.push_back(tempText);
+			}
+			pCurControl->SetStringArray(arrTabTitles);
+		} break;
+
+		// Static text and decorating items
+		case Static_Text:
+		case Group_Box:
+		case SysLink_Control:
+		{
+			// Update control's text label
+			const int textLength = pBaseControl->GetWindowTextLength();
+			std::vector<wchar_t> tempBuff(textLength + 1);
+			pBaseControl->GetWindowText(tempBuff.data(), textLength + 1);
+			String captionString = tempBuff.data();
+			pCurControl->SetCaption(captionString);
+		} break;
+
+		// Scroll bars
+		case Horizontal_Scroll_Bar:
+		case Vertical_Scroll_Bar:
+		{
+			// Update control's current position
+			size_t nCurPos = ((CScrollBar*)pBaseControl)->GetScrollPos();
+			pCurControl->SetInteger(nCurPos);
+			// Update control's min/max range
+			int nMin = NULL, nMax = NULL;
+			((CScrollBar*)pBaseControl)->GetScrollRange(&nMin, &nMax);
+			pCurControl->SetMinMaxInt(nMin, nMax);
+		} break;
+
+		// Slider control
+		case Slider_Control:
+		{
+			// Update control's current position
+			size_t nCurPos = ((CSliderCtrl*)pBaseControl)->GetPos();
+			pCurControl->SetInteger(nCurPos);
+			// Update control's min/max range
+			size_t nMin = ((CSliderCtrl*)pBaseControl)->GetRangeMin();
+			size_t nMax = ((CSliderCtrl*)pBaseControl)->GetRangeMax();
+			pCurControl->SetMinMaxInt(nMin, nMax);
+		} break;
+
+		// Progress bar
+		case Progress_Control:
+		{
+			// Update control's current position
+			size_t nCurPos = ((CProgressCtrl*)pBaseControl)->GetPos();
+			pCurControl->SetInteger(nCurPos);
+			// Update control's min/max range
+			int nMin = NULL, nMax = NULL;
+			((CProgressCtrl*)pBaseControl)->GetRange(nMin, nMax);
+			pCurControl->SetMinMaxInt(nMin, nMax);
+		} break;
+
+		// Spin button control
+		case Spin_Control:
+		{
+			// Update control's current position
+			size_t nCurPos = ((CSpinButtonCtrl*)pBaseControl)->GetPos();
+			pCurControl->SetInteger(nCurPos);
+			// Update control's min/max range
+			int nMin = NULL, nMax = NULL;
+			((CSpinButtonCtrl*)pBaseControl)->GetRange(nMin, nMax);
+			pCurControl->SetMinMaxInt(nMin, nMax);
+		} break;
+
+		// Hot key control
+		case Hot_Key:
+		{
+			// Update control's current hotkey
+			DWORD dwHotkey = ((CHotKeyCtrl*)pBaseControl)->GetHotKey();
+			pCurControl->SetInteger(LOWORD(dwHotkey));			// Virtual keycode
+			pCurControl->SetReserveInteger(HIWORD(dwHotkey));	// Modifier flags
+		} break;
+
+		// IP address control
+		case IP_Address_Control:
+		{
+			// Update control's current IP address
+			DWORD dwAddress = 0;
+			byte byField0 = 0, byField1 = 0, byField2 = 0, byField3 = 0;
+			int nNonBlankFieldNum = ((CIPAddressCtrl*)pBaseControl)->GetAddress(dwAddress);
+			((CIPAddressCtrl*)pBaseControl)->GetAddress(byField0, byField1, byField2, byField3);
+			pCurControl->SetInteger(dwAddress);
+			pCurControl->SetReserveInteger(nNonBlankFieldNum);
+			// Store each field value separately into an integer array
+			ULongArray arrAddressFields;
+			arrAddressFields.resize(4);
+			arrAddressFields[0] = byField0;		// Field 0
+			arrAddressFields[1] = byField1;		// Field 1
+			arrAddressFields[2] = byField2;		// Field 2
+			arrAddressFields[3] = byField3;		// Field 3
+			pCurControl->SetIntArray(arrAddressFields);
+		} break;
+
+		// Network address control
+		case Network_Address_Control:
+		{
+			// Update control's current network address
+			NC_ADDRESS ncAddress;
+			NET_ADDRESS_INFO netAddressInfo;
+			ncAddress.pAddrInfo = &netAddressInfo;
+			HRESULT hRes = ((CNetAddressCtrl*)pBaseControl)->GetAddress(&ncAddress);
+			if (hRes == S_OK) {
+				// Save address and port info
+				String addressString = ncAddress.pAddrInfo->NamedAddress.Address;
+				String portString = ncAddress.pAddrInfo->NamedAddress.Port;
+				pCurControl->SetString(addressString);
+				pCurControl->SetReserveString(portString);
+				// Numeric data
+				pCurControl->SetInteger(ncAddress.PortNumber);
+				pCurControl->SetReserveInteger(ncAddress.PrefixLength);
+			}
+		} break;
+
+		// Date time picker
+		case Date_Time_Picker:
+		{
+			// Update control's date/time value
+			SYSTEMTIME timeTemp{};
+			((CDateTimeCtrl*)pBaseControl)->GetTime(&timeTemp);
+			pCurControl->SetTime(timeTemp);
+		} break;
+
+		// Month calendar control
+		case Month_Calendar_Control:
+		{
+			// Update control's current selected date
+			SYSTEMTIME dateTemp{};
+			((CMonthCalCtrl*)pBaseControl)->GetCurSel(&dateTemp);
+			pCurControl->SetTime(dateTemp);
+		} break;
 	}
 }
-
@@ -401,13 +401,19 @@ void SWinApp::InitAppEventLog(void)
 	// Set properties
 	m_pAppEventLog->Init();
 	m_pAppEventLog->SetWriteMode(WriteOnCall);
+
+	// Keep only recent events in memory during long sessions, older events are spilled to disk
+	m_pAppEventLog->EnableRingBuffer(4096, 1024);
+
+	// Build search index in background (for log viewer filtering)
+	m_pAppEventLog->StartIndexing();
 }
 
 /**
  * @brief	Output application event log
  * @param	usEvent		- Event ID
  * @param	description - Additional description
- * @param	pDetailInfo	- Log detail info (array pointer)
+ * @param	pDetailInfo	- Log detail info (array pointer, data is moved into the log item)
  * @return	None
  */
 void SWinApp::OutputEventLog(USHORT usEvent, const wchar_t* description /* = NULL */, LOGDETAILINFO* pDetailInfo /* = NULL */)
@@ -422,15 +428,13 @@ void SWinApp::OutputEventLog(USHORT usEvent, const wchar_t* description /* = NUL
 		logItemAppEvent.SetLogString(description);
 	}
 	if (pDetailInfo != NULL) {
-		// Include event detail info data
-		for (int nIndex = 0; nIndex < pDetailInfo->size(); nIndex++) {
-			logItemAppEvent.AddDetail(pDetailInfo->at(nIndex));
-		}
+		// Include event detail info data (moved into the log item)
+		logItemAppEvent.SetDetailInfo(std::move(*pDetailInfo));
 	}
 
 	// Output app event log
 	if (SLogging* ptrAppEventLog = GetAppEventLog()) {
-		ptrAppEventLog->OutputItem(logItemAppEvent);
+		ptrAppEventLog->OutputItem(std::move(logItemAppEvent));
 	}
 }
 
@@ -491,6 +495,17 @@ void SWinApp::SetFlagValue(AppFlagID eFlagID, int nValue)
 	}
 }
 
+/**
+ * @brief	Notify subscribers of application and global flag changes (in one batch)
+ * @param	None
+ * @return	None
+ */
+void SWinApp::DispatchFlagNotifications(void)
+{
+	m_flagManager.DispatchNotifications();
+	GetGlobalFlagManager().DispatchNotifications();
+}
+
 /**
  * @brief	Request current dialog to close
  * @param	nDialogID  - Dialog ID
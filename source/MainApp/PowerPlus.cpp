@@ -27,6 +27,20 @@ BEGIN_MESSAGE_MAP(CPowerPlusApp, SWinApp)
 END_MESSAGE_MAP()
 
 
+/**
+ * @brief	Get app data sections stored in app data snapshot file
+ * @param	None
+ * @return	const std::vector<std::wstring>&
+ */
+static const std::vector<std::wstring>& GetAppDataSnapshotSections(void)
+{
+	static const std::vector<std::wstring> arrSections = {
+		Section::ConfigData, Section::ScheduleData, Section::HotkeySetData, Section::PwrReminderData
+	};
+	return arrSections;
+}
+
+
 /**
  * @brief	Constructor
  */
@@ -41,6 +55,10 @@ CPowerPlusApp::CPowerPlusApp() : SWinApp()
 	m_phksHotkeySetData = NULL;
 	m_ppwrReminderData = NULL;
 
+	// Init app data settings store
+	m_pSettingsStore = NULL;
+	m_dwAppDataSerial = 0;
+
 	// Init logging pointers
 	m_pAppHistoryLog = NULL;
 
@@ -80,6 +98,12 @@ CPowerPlusApp::~CPowerPlusApp()
 		m_ppwrReminderData = NULL;
 	}
 
+	// Delete app data settings store
+	if (m_pSettingsStore != NULL) {
+		delete m_pSettingsStore;
+		m_pSettingsStore = NULL;
+	}
+
 	// Delete log data pointers
 	if (m_pAppHistoryLog != NULL) {
 		delete m_pAppHistoryLog;
@@ -207,6 +231,14 @@ BOOL CPowerPlusApp::InitInstance()
 		TRACE_DEBUG(__FUNCTION__, __FILENAME__, __LINE__);
 	}
 
+	// Trace changes of global trace flags (notified in batches from the main message loop)
+	for (AppFlagID eFlagID : { AppFlagID::pwrActionFlag, AppFlagID::systemSuspendFlag, AppFlagID::sessionEndFlag,
+							   AppFlagID::safeTerminationFlag, AppFlagID::sessionLockFlag }) {
+		GetGlobalFlagManager().Subscribe(eFlagID, [](AppFlagID eChangedFlagID, int nValue) {
+			TRACE_DEBUGINFO(L"Global trace flag changed (ID: {}, value: {})", static_cast<int>(eChangedFlagID), nValue);
+		});
+	}
+
 	// Initialize application language
 	SetAppLanguageOption(GetAppOption(AppOptionID::languageID));
 	if (!InitAppLanguage()) {
@@ -223,6 +255,7 @@ BOOL CPowerPlusApp::InitInstance()
 	// Initialize log objects
 	InitAppEventLog();
 	InitAppHistoryLog();
+	UpdateAppLogWriters();
 
 	// Output event log: InitInstance
 	OutputEventLog(LOG_EVENT_INIT_INSTANCE);
@@ -350,6 +383,13 @@ int CPowerPlusApp::ExitInstance()
 		GetAppHistoryLog()->Write();
 	}
 
+	// Stop background log writers
+	GetAppEventLog()->StopWriter();
+	GetAppHistoryLog()->StopWriter();
+
+	// Write buffered trace/debug log strings
+	DebugLogging::GetDebugLogger().FlushLogFiles();
+
 	// Close DebugTest dialog
 	DestroyDebugTestDlg();
 
@@ -595,6 +635,10 @@ bool CPowerPlusApp::InitAppData()
 	if (m_ppwrReminderData == NULL) {
 		m_ppwrReminderData = new PwrReminderData;
 	}
+	// Initialize app data settings store
+	if (m_pSettingsStore == NULL) {
+		m_pSettingsStore = new SettingsStore(std::make_unique<RegistrySettingsBackend>());
+	}
 
 	// Check data validity
 	bool bResult = true;
@@ -647,6 +691,16 @@ bool CPowerPlusApp::LoadRegistryAppData()
 	if (!DataSerializeCheck(Mode::Load))
 		return false;
 
+	// Load app data snapshot file (all data sets with one file read)
+	// If it is not available or outdated, data is read from registry keys
+	PerformanceCounter counter;
+	counter.Start();
+	SettingsStore::Snapshot snapshotData;
+	bool bSnapshotLoaded = LoadAppDataSnapshot(snapshotData);
+	if (bSnapshotLoaded == true) {
+		SetReadSnapshot(&snapshotData);
+	}
+
 	// Create temporary data
 	ConfigData* pcfgTempData = new ConfigData;
 	ScheduleData* pschTempData = new ScheduleData;
@@ -1127,6 +1181,22 @@ bool CPowerPlusApp::LoadRegistryAppData()
 		ppwrTempData = NULL;
 	}
 
+	// Reset reading from snapshot
+	SetReadSnapshot(NULL);
+	counter.Stop();
+	TRACE_INFO(L"App data loaded from {} in {:.3f} ms", bSnapshotLoaded ? L"snapshot file" : L"registry", counter.GetElapsedTime(true));
+
+	// Migrate data loaded from registry to snapshot file
+	if ((bSnapshotLoaded == false) && (bFinalResult == true) && (m_pSettingsStore != NULL)) {
+		SettingsStore::Snapshot serialData;
+		DWORD dwNewSerial = (m_dwAppDataSerial % INT_MAX) + 1;
+		SetDataSnapshotSerial(serialData, Key::AppDataSnapshot::Serial, dwNewSerial);
+		if (m_pSettingsStore->Commit(serialData, { Section::AppDataSnapshot })) {
+			m_dwAppDataSerial = dwNewSerial;
+			SaveAppDataSnapshot();
+		}
+	}
+
 	/***********************************************************************************************/
 	/*																							   */
 	/*										Load other data										   */
@@ -1155,6 +1225,10 @@ bool CPowerPlusApp::SaveRegistryAppData(DWORD dwDataType /* = APPDATA_ALL */)
 	if (!DataSerializeCheck(Mode::Save, dwDataType))
 		return false;
 
+	// Settings snapshot of new data
+	// (only changed keys are written to registry when committing)
+	SettingsStore::Snapshot settingsData;
+
 	/***********************************************************************************************/
 	/*																							   */
 	/*									Save configuration info									   */
@@ -1164,9 +1238,6 @@ bool CPowerPlusApp::SaveRegistryAppData(DWORD dwDataType /* = APPDATA_ALL */)
 	// Save configuration data
 	if ((dwDataType & APPDATA_CONFIG) != 0) {
 
-		// Delete old data before writing
-		DeleteConfigSection();
-
 		// Get a copy of config data
 		ConfigData cfgConfigTemp{};
 		if (m_pcfgAppConfig != NULL) {
@@ -1174,31 +1245,23 @@ bool CPowerPlusApp::SaveRegistryAppData(DWORD dwDataType /* = APPDATA_ALL */)
 		}
 
 		// Save registry data
-		bResult &= WriteConfig(Key::ConfigData::LMBAction,				cfgConfigTemp.nLMBAction);
-		bResult &= WriteConfig(Key::ConfigData::MMBAction,				cfgConfigTemp.nMMBAction);
-		bResult &= WriteConfig(Key::ConfigData::RMBAction,				cfgConfigTemp.nRMBAction);
-		bResult &= WriteConfig(Key::ConfigData::RMBShowMenu,			cfgConfigTemp.bRMBShowMenu);
-		bResult &= WriteConfig(Key::ConfigData::LanguageID,				cfgConfigTemp.nLanguageID);
-		bResult &= WriteConfig(Key::ConfigData::ShowDlgAtStartup,		cfgConfigTemp.bShowDlgAtStartup);
-		bResult &= WriteConfig(Key::ConfigData::StartupEnabled,			cfgConfigTemp.bStartupEnabled);
-		bResult &= WriteConfig(Key::ConfigData::ConfirmAction,			cfgConfigTemp.bConfirmAction);
-		bResult &= WriteConfig(Key::ConfigData::SaveHistoryLog,			cfgConfigTemp.bSaveHistoryLog);
-		bResult &= WriteConfig(Key::ConfigData::SaveAppEventLog,		cfgConfigTemp.bSaveAppEventLog);
-		bResult &= WriteConfig(Key::ConfigData::RunAsAdmin,				cfgConfigTemp.bRunAsAdmin);
-		bResult &= WriteConfig(Key::ConfigData::ShowErrorMsg,			cfgConfigTemp.bShowErrorMsg);
-		bResult &= WriteConfig(Key::ConfigData::NotifySchedule,			cfgConfigTemp.bNotifySchedule);
-		bResult &= WriteConfig(Key::ConfigData::AllowCancelSchedule,	cfgConfigTemp.bAllowCancelSchedule);
-		bResult &= WriteConfig(Key::ConfigData::EnableBackgroundHotkey,	cfgConfigTemp.bEnableBackgroundHotkey);
-		bResult &= WriteConfig(Key::ConfigData::LockStateHotkey,		cfgConfigTemp.bLockStateHotkey);
-		bResult &= WriteConfig(Key::ConfigData::EnablePowerReminder,	cfgConfigTemp.bEnablePowerReminder);
-
-		// Trace error
-		if (bResult == false) {
-			wSaveRet = APP_ERROR_SAVE_CFG_FAILED;
-			TraceSerializeData(wSaveRet);
-			bFinalResult = false; // Set final result
-			bResult = true; // Reset flag
-		}
+		SetConfig(settingsData, Key::ConfigData::LMBAction,					cfgConfigTemp.nLMBAction);
+		SetConfig(settingsData, Key::ConfigData::MMBAction,					cfgConfigTemp.nMMBAction);
+		SetConfig(settingsData, Key::ConfigData::RMBAction,					cfgConfigTemp.nRMBAction);
+		SetConfig(settingsData, Key::ConfigData::RMBShowMenu,				cfgConfigTemp.bRMBShowMenu);
+		SetConfig(settingsData, Key::ConfigData::LanguageID,				cfgConfigTemp.nLanguageID);
+		SetConfig(settingsData, Key::ConfigData::ShowDlgAtStartup,			cfgConfigTemp.bShowDlgAtStartup);
+		SetConfig(settingsData, Key::ConfigData::StartupEnabled,			cfgConfigTemp.bStartupEnabled);
+		SetConfig(settingsData, Key::ConfigData::ConfirmAction,				cfgConfigTemp.bConfirmAction);
+		SetConfig(settingsData, Key::ConfigData::SaveHistoryLog,			cfgConfigTemp.bSaveHistoryLog);
+		SetConfig(settingsData, Key::ConfigData::SaveAppEventLog,			cfgConfigTemp.bSaveAppEventLog);
+		SetConfig(settingsData, Key::ConfigData::RunAsAdmin,				cfgConfigTemp.bRunAsAdmin);
+		SetConfig(settingsData, Key::ConfigData::ShowErrorMsg,				cfgConfigTemp.bShowErrorMsg);
+		SetConfig(settingsData, Key::ConfigData::NotifySchedule,			cfgConfigTemp.bNotifySchedule);
+		SetConfig(settingsData, Key::ConfigData::AllowCancelSchedule,		cfgConfigTemp.bAllowCancelSchedule);
+		SetConfig(settingsData, Key::ConfigData::EnableBackgroundHotkey,	cfgConfigTemp.bEnableBackgroundHotkey);
+		SetConfig(settingsData, Key::ConfigData::LockStateHotkey,			cfgConfigTemp.bLockStateHotkey);
+		SetConfig(settingsData, Key::ConfigData::EnablePowerReminder,		cfgConfigTemp.bEnablePowerReminder);
 	}
 
 	/***********************************************************************************************/
@@ -1210,9 +1273,6 @@ bool CPowerPlusApp::SaveRegistryAppData(DWORD dwDataType /* = APPDATA_ALL */)
 	// Save schedule data
 	if ((dwDataType & APPDATA_SCHEDULE) != 0) {
 
-		// Delete old data before writing
-		DeleteScheduleSection();
-
 		// Save default schedule item
 		ScheduleItem schTempDefault = m_pschScheduleData->GetDefaultItem();
 		{
@@ -1220,24 +1280,16 @@ bool CPowerPlusApp::SaveRegistryAppData(DWORD dwDataType /* = APPDATA_ALL */)
 			nTimeTemp = FORMAT_REG_TIME(schTempDefault.GetTime());
 
 			// Save registry data
-			bResult &= WriteDefaultSchedule(Key::ScheduleItem::IsEnabled,		schTempDefault.IsEnabled());
-			bResult &= WriteDefaultSchedule(Key::ScheduleItem::ActionID,		schTempDefault.GetAction());
-			bResult &= WriteDefaultSchedule(Key::PwrRepeatSet::IsRepeated,		schTempDefault.IsRepeatEnabled());
-			bResult &= WriteDefaultSchedule(Key::PwrRepeatSet::RepeatDays,		schTempDefault.GetActiveDays());
-			bResult &= WriteDefaultSchedule(Key::ScheduleItem::Time,			nTimeTemp);
-
-			// Trace error
-			if (bResult == false) {
-				wSaveRet = APP_ERROR_SAVE_SCHED_FAILED;
-				TraceSerializeData(wSaveRet);
-				bFinalResult = false; // Set final result
-				bResult = true; // Reset flag
-			}
+			SetDefaultSchedule(settingsData, Key::ScheduleItem::IsEnabled,	schTempDefault.IsEnabled());
+			SetDefaultSchedule(settingsData, Key::ScheduleItem::ActionID,	schTempDefault.GetAction());
+			SetDefaultSchedule(settingsData, Key::PwrRepeatSet::IsRepeated,	schTempDefault.IsRepeatEnabled());
+			SetDefaultSchedule(settingsData, Key::PwrRepeatSet::RepeatDays,	schTempDefault.GetActiveDays());
+			SetDefaultSchedule(settingsData, Key::ScheduleItem::Time,		nTimeTemp);
 		}
 
 		// Save schedule extra data
 		int nExtraItemNum = m_pschScheduleData->GetExtraItemNum();
-		bResult &= WriteScheduleExtraItemNum(Key::ScheduleData::ExtraItemNum, nExtraItemNum);
+		SetScheduleExtraItemNum(settingsData, Key::ScheduleData::ExtraItemNum, nExtraItemNum);
 		for (int nExtraIndex = 0; nExtraIndex < nExtraItemNum; nExtraIndex++) {
 
 			// Get schedule extra item
@@ -1247,20 +1299,12 @@ bool CPowerPlusApp::SaveRegistryAppData(DWORD dwDataType /* = APPDATA_ALL */)
 			nTimeTemp = FORMAT_REG_TIME(schTempExtra.GetTime());
 
 			// Save registry data
-			bResult &= WriteScheduleExtra(nExtraIndex, Key::ScheduleItem::IsEnabled,	schTempExtra.IsEnabled());
-			bResult &= WriteScheduleExtra(nExtraIndex, Key::ScheduleItem::ItemID,		schTempExtra.GetItemID());
-			bResult &= WriteScheduleExtra(nExtraIndex, Key::ScheduleItem::ActionID,		schTempExtra.GetAction());
-			bResult &= WriteScheduleExtra(nExtraIndex, Key::PwrRepeatSet::IsRepeated,	schTempExtra.IsRepeatEnabled());
-			bResult &= WriteScheduleExtra(nExtraIndex, Key::PwrRepeatSet::RepeatDays,	schTempExtra.GetActiveDays());
-			bResult &= WriteScheduleExtra(nExtraIndex, Key::ScheduleItem::Time,			nTimeTemp);
-
-			// Trace error
-			if (bResult == false) {
-				wSaveRet = APP_ERROR_SAVE_SCHED_FAILED;
-				TraceSerializeData(wSaveRet);
-				bFinalResult = false; // Set final result
-				bResult = true; // Reset flag
-			}
+			SetScheduleExtra(settingsData, nExtraIndex, Key::ScheduleItem::IsEnabled,	schTempExtra.IsEnabled());
+			SetScheduleExtra(settingsData, nExtraIndex, Key::ScheduleItem::ItemID,		schTempExtra.GetItemID());
+			SetScheduleExtra(settingsData, nExtraIndex, Key::ScheduleItem::ActionID,	schTempExtra.GetAction());
+			SetScheduleExtra(settingsData, nExtraIndex, Key::PwrRepeatSet::IsRepeated,	schTempExtra.IsRepeatEnabled());
+			SetScheduleExtra(settingsData, nExtraIndex, Key::PwrRepeatSet::RepeatDays,	schTempExtra.GetActiveDays());
+			SetScheduleExtra(settingsData, nExtraIndex, Key::ScheduleItem::Time,		nTimeTemp);
 		}
 	}
 
@@ -1296,12 +1340,9 @@ bool CPowerPlusApp::SaveRegistryAppData(DWORD dwDataType /* = APPDATA_ALL */)
 	// Save HotkeySet data
 	if ((dwDataType & APPDATA_HOTKEYSET) != 0) {
 
-		// Delete old data before writing
-		DeleteHotkeySetSection();
-
 		// Save registry data
 		int nItemNum = m_phksHotkeySetData->GetItemNum();
-		bResult &= WriteHotkeyItemNum(Key::HotkeySetData::ItemNum, nItemNum);
+		SetHotkeyItemNum(settingsData, Key::HotkeySetData::ItemNum, nItemNum);
 		for (int nIndex = 0; nIndex < nItemNum; nIndex++) {
 
 			// Get HotkeySet item
@@ -1312,18 +1353,10 @@ bool CPowerPlusApp::SaveRegistryAppData(DWORD dwDataType /* = APPDATA_ALL */)
 			hksTemp.GetKeyCode(dwModifiersTemp, dwVirtKeyTemp);
 
 			// Write item data
-			bResult &= WriteHotkeySet(nIndex, Key::HotkeySetItem::IsEnabled,	hksTemp.IsEnabled());
-			bResult &= WriteHotkeySet(nIndex, Key::HotkeySetItem::HKActionID,	hksTemp.GetActionID());
-			bResult &= WriteHotkeySet(nIndex, Key::HotkeySetItem::Modifiers,	dwModifiersTemp);
-			bResult &= WriteHotkeySet(nIndex, Key::HotkeySetItem::VirtualKey,	dwVirtKeyTemp);
-		}
-
-		// Trace error
-		if (bResult == false) {
-			wSaveRet = APP_ERROR_SAVE_HKEYSET_FAILED;
-			TraceSerializeData(wSaveRet);
-			bFinalResult = false; // Set final result
-			bResult = true; // Reset flag
+			SetHotkeySet(settingsData, nIndex, Key::HotkeySetItem::IsEnabled,	hksTemp.IsEnabled());
+			SetHotkeySet(settingsData, nIndex, Key::HotkeySetItem::HKActionID,	hksTemp.GetActionID());
+			SetHotkeySet(settingsData, nIndex, Key::HotkeySetItem::Modifiers,	dwModifiersTemp);
+			SetHotkeySet(settingsData, nIndex, Key::HotkeySetItem::VirtualKey,	dwVirtKeyTemp);
 		}
 	}
 
@@ -1336,37 +1369,26 @@ bool CPowerPlusApp::SaveRegistryAppData(DWORD dwDataType /* = APPDATA_ALL */)
 	// Save Power Reminder data
 	if ((dwDataType & APPDATA_PWRREMINDER) != 0) {
 
-		// Delete old data before writing
-		DeletePwrReminderSection();
-
 		// Save Power Reminder common style data
 		RmdMsgStyleSet& rmdTempCommonStyle = m_ppwrReminderData->GetCommonStyle();
 		{
 			// Save registry data
-			bResult &= WritePwrReminderCommonStyle(Key::PwrReminderMsgStyle::BkgrdColor,		rmdTempCommonStyle.GetBkgrdColor());
-			bResult &= WritePwrReminderCommonStyle(Key::PwrReminderMsgStyle::TextColor,			rmdTempCommonStyle.GetTextColor());
-			bResult &= WritePwrReminderCommonStyle(Key::PwrReminderMsgStyle::FontName,			rmdTempCommonStyle.GetFontName());
-			bResult &= WritePwrReminderCommonStyle(Key::PwrReminderMsgStyle::FontSize,			rmdTempCommonStyle.GetFontSize());
-			bResult &= WritePwrReminderCommonStyle(Key::PwrReminderMsgStyle::Timeout,			rmdTempCommonStyle.GetTimeout());
-			bResult &= WritePwrReminderCommonStyle(Key::PwrReminderMsgStyle::IconID,			rmdTempCommonStyle.GetIconID());
-			bResult &= WritePwrReminderCommonStyle(Key::PwrReminderMsgStyle::IconSize,	 		rmdTempCommonStyle.GetIconSize());
-			bResult &= WritePwrReminderCommonStyle(Key::PwrReminderMsgStyle::IconPosition,		rmdTempCommonStyle.GetIconPosition());
-			bResult &= WritePwrReminderCommonStyle(Key::PwrReminderMsgStyle::DisplayPosition,	rmdTempCommonStyle.GetDisplayPosition());
-			bResult &= WritePwrReminderCommonStyle(Key::PwrReminderMsgStyle::HorizontalMargin,	rmdTempCommonStyle.GetHorizontalMargin());
-			bResult &= WritePwrReminderCommonStyle(Key::PwrReminderMsgStyle::VerticalMargin,	rmdTempCommonStyle.GetVerticalMargin());
-
-			// Trace error
-			if (bResult == false) {
-				wSaveRet = APP_ERROR_SAVE_PWRRMD_FAILED;
-				TraceSerializeData(wSaveRet);
-				bFinalResult = false; // Set final result
-				bResult = true; // Reset flag
-			}
+			SetPwrReminderCommonStyle(settingsData, Key::PwrReminderMsgStyle::BkgrdColor,		rmdTempCommonStyle.GetBkgrdColor());
+			SetPwrReminderCommonStyle(settingsData, Key::PwrReminderMsgStyle::TextColor,		rmdTempCommonStyle.GetTextColor());
+			SetPwrReminderCommonStyle(settingsData, Key::PwrReminderMsgStyle::FontName,			rmdTempCommonStyle.GetFontName());
+			SetPwrReminderCommonStyle(settingsData, Key::PwrReminderMsgStyle::FontSize,			rmdTempCommonStyle.GetFontSize());
+			SetPwrReminderCommonStyle(settingsData, Key::PwrReminderMsgStyle::Timeout,			rmdTempCommonStyle.GetTimeout());
+			SetPwrReminderCommonStyle(settingsData, Key::PwrReminderMsgStyle::IconID,			rmdTempCommonStyle.GetIconID());
+			SetPwrReminderCommonStyle(settingsData, Key::PwrReminderMsgStyle::IconSize,			rmdTempCommonStyle.GetIconSize());
+			SetPwrReminderCommonStyle(settingsData, Key::PwrReminderMsgStyle::IconPosition,		rmdTempCommonStyle.GetIconPosition());
+			SetPwrReminderCommonStyle(settingsData, Key::PwrReminderMsgStyle::DisplayPosition,	rmdTempCommonStyle.GetDisplayPosition());
+			SetPwrReminderCommonStyle(settingsData, Key::PwrReminderMsgStyle::HorizontalMargin,	rmdTempCommonStyle.GetHorizontalMargin());
+			SetPwrReminderCommonStyle(settingsData, Key::PwrReminderMsgStyle::VerticalMargin,	rmdTempCommonStyle.GetVerticalMargin());
 		}
 
 		// Save registry data
 		int nItemNum = m_ppwrReminderData->GetItemNum();
-		bResult &= WritePwrReminderItemNum(Key::PwrReminderData::ItemNum, nItemNum);
+		SetPwrReminderItemNum(settingsData, Key::PwrReminderData::ItemNum, nItemNum);
 		for (int nIndex = 0; nIndex < nItemNum; nIndex++) {
 
 			// Get Power Reminder item
@@ -1376,30 +1398,115 @@ bool CPowerPlusApp::SaveRegistryAppData(DWORD dwDataType /* = APPDATA_ALL */)
 			nTimeTemp = FORMAT_REG_TIME(pwrTemp.GetTime());
 
 			// Write item data
-			bResult &= WritePwrReminder(nIndex, Key::PwrReminderItem::ItemID,		pwrTemp.GetItemID());
-			bResult &= WritePwrReminder(nIndex, Key::PwrReminderItem::IsEnabled,	pwrTemp.IsEnabled());
-			bResult &= WritePwrReminder(nIndex, Key::PwrReminderItem::Message,		pwrTemp.GetMessage());
-			bResult &= WritePwrReminder(nIndex, Key::PwrReminderItem::EventID,		pwrTemp.GetEventID());
-			bResult &= WritePwrReminder(nIndex, Key::PwrReminderItem::Time,			nTimeTemp);
-			bResult &= WritePwrReminder(nIndex, Key::PwrReminderItem::MsgStyle,		pwrTemp.GetMessageStyle());
-			bResult &= WritePwrReminder(nIndex, Key::PwrRepeatSet::IsRepeated,		pwrTemp.IsRepeatEnabled());
-			bResult &= WritePwrReminder(nIndex, Key::PwrRepeatSet::AllowSnooze,		pwrTemp.IsAllowSnoozing());
-			bResult &= WritePwrReminder(nIndex, Key::PwrRepeatSet::SnoozeInterval,	pwrTemp.GetSnoozeInterval());
-			bResult &= WritePwrReminder(nIndex, Key::PwrRepeatSet::RepeatDays,		pwrTemp.GetActiveDays());
+			SetPwrReminder(settingsData, nIndex, Key::PwrReminderItem::ItemID,		pwrTemp.GetItemID());
+			SetPwrReminder(settingsData, nIndex, Key::PwrReminderItem::IsEnabled,	pwrTemp.IsEnabled());
+			SetPwrReminder(settingsData, nIndex, Key::PwrReminderItem::Message,		pwrTemp.GetMessage());
+			SetPwrReminder(settingsData, nIndex, Key::PwrReminderItem::EventID,		pwrTemp.GetEventID());
+			SetPwrReminder(settingsData, nIndex, Key::PwrReminderItem::Time,		nTimeTemp);
+			SetPwrReminder(settingsData, nIndex, Key::PwrReminderItem::MsgStyle,	pwrTemp.GetMessageStyle());
+			SetPwrReminder(settingsData, nIndex, Key::PwrRepeatSet::IsRepeated,		pwrTemp.IsRepeatEnabled());
+			SetPwrReminder(settingsData, nIndex, Key::PwrRepeatSet::AllowSnooze,	pwrTemp.IsAllowSnoozing());
+			SetPwrReminder(settingsData, nIndex, Key::PwrRepeatSet::SnoozeInterval,	pwrTemp.GetSnoozeInterval());
+			SetPwrReminder(settingsData, nIndex, Key::PwrRepeatSet::RepeatDays,		pwrTemp.GetActiveDays());
 		}
+	}
 
-		// Trace error
-		if (bResult == false) {
-			wSaveRet = APP_ERROR_SAVE_PWRRMD_FAILED;
-			TraceSerializeData(wSaveRet);
-			bFinalResult = false; // Set final result
-			bResult = true; // Reset flag
-		}
+	/***********************************************************************************************/
+	/*																							   */
+	/*									Commit data to registry									   */
+	/*																							   */
+	/***********************************************************************************************/
+
+	// Get saved data sections
+	std::vector<std::wstring> arrSavedSections;
+	if ((dwDataType & APPDATA_CONFIG) != 0)			arrSavedSections.push_back(Section::ConfigData);
+	if ((dwDataType & APPDATA_SCHEDULE) != 0)		arrSavedSections.push_back(Section::ScheduleData);
+	if ((dwDataType & APPDATA_HOTKEYSET) != 0)		arrSavedSections.push_back(Section::HotkeySetData);
+	if ((dwDataType & APPDATA_PWRREMINDER) != 0)	arrSavedSections.push_back(Section::PwrReminderData);
+
+	// Update snapshot serial number together with data
+	// (snapshot file written before this commit will no longer be used)
+	DWORD dwNewSerial = (m_dwAppDataSerial % INT_MAX) + 1;
+	SetDataSnapshotSerial(settingsData, Key::AppDataSnapshot::Serial, dwNewSerial);
+	arrSavedSections.push_back(Section::AppDataSnapshot);
+
+	// Write changed keys of all saved sections in one transaction
+	// (if committing failed, registry data is kept unchanged)
+	if (m_pSettingsStore != NULL) {
+		bResult = m_pSettingsStore->Commit(settingsData, arrSavedSections);
+		TRACE_DEBUGINFO(L"Save app data: {} values written, {} values deleted",
+						m_pSettingsStore->GetLastWriteCount(), m_pSettingsStore->GetLastDeleteCount());
+	}
+	else {
+		bResult = false;
+	}
+
+	// Update app data snapshot file
+	if (bResult == true) {
+		m_dwAppDataSerial = dwNewSerial;
+		SaveAppDataSnapshot();
+	}
+
+	// Trace error
+	if (bResult == false) {
+		if ((dwDataType & APPDATA_CONFIG) != 0)			TraceSerializeData(APP_ERROR_SAVE_CFG_FAILED);
+		if ((dwDataType & APPDATA_SCHEDULE) != 0)		TraceSerializeData(APP_ERROR_SAVE_SCHED_FAILED);
+		if ((dwDataType & APPDATA_HOTKEYSET) != 0)		TraceSerializeData(APP_ERROR_SAVE_HKEYSET_FAILED);
+		if ((dwDataType & APPDATA_PWRREMINDER) != 0)	TraceSerializeData(APP_ERROR_SAVE_PWRRMD_FAILED);
+		bFinalResult = false; // Set final result
+		bResult = true; // Reset flag
 	}
 
 	return bFinalResult;
 }
 
+/**
+ * @brief	Load app data snapshot file
+ * @param	snapshotData - Snapshot data (out)
+ * @return	bool - Snapshot file is valid and matches registry data or not
+ */
+bool CPowerPlusApp::LoadAppDataSnapshot(SettingsStore::Snapshot& snapshotData)
+{
+	// Get snapshot serial number saved with registry data
+	int nSerial = 0;
+	if (!GetDataSnapshotSerial(Key::AppDataSnapshot::Serial, nSerial))
+		return false;
+	m_dwAppDataSerial = static_cast<DWORD>(nSerial);
+
+	// Read snapshot file
+	if (!DataSnapshot::Read(m_dwAppDataSerial, snapshotData))
+		return false;
+
+	// Snapshot data is the same as registry data,
+	// use it as last persisted data so that saving does not need to read registry
+	if (m_pSettingsStore != NULL) {
+		SettingsStore::Snapshot serialData;
+		SetDataSnapshotSerial(serialData, Key::AppDataSnapshot::Serial, nSerial);
+		m_pSettingsStore->SetPersistedData(snapshotData, GetAppDataSnapshotSections());
+		m_pSettingsStore->SetPersistedData(serialData, { Section::AppDataSnapshot });
+	}
+
+	return true;
+}
+
+/**
+ * @brief	Save app data snapshot file (data as last persisted in registry)
+ * @param	None
+ * @return	bool - Result of saving process
+ */
+bool CPowerPlusApp::SaveAppDataSnapshot(void)
+{
+	if (m_pSettingsStore == NULL)
+		return false;
+
+	// Get persisted data of all app data sections
+	SettingsStore::Snapshot snapshotData;
+	if (!m_pSettingsStore->GetPersistedData(GetAppDataSnapshotSections(), snapshotData))
+		return false;
+
+	return DataSnapshot::Write(snapshotData, m_dwAppDataSerial);
+}
+
 /**
  * @brief	Backup app data to file
  * @param	None
@@ -1445,11 +1552,12 @@ bool CPowerPlusApp::UpdateAppLaunchTimeProfileInfo(void)
 
 	// Format launch-time
 	DateTime dateTimeAppLaunch = GetAppLaunchTime();
-	unsigned nTimePeriod = (dateTimeAppLaunch.Hour() < 12) ? FORMAT_TIMEPERIOD_ANTE_MERIDIEM : FORMAT_TIMEPERIOD_POST_MERIDIEM;
+	const DateTime::Fields timeFields = dateTimeAppLaunch.Decompose();
+	unsigned nTimePeriod = (timeFields.hour < 12) ? FORMAT_TIMEPERIOD_ANTE_MERIDIEM : FORMAT_TIMEPERIOD_POST_MERIDIEM;
 	const wchar_t* timePeriodFormat = GetLanguageString(LoadLanguageTable(NULL), nTimePeriod);
 	const wchar_t* timeFormatString = StringUtils::LoadResourceString(IDS_FORMAT_FULLDATETIME);
-	strValue = StringUtils::StringFormat(timeFormatString, dateTimeAppLaunch.Year(), dateTimeAppLaunch.Month(), dateTimeAppLaunch.Day(),
-		dateTimeAppLaunch.Hour(), dateTimeAppLaunch.Minute(), dateTimeAppLaunch.Second(), dateTimeAppLaunch.Millisecond(), timePeriodFormat);
+	strValue = StringUtils::StringFormat(timeFormatString, timeFields.year, timeFields.month, timeFields.day,
+		timeFields.hour, timeFields.minute, timeFields.second, timeFields.millisecond, timePeriodFormat);
 
 	// Store launch-time info data
 	if (!WriteProfileInfo(AppProfile::LaunchInfo::LaunchTime, strValue)) {
@@ -1719,6 +1827,9 @@ void CPowerPlusApp::SetAppConfigData(ConfigData* pcfgData)
 
 	// Copy value of data pointer
 	GetAppConfigData()->Copy(*pcfgData);
+
+	// Logging options might be changed
+	UpdateAppLogWriters();
 }
 
 /**
@@ -1885,6 +1996,30 @@ SLogging* CPowerPlusApp::GetAppHistoryLog()
 	return m_pAppHistoryLog;
 }
 
+/**
+ * @brief	Start/stop background log writers according to logging options
+ * @param	None
+ * @return	None
+ */
+void CPowerPlusApp::UpdateAppLogWriters()
+{
+	// App event log
+	if (SLogging* ptrAppEventLog = GetAppEventLog()) {
+		if (GetAppOption(AppOptionID::saveAppEventLog) == true)
+			ptrAppEventLog->StartWriter();
+		else
+			ptrAppEventLog->StopWriter();
+	}
+
+	// Action history log
+	if (SLogging* ptrAppHistoryLog = GetAppHistoryLog()) {
+		if (GetAppOption(AppOptionID::saveAppHistoryLog) == true)
+			ptrAppHistoryLog->StartWriter();
+		else
+			ptrAppHistoryLog->StopWriter();
+	}
+}
+
 /**
  * @brief	Output a log item to action history log
  * @param	logItem - Log item data
@@ -1897,7 +2032,7 @@ void CPowerPlusApp::OutputAppHistoryLog(LOGITEM logItem)
 	
 	// Only output log if option is ON
 	if ((ptrAppHistoryLog != NULL) && (GetAppOption(AppOptionID::saveAppHistoryLog) != false)) {
-		ptrAppHistoryLog->OutputItem(logItem);
+		ptrAppHistoryLog->OutputItem(std::move(logItem));
 	}
 }
 
@@ -2375,11 +2510,12 @@ bool CPowerPlusApp::SaveLastSysEventTime(BYTE byEventType, const DateTime& timeS
 	}
 
 	// Format date/time
-	unsigned nTimePeriod = (timeSysEvent.Hour() < 12) ? FORMAT_TIMEPERIOD_ANTE_MERIDIEM : FORMAT_TIMEPERIOD_POST_MERIDIEM;
+	const DateTime::Fields timeFields = timeSysEvent.Decompose();
+	unsigned nTimePeriod = (timeFields.hour < 12) ? FORMAT_TIMEPERIOD_ANTE_MERIDIEM : FORMAT_TIMEPERIOD_POST_MERIDIEM;
 	const wchar_t* timePeriodFormat = GetLanguageString(GetAppLanguage(), nTimePeriod);
 	const wchar_t* timeFormatString = StringUtils::LoadResourceString(IDS_FORMAT_FULLDATETIME);
-	String dateTimeFormat = StringUtils::StringFormat(timeFormatString, timeSysEvent.Year(), timeSysEvent.Month(), timeSysEvent.Day(),
-		timeSysEvent.Hour(), timeSysEvent.Minute(), timeSysEvent.Second(), timeSysEvent.Millisecond(), timePeriodFormat);
+	String dateTimeFormat = StringUtils::StringFormat(timeFormatString, timeFields.year, timeFields.month, timeFields.day,
+		timeFields.hour, timeFields.minute, timeFields.second, timeFields.millisecond, timePeriodFormat);
 
 	// Save registry data
 	if (!WriteSysEventTracking(keyName, dateTimeFormat)) {
@@ -40,7 +40,8 @@ IMPLEMENT_DYNAMIC(CPowerPlusDlg, SDialog)
  * @brief	Constructor
  */
 CPowerPlusDlg::CPowerPlusDlg(CWnd* pParent /*=NULL*/)
-	: SDialog(IDD_POWERPLUS_DIALOG, pParent)
+	: SDialog(IDD_POWERPLUS_DIALOG, pParent),
+	m_schScheduleEngine([]() { return DateTimeUtils::GetCurrentDateTime().GetTimePoint(); })
 {
 	// Initialize member variables
 	m_hDefaultIcon = NULL;
@@ -155,6 +156,8 @@ CPowerPlusDlg::~CPowerPlusDlg()
 	KillTimer(TIMERID_STD_ACTIONSCHEDULE);
 	KillTimer(TIMERID_STD_POWERREMINDER);
 	KillTimer(TIMERID_STD_EVENTSKIPCOUNTER);
+	DebugLogging::GetDebugLogger().SetFlushNotifyWnd(NULL);
+	KillTimer(TIMERID_STD_DEBUGLOGFLUSH);
 
 	// Unregister for session state change notifications
 	RegisterSessionNotification(Mode::Disable);
@@ -264,10 +267,7 @@ void CPowerPlusDlg::UpdateDialogManagement(void)
 	pCtrlMan->SetBuddy(IDC_RMBACTION_LIST, IDC_RIGHTMOUSE_TITLE);
 	pCtrlMan->SetBuddy(IDC_LANGUAGE_LIST, IDC_LANGUAGE_TITLE);
 
-	// Update control data
-	pCtrlMan->UpdateData(NULL);
-
-	// Default
+	// Default (update control data)
 	SDialog::UpdateDialogManagement();
 }
 
@@ -421,6 +421,7 @@ BEGIN_MESSAGE_MAP(CPowerPlusDlg, SDialog)
 	ON_MESSAGE(SM_APP_DEBUG_COMMAND,			&CPowerPlusDlg::OnProcessDebugCommand)
 	ON_MESSAGE(SM_WND_SHOWDIALOG,				&CPowerPlusDlg::OnShowDialog)
 	ON_MESSAGE(SM_APP_ERROR_MESSAGE,			&CPowerPlusDlg::OnShowErrorMessage)
+	ON_MESSAGE(SM_APP_DEBUGLOG_BUFFERED,		&CPowerPlusDlg::OnDebugLogBuffered)
 	ON_COMMAND_RANGE(IDC_SHOWATSTARTUP_CHK, IDC_ENBPWRREMINDER_CHK, &CPowerPlusDlg::OnCheckboxClicked)
 	ON_WM_KEYDOWN()
 	ON_WM_CLOSE()
@@ -486,10 +487,13 @@ BOOL CPowerPlusDlg::OnInitDialog()
 	SetUseEnter(false);
 
 	// Set app features standard timers
-	SetTimer(TIMERID_STD_ACTIONSCHEDULE, 1000, NULL);
+	// Notes: Action Schedule timer will be armed by the schedule engine
 	SetTimer(TIMERID_STD_POWERREMINDER, 1000, NULL);
 	SetTimer(TIMERID_STD_EVENTSKIPCOUNTER, 1000, NULL);
 
+	// Debug log flush timer will be armed only while log strings are buffered
+	DebugLogging::GetDebugLogger().SetFlushNotifyWnd(this->GetSafeHwnd());
+
 	// Save dialog event log if enabled
 	OutputEventLog(LOG_EVENT_DLG_INIT, this->GetCaption());
 
@@ -527,6 +531,9 @@ BOOL CPowerPlusDlg::OnInitDialog()
 	UpdateActionScheduleQueue(Mode::Init);
 	UpdatePwrReminderSnooze(Mode::Init);
 
+	// Initialize Action Schedule engine
+	UpdateScheduleEngine();
+
 	// Initialize background hotkeys if enabled
 	SetupBackgroundHotkey(Mode::Init);
 
@@ -629,6 +636,8 @@ int CPowerPlusDlg::PreDestroyDialog()
 	KillTimer(TIMERID_STD_ACTIONSCHEDULE);
 	KillTimer(TIMERID_STD_POWERREMINDER);
 	KillTimer(TIMERID_STD_EVENTSKIPCOUNTER);
+	DebugLogging::GetDebugLogger().SetFlushNotifyWnd(NULL);
+	KillTimer(TIMERID_STD_DEBUGLOGFLUSH);
 
 	// Execute Power Reminder before exitting
 	ExecutePowerReminder(PwrReminderEvent::atAppExit);
@@ -1164,6 +1173,14 @@ void CPowerPlusDlg::OnTimer(UINT_PTR nIDEvent)
 		}
 	}
 
+	// Timer ID: Debug log flush
+	else if (nIDEvent == TIMERID_STD_DEBUGLOGFLUSH) {
+		// Write buffered trace/debug log strings to files
+		// Buffers are empty now, timer will be armed again by the next buffered log string
+		KillTimer(TIMERID_STD_DEBUGLOGFLUSH);
+		DebugLogging::GetDebugLogger().FlushLogFiles();
+	}
+
 	// Default
 	SDialog::OnTimer(nIDEvent);
 }
@@ -1254,6 +1271,7 @@ LRESULT CPowerPlusDlg::OnUpdateScheduleData(WPARAM /*wParam*/, LPARAM /*lParam*/
 		if (pschData != NULL) {
 			m_schScheduleData.Copy(*pschData);
 			UpdateActionScheduleQueue(Mode::Update);
+			UpdateScheduleEngine();
 		}
 	}
 
@@ -1411,6 +1429,22 @@ LRESULT CPowerPlusDlg::OnShowErrorMessage(WPARAM wParam, LPARAM /*lParam*/)
 }
 
 
+/**
+ * @brief	Arm debug log flush timer when trace/debug log strings are buffered
+ * @param	wParam - Not used
+ * @param	lParam - Not used
+ * @return	LRESULT
+ */
+LRESULT CPowerPlusDlg::OnDebugLogBuffered(WPARAM /*wParam*/, LPARAM /*lParam*/)
+{
+	// One-shot: the timer is killed when it flushes the buffers
+	SetTimer(TIMERID_STD_DEBUGLOGFLUSH, 1000, NULL);
+
+	// Default: Always success
+	return LRESULT(Result::Success);
+}
+
+
 /**
  * @brief	Handle power broadcast event
  * @param	wParam - Event ID
@@ -1458,6 +1492,9 @@ LRESULT CPowerPlusDlg::OnPowerBroadcastEvent(WPARAM wParam, LPARAM /*lParam*/)
 		// Reset session ending flag
 		SetSessionEndFlag(FLAG_OFF);
 
+		// Re-calculate schedule deadlines after system wakeup
+		UpdateScheduleEngine();
+
 		// Reset system suspended flag
 		SetSystemSuspendFlag(FLAG_OFF);
 		if (pApp != NULL) {
@@ -1737,6 +1774,10 @@ LRESULT CPowerPlusDlg::WindowProc(UINT message, WPARAM wParam, LPARAM lParam)
 		case WM_POWERBROADCAST:
 			OnPowerBroadcastEvent(wParam, NULL);
 			break;
+		case WM_TIMECHANGE:
+			// System time changed, re-calculate schedule deadlines
+			UpdateScheduleEngine();
+			break;
 		case WM_WTSSESSION_CHANGE:
 			OnWTSSessionChange(wParam, lParam);
 			break;
@@ -2960,6 +3001,8 @@ void CPowerPlusDlg::ReloadSettings(void)
 {
 	// Reload app data
 	GetAppData();
+	UpdateActionScheduleQueue(Mode::Update);
+	UpdateScheduleEngine();
 
 	// Reload app language
 	((CPowerPlusApp*)AfxGetApp())->ReloadAppLanguage();
@@ -3382,147 +3425,163 @@ bool CPowerPlusDlg::ProcessActionSchedule(void)
 {
 	bool bResult = false;
 
-	// Get current time
-	DateTime currentDateTime = DateTimeUtils::GetCurrentDateTime();
-
 	// Flag that trigger to reupdate schedule data
 	bool bTriggerReupdate = false;
 
-	// Get default schedule item
-	ScheduleItem& schDefaultItem = m_schScheduleData.GetDefaultItem();
-	{
-		// Flag to skip processing schedule item
-		bool bSkipProcess = false;
+	// Collect schedule events which are due at current time
+	ScheduleEngine::EventList arrDueEvents;
+	m_schScheduleEngine.CollectDueEvents(arrDueEvents);
 
-		// If item is not enabled
-		if (schDefaultItem.IsEnabled() == false) {
-			// Do not process
-			bSkipProcess = true;
-		}
+	// Re-arm timer for the next deadline before processing,
+	// because notify message box will block here until user responds
+	ArmActionScheduleTimer();
 
-		// If repeat option is ON and is set as active in current day of week
-		if ((schDefaultItem.IsRepeatEnabled() == true) && (!schDefaultItem.IsDayActive((DayOfWeek)currentDateTime.DayOfWeek()))) {
-			// Do not process
-			bSkipProcess = true;
-		}
+	// Process each due event
+	for (const ScheduleEngine::Event& schEvent : arrDueEvents) {
+
+		// Get schedule item
+		PScheduleItem pschItem = FindScheduleItem(schEvent.nItemID);
+		if (pschItem == NULL) continue;
 
-		// Process default schedule
-		if (bSkipProcess != true) {
+		// Do not process if item is no longer enabled
+		if (pschItem->IsEnabled() == false) continue;
 
-			// Check for time matching and trigger schedule notifying if enabled
+		// Trigger schedule notifying if enabled
+		if (schEvent.eType == ScheduleEngine::notifyEvent) {
 			if (GetAppOption(AppOptionID::notifySchedule) == true) {
-				bool bTriggerNotify = ClockTimeUtils::IsMatching(currentDateTime.GetClockTime(), schDefaultItem.GetTime(), -30);
-				if (bTriggerNotify == true) {
-					// Do notify schedule (and check for trigger reupdate)
-					NotifySchedule(&schDefaultItem, bTriggerReupdate);
-					bResult = false;
-				}
+				// Do notify schedule (and check for trigger reupdate)
+				NotifySchedule(pschItem, bTriggerReupdate);
+				bResult = false;
 			}
+			continue;
+		}
 
-			// Check for time matching and trigger the scheduled action
-			bool bTriggerAction = ClockTimeUtils::IsMatching(currentDateTime.GetClockTime(), schDefaultItem.GetTime());
-			if (bTriggerAction == true) {
-				
-				// Check if item is marked as skipped
-				bool bSkipFlag = GetActionScheduleSkipStatus(schDefaultItem.GetItemID());
-				if (bSkipFlag != true) {
+		// Check if item is marked as skipped
+		bool bSkipFlag = GetActionScheduleSkipStatus(pschItem->GetItemID());
+		if (bSkipFlag != true) {
 
-					// Output event log: Schedule executed
-					OutputScheduleEventLog(LOG_EVENT_EXEC_SCHEDULE, schDefaultItem);
+			// Output event log: Schedule executed
+			OutputScheduleEventLog(LOG_EVENT_EXEC_SCHEDULE, *pschItem);
 
-					// Save history info data
-					InitScheduleHistoryInfo(schDefaultItem);
-					SaveHistoryInfoData();
+			// Save history info data
+			InitScheduleHistoryInfo(*pschItem);
+			SaveHistoryInfoData();
 
-					// Execute schedule action
-					bResult = ExecuteAction(APP_MACRO_ACTION_SCHEDULE, schDefaultItem.GetAction());
+			// Execute schedule action
+			bResult = ExecuteAction(APP_MACRO_ACTION_SCHEDULE, pschItem->GetAction());
 
-					// If "Repeat" option is not ON,
-					// --> Disable schedule item after done
-					if (schDefaultItem.IsRepeatEnabled() == false) {
-						schDefaultItem.EnableItem(false);
-						bTriggerReupdate |= true;
-					}
-				}
-				else {
-					// Process failed
-					bResult = false;
-				}
-
-				// Set item as no longer skipped
-				SetActionScheduleSkip(schDefaultItem, FLAG_OFF);
+			// If "Repeat" option is not ON,
+			// --> Disable schedule item after done
+			if (pschItem->IsRepeatEnabled() == false) {
+				pschItem->EnableItem(false);
+				bTriggerReupdate |= true;
 			}
 		}
 		else {
 			// Process failed
 			bResult = false;
 		}
+
+		// Set item as no longer skipped and no longer snoozed
+		// (the action has run, so the next occurrence is not treated as snoozed)
+		SetActionScheduleSkip(*pschItem, FLAG_OFF);
+		SetActionScheduleSnooze(*pschItem, FLAG_OFF);
 	}
 
-	// Loop through each extra item and process
-	for (int nExtraIndex = 0; nExtraIndex < m_schScheduleData.GetExtraItemNum(); nExtraIndex++) {
+	// Reupdate flag is triggered
+	if (bTriggerReupdate == true) {
+		// Reupdate schedule data
+		ReupdateActionScheduleData();
+		bResult = true;
+	}
 
-		// Get schedule item
-		ScheduleItem& schExtraItem = m_schScheduleData.GetItemAt(nExtraIndex);
+	return bResult;
+}
 
-		// Do not process if repeat option is ON but is not set as active in current day of week
-		if ((schExtraItem.IsRepeatEnabled() == true) && (!schExtraItem.IsDayActive((DayOfWeek)currentDateTime.DayOfWeek())))
-			continue;
 
-		// Check for time matching and trigger schedule notifying if enabled
-		if (GetAppOption(AppOptionID::notifySchedule) == true) {
-			bool bTriggerNotify = ClockTimeUtils::IsMatching(currentDateTime.GetClockTime(), schExtraItem.GetTime(), -30);
-			if (bTriggerNotify == true) {
-				// Do notify schedule (and check for trigger reupdate)
-				NotifySchedule(&schExtraItem, bTriggerReupdate);
-				bResult = false;
-				continue;
-			}
-		}
+/**
+ * @brief	Rebuild Action Schedule engine data and re-arm schedule timer
+ * @param	None
+ * @return	None
+ */
+void CPowerPlusDlg::UpdateScheduleEngine(void)
+{
+	// Prepare schedule entries
+	ScheduleEngine::EntryList arrEntries;
+	arrEntries.reserve(m_schScheduleData.GetExtraItemNum() + 1);
+
+	auto AddEntry = [&arrEntries](const ScheduleItem& schItem) {
+		if (schItem.IsEmpty()) return;
+		ClockTime schTime = schItem.GetTime();
+		ScheduleEngine::Entry schEntry{};
+		schEntry.nItemID = schItem.GetItemID();
+		schEntry.bEnabled = schItem.IsEnabled();
+		schEntry.bRepeat = schItem.IsRepeatEnabled();
+		schEntry.byActiveDays = schItem.GetActiveDays();
+		schEntry.nTimeOfDay = (schTime.Hour() * 3600) + (schTime.Minute() * 60) + schTime.Second();
+		arrEntries.push_back(schEntry);
+	};
+
+	// Default item and extra items
+	AddEntry(m_schScheduleData.GetDefaultItem());
+	for (int nExtraIndex = 0; nExtraIndex < m_schScheduleData.GetExtraItemNum(); nExtraIndex++) {
+		AddEntry(m_schScheduleData.GetItemAt(nExtraIndex));
+	}
+
+	// Rebuild engine data
+	m_schScheduleEngine.Rebuild(arrEntries);
+
+	// Re-arm timer
+	ArmActionScheduleTimer();
+}
 
-		// Check for time matching and trigger the scheduled action
-		bool bTriggerAction = ClockTimeUtils::IsMatching(currentDateTime.GetClockTime(), schExtraItem.GetTime());
-		if (bTriggerAction == true) {
 
-			// Check if item is marked as skipped
-			bool bSkipFlag = GetActionScheduleSkipStatus(schExtraItem.GetItemID());
-			if (bSkipFlag != true) {
+/**
+ * @brief	Arm Action Schedule timer for the earliest deadline
+ * @param	None
+ * @return	None
+ */
+void CPowerPlusDlg::ArmActionScheduleTimer(void)
+{
+	// Kill current timer
+	KillTimer(TIMERID_STD_ACTIONSCHEDULE);
 
-				// Output event log: Schedule executed
-				OutputScheduleEventLog(LOG_EVENT_EXEC_SCHEDULE, schExtraItem);
+	// No pending schedule event
+	if (m_schScheduleEngine.IsEmpty())
+		return;
 
-				// Save history info data
-				InitScheduleHistoryInfo(schExtraItem);
-				SaveHistoryInfoData();
+	// Calculate timer interval
+	// Notes: Interval is limited so that timer will be re-armed periodically
+	// in case clock time changes without any notification
+	long long llInterval = m_schScheduleEngine.GetTimeToNextDeadline().count();
+	llInterval = (std::max)(llInterval, static_cast<long long>(USER_TIMER_MINIMUM));
+	llInterval = (std::min)(llInterval, static_cast<long long>(Constant::Max::Timeout::ScheduleTimer));
 
-				// Execute schedule action
-				bResult = ExecuteAction(APP_MACRO_ACTION_SCHEDULE, schExtraItem.GetAction());
+	// Set timer
+	SetTimer(TIMERID_STD_ACTIONSCHEDULE, static_cast<unsigned>(llInterval), NULL);
+}
 
-				// If "Repeat" option is not ON,
-				// --> Disable schedule item after done
-				if (schExtraItem.IsRepeatEnabled() == false) {
-					schExtraItem.EnableItem(false);
-					bTriggerReupdate |= true;
-				}
-			}
-			else {
-				// Process failed
-				bResult = false;
-			}
 
-			// Set item as no longer skipped
-			SetActionScheduleSkip(schExtraItem, FLAG_OFF);
-		}
-	}
+/**
+ * @brief	Find Action Schedule item by ID
+ * @param	nItemID - Action Schedule item ID
+ * @return	PScheduleItem - Schedule item pointer (NULL if not found)
+ */
+PScheduleItem CPowerPlusDlg::FindScheduleItem(unsigned nItemID)
+{
+	// Check default item
+	ScheduleItem& schDefaultItem = m_schScheduleData.GetDefaultItem();
+	if (schDefaultItem.GetItemID() == nItemID)
+		return &schDefaultItem;
 
-	// Reupdate flag is triggered
-	if (bTriggerReupdate == true) {
-		// Reupdate schedule data
-		ReupdateActionScheduleData();
-		bResult = true;
+	// Search in extra item data
+	for (int nExtraIndex = 0; nExtraIndex < m_schScheduleData.GetExtraItemNum(); nExtraIndex++) {
+		ScheduleItem& schExtraItem = m_schScheduleData.GetItemAt(nExtraIndex);
+		if (schExtraItem.GetItemID() == nItemID)
+			return &schExtraItem;
 	}
 
-	return bResult;
+	return NULL;
 }
 
 
@@ -3625,7 +3684,14 @@ void CPowerPlusDlg::SetActionScheduleSnooze(const ScheduleItem& schItem, int nSn
 				// Calculate next snooze trigger time
 				pwrRuntimeItem.SetTime(ClockTimeUtils::GetCurrentClockTime());
 				pwrRuntimeItem.CalcNextSnoozeTime(nInterval);
+				m_schScheduleEngine.Snooze(schItem.GetItemID(), nInterval);
+			}
+			else {
+				// Reset snooze trigger time and cancel snoozed action
+				pwrRuntimeItem.SetTime(ClockTime());
+				m_schScheduleEngine.CancelSnooze(schItem.GetItemID());
 			}
+			ArmActionScheduleTimer();
 			return;
 		}
 	}
@@ -3639,6 +3705,8 @@ void CPowerPlusDlg::SetActionScheduleSnooze(const ScheduleItem& schItem, int nSn
 		// Calculate next snooze trigger time
 		pwrRuntimeItem.SetTime(ClockTimeUtils::GetCurrentClockTime());
 		pwrRuntimeItem.CalcNextSnoozeTime(nInterval);
+		m_schScheduleEngine.Snooze(schItem.GetItemID(), nInterval);
+		ArmActionScheduleTimer();
 	}
 
 	// Add item to runtime queue
@@ -3684,6 +3752,7 @@ void CPowerPlusDlg::UpdateActionScheduleQueue(int nMode)
 				if (!schDefaultItem.IsAllowSnoozing()) {
 					// Disable snooze mode
 					pwrRuntimeItem.SetSnoozeFlag(FLAG_OFF);
+					m_schScheduleEngine.CancelSnooze(pwrRuntimeItem.GetItemID());
 				}
 				
 				// Mark as found
@@ -3700,6 +3769,7 @@ void CPowerPlusDlg::UpdateActionScheduleQueue(int nMode)
 					if (!schItem.IsAllowSnoozing()) {
 						// Disable snooze mode
 						pwrRuntimeItem.SetSnoozeFlag(FLAG_OFF);
+						m_schScheduleEngine.CancelSnooze(pwrRuntimeItem.GetItemID());
 					}
 
 					// Mark as found
@@ -3732,6 +3802,7 @@ void CPowerPlusDlg::UpdateActionScheduleQueue(int nMode)
 
 			// Update item snooze mode data
 			pwrRuntimeItem.SetSnoozeFlag(FLAG_OFF);
+			m_schScheduleEngine.CancelSnooze(pwrRuntimeItem.GetItemID());
 		}
 	}
 }
@@ -4222,11 +4293,12 @@ bool CPowerPlusDlg::ExecutePowerReminder(unsigned nExecEventID)
 	}
 
 	// Get current time
-	DateTime currentDateTime;
+	// (decompose it once, then match all items against the broken-down fields)
+	DateTime::Fields currentTimeFields{};
 	ClockTime currentClockTime;
 	if (nExecEventID == PwrReminderEvent::atSetTime) {
-		currentDateTime = DateTimeUtils::GetCurrentDateTime();
-		currentClockTime = currentDateTime.GetClockTime();
+		currentTimeFields = DateTimeUtils::GetCurrentDateTime().Decompose();
+		currentClockTime = ClockTime(currentTimeFields.hour, currentTimeFields.minute, currentTimeFields.second, currentTimeFields.millisecond);
 	}
 
 	// Flag that trigger to reupdate Power Reminder data
@@ -4254,7 +4326,7 @@ bool CPowerPlusDlg::ExecutePowerReminder(unsigned nExecEventID)
 		{
 		case PwrReminderEvent::atSetTime:
 			// If item is set to repeat but not set active in current day of week
-			if ((pwrCurItem.IsRepeatEnabled() == true) && (!pwrCurItem.IsDayActive((DayOfWeek)currentDateTime.DayOfWeek())))
+			if ((pwrCurItem.IsRepeatEnabled() == true) && (!pwrCurItem.IsDayActive((DayOfWeek)currentTimeFields.dayOfWeek)))
 				continue;
 
 			// If set time matching or snooze time is triggered
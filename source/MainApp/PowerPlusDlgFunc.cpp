@@ -9,6 +9,8 @@
 
 #include "MainApp/PowerPlus.h"
 #include "MainApp/PowerPlusDlg.h"
+#include "AppCore/LogJournal.h"
+#include "Components/GridCtrl/GridCtrl.h"
 #include "Dialogs/AboutDlg.h"
 #include "Dialogs/MultiScheduleDlg.h"
 #include "Dialogs/LogViewerDlg.h"
@@ -1634,6 +1636,822 @@ bool CPowerPlusDlg::ProcessDebugCommand(const wchar_t* commandString, DWORD& err
 			}
 		}
 	}
+	else if (!_tcscmp(tokenList.at(0).c_str(), _T("benchmark"))) {
+		if ((tokenCount == 2) && (!_tcscmp(tokenList.at(1).c_str(), _T("langlookup")))) {
+			// Compare indexed language string lookup against sequential search, for every ID in the tables
+			constexpr int nRepeatCount = 100;
+			const unsigned arrLanguageIDs[] = { APP_LANGUAGE_ENGLISH, APP_LANGUAGE_VIETNAMESE, APP_LANGUAGE_SIMPCHINESE };
+			BeginWaitCursor();
+			for (unsigned nLanguageID : arrLanguageIDs) {
+				LANGTABLE_PTR ptrLangTable = LoadLanguageTable(nLanguageID);
+				GetLanguageIndex(ptrLangTable);		// Make sure the index is built before measuring
+
+				// Verify lookup results
+				int nMismatchCount = 0;
+				for (const LANGTEXT& langText : *ptrLangTable) {
+					if (GetLanguageString(ptrLangTable, langText.id) != FindLanguageString(ptrLangTable, langText.id))
+						nMismatchCount++;
+				}
+
+				// Measure sequential search
+				PerformanceCounter counter;
+				size_t nFoundCount = 0;
+				counter.Start();
+				for (int nRepeat = 0; nRepeat < nRepeatCount; nRepeat++) {
+					for (const LANGTEXT& langText : *ptrLangTable) {
+						if (!IS_NULL_STRING(FindLanguageString(ptrLangTable, langText.id))) nFoundCount++;
+					}
+				}
+				counter.Stop();
+				double dScanTime = counter.GetElapsedTime(true);
+
+				// Measure indexed lookup
+				counter.Start();
+				for (int nRepeat = 0; nRepeat < nRepeatCount; nRepeat++) {
+					for (const LANGTEXT& langText : *ptrLangTable) {
+						if (!IS_NULL_STRING(GetLanguageString(ptrLangTable, langText.id))) nFoundCount++;
+					}
+				}
+				counter.Stop();
+				double dIndexedTime = counter.GetElapsedTime(true);
+
+				OutputDebugLogFormat(_T("Language=%s, Items=%d, Repeat=%d, Scan=%.4f (ms), Indexed=%.4f (ms), Found=%d, Mismatch=%d"),
+					GetLanguageName(nLanguageID), static_cast<int>(ptrLangTable->size()), nRepeatCount, dScanTime, dIndexedTime, static_cast<int>(nFoundCount), nMismatchCount);
+			}
+			EndWaitCursor();
+			bNoReply = false;	// Reset flag
+		}
+		else if ((tokenCount == 2) && (!_tcscmp(tokenList.at(1).c_str(), _T("logformat")))) {
+			// Compare streaming YAML output against JSON data tree output
+			constexpr int nItemCount = 10000;
+
+			// Prepare a sample log item (integer, dictionary, string, duplicated and read-only details)
+			LOGITEM logItem;
+			logItem.SetTime(DateTimeUtils::GetCurrentDateTime());
+			logItem.SetProcessID();
+			logItem.SetCategory(LOG_HISTORY_EXEC_SCHEDULE);
+			logItem.SetLogString(_T("Benchmark log item"));
+			logItem.AddDetail(HistoryDetail::ItemID, 12345);
+			logItem.AddDetail(HistoryDetail::Action, HistoryAction::Shutdown, LogDetailFlag::LookUp_Dict);
+			logItem.AddDetail(HistoryDetail::Message, _T("Sample detail message"), LogDetailFlag::Write_String);
+			logItem.AddDetail(HistoryDetail::ItemID, -1);
+			logItem.AddDetail(HistoryDetail::Result, 0, LogDetailFlag::ReadOnly_Data);
+
+			// Verify output result
+			String streamOutput;
+			logItem.FormatOutput(streamOutput);
+			bool bIdentical = (streamOutput == logItem.FormatOutputJSON());
+
+			BeginWaitCursor();
+
+			// Measure JSON data tree output
+			PerformanceCounter counter;
+			size_t nTotalLength = 0;
+			counter.Start();
+			for (int nCount = 0; nCount < nItemCount; nCount++) {
+				nTotalLength += logItem.FormatOutputJSON().GetLength();
+			}
+			counter.Stop();
+			double dTreeTime = counter.GetElapsedTime(true);
+
+			// Measure streaming output (reusing one output buffer)
+			counter.Start();
+			for (int nCount = 0; nCount < nItemCount; nCount++) {
+				streamOutput.Empty();
+				logItem.FormatOutput(streamOutput);
+				nTotalLength += streamOutput.GetLength();
+			}
+			counter.Stop();
+			double dStreamTime = counter.GetElapsedTime(true);
+
+			EndWaitCursor();
+
+			double dTreeRate = (dTreeTime > 0) ? (nItemCount * 1000.0 / dTreeTime) : 0;
+			double dStreamRate = (dStreamTime > 0) ? (nItemCount * 1000.0 / dStreamTime) : 0;
+			OutputDebugLogFormat(_T("Items=%d, Tree=%.4f (ms, %.0f items/s), Stream=%.4f (ms, %.0f items/s), Identical=%s, Length=%d"),
+				nItemCount, dTreeTime, dTreeRate, dStreamTime, dStreamRate, (bIdentical ? _T("Yes") : _T("No")), static_cast<int>(nTotalLength));
+			bNoReply = false;	// Reset flag
+		}
+		else if ((tokenCount == 2) && (!_tcscmp(tokenList.at(1).c_str(), _T("logfilter")))) {
+			// Measure background indexing and filter query time of log items
+			constexpr int nItemCount = 100000;
+			const wchar_t* arrDescriptions[] = { _T("LogViewerDlg"), _T("MultiScheduleDlg"), _T("Power reminder message"), _T("Hotkey settings changed") };
+			const USHORT arrCategories[] = { LOG_EVENT_DLG_INIT, LOG_EVENT_DLG_DESTROYED, LOG_EVENT_BTN_CLICKED, LOG_EVENT_EDIT_CHANGED };
+			const wchar_t* arrFilters[] = { _T("dlg"), _T("power message"), _T("id:1005"), _T("name:multi dlg"), _T("pid:0"), _T("zzz") };
+
+			BeginWaitCursor();
+
+			// Build index (in background)
+			LogIndex logIndex;
+			PerformanceCounter counter;
+			counter.Start();
+			logIndex.Start();
+			LogIndex::Entry indexEntry;
+			for (int nCount = 0; nCount < nItemCount; nCount++) {
+				indexEntry.nTime = nCount;
+				indexEntry.dwProcessID = static_cast<DWORD>(nCount % 16);
+				indexEntry.usCategory = arrCategories[nCount % _countof(arrCategories)];
+				indexEntry.nResourceID = 1000 + (nCount % 10);
+				indexEntry.nameID = (nCount % 2) ? _T("MultiScheduleDlg") : _T("LogViewerDlg");
+				indexEntry.description = arrDescriptions[nCount % _countof(arrDescriptions)];
+				logIndex.AddEntry(std::move(indexEntry));
+			}
+			while (!logIndex.IsUpToDate()) {
+				Sleep(1);
+			}
+			counter.Stop();
+			OutputDebugLogFormat(_T("Items=%d, Index=%.4f (ms)"), nItemCount, counter.GetElapsedTime(true));
+
+			// Query filters
+			LANGTABLE_PTR ptrLanguage = ((CPowerPlusApp*)AfxGetApp())->GetAppLanguage();
+			LogIndex::ItemList arrResult;
+			for (const wchar_t* filterString : arrFilters) {
+				counter.Start();
+				size_t nMatchCount = logIndex.Query(filterString, ptrLanguage, arrResult);
+				counter.Stop();
+				OutputDebugLogFormat(_T("Filter=\"%s\", Matched=%d, Time=%.4f (ms)"), filterString, static_cast<int>(nMatchCount), counter.GetElapsedTime(true));
+			}
+
+			EndWaitCursor();
+			bNoReply = false;	// Reset flag
+		}
+		else if ((tokenCount == 2) && (!_tcscmp(tokenList.at(1).c_str(), _T("tracelog")))) {
+			// Measure cost per leveled trace call (disabled at runtime and enabled)
+			constexpr int nDisabledCount = 1000000;
+			constexpr int nEnabledCount = 10000;
+			int nSavedLevel = TraceLog::GetLevel();
+			String sampleString = _T("Benchmark trace string");
+
+			BeginWaitCursor();
+
+			// Disabled calls: only one level comparison
+			PerformanceCounter counter;
+			TraceLog::SetLevel(TraceLog::Off);
+			counter.Start();
+			for (int nCount = 0; nCount < nDisabledCount; nCount++) {
+				TRACE_INFO(L"Benchmark item {}: {}", nCount, sampleString);
+			}
+			counter.Stop();
+			double dDisabledTime = counter.GetElapsedTime(true);
+
+			// Enabled calls: capture arguments only (formatting is deferred)
+			TraceLog::SetLevel(TraceLog::Verbose);
+			counter.Start();
+			for (int nCount = 0; nCount < nEnabledCount; nCount++) {
+				TRACE_INFO(L"Benchmark item {}: {}", nCount, sampleString);
+			}
+			counter.Stop();
+			double dEnabledTime = counter.GetElapsedTime(true);
+			TraceLog::SetLevel(nSavedLevel);
+
+			// Write remaining records to file
+			counter.Start();
+			DebugLogging::GetDebugLogger().FlushLogFiles();
+			counter.Stop();
+			double dFlushTime = counter.GetElapsedTime(true);
+
+			EndWaitCursor();
+
+			OutputDebugLogFormat(_T("CompiledLevel=%d, Disabled=%.3f (ns/call), Enabled=%.3f (ns/call), Flush=%.4f (ms)"), TraceLog::compiledLevel,
+				(dDisabledTime * 1000000.0 / nDisabledCount), (dEnabledTime * 1000000.0 / nEnabledCount), dFlushTime);
+			bNoReply = false;	// Reset flag
+		}
+		else if ((tokenCount == 2) && (!_tcscmp(tokenList.at(1).c_str(), _T("idmap")))) {
+			// Measure construction and lookup of the application resource ID map
+			constexpr int nRepeatCount = 100;
+			SResourceIDMap* pResourceIDMap = GET_RESOURCEID_MAP();
+			if ((pResourceIDMap != NULL) && (pResourceIDMap->GetMapCount() > 0)) {
+
+				// Snapshot current map data (all dialogs which have been registered)
+				RESOURCE_ID_MAP_DATA arrMapEntries;
+				for (size_t nIndex = 0; nIndex < pResourceIDMap->GetMapCount(); nIndex++) {
+					arrMapEntries.push_back(pResourceIDMap->GetAt(nIndex));
+				}
+
+				BeginWaitCursor();
+
+				// Bulk construction (same as resource ID map macros)
+				PerformanceCounter counter;
+				counter.Start();
+				for (int nRepeat = 0; nRepeat < nRepeatCount; nRepeat++) {
+					pResourceIDMap->RemoveAll();
+					pResourceIDMap->Append(arrMapEntries.data(), arrMapEntries.size());
+				}
+				counter.Stop();
+				double dBulkTime = counter.GetElapsedTime(true);
+
+				// Construction by adding items one by one
+				counter.Start();
+				for (int nRepeat = 0; nRepeat < nRepeatCount; nRepeat++) {
+					pResourceIDMap->RemoveAll();
+					for (const RESOURCE_ID_MAP_ENTRY& mapEntry : arrMapEntries) {
+						ADD_RESOURCE_ID(mapEntry.byTypeID, mapEntry.dwResourceID, mapEntry.strNameID)
+					}
+				}
+				counter.Stop();
+				double dAddTime = counter.GetElapsedTime(true);
+
+				// Lookup in both directions
+				size_t nFoundCount = 0;
+				counter.Start();
+				for (int nRepeat = 0; nRepeat < nRepeatCount; nRepeat++) {
+					for (const RESOURCE_ID_MAP_ENTRY& mapEntry : arrMapEntries) {
+						if (GET_RESOURCE_ID(GET_NAME_ID(mapEntry.dwResourceID)) != INT_NULL)
+							nFoundCount++;
+					}
+				}
+				counter.Stop();
+				double dLookupTime = counter.GetElapsedTime(true);
+
+				EndWaitCursor();
+
+				OutputDebugLogFormat(_T("Entries=%d, Repeat=%d, Bulk=%.4f (ms), Add=%.4f (ms), Lookup=%.4f (ms), Found=%d"), static_cast<int>(arrMapEntries.size()),
+					nRepeatCount, dBulkTime, dAddTime, dLookupTime, static_cast<int>(nFoundCount));
+				bNoReply = false;	// Reset flag
+			}
+		}
+		else if ((tokenCount == 2) && (!_tcscmp(tokenList.at(1).c_str(), _T("datetime")))) {
+			// Compare calling field getters one by one against a single decomposition,
+			// for date/time formatting and Power Reminder schedule matching
+			constexpr int nFormatCount = 100000;
+			constexpr int nMatchCount = 1000000;
+			const String templateFormatStr = StringUtils::LoadResourceString(IDS_FORMAT_FULLDATETIME);
+			const DateTime sampleDateTime = DateTimeUtils::GetCurrentDateTime();
+			const ClockTime matchClockTime = sampleDateTime.GetClockTime();
+			wchar_t dateTimeBuff[128];
+			size_t nTotalLength = 0;
+			int nMatchedCount = 0;
+
+			BeginWaitCursor();
+
+			// Formatting: field getters
+			PerformanceCounter counter;
+			counter.Start();
+			for (int nCount = 0; nCount < nFormatCount; nCount++) {
+				nTotalLength += std::swprintf(dateTimeBuff, _countof(dateTimeBuff), templateFormatStr.GetString(), sampleDateTime.Year(),
+					sampleDateTime.Month(), sampleDateTime.Day(), sampleDateTime.Hour(), sampleDateTime.Minute(), sampleDateTime.Second(),
+					sampleDateTime.Millisecond(), ((sampleDateTime.Hour() >= 12) ? Constant::Symbol::PostMeridiem : Constant::Symbol::AnteMeridiem));
+			}
+			counter.Stop();
+			double dFormatGetterTime = counter.GetElapsedTime(true);
+
+			// Formatting: single decomposition
+			counter.Start();
+			for (int nCount = 0; nCount < nFormatCount; nCount++) {
+				const DateTime::Fields timeFields = sampleDateTime.Decompose();
+				nTotalLength += std::swprintf(dateTimeBuff, _countof(dateTimeBuff), templateFormatStr.GetString(), timeFields.year,
+					timeFields.month, timeFields.day, timeFields.hour, timeFields.minute, timeFields.second,
+					timeFields.millisecond, ((timeFields.hour >= 12) ? Constant::Symbol::PostMeridiem : Constant::Symbol::AnteMeridiem));
+			}
+			counter.Stop();
+			double dFormatDecomposeTime = counter.GetElapsedTime(true);
+
+			// Schedule matching: clock-time and day of week getters
+			counter.Start();
+			for (int nCount = 0; nCount < nMatchCount; nCount++) {
+				if ((sampleDateTime.DayOfWeek() == (nCount % 7)) && ClockTimeUtils::IsMatching(sampleDateTime.GetClockTime(), matchClockTime))
+					nMatchedCount++;
+			}
+			counter.Stop();
+			double dMatchGetterTime = counter.GetElapsedTime(true);
+
+			// Schedule matching: single decomposition
+			counter.Start();
+			for (int nCount = 0; nCount < nMatchCount; nCount++) {
+				const DateTime::Fields timeFields = sampleDateTime.Decompose();
+				const ClockTime clockTime(timeFields.hour, timeFields.minute, timeFields.second, timeFields.millisecond);
+				if ((timeFields.dayOfWeek == (nCount % 7)) && ClockTimeUtils::IsMatching(clockTime, matchClockTime))
+					nMatchedCount++;
+			}
+			counter.Stop();
+			double dMatchDecomposeTime = counter.GetElapsedTime(true);
+
+			EndWaitCursor();
+
+			OutputDebugLogFormat(_T("Format: Count=%d, Getters=%.4f (ms), Decompose=%.4f (ms), Length=%d"),
+				nFormatCount, dFormatGetterTime, dFormatDecomposeTime, static_cast<int>(nTotalLength));
+			OutputDebugLogFormat(_T("Match: Count=%d, Getters=%.4f (ms), Decompose=%.4f (ms), Matched=%d"),
+				nMatchCount, dMatchGetterTime, dMatchDecomposeTime, nMatchedCount);
+			bNoReply = false;	// Reset flag
+		}
+		else if ((tokenCount == 2) && (!_tcscmp(tokenList.at(1).c_str(), _T("strings")))) {
+			// Measure number conversion, log item output and JSON printing
+			// with new result strings against reused (pre-allocated) buffers
+			constexpr int nNumberCount = 100000;
+			constexpr int nItemCount = 10000;
+			size_t nTotalLength = 0;
+
+			// Prepare a sample log item and JSON data (with a child object)
+			LOGITEM logItem;
+			logItem.SetTime(DateTimeUtils::GetCurrentDateTime());
+			logItem.SetProcessID();
+			logItem.SetCategory(LOG_HISTORY_EXEC_SCHEDULE);
+			logItem.SetLogString(_T("Benchmark log item"));
+			logItem.AddDetail(HistoryDetail::ItemID, 12345);
+			logItem.AddDetail(HistoryDetail::Action, HistoryAction::Shutdown, LogDetailFlag::LookUp_Dict);
+			logItem.AddDetail(HistoryDetail::Message, _T("Sample detail message"), LogDetailFlag::Write_String);
+
+			JSONDATA jsonData;
+			JSONDATA jsonDetailData;
+			jsonData.AddString(_T("Time"), logItem.FormatDateTime());
+			jsonData.AddInteger(_T("PID"), 1234);
+			jsonData.AddString(_T("Category"), _T("Benchmark"));
+			jsonData.AddFloat(_T("Ratio"), 0.75);
+			jsonDetailData.SetObjectName(_T("Details"));
+			jsonDetailData.AddInteger(_T("ItemID"), 12345);
+			jsonDetailData.AddString(_T("Message"), _T("Sample detail message"));
+			jsonData.AddChildObject(&jsonDetailData);
+
+			BeginWaitCursor();
+
+			// Number conversion: format function against std::to_chars
+			PerformanceCounter counter;
+			counter.Start();
+			for (int nCount = 0; nCount < nNumberCount; nCount++) {
+				nTotalLength += StringUtils::StringFormat(_T("%d"), nCount).GetLength();
+			}
+			counter.Stop();
+			double dNumberFormatTime = counter.GetElapsedTime(true);
+
+			counter.Start();
+			for (int nCount = 0; nCount < nNumberCount; nCount++) {
+				nTotalLength += String::FromNumber(nCount).GetLength();
+			}
+			counter.Stop();
+			double dNumberConvertTime = counter.GetElapsedTime(true);
+
+			// Log item output: new result string against reused builder buffer
+			counter.Start();
+			for (int nCount = 0; nCount < nItemCount; nCount++) {
+				nTotalLength += logItem.FormatOutput().GetLength();
+			}
+			counter.Stop();
+			double dLogNewTime = counter.GetElapsedTime(true);
+
+			StringBuilder outputBuilder(1024);
+			counter.Start();
+			for (int nCount = 0; nCount < nItemCount; nCount++) {
+				outputBuilder.Reset();
+				logItem.FormatOutput(outputBuilder.GetBuffer());
+				nTotalLength += outputBuilder.GetLength();
+			}
+			counter.Stop();
+			double dLogReuseTime = counter.GetElapsedTime(true);
+
+			// JSON printing: new result string against reused output string
+			counter.Start();
+			for (int nCount = 0; nCount < nItemCount; nCount++) {
+				String printOutput;
+				jsonData.Print(printOutput, 0, false);
+				nTotalLength += printOutput.GetLength();
+			}
+			counter.Stop();
+			double dJSONNewTime = counter.GetElapsedTime(true);
+
+			String printOutput;
+			printOutput.Reserve(1024);
+			counter.Start();
+			for (int nCount = 0; nCount < nItemCount; nCount++) {
+				jsonData.Print(printOutput, 0, false);
+				nTotalLength += printOutput.GetLength();
+			}
+			counter.Stop();
+			double dJSONReuseTime = counter.GetElapsedTime(true);
+
+			EndWaitCursor();
+
+			OutputDebugLogFormat(_T("Number: Count=%d, Format=%.4f (ms), ToChars=%.4f (ms)"), nNumberCount, dNumberFormatTime, dNumberConvertTime);
+			OutputDebugLogFormat(_T("LogItem::FormatOutput: Count=%d, New=%.4f (ms), Reused=%.4f (ms)"), nItemCount, dLogNewTime, dLogReuseTime);
+			OutputDebugLogFormat(_T("JSON::Print: Count=%d, New=%.4f (ms), Reused=%.4f (ms), Length=%d"), nItemCount, dJSONNewTime, dJSONReuseTime, static_cast<int>(nTotalLength));
+			bNoReply = false;	// Reset flag
+		}
+		else if ((tokenCount == 2) && (!_tcscmp(tokenList.at(1).c_str(), _T("logarena")))) {
+			// Measure building event log items (same as dialog event logs) and
+			// arena memory used by their detail info
+			constexpr int nItemCount = 100000;
+			LOGDATA arrLogData;
+			arrLogData.reserve(nItemCount);
+
+			BeginWaitCursor();
+
+			// Build and store items (detail info and items are moved, not copied)
+			PerformanceCounter counter;
+			size_t nArenaSize = LogArena::GetTotalUsedSize();
+			counter.Start();
+			for (int nCount = 0; nCount < nItemCount; nCount++) {
+				LOGDETAILINFO logDetailInfo;
+				logDetailInfo.AddDetail(EventDetail::ResourceID, IDC_APPLY_BTN);
+				logDetailInfo.AddDetail(EventDetail::NameID, _T("IDC_APPLY_BTN"));
+
+				LOGITEM logItem;
+				logItem.SetCategory(LOG_EVENT_BTN_CLICKED);
+				logItem.SetTime(DateTimeUtils::GetCurrentDateTime());
+				logItem.SetProcessID();
+				logItem.SetLogString(_T("Apply"));
+				logItem.SetDetailInfo(std::move(logDetailInfo));
+				arrLogData.push_back(std::move(logItem));
+			}
+			counter.Stop();
+			double dBuildTime = counter.GetElapsedTime(true);
+			nArenaSize = LogArena::GetTotalUsedSize() - nArenaSize;
+
+			// Copy items (detail data is shared with the source items)
+			LOGDATA arrLogDataCopy;
+			counter.Start();
+			arrLogDataCopy = arrLogData;
+			counter.Stop();
+			double dCopyTime = counter.GetElapsedTime(true);
+
+			EndWaitCursor();
+
+			OutputDebugLogFormat(_T("Items=%d, Build=%.4f (ms), Copy=%.4f (ms), ItemSize=%d (bytes), ArenaPerItem=%.1f (bytes)"), nItemCount, dBuildTime, dCopyTime,
+				static_cast<int>(sizeof(LOGITEM)), (static_cast<double>(nArenaSize) / nItemCount));
+			bNoReply = false;	// Reset flag
+		}
+		else if ((tokenCount == 2) && (!_tcscmp(tokenList.at(1).c_str(), _T("logspill")))) {
+			// Measure storing event log items in ring buffer mode and
+			// reading them back across in-memory and spilled segments
+			constexpr int nItemCount = 50000;
+			constexpr int nReadCount = 10000;
+			SLogging benchmarkLog(LOGTYPE_APP_EVENT);
+			benchmarkLog.SetWriteMode(WriteOnCall);
+			benchmarkLog.EnableRingBuffer(4096, 1024);
+
+			BeginWaitCursor();
+
+			// Store items
+			PerformanceCounter counter;
+			counter.Start();
+			for (int nCount = 0; nCount < nItemCount; nCount++) {
+				LOGITEM logItem;
+				logItem.SetCategory(LOG_EVENT_BTN_CLICKED);
+				logItem.SetTime(DateTimeUtils::GetCurrentDateTime());
+				logItem.SetProcessID();
+				logItem.SetLogString(_T("Apply"));
+				logItem.AddDetail(EventDetail::ResourceID, nCount);
+				benchmarkLog.OutputItem(std::move(logItem));
+			}
+			counter.Stop();
+			double dOutputTime = counter.GetElapsedTime(true);
+
+			// Read items back in a scattered order (spilled items are mostly read from disk)
+			int nMismatchCount = 0;
+			counter.Start();
+			for (int nCount = 0; nCount < nReadCount; nCount++) {
+				int nIndex = static_cast<int>((static_cast<size_t>(nCount) * 7919) % nItemCount);
+				const LOGITEM& logItem = std::as_const(benchmarkLog).GetLogItem(nIndex);
+				if ((logItem.GetDetailInfo().empty()) || (logItem.GetDetailInfo().front().GetDetailValue() != nIndex)) {
+					nMismatchCount++;
+				}
+			}
+			counter.Stop();
+			double dReadTime = counter.GetElapsedTime(true);
+
+			EndWaitCursor();
+
+			OutputDebugLogFormat(_T("Items=%d, InMemory=%d, Output=%.4f (ms), Read(%d)=%.4f (ms), Mismatch=%d"), nItemCount,
+				static_cast<int>(benchmarkLog.GetMemoryCount()), dOutputTime, nReadCount, dReadTime, nMismatchCount);
+			bNoReply = false;	// Reset flag
+		}
+		else if ((tokenCount == 2) && (!_tcscmp(tokenList.at(1).c_str(), _T("logjournal")))) {
+			// Measure journal append cost per event (same as queuing an event log item)
+			// and reading the journal back
+			constexpr int nItemCount = 20000;
+			String folderPath = StringUtils::GetSubFolderPath(Constant::Folder::Log);
+			String journalFilePath = LogJournal::GetFilePath(LOGTYPE_NONE, folderPath);
+
+			LOGITEM logItem;
+			logItem.SetCategory(LOG_EVENT_BTN_CLICKED);
+			logItem.SetTime(DateTimeUtils::GetCurrentDateTime());
+			logItem.SetProcessID();
+			logItem.SetLogString(_T("Apply"));
+			logItem.AddDetail(EventDetail::ResourceID, IDC_APPLY_BTN);
+			logItem.AddDetail(EventDetail::NameID, _T("IDC_APPLY_BTN"));
+
+			BeginWaitCursor();
+
+			// Append items, mark the first half as written
+			PerformanceCounter counter;
+			LogJournal logJournal;
+			std::atomic<size_t> nQueuedCount = nItemCount;
+			bool bRet = logJournal.Create(journalFilePath);
+			counter.Start();
+			for (int nCount = 0; (bRet == true) && (nCount < nItemCount); nCount++) {
+				bRet = logJournal.AppendItem(nCount, logItem);
+			}
+			counter.Stop();
+			double dAppendTime = counter.GetElapsedTime(true);
+			logJournal.AppendCheckpoint(nItemCount / 2, nQueuedCount);
+
+			// Read back items which are not written yet
+			LOGDATA arrLogData;
+			counter.Start();
+			LogJournal::ReadItems(journalFilePath, arrLogData);
+			counter.Stop();
+			double dReadTime = counter.GetElapsedTime(true);
+			logJournal.Remove();
+
+			EndWaitCursor();
+
+			OutputDebugLogFormat(_T("Items=%d, Result=%d, Append=%.4f (ms), PerItem=%.3f (us), Read=%.4f (ms), Unwritten=%d"), nItemCount, bRet,
+				dAppendTime, (dAppendTime * 1000.0 / nItemCount), dReadTime, static_cast<int>(arrLogData.size()));
+			bNoReply = false;	// Reset flag
+		}
+		else if ((tokenCount == 2) && (!_tcscmp(tokenList.at(1).c_str(), _T("gridgeometry")))) {
+			// Measure grid cell origin and point-to-row lookups on a 100k-row grid:
+			// prefix sum index (as used by CGridCtrl) versus walking row heights one by one
+			constexpr int nRowCount = 100000;
+			constexpr int nQueryCount = 2000;
+			CGridSizeArray arrRowHeights;
+			for (int nRow = 0; nRow < nRowCount; nRow++) {
+				arrRowHeights.Add((nRow % 10 == 0) ? 0 : (18 + nRow % 7));	// Some hidden rows
+			}
+
+			BeginWaitCursor();
+
+			// Cell origin and point-to-row with the index
+			PerformanceCounter counter;
+			LONGLONG lIndexCheck = 0;
+			counter.Start();
+			for (int nCount = 0; nCount < nQueryCount; nCount++) {
+				int nRow = static_cast<int>((static_cast<size_t>(nCount) * 7919) % nRowCount);
+				LONGLONG lOffset = arrRowHeights.GetSum(nRow);
+				lIndexCheck += lOffset + arrRowHeights.FindIndex(lOffset + 5);
+			}
+			counter.Stop();
+			double dIndexTime = counter.GetElapsedTime(true);
+
+			// Same lookups by walking rows from the top
+			LONGLONG lWalkCheck = 0;
+			counter.Start();
+			for (int nCount = 0; nCount < nQueryCount; nCount++) {
+				int nRow = static_cast<int>((static_cast<size_t>(nCount) * 7919) % nRowCount);
+				LONGLONG lOffset = 0;
+				for (int nIndex = 0; nIndex < nRow; nIndex++) {
+					lOffset += arrRowHeights.GetAt(nIndex);
+				}
+				int nFound = 0;
+				LONGLONG lBottom = 0;
+				for (; nFound < nRowCount; nFound++) {
+					lBottom += arrRowHeights.GetAt(nFound);
+					if (lBottom > lOffset + 5)
+						break;
+				}
+				lWalkCheck += lOffset + nFound;
+			}
+			counter.Stop();
+			double dWalkTime = counter.GetElapsedTime(true);
+
+			// Resize rows one by one (index is updated incrementally)
+			counter.Start();
+			for (int nCount = 0; nCount < nQueryCount; nCount++) {
+				int nRow = static_cast<int>((static_cast<size_t>(nCount) * 7919) % nRowCount);
+				arrRowHeights[nRow] = 24;
+			}
+			LONGLONG lTotalHeight = arrRowHeights.GetTotal();
+			counter.Stop();
+			double dResizeTime = counter.GetElapsedTime(true);
+
+			EndWaitCursor();
+
+			OutputDebugLogFormat(_T("Rows=%d, Queries=%d, Index=%.4f (ms), Walk=%.4f (ms), Match=%d, Resize=%.4f (ms), Height=%lld"), nRowCount, nQueryCount,
+				dIndexTime, dWalkTime, (lIndexCheck == lWalkCheck), dResizeTime, lTotalHeight);
+			bNoReply = false;	// Reset flag
+		}
+		else if ((tokenCount == 2) && (!_tcscmp(tokenList.at(1).c_str(), _T("gridstorage")))) {
+			// Fill a 100k-row grid with one cell object per cell versus the compact cell store
+			constexpr int nRowCount = 100000;
+			constexpr int nColCount = 6;
+			double dResizeTime[2] = { 0 }, dFillTime[2] = { 0 }, dReadTime[2] = { 0 };
+			size_t nReadCheck[2] = { 0 };
+			size_t nStoreSize = 0;
+
+			BeginWaitCursor();
+
+			PerformanceCounter counter;
+			for (int nMode = 0; nMode < 2; nMode++) {
+				CGridCtrl gridCtrl;
+				gridCtrl.SetCompactMode(nMode == 1);
+				gridCtrl.SetColumnCount(nColCount);
+				gridCtrl.SetFixedRowCount(1);
+
+				counter.Start();
+				gridCtrl.SetRowCount(nRowCount + 1);
+				counter.Stop();
+				dResizeTime[nMode] = counter.GetElapsedTime(true);
+
+				// Few distinct values per column, as in log and schedule tables
+				String strText;
+				counter.Start();
+				for (int nRow = 1; nRow <= nRowCount; nRow++) {
+					for (int nCol = 0; nCol < nColCount; nCol++) {
+						strText.Format(_T("Item %d"), (nRow * (nCol + 1)) % 500);
+						gridCtrl.SetItemText(nRow, nCol, strText);
+					}
+				}
+				counter.Stop();
+				dFillTime[nMode] = counter.GetElapsedTime(true);
+
+				counter.Start();
+				for (int nRow = 1; nRow <= nRowCount; nRow++) {
+					for (int nCol = 0; nCol < nColCount; nCol++) {
+						nReadCheck[nMode] += gridCtrl.GetItemText(nRow, nCol).GetLength();
+					}
+				}
+				counter.Stop();
+				dReadTime[nMode] = counter.GetElapsedTime(true);
+
+				if (nMode == 1) {
+					nStoreSize = gridCtrl.GetCellStore().GetMemoryUsage();
+				}
+			}
+
+			EndWaitCursor();
+
+			// Per cell: a CGridCell object plus its pointer in the row array (text buffers excluded)
+			size_t nObjectBytes = sizeof(CGridCell) + sizeof(CGridCellBase*);
+			OutputDebugLogFormat(_T("Cells=%d, Resize: objects=%.4f (ms), compact=%.4f (ms), Fill: objects=%.4f (ms), compact=%.4f (ms), ")
+								 _T("Read: objects=%.4f (ms), compact=%.4f (ms), Match=%d, Bytes/cell: objects>=%zu, compact=%.1f"),
+				nRowCount * nColCount, dResizeTime[0], dResizeTime[1], dFillTime[0], dFillTime[1], dReadTime[0], dReadTime[1],
+				(nReadCheck[0] == nReadCheck[1]), nObjectBytes, static_cast<double>(nStoreSize) / ((nRowCount + 1) * nColCount));
+			bNoReply = false;	// Reset flag
+		}
+		else if ((tokenCount == 2) && (!_tcscmp(tokenList.at(1).c_str(), _T("gridsort")))) {
+			// Sort a 100k-row grid by a text and a date column: keys extracted once (built-in
+			// comparisons) versus calling a compare function on the cells for each comparison
+			constexpr int nRowCount = 100000;
+			CGridCtrl gridCtrl;
+			gridCtrl.SetColumnCount(2);
+			gridCtrl.SetFixedRowCount(1);
+			gridCtrl.SetRowCount(nRowCount + 1);
+
+			auto fillGrid = [&gridCtrl]() {
+				String strText;
+				for (int nRow = 1; nRow <= nRowCount; nRow++) {
+					int nValue = static_cast<int>((static_cast<size_t>(nRow) * 7919) % nRowCount);
+					strText.Format(_T("Item %05d"), nValue);
+					gridCtrl.SetItemText(nRow, 0, strText);
+					strText.Format(_T("%04d/%02d/%02d %02d:%02d:%02d"), 2000 + nValue % 25, 1 + nValue % 12, 1 + nValue % 28,
+								   nValue % 24, nValue % 60, (nValue / 60) % 60);
+					gridCtrl.SetItemText(nRow, 1, strText);
+				}
+			};
+			auto isSorted = [&gridCtrl](int nCol, PFNLVCOMPARE pfnCompare) {
+				for (int nRow = 2; nRow <= nRowCount; nRow++) {
+					if (pfnCompare((LPARAM)gridCtrl.GetCell(nRow - 1, nCol), (LPARAM)gridCtrl.GetCell(nRow, nCol), 0) > 0)
+						return false;
+				}
+				return true;
+			};
+			PFNLVCOMPARE pfnCallbackCompare = [](LPARAM lParam1, LPARAM lParam2, LPARAM) -> int {
+				return _tcscmp(((CGridCellBase*)lParam1)->GetText(), ((CGridCellBase*)lParam2)->GetText());
+			};
+
+			BeginWaitCursor();
+
+			PerformanceCounter counter;
+			fillGrid();
+			counter.Start();
+			gridCtrl.SortItems(CGridCtrl::pfnCellTextCompare, 0, TRUE);
+			counter.Stop();
+			double dTextTime = counter.GetElapsedTime(true);
+			bool bTextSorted = isSorted(0, CGridCtrl::pfnCellTextCompare);
+
+			fillGrid();
+			counter.Start();
+			gridCtrl.SortItems(pfnCallbackCompare, 0, TRUE);
+			counter.Stop();
+			double dCallbackTime = counter.GetElapsedTime(true);
+			bool bCallbackSorted = isSorted(0, CGridCtrl::pfnCellTextCompare);
+
+			fillGrid();
+			counter.Start();
+			gridCtrl.SortItems(CGridCtrl::pfnCellDateCompare, 1, FALSE);
+			counter.Stop();
+			double dDateTime = counter.GetElapsedTime(true);
+			bool bDateSorted = isSorted(1, [](LPARAM lParam1, LPARAM lParam2, LPARAM lParamSort) -> int {
+				return CGridCtrl::pfnCellDateCompare(lParam2, lParam1, lParamSort);
+			});
+
+			EndWaitCursor();
+
+			OutputDebugLogFormat(_T("Rows=%d, Text: keys=%.4f (ms), callback=%.4f (ms), Date (descending): keys=%.4f (ms), Sorted=%d/%d/%d"),
+				nRowCount, dTextTime, dCallbackTime, dDateTime, bTextSorted, bCallbackSorted, bDateSorted);
+			bNoReply = false;	// Reset flag
+		}
+		else if ((tokenCount == 2) && (!_tcscmp(tokenList.at(1).c_str(), _T("gridpaint")))) {
+			// Scroll a visible grid line by line, redrawing the whole cell area on each scroll
+			// versus moving the drawn cells and redrawing the exposed row only
+			constexpr int nRowCount = 20000;
+			constexpr int nColCount = 8;
+			constexpr int nScrollCount = 300;
+			GV_PAINTSTATS paintStats[2] = { 0 };
+
+			BeginWaitCursor();
+
+			for (int nMode = 0; nMode < 2; nMode++) {
+				CGridCtrl gridCtrl;
+				if (!gridCtrl.CreateEx(WS_EX_TOOLWINDOW, GRIDCTRL_CLASSNAME, NULL, WS_POPUP | WS_BORDER | WS_VISIBLE,
+									   CRect(100, 100, 900, 700), this, 0))
+					break;
+
+				gridCtrl.SetScrollBlit(nMode == 1);
+				gridCtrl.SetColumnCount(nColCount);
+				gridCtrl.SetFixedRowCount(1);
+				gridCtrl.SetRowCount(nRowCount + 1);
+				String strText;
+				for (int nRow = 1; nRow <= nRowCount; nRow++) {
+					for (int nCol = 0; nCol < nColCount; nCol++) {
+						strText.Format(_T("Row %d, column %d"), nRow, nCol);
+						gridCtrl.SetItemText(nRow, nCol, strText);
+					}
+				}
+				gridCtrl.UpdateWindow();
+				gridCtrl.ResetPaintStats();
+
+				for (int nCount = 0; nCount < nScrollCount; nCount++) {
+					gridCtrl.SendMessage(WM_VSCROLL, SB_LINEDOWN, 0);
+					gridCtrl.UpdateWindow();
+				}
+				paintStats[nMode] = gridCtrl.GetPaintStats();
+				gridCtrl.DestroyWindow();
+			}
+
+			EndWaitCursor();
+
+			auto averageTime = [](const GV_PAINTSTATS& stats) {
+				return (stats.nPaintCount > 0) ? (stats.dTotalTime / stats.nPaintCount) : 0.0;
+			};
+			OutputDebugLogFormat(_T("Scrolls=%d, Redraw all: paints=%u, avg=%.4f (ms), max=%.4f (ms), Move cells: paints=%u, moved=%u, avg=%.4f (ms), max=%.4f (ms)"),
+				nScrollCount, paintStats[0].nPaintCount, averageTime(paintStats[0]), paintStats[0].dMaxTime,
+				paintStats[1].nPaintCount, paintStats[1].nScrollCount, averageTime(paintStats[1]), paintStats[1].dMaxTime);
+			bNoReply = false;	// Reset flag
+		}
+		else if ((tokenCount == 2) && (!_tcscmp(tokenList.at(1).c_str(), _T("gridautosize")))) {
+			// Autosize the columns of a 20k-row grid: first pass (text measured), second pass
+			// (extents found in the text cache), then measuring sampled rows only
+			constexpr int nRowCount = 20000;
+			constexpr int nColCount = 8;
+			constexpr int nSampleRows = 1000;
+			CGridCtrl gridCtrl;
+			if (gridCtrl.CreateEx(WS_EX_TOOLWINDOW, GRIDCTRL_CLASSNAME, NULL, WS_POPUP | WS_BORDER,
+								  CRect(100, 100, 900, 700), this, 0)) {
+				BeginWaitCursor();
+
+				gridCtrl.SetColumnCount(nColCount);
+				gridCtrl.SetFixedRowCount(1);
+				gridCtrl.SetRowCount(nRowCount + 1);
+				String strText;
+				for (int nRow = 1; nRow <= nRowCount; nRow++) {
+					for (int nCol = 0; nCol < nColCount; nCol++) {
+						strText.Format(_T("Item %d-%d"), (nRow * 7919) % 400, nCol);
+						gridCtrl.SetItemText(nRow, nCol, strText);
+					}
+				}
+
+				CGridTextExtentCache& textCache = gridCtrl.GetTextExtentCache();
+				textCache.RemoveAll();
+				textCache.ResetStats();
+
+				PerformanceCounter counter;
+				counter.Start();
+				gridCtrl.AutoSizeColumns();
+				counter.Stop();
+				double dColdTime = counter.GetElapsedTime(true);
+				UINT nColdMisses = textCache.GetMissCount();
+
+				textCache.ResetStats();
+				counter.Start();
+				gridCtrl.AutoSizeColumns();
+				counter.Stop();
+				double dWarmTime = counter.GetElapsedTime(true);
+				UINT nWarmHits = textCache.GetHitCount();
+				UINT nWarmMisses = textCache.GetMissCount();
+
+				gridCtrl.SetAutoSizeSampleRows(nSampleRows);
+				counter.Start();
+				gridCtrl.AutoSizeColumns();
+				counter.Stop();
+				double dSampleTime = counter.GetElapsedTime(true);
+
+				counter.Start();
+				gridCtrl.AutoSize();
+				counter.Stop();
+				double dSampleBothTime = counter.GetElapsedTime(true);
+
+				gridCtrl.DestroyWindow();
+				EndWaitCursor();
+
+				OutputDebugLogFormat(_T("Rows=%d, Columns=%d, First autosize=%.4f (ms, measured=%u), Cached=%.4f (ms, hits=%u, measured=%u), Sampled (%d rows)=%.4f (ms), Sampled rows and columns=%.4f (ms)"),
+					nRowCount, nColCount, dColdTime, nColdMisses, dWarmTime, nWarmHits, nWarmMisses, nSampleRows, dSampleTime, dSampleBothTime);
+			}
+			bNoReply = false;	// Reset flag
+		}
+		else {
+			// Invalid command
+			bInvalidCmdFlag = true;
+		}
+	}
 	else {
 		// Invalid command
 		bInvalidCmdFlag = true;
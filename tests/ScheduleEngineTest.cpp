@@ -0,0 +1,277 @@
+﻿/**
+ * @file		ScheduleEngineTest.cpp
+ * @brief		Unit test of the schedule engine, driven by a fake clock
+ * @author		AnthonyLeeStark
+ * @date		2026.10.17
+ *
+ * @copyright 	Copyright (c) 2015-2025 AnthonyLeeStark
+ *
+ * The engine only depends on the standard library, so this test builds on any platform:
+ *		g++ -std=c++20 -Iinclude tests/ScheduleEngineTest.cpp source/AppCore/ScheduleEngine.cpp
+ */
+
+#include "AppCore/ScheduleEngine.h"
+#include <cstdio>
+
+using namespace std::chrono;
+
+
+// Test result counters
+static int g_nCheckCount = 0;
+static int g_nFailCount = 0;
+
+#define TEST_CHECK(expr) \
+	do { \
+		g_nCheckCount++; \
+		if (!(expr)) { \
+			g_nFailCount++; \
+			std::printf("%s(%d): check failed: %s\n", __FILE__, __LINE__, #expr); \
+		} \
+	} while (0)
+
+
+// Fake clock which only moves when the test moves it
+class FakeClock
+{
+private:
+	ScheduleEngine::TimePoint	m_tpNow;
+	int							m_nQueryCount;
+
+public:
+	explicit FakeClock(ScheduleEngine::TimePoint tpStart) : m_tpNow(tpStart), m_nQueryCount(0) {};
+
+	ScheduleEngine::TimePoint Now(void) {
+		m_nQueryCount++;
+		return m_tpNow;
+	};
+	void SetTime(ScheduleEngine::TimePoint tpTime) {
+		m_tpNow = tpTime;
+	};
+	void Advance(ScheduleEngine::Duration duration) {
+		m_tpNow += duration;
+	};
+	int GetQueryCount(void) const {
+		return m_nQueryCount;
+	};
+	ScheduleEngine::ClockFunc GetClockFunc(void) {
+		return [this]() { return Now(); };
+	};
+};
+
+
+// Test data helpers
+static const sys_days g_dayStart = sys_days{ year{2026} / October / 17 };	// Saturday
+
+static ScheduleEngine::TimePoint At(int nDayOffset, int nHour, int nMinute, int nSecond = 0)
+{
+	return g_dayStart + days(nDayOffset) + hours(nHour) + minutes(nMinute) + seconds(nSecond);
+}
+
+static ScheduleEngine::Entry MakeEntry(unsigned nItemID, int nHour, int nMinute, bool bRepeat = false,
+									   unsigned char byActiveDays = 0x7F, bool bEnabled = true)
+{
+	ScheduleEngine::Entry schEntry{};
+	schEntry.nItemID = nItemID;
+	schEntry.bEnabled = bEnabled;
+	schEntry.bRepeat = bRepeat;
+	schEntry.byActiveDays = byActiveDays;
+	schEntry.nTimeOfDay = (nHour * 3600) + (nMinute * 60);
+	return schEntry;
+}
+
+
+/**
+ * @brief	An engine without enabled entries has no deadline, so the caller never wakes up
+ */
+static void TestIdleEngineHasNoDeadline(void)
+{
+	FakeClock clock(At(0, 7, 0));
+	ScheduleEngine schEngine(clock.GetClockFunc());
+
+	TEST_CHECK(schEngine.IsEmpty());
+	TEST_CHECK(schEngine.GetNextDeadline() == ScheduleEngine::TimePoint::max());
+	TEST_CHECK(schEngine.GetTimeToNextDeadline() == milliseconds::max());
+
+	// Disabled items and repeat items without active days never fire
+	schEngine.Rebuild({ MakeEntry(1, 8, 0, false, 0x7F, false), MakeEntry(2, 9, 0, true, 0x00) });
+	TEST_CHECK(schEngine.IsEmpty());
+	TEST_CHECK(schEngine.GetTimeToNextDeadline() == milliseconds::max());
+
+	// Nothing is due however far the clock moves
+	ScheduleEngine::EventList arrDueEvents;
+	clock.Advance(days(30));
+	TEST_CHECK(schEngine.CollectDueEvents(arrDueEvents) == 0);
+	TEST_CHECK(schEngine.IsEmpty());
+}
+
+
+/**
+ * @brief	Notify and action events fire at the exact times, in order
+ */
+static void TestNotifyAndActionTimes(void)
+{
+	FakeClock clock(At(0, 7, 0));
+	ScheduleEngine schEngine(clock.GetClockFunc());
+	schEngine.Rebuild({ MakeEntry(1, 8, 0) });
+
+	// First deadline is the notify event, the whole wait is one timer interval
+	TEST_CHECK(schEngine.GetNextDeadline() == At(0, 7, 59, 30));
+	TEST_CHECK(schEngine.GetTimeToNextDeadline() == duration_cast<milliseconds>(minutes(59) + seconds(30)));
+
+	// Nothing is due one second early
+	ScheduleEngine::EventList arrDueEvents;
+	clock.SetTime(At(0, 7, 59, 29));
+	TEST_CHECK(schEngine.CollectDueEvents(arrDueEvents) == 0);
+
+	clock.SetTime(At(0, 7, 59, 30));
+	TEST_CHECK(schEngine.CollectDueEvents(arrDueEvents) == 1);
+	TEST_CHECK(arrDueEvents.size() == 1 && arrDueEvents[0].eType == ScheduleEngine::notifyEvent);
+	TEST_CHECK(arrDueEvents.size() == 1 && arrDueEvents[0].tpOccurrence == At(0, 8, 0));
+	TEST_CHECK(schEngine.GetNextDeadline() == At(0, 8, 0));
+
+	clock.SetTime(At(0, 8, 0));
+	TEST_CHECK(schEngine.CollectDueEvents(arrDueEvents) == 1);
+	TEST_CHECK(arrDueEvents.size() == 1 && arrDueEvents[0].eType == ScheduleEngine::actionEvent);
+	TEST_CHECK(arrDueEvents.size() == 1 && arrDueEvents[0].nItemID == 1);
+
+	// Collecting again at the same time does not fire the action twice
+	TEST_CHECK(schEngine.CollectDueEvents(arrDueEvents) == 0);
+
+	// Rebuilding right after the action (data changed) does not fire it again either
+	clock.SetTime(At(0, 8, 0, 5));
+	schEngine.Rebuild({ MakeEntry(1, 8, 0) });
+	TEST_CHECK(schEngine.CollectDueEvents(arrDueEvents) == 0);
+	TEST_CHECK(schEngine.GetNextDeadline() == At(1, 7, 59, 30));
+}
+
+
+/**
+ * @brief	Repeat items only fire on their active days
+ */
+static void TestRepeatActiveDays(void)
+{
+	// Monday and Wednesday only (Sunday = bit 0), starting on a Saturday
+	FakeClock clock(At(0, 12, 0));
+	ScheduleEngine schEngine(clock.GetClockFunc());
+	schEngine.SetNotifyOffset(0);
+	schEngine.Rebuild({ MakeEntry(7, 6, 30, true, (1 << 1) | (1 << 3)) });
+
+	TEST_CHECK(weekday(g_dayStart) == Saturday);
+	TEST_CHECK(schEngine.GetNextDeadline() == At(2, 6, 30));
+
+	ScheduleEngine::EventList arrDueEvents;
+	clock.SetTime(At(2, 6, 30));
+	TEST_CHECK(schEngine.CollectDueEvents(arrDueEvents) == 1);
+	TEST_CHECK(schEngine.GetNextDeadline() == At(4, 6, 30));
+
+	clock.SetTime(At(4, 6, 30));
+	TEST_CHECK(schEngine.CollectDueEvents(arrDueEvents) == 1);
+	TEST_CHECK(schEngine.GetNextDeadline() == At(9, 6, 30));
+}
+
+
+/**
+ * @brief	Snoozed actions fire after the interval, and can be cancelled
+ */
+static void TestSnooze(void)
+{
+	FakeClock clock(At(0, 8, 0));
+	ScheduleEngine schEngine(clock.GetClockFunc());
+	schEngine.SetNotifyOffset(0);
+	schEngine.Rebuild({ MakeEntry(3, 8, 0) });
+
+	ScheduleEngine::EventList arrDueEvents;
+	TEST_CHECK(schEngine.CollectDueEvents(arrDueEvents) == 1);
+
+	// Snooze for 5 minutes
+	schEngine.Snooze(3, 300);
+	TEST_CHECK(schEngine.GetNextDeadline() == At(0, 8, 5));
+
+	clock.SetTime(At(0, 8, 4, 59));
+	TEST_CHECK(schEngine.CollectDueEvents(arrDueEvents) == 0);
+	clock.SetTime(At(0, 8, 5));
+	TEST_CHECK(schEngine.CollectDueEvents(arrDueEvents) == 1);
+	TEST_CHECK(arrDueEvents.size() == 1 && arrDueEvents[0].eType == ScheduleEngine::snoozeEvent);
+
+	// A snooze is kept by rebuilds, but not by cancelling
+	schEngine.Snooze(3, 300);
+	schEngine.Rebuild({ MakeEntry(3, 8, 0) });
+	TEST_CHECK(schEngine.GetNextDeadline() == At(0, 8, 10));
+	schEngine.CancelSnooze(3);
+	TEST_CHECK(schEngine.GetNextDeadline() == At(1, 8, 0));
+}
+
+
+/**
+ * @brief	Actions which are late beyond the tolerance (system sleep) are dropped
+ */
+static void TestLateActionIsDropped(void)
+{
+	FakeClock clock(At(0, 7, 0));
+	ScheduleEngine schEngine(clock.GetClockFunc());
+	schEngine.Rebuild({ MakeEntry(5, 8, 0, true) });
+
+	ScheduleEngine::EventList arrDueEvents;
+	clock.SetTime(At(0, 9, 0));
+	TEST_CHECK(schEngine.CollectDueEvents(arrDueEvents) == 0);
+
+	// Next occurrence is still scheduled
+	TEST_CHECK(schEngine.GetNextDeadline() == At(1, 7, 59, 30));
+}
+
+
+/**
+ * @brief	Waking up only at the deadlines handles a week of schedules without a single empty wake-up
+ */
+static void TestNoPollingWhileIdle(void)
+{
+	FakeClock clock(At(0, 0, 0));
+	ScheduleEngine schEngine(clock.GetClockFunc());
+	schEngine.Rebuild({
+		MakeEntry(1, 8, 0, true, 0x3E),				// Weekdays
+		MakeEntry(2, 22, 30, true, 0x7F),			// Every day
+		MakeEntry(3, 12, 15, true, 0x41),			// Weekends
+	});
+
+	int nWakeUpCount = 0;
+	int nEmptyWakeUpCount = 0;
+	int nActionCount = 0;
+	ScheduleEngine::EventList arrDueEvents;
+	while (schEngine.GetNextDeadline() < At(7, 0, 0)) {
+
+		// Sleep until the deadline, as the caller's one-shot timer does
+		clock.Advance(schEngine.GetTimeToNextDeadline());
+		nWakeUpCount++;
+
+		if (schEngine.CollectDueEvents(arrDueEvents) == 0)
+			nEmptyWakeUpCount++;
+		for (const ScheduleEngine::Event& schEvent : arrDueEvents) {
+			if (schEvent.eType == ScheduleEngine::actionEvent)
+				nActionCount++;
+		}
+	}
+
+	// 5 weekday + 7 daily + 2 weekend actions, each one preceded by a notify event
+	TEST_CHECK(nActionCount == 14);
+	TEST_CHECK(nWakeUpCount == 28);
+	TEST_CHECK(nEmptyWakeUpCount == 0);
+
+	// The engine does not query the clock on its own while nobody asks
+	int nQueryCount = clock.GetQueryCount();
+	clock.Advance(hours(1));
+	TEST_CHECK(clock.GetQueryCount() == nQueryCount);
+}
+
+
+int main(void)
+{
+	TestIdleEngineHasNoDeadline();
+	TestNotifyAndActionTimes();
+	TestRepeatActiveDays();
+	TestSnooze();
+	TestLateActionIsDropped();
+	TestNoPollingWhileIdle();
+
+	std::printf("ScheduleEngineTest: %d checks, %d failed\n", g_nCheckCount, g_nFailCount);
+	return (g_nFailCount == 0) ? 0 : 1;
+}
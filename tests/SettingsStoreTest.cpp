@@ -0,0 +1,252 @@
+﻿/**
+ * @file		SettingsStoreTest.cpp
+ * @brief		Unit test of the settings store with the memory/file backend
+ * @author		AnthonyLeeStark
+ * @date		2026.10.17
+ *
+ * @copyright 	Copyright (c) 2015-2025 AnthonyLeeStark
+ *
+ * The store only depends on the standard library, so this test builds on any platform:
+ *		g++ -std=c++20 -Iinclude tests/SettingsStoreTest.cpp source/AppCore/SettingsStore.cpp
+ */
+
+#include "AppCore/SettingsStore.h"
+#include <cstdio>
+#include <fstream>
+
+using Snapshot = SettingsStore::Snapshot;
+
+
+// Test result counters
+static int g_nCheckCount = 0;
+static int g_nFailCount = 0;
+
+#define TEST_CHECK(expr) \
+	do { \
+		g_nCheckCount++; \
+		if (!(expr)) { \
+			g_nFailCount++; \
+			std::printf("%s(%d): check failed: %s\n", __FILE__, __LINE__, #expr); \
+		} \
+	} while (0)
+
+
+// Backend which counts calls and fails on request (wraps a memory backend)
+class FaultyBackend final : public SettingsStore::Backend
+{
+private:
+	MemorySettingsBackend*	m_pMemoryBackend;
+	std::wstring			m_failKeyName;						// Writing this key fails
+	bool					m_bFailCommit;						// Committing fails
+
+public:
+	int						m_nWriteCalls;
+	int						m_nDeleteValueCalls;
+	int						m_nDeleteSectionCalls;
+	int						m_nRollbackCalls;
+
+public:
+	explicit FaultyBackend(MemorySettingsBackend* pMemoryBackend)
+		: m_pMemoryBackend(pMemoryBackend), m_bFailCommit(false),
+		  m_nWriteCalls(0), m_nDeleteValueCalls(0), m_nDeleteSectionCalls(0), m_nRollbackCalls(0) {};
+
+	void SetFailKey(const wchar_t* keyName) {
+		m_failKeyName = (keyName != nullptr) ? keyName : L"";
+	};
+	void SetFailCommit(bool bFailCommit) {
+		m_bFailCommit = bFailCommit;
+	};
+	void ResetCalls(void) {
+		m_nWriteCalls = m_nDeleteValueCalls = m_nDeleteSectionCalls = m_nRollbackCalls = 0;
+	};
+
+public:
+	bool ReadSection(const std::wstring& rootSection, Snapshot& snapshot) override {
+		return m_pMemoryBackend->ReadSection(rootSection, snapshot);
+	};
+	bool BeginTransaction(void) override {
+		return m_pMemoryBackend->BeginTransaction();
+	};
+	bool CommitTransaction(void) override {
+		if (m_bFailCommit) {
+			m_pMemoryBackend->RollbackTransaction();
+			return false;
+		}
+		return m_pMemoryBackend->CommitTransaction();
+	};
+	void RollbackTransaction(void) override {
+		m_nRollbackCalls++;
+		m_pMemoryBackend->RollbackTransaction();
+	};
+	bool WriteValue(const std::wstring& sectionPath, const std::wstring& keyName, const SettingsStore::Value& value) override {
+		m_nWriteCalls++;
+		if (!m_failKeyName.empty() && (keyName == m_failKeyName)) return false;
+		return m_pMemoryBackend->WriteValue(sectionPath, keyName, value);
+	};
+	bool DeleteValue(const std::wstring& sectionPath, const std::wstring& keyName) override {
+		m_nDeleteValueCalls++;
+		return m_pMemoryBackend->DeleteValue(sectionPath, keyName);
+	};
+	bool DeleteSection(const std::wstring& sectionPath) override {
+		m_nDeleteSectionCalls++;
+		return m_pMemoryBackend->DeleteSection(sectionPath);
+	};
+};
+
+
+// Test data helpers
+static Snapshot MakeConfigData(int nActionType, const wchar_t* message)
+{
+	Snapshot snapshot;
+	SettingsStore::SetValue(snapshot, L"ConfigData", nullptr, L"LMBAction", nActionType);
+	SettingsStore::SetValue(snapshot, L"ConfigData", nullptr, L"ShowAtStartup", 1);
+	SettingsStore::SetValue(snapshot, L"ScheduleData", L"Item_00", L"Time", 480);
+	SettingsStore::SetValue(snapshot, L"ScheduleData", L"Item_00", L"Message", message);
+	SettingsStore::SetValue(snapshot, L"ScheduleData", L"Item_01", L"Time", 1320);
+	return snapshot;
+}
+
+static const std::vector<std::wstring> g_arrRootSections = { L"ConfigData", L"ScheduleData" };
+
+
+/**
+ * @brief	Only changed keys are written, removed keys and subsections are deleted
+ */
+static void TestCommitChangedKeysOnly(void)
+{
+	MemorySettingsBackend memoryBackend;
+	FaultyBackend* pBackend = new FaultyBackend(&memoryBackend);
+	SettingsStore settingsStore{ std::unique_ptr<SettingsStore::Backend>(pBackend) };
+
+	// First commit writes everything
+	Snapshot snapshot = MakeConfigData(1, L"Wake up");
+	TEST_CHECK(settingsStore.Commit(snapshot, g_arrRootSections));
+	TEST_CHECK(settingsStore.GetLastWriteCount() == 5);
+	TEST_CHECK(settingsStore.GetLastDeleteCount() == 0);
+	TEST_CHECK(memoryBackend.GetData() == snapshot);
+
+	// Nothing changed: nothing is written
+	pBackend->ResetCalls();
+	TEST_CHECK(settingsStore.Commit(snapshot, g_arrRootSections));
+	TEST_CHECK(settingsStore.GetLastWriteCount() == 0);
+	TEST_CHECK(pBackend->m_nWriteCalls == 0);
+
+	// One value changed: only that key is written
+	pBackend->ResetCalls();
+	snapshot = MakeConfigData(2, L"Wake up");
+	TEST_CHECK(settingsStore.Commit(snapshot, g_arrRootSections));
+	TEST_CHECK(settingsStore.GetLastWriteCount() == 1);
+	TEST_CHECK(pBackend->m_nWriteCalls == 1);
+	TEST_CHECK(memoryBackend.GetData().at(L"ConfigData").at(L"LMBAction") == SettingsStore::Value(2));
+
+	// Value type changed (integer -> string) counts as a change
+	pBackend->ResetCalls();
+	snapshot[L"ConfigData"][L"LMBAction"] = std::wstring(L"2");
+	TEST_CHECK(settingsStore.Commit(snapshot, g_arrRootSections));
+	TEST_CHECK(pBackend->m_nWriteCalls == 1);
+
+	// Removed key and removed subsection are deleted
+	pBackend->ResetCalls();
+	snapshot[L"ConfigData"].erase(L"ShowAtStartup");
+	snapshot.erase(L"ScheduleData\\Item_01");
+	TEST_CHECK(settingsStore.Commit(snapshot, g_arrRootSections));
+	TEST_CHECK(settingsStore.GetLastWriteCount() == 0);
+	TEST_CHECK(settingsStore.GetLastDeleteCount() == 2);
+	TEST_CHECK(pBackend->m_nDeleteValueCalls == 1);
+	TEST_CHECK(pBackend->m_nDeleteSectionCalls == 1);
+	TEST_CHECK(memoryBackend.GetData() == snapshot);
+
+	// Sections outside the committed root sections are not touched
+	pBackend->ResetCalls();
+	Snapshot otherSnapshot = snapshot;
+	otherSnapshot.erase(L"ScheduleData\\Item_00");
+	TEST_CHECK(settingsStore.Commit(otherSnapshot, { L"ConfigData" }));
+	TEST_CHECK(pBackend->m_nDeleteSectionCalls == 0);
+	TEST_CHECK(memoryBackend.GetData().count(L"ScheduleData\\Item_00") == 1);
+}
+
+
+/**
+ * @brief	A failed commit changes nothing, and the next commit writes the full difference again
+ */
+static void TestFailedCommitRollsBack(void)
+{
+	MemorySettingsBackend memoryBackend;
+	FaultyBackend* pBackend = new FaultyBackend(&memoryBackend);
+	SettingsStore settingsStore{ std::unique_ptr<SettingsStore::Backend>(pBackend) };
+
+	Snapshot oldSnapshot = MakeConfigData(1, L"Wake up");
+	TEST_CHECK(settingsStore.Commit(oldSnapshot, g_arrRootSections));
+
+	// Writing one key fails: the whole commit is rolled back
+	pBackend->ResetCalls();
+	pBackend->SetFailKey(L"Message");
+	Snapshot newSnapshot = MakeConfigData(3, L"Go to bed");
+	TEST_CHECK(!settingsStore.Commit(newSnapshot, g_arrRootSections));
+	TEST_CHECK(pBackend->m_nRollbackCalls == 1);
+	TEST_CHECK(settingsStore.GetLastWriteCount() == 0);
+	TEST_CHECK(settingsStore.GetLastDeleteCount() == 0);
+	TEST_CHECK(memoryBackend.GetData() == oldSnapshot);
+
+	// Committing the transaction fails: nothing is changed either
+	pBackend->SetFailKey(nullptr);
+	pBackend->SetFailCommit(true);
+	TEST_CHECK(!settingsStore.Commit(newSnapshot, g_arrRootSections));
+	TEST_CHECK(memoryBackend.GetData() == oldSnapshot);
+
+	// Backend works again: persisted data is read back, and both changed keys are written
+	pBackend->SetFailCommit(false);
+	pBackend->ResetCalls();
+	TEST_CHECK(settingsStore.Commit(newSnapshot, g_arrRootSections));
+	TEST_CHECK(settingsStore.GetLastWriteCount() == 2);
+	TEST_CHECK(memoryBackend.GetData() == newSnapshot);
+}
+
+
+/**
+ * @brief	File backed data survives a reload, and a failed file save keeps the old data
+ */
+static void TestFileBackend(void)
+{
+	std::filesystem::path filePath = std::filesystem::temp_directory_path() / L"SettingsStoreTest.dat";
+	std::filesystem::remove(filePath);
+
+	Snapshot snapshot = MakeConfigData(1, L"Wake up");
+	{
+		SettingsStore settingsStore{ std::make_unique<MemorySettingsBackend>(filePath) };
+		TEST_CHECK(settingsStore.Commit(snapshot, g_arrRootSections));
+	}
+
+	// Reload from file
+	MemorySettingsBackend reloadBackend(filePath);
+	TEST_CHECK(reloadBackend.GetData() == snapshot);
+
+	// Corrupted file is rejected (checksum)
+	{
+		std::fstream fileStream(filePath, std::ios::binary | std::ios::in | std::ios::out);
+		fileStream.seekp(-1, std::ios::end);
+		fileStream.put('\x7F');
+	}
+	MemorySettingsBackend corruptBackend(filePath);
+	TEST_CHECK(corruptBackend.GetData().empty());
+
+	// File can not be saved (folder does not exist): committed data is kept
+	std::filesystem::path badFilePath = std::filesystem::temp_directory_path() / L"SettingsStoreTest_NoFolder" / L"Settings.dat";
+	MemorySettingsBackend* pBadBackend = new MemorySettingsBackend(badFilePath);
+	SettingsStore badStore{ std::unique_ptr<SettingsStore::Backend>(pBadBackend) };
+	TEST_CHECK(!badStore.Commit(snapshot, g_arrRootSections));
+	TEST_CHECK(pBadBackend->GetData().empty());
+
+	std::filesystem::remove(filePath);
+}
+
+
+int main(void)
+{
+	TestCommitChangedKeysOnly();
+	TestFailedCommitRollsBack();
+	TestFileBackend();
+
+	std::printf("SettingsStoreTest: %d checks, %d failed\n", g_nCheckCount, g_nFailCount);
+	return (g_nFailCount == 0) ? 0 : 1;
+}